@@ -294,6 +294,14 @@ bool PersistentCache::IsValid() const {
   return cache_directory_ && cache_directory_->is_valid();
 }
 
+fml::UniqueFD PersistentCache::OpenRasterCacheDirectory() const {
+  if (is_read_only_ || !IsValid()) {
+    return {};
+  }
+  return fml::CreateDirectory(*cache_directory_, {kRasterCacheSubdirName},
+                              fml::FilePermission::kReadWrite);
+}
+
 PersistentCache::SkSLCache PersistentCache::LoadFile(
     const fml::UniqueFD& dir,
     const std::string& file_name,
@@ -131,7 +131,13 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static void MarkStrategySet() { strategy_set_ = true; }
 
+  /// Opens the directory for the raster cache images that are kept across
+  /// runs, creating it if needed. Returns an invalid descriptor if the cache
+  /// is read-only or invalid.
+  fml::UniqueFD OpenRasterCacheDirectory() const;
+
   static constexpr char kSkSLSubdirName[] = "sksl";
+  static constexpr char kRasterCacheSubdirName[] = "raster_cache";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
 
  private:
@@ -38,7 +38,7 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  static constexpr int kStatisticsCount = kCount + 7;
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
@@ -60,6 +60,21 @@ class FrameTiming {
     picture_cache_count_ = picture_cache_count;
     picture_cache_bytes_ = picture_cache_bytes;
   }
+  // The number of frames that were waiting to be rasterized when the build
+  // of this frame finished, not counting this frame.
+  uint64_t GetQueuedFramesAtBuildFinish() const {
+    return queued_frames_at_build_finish_;
+  }
+  // The number of frames that were waiting to be rasterized when the
+  // rasterization of this frame started.
+  uint64_t GetQueuedFramesAtRasterStart() const {
+    return queued_frames_at_raster_start_;
+  }
+  void SetQueueDepths(size_t queued_frames_at_build_finish,
+                      size_t queued_frames_at_raster_start) {
+    queued_frames_at_build_finish_ = queued_frames_at_build_finish;
+    queued_frames_at_raster_start_ = queued_frames_at_raster_start;
+  }
 
  private:
   fml::TimePoint data_[kCount];
@@ -68,6 +83,8 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  size_t queued_frames_at_build_finish_ = 0;
+  size_t queued_frames_at_raster_start_ = 0;
 };
 
 using TaskObserverAdd =
@@ -152,10 +169,39 @@ struct Settings {
   bool trace_startup = false;
   bool trace_systrace = false;
   std::string trace_to_file;
+  // If not empty, the DisplayList op profiler is enabled and its profile is
+  // written to this path when the shell is destroyed.
+  std::string display_list_op_profile_path;
+  // If not empty, the percentiles of the durations of the phases of the
+  // rasterized frames are periodically written to this path as JSON, and
+  // once more when the shell is destroyed.
+  std::string frame_timing_statistics_path;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
+  // Render new raster cache entries on a background worker instead of in
+  // the frame that first needs them.
+  bool enable_background_raster_cache = false;
+  // The size limit of the raster cache images of static content that are
+  // kept in the persistent cache directory across runs of the app, or 0 to
+  // not keep them.
+  size_t raster_cache_disk_size_mb = 0;
+  // The size limit of the images in the raster cache, 0 for unlimited, or -1
+  // to derive the limit from the size of the view.
+  int64_t raster_cache_max_bytes = -1;
+  // The number of frames that the raster cache keeps an image after the last
+  // frame that used it, or -1 for the default.
+  int64_t raster_cache_eviction_grace_frames = -1;
+  // The number of frames that the UI thread may build ahead of the raster
+  // thread, or 0 for the platform default.
+  size_t frame_pipeline_depth = 0;
+  // Begin frames as soon as the frame pipeline has room for them instead of
+  // on vsync, for rendering that is not shown on a display.
+  bool enable_throughput_frame_pacing = false;
+  // The number of threads that rasterize the tiles of frames of the software
+  // renderer in parallel, or 0 or 1 to rasterize them on the raster thread.
+  size_t software_raster_thread_count = 0;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool profile_startup = false;
@@ -241,6 +287,9 @@ struct Settings {
   // An experimental mode that antialiases lines.
   bool impeller_antialiased_lines = false;
 
+  // An experimental mode that fills paths with analytic anti-aliasing.
+  bool impeller_analytic_path_fills = false;
+
   // Log a warning during shell initialization if Impeller is not enabled.
   bool warn_on_impeller_opt_out = false;
 
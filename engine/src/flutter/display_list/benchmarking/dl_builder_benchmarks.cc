@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_optimizer.h"
+#include "flutter/display_list/dl_storage_pool.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
 
@@ -98,6 +100,23 @@ static void BM_DisplayListBuilderDefault(benchmark::State& state,
   }
 }
 
+static void BM_DisplayListBuilderPooledStorage(
+    benchmark::State& state,
+    DisplayListBuilderBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  auto pool = DisplayListStoragePool::Create();
+  DisplayListStoragePool::SetForCurrentThread(pool);
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(prepare_rtree);
+    InvokeAllRenderingOps(builder);
+    Complete(builder, type);
+  }
+  DisplayListStoragePool::SetForCurrentThread(nullptr);
+  DisplayListStoragePool::Stats stats = pool->GetStats();
+  state.counters["ReusedBytes"] = stats.reused_bytes;
+  state.counters["AllocatedBytes"] = stats.allocated_bytes;
+}
+
 static void BM_DisplayListBuilderWithScaleAndTranslate(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
@@ -310,6 +329,61 @@ static void BM_DisplayListDispatchByVectorCull(
   }
 }
 
+// Records a few pages of a list of items, each drawn over an opaque
+// background, where each page covers the pages before it as it would
+// during a route transition. Each item is a row of abutting cells and
+// is followed by the empty save/restore of a child that drew nothing.
+static sk_sp<DisplayList> BuildOverdrawDisplayList() {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint background_paint(DlColor::kLightGrey());
+  DlPaint item_paint(DlColor::kWhite());
+  DlPaint cell_paint(DlColor::kMidGrey());
+  for (int page = 0; page < 4; page++) {
+    builder.DrawPaint(background_paint);
+    for (int item = 0; item < 50; item++) {
+      builder.Save();
+      builder.Translate(0, item * 40);
+      builder.ClipRect(DlRect::MakeWH(400, 40));
+      builder.DrawRect(DlRect::MakeWH(400, 40), item_paint);
+      for (int cell = 0; cell < 4; cell++) {
+        builder.DrawRect(DlRect::MakeXYWH(cell * 100, 5, 100, 30), cell_paint);
+      }
+      builder.Save();
+      builder.Translate(10, 10);
+      builder.Restore();
+      builder.Restore();
+    }
+  }
+  return builder.Build();
+}
+
+static void BM_DisplayListOptimize(benchmark::State& state) {
+  auto display_list = BuildOverdrawDisplayList();
+  DisplayListOptimizer::Stats stats;
+  sk_sp<DisplayList> optimized;
+  while (state.KeepRunning()) {
+    optimized = DisplayListOptimizer::Optimize(display_list, &stats);
+  }
+  state.counters["OpCount"] = display_list->op_count();
+  state.counters["OptimizedOpCount"] = optimized->op_count();
+  state.counters["OccludedOps"] = stats.occluded_op_count;
+  state.counters["MergedOps"] = stats.merged_op_count;
+  state.counters["RemovedStateOps"] = stats.removed_state_op_count;
+}
+
+static void BM_DisplayListDispatchOverdraw(benchmark::State& state,
+                                           bool optimize) {
+  auto display_list = BuildOverdrawDisplayList();
+  if (optimize) {
+    display_list = DisplayListOptimizer::Optimize(display_list);
+  }
+  DlOpReceiverIgnore receiver;
+  while (state.KeepRunning()) {
+    display_list->Dispatch(receiver);
+  }
+  state.counters["OpCount"] = display_list->op_count();
+}
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -327,6 +401,15 @@ BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   DisplayListBuilderBenchmarkType::kBoundsAndRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderPooledStorage,
+                  kDefault,
+                  DisplayListBuilderBenchmarkType::kDefault)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderPooledStorage,
+                  kRtree,
+                  DisplayListBuilderBenchmarkType::kRtree)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderWithScaleAndTranslate,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -464,4 +547,12 @@ BENCHMARK_CAPTURE(BM_DisplayListDispatchByVectorCull,
                   DisplayListDispatchBenchmarkType::kCulledWithRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_DisplayListOptimize)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListDispatchOverdraw, kOriginal, false)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListDispatchOverdraw, kOptimized, true)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_COST_TABLE_H_
+#define FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_COST_TABLE_H_
+
+namespace flutter {
+
+/// A linear model of the cost of rendering one op, in the complexity units
+/// used by all of the complexity calculators, where a score of 100 is
+/// roughly equivalent to 0.0005ms of rendering time.
+///
+/// The meaning of the units depends on the op that the cost applies to and
+/// is described next to each cost in |DlComplexityCostTable|. The area is
+/// always the area of the bounds of the op, or the size of the image for
+/// image ops.
+struct DlComplexityCost {
+  /// The cost of each call, regardless of its size.
+  float fixed = 0.0f;
+
+  /// The cost of each unit of the size of the call.
+  float per_unit = 0.0f;
+
+  /// The cost of each pixel of area covered by the call.
+  float per_area = 0.0f;
+
+  float Evaluate(float units, float area = 0.0f) const {
+    return fixed + per_unit * units + per_area * area;
+  }
+};
+
+/// The costs of an op for each of the paint attributes that the benchmarks
+/// measure separately. Ops which are always stroked, such as lines, only
+/// use the stroke and hairline costs.
+struct DlComplexityStyledCosts {
+  DlComplexityCost fill;
+  DlComplexityCost fill_aa;
+  DlComplexityCost stroke;
+  DlComplexityCost stroke_aa;
+  DlComplexityCost hairline;
+  DlComplexityCost hairline_aa;
+};
+
+/// The costs of an op that renders a path, which has a fixed cost for each
+/// call and a cost for each verb of the path depending on its type.
+struct DlComplexityPathCosts {
+  float fixed = 0.0f;
+  float line_verb = 0.0f;
+  float quad_verb = 0.0f;
+  float conic_verb = 0.0f;
+  float cubic_verb = 0.0f;
+};
+
+/// The costs of an op that renders an image, depending on whether the image
+/// is already backed by a texture or has to be uploaded first.
+struct DlComplexityImageCosts {
+  DlComplexityCost texture;
+  DlComplexityCost upload;
+};
+
+/// A table of per-op costs for one rendering backend, which is used by the
+/// |DisplayListTableComplexityCalculator|.
+///
+/// The tables are generated by
+/// //flutter/testing/benchmark/displaylist_cost_table.py, which fits the
+/// costs to the results of running the display_list_benchmarks suite
+/// against the backend. The fields below are listed in the order that the
+/// script emits them in.
+struct DlComplexityCostTable {
+  /// A human readable name for the backend that the table describes.
+  const char* name;
+
+  /// DisplayLists with a higher score than this are worth caching.
+  unsigned int cache_threshold;
+
+  /// drawColor and drawPaint, per call.
+  DlComplexityCost draw_color;
+
+  /// saveLayer and drawText are batched by most backends, so their fixed
+  /// cost is charged once per DisplayList that contains any such calls,
+  /// and their unit is a call.
+  DlComplexityCost save_layer;
+  DlComplexityCost draw_text;
+
+  /// The unit is the sum of the horizontal and vertical distances between
+  /// the end points of the line.
+  DlComplexityStyledCosts line;
+
+  /// The unit of the shape ops is the average of the width and height of
+  /// their bounds. The bounds of a circle are the square around it, and the
+  /// bounds of a DRRect are the bounds of its outer round rect.
+  DlComplexityStyledCosts rect;
+  DlComplexityStyledCosts oval;
+  DlComplexityStyledCosts circle;
+  DlComplexityStyledCosts round_rect;
+  DlComplexityStyledCosts diff_round_rect;
+  DlComplexityStyledCosts arc;
+
+  DlComplexityPathCosts path;
+  DlComplexityPathCosts path_aa;
+
+  /// drawPoints, indexed by |DlPointMode|. The unit is a point.
+  DlComplexityStyledCosts points[3];
+
+  /// The unit is a vertex.
+  DlComplexityCost vertices;
+
+  /// The unit of the image ops is the average of the width and height of
+  /// the image, or of the source rect for atlas sprites.
+  DlComplexityImageCosts image;
+  DlComplexityImageCosts image_rect;
+  DlComplexityImageCosts image_nine;
+
+  DlComplexityPathCosts shadow;
+  DlComplexityPathCosts shadow_transparent;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_COST_TABLE_H_
@@ -0,0 +1,308 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/benchmarking/dl_complexity_table.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Unlike the OpenGL and Metal calculators, this calculator contains no
+// numbers of its own. All of the costs come from a DlComplexityCostTable,
+// and the helper only decides which cost of the table applies to an op
+// and how large the op is, in the units documented in
+// dl_complexity_cost_table.h.
+//
+// The tables are meant to be fitted to the output of the
+// DisplayListBenchmarks suite by testing/benchmark/displaylist_cost_table.py.
+// The units used here must match the units that the script derives from
+// each benchmark.
+
+namespace flutter {
+
+unsigned int DisplayListTableComplexityCalculator::TableHelper::
+    BatchedComplexity() {
+  float complexity = 0.0f;
+  if (save_layer_count_ > 0) {
+    complexity += table_.save_layer.Evaluate(save_layer_count_);
+  }
+  if (draw_text_count_ > 0) {
+    complexity += table_.draw_text.Evaluate(draw_text_count_);
+  }
+  if (!(complexity < static_cast<float>(Ceiling()))) {
+    return Ceiling();
+  }
+  return static_cast<unsigned int>(std::max(complexity, 0.0f));
+}
+
+const DlComplexityCost&
+DisplayListTableComplexityCalculator::TableHelper::StyledCost(
+    const DlComplexityStyledCosts& costs,
+    bool always_stroked) {
+  if (!always_stroked && DrawStyle() == DlDrawStyle::kFill) {
+    return IsAntiAliased() ? costs.fill_aa : costs.fill;
+  }
+  if (IsHairline()) {
+    return IsAntiAliased() ? costs.hairline_aa : costs.hairline;
+  }
+  return IsAntiAliased() ? costs.stroke_aa : costs.stroke;
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    AccumulateShape(const DlComplexityStyledCosts& costs,
+                    const DlRect& bounds) {
+  DlScalar length = (bounds.GetWidth() + bounds.GetHeight()) / 2;
+  AccumulateCost(StyledCost(costs).Evaluate(length, bounds.Area()));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    AccumulateImage(const DlComplexityImageCosts& costs,
+                    const DlISize& size,
+                    bool texture_backed) {
+  // The area is computed in floating point as it can overflow for very
+  // large images.
+  float width = size.width;
+  float height = size.height;
+  const DlComplexityCost& cost = texture_backed ? costs.texture : costs.upload;
+  AccumulateCost(cost.Evaluate((width + height) / 2, width * height));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    AccumulatePath(const DlComplexityPathCosts& costs, const DlPath& path) {
+  auto verb_cost = [](float cost) {
+    return static_cast<unsigned int>(std::lround(std::max(cost, 0.0f)));
+  };
+  unsigned int verbs_complexity = CalculatePathComplexity(
+      path, verb_cost(costs.line_verb), verb_cost(costs.quad_verb),
+      verb_cost(costs.conic_verb), verb_cost(costs.cubic_verb));
+  AccumulateCost(costs.fixed + verbs_complexity);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    AccumulateCost(float cost) {
+  // Costs fitted to noisy measurements can be slightly negative for small
+  // ops, and costs of huge ops may not fit in an unsigned int.
+  if (!(cost < static_cast<float>(Ceiling()))) {
+    AccumulateComplexity(Ceiling());
+    return;
+  }
+  AccumulateComplexity(static_cast<unsigned int>(std::max(cost, 0.0f)));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::saveLayer(
+    const DlRect& bounds,
+    const SaveLayerOptions options,
+    const DlImageFilter* backdrop,
+    std::optional<int64_t> backdrop_id) {
+  if (IsComplex()) {
+    return;
+  }
+  if (backdrop) {
+    // Flutter does not offer this operation so this value can only ever be
+    // non-null for a frame-wide builder which is not currently evaluated for
+    // complexity.
+    AccumulateComplexity(Ceiling());
+  }
+  save_layer_count_++;
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawColor(
+    DlColor color,
+    DlBlendMode mode) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateCost(table_.draw_color.fixed);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawPaint() {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateCost(table_.draw_color.fixed);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawLine(
+    const DlPoint& p0,
+    const DlPoint& p1) {
+  if (IsComplex()) {
+    return;
+  }
+  DlScalar distance = std::abs(p0.x - p1.x) + std::abs(p0.y - p1.y);
+  AccumulateCost(StyledCost(table_.line, true).Evaluate(distance));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    drawDashedLine(const DlPoint& p0,
+                   const DlPoint& p1,
+                   DlScalar on_length,
+                   DlScalar off_length) {
+  // The benchmarks do not measure dashing separately.
+  drawLine(p0, p1);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawRect(
+    const DlRect& rect) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(table_.rect, rect);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawOval(
+    const DlRect& bounds) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(table_.oval, bounds);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawCircle(
+    const DlPoint& center,
+    DlScalar radius) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(table_.circle,
+                  DlRect::MakeLTRB(center.x - radius, center.y - radius,
+                                   center.x + radius, center.y + radius));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    drawRoundRect(const DlRoundRect& rrect) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(table_.round_rect, rrect.GetBounds());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    drawDiffRoundRect(const DlRoundRect& outer, const DlRoundRect& inner) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(table_.diff_round_rect, outer.GetBounds());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    drawRoundSuperellipse(const DlRoundSuperellipse& rse) {
+  // The benchmarks do not measure RSEs, so cost them as the round rect that
+  // approximates them.
+  drawRoundRect(rse.ToApproximateRoundRect());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawPath(
+    const DlPath& path) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulatePath(IsAntiAliased() ? table_.path_aa : table_.path, path);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawArc(
+    const DlRect& oval_bounds,
+    DlScalar start_degrees,
+    DlScalar sweep_degrees,
+    bool use_center) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(table_.arc, oval_bounds);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawPoints(
+    DlPointMode mode,
+    uint32_t count,
+    const DlPoint points[]) {
+  if (IsComplex()) {
+    return;
+  }
+  const DlComplexityStyledCosts& costs =
+      table_.points[static_cast<int>(mode)];
+  AccumulateCost(StyledCost(costs, true).Evaluate(count));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawVertices(
+    const std::shared_ptr<DlVertices>& vertices,
+    DlBlendMode mode) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateCost(table_.vertices.Evaluate(vertices->vertex_count()));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawImage(
+    const sk_sp<DlImage> image,
+    const DlPoint& point,
+    DlImageSampling sampling,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateImage(table_.image, image->GetSize(), image->isTextureBacked());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::ImageRect(
+    const DlISize& size,
+    bool texture_backed,
+    bool render_with_attributes,
+    bool enforce_src_edges) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateImage(table_.image_rect, size, texture_backed);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    drawImageNine(const sk_sp<DlImage> image,
+                  const DlIRect& center,
+                  const DlRect& dst,
+                  DlFilterMode filter,
+                  bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateImage(table_.image_nine, image->GetSize(),
+                  image->isTextureBacked());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::
+    drawDisplayList(const sk_sp<DisplayList> display_list, DlScalar opacity) {
+  if (IsComplex()) {
+    return;
+  }
+  TableHelper helper(table_, Ceiling() - CurrentComplexityScore());
+  if (opacity < SK_Scalar1 && !display_list->can_apply_group_opacity()) {
+    auto bounds = display_list->GetBounds();
+    helper.saveLayer(bounds, SaveLayerOptions::kWithAttributes, nullptr,
+                     /*backdrop_id=*/-1);
+  }
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawText(
+    const std::shared_ptr<DlText>& text,
+    DlScalar x,
+    DlScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  // The cost is calculated at the end as the calls are batched.
+  draw_text_count_++;
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawShadow(
+    const DlPath& path,
+    const DlColor color,
+    const DlScalar elevation,
+    bool transparent_occluder,
+    DlScalar dpr) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulatePath(
+      transparent_occluder ? table_.shadow_transparent : table_.shadow, path);
+}
+
+}  // namespace flutter
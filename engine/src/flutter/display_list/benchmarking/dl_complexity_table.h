@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_TABLE_H_
+#define FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_TABLE_H_
+
+#include "flutter/display_list/benchmarking/dl_complexity_cost_table.h"
+#include "flutter/display_list/benchmarking/dl_complexity_helper.h"
+
+namespace flutter {
+
+/// A complexity calculator whose per-op costs come from a generated
+/// |DlComplexityCostTable| rather than from hand written formulas, so that
+/// the costs of a backend can be fitted by rerunning the benchmarks without
+/// changing any code.
+///
+/// No tables are checked in until they have been fitted to measurements of
+/// the devices that they are meant for, so the raster cache does not use
+/// this calculator yet.
+class DisplayListTableComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  /// Creates a calculator that uses the indicated table, which must
+  /// outlive the calculator.
+  explicit DisplayListTableComplexityCalculator(
+      const DlComplexityCostTable& table)
+      : table_(table), ceiling_(std::numeric_limits<unsigned int>::max()) {}
+
+  const DlComplexityCostTable& table() const { return table_; }
+
+  unsigned int Compute(const DisplayList* display_list) override {
+    TableHelper helper(table_, ceiling_);
+    display_list->Dispatch(helper);
+    return helper.ComplexityScore();
+  }
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    return complexity_score > table_.cache_threshold;
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+ private:
+  class TableHelper : public ComplexityCalculatorHelper {
+   public:
+    TableHelper(const DlComplexityCostTable& table, unsigned int ceiling)
+        : ComplexityCalculatorHelper(ceiling), table_(table) {}
+
+    void saveLayer(const DlRect& bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop,
+                   std::optional<int64_t> backdrop_id) override;
+
+    void drawColor(DlColor color, DlBlendMode mode) override;
+    void drawPaint() override;
+    void drawLine(const DlPoint& p0, const DlPoint& p1) override;
+    void drawDashedLine(const DlPoint& p0,
+                        const DlPoint& p1,
+                        DlScalar on_length,
+                        DlScalar off_length) override;
+    void drawRect(const DlRect& rect) override;
+    void drawOval(const DlRect& bounds) override;
+    void drawCircle(const DlPoint& center, DlScalar radius) override;
+    void drawRoundRect(const DlRoundRect& rrect) override;
+    void drawDiffRoundRect(const DlRoundRect& outer,
+                           const DlRoundRect& inner) override;
+    void drawRoundSuperellipse(const DlRoundSuperellipse& rse) override;
+    void drawPath(const DlPath& path) override;
+    void drawArc(const DlRect& oval_bounds,
+                 DlScalar start_degrees,
+                 DlScalar sweep_degrees,
+                 bool use_center) override;
+    void drawPoints(DlPointMode mode,
+                    uint32_t count,
+                    const DlPoint points[]) override;
+    void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                      DlBlendMode mode) override;
+    void drawImage(const sk_sp<DlImage> image,
+                   const DlPoint& point,
+                   DlImageSampling sampling,
+                   bool render_with_attributes) override;
+    void drawImageNine(const sk_sp<DlImage> image,
+                       const DlIRect& center,
+                       const DlRect& dst,
+                       DlFilterMode filter,
+                       bool render_with_attributes) override;
+    void drawDisplayList(const sk_sp<DisplayList> display_list,
+                         DlScalar opacity) override;
+    void drawText(const std::shared_ptr<DlText>& text,
+                  DlScalar x,
+                  DlScalar y) override;
+    void drawShadow(const DlPath& path,
+                    const DlColor color,
+                    const DlScalar elevation,
+                    bool transparent_occluder,
+                    DlScalar dpr) override;
+
+   protected:
+    void ImageRect(const DlISize& size,
+                   bool texture_backed,
+                   bool render_with_attributes,
+                   bool enforce_src_edges) override;
+
+    unsigned int BatchedComplexity() override;
+
+   private:
+    // Returns the cost from |costs| that matches the current attributes.
+    // Ops that are always stroked, such as lines and points, use the stroke
+    // costs even if the style is fill.
+    const DlComplexityCost& StyledCost(const DlComplexityStyledCosts& costs,
+                                       bool always_stroked = false);
+
+    // Accumulates the cost of a shape op with the indicated bounds.
+    void AccumulateShape(const DlComplexityStyledCosts& costs,
+                         const DlRect& bounds);
+
+    // Accumulates the cost of an image op for an image of the indicated
+    // size.
+    void AccumulateImage(const DlComplexityImageCosts& costs,
+                         const DlISize& size,
+                         bool texture_backed);
+
+    void AccumulatePath(const DlComplexityPathCosts& costs,
+                        const DlPath& path);
+
+    void AccumulateCost(float cost);
+
+    const DlComplexityCostTable& table_;
+    unsigned int save_layer_count_ = 0;
+    unsigned int draw_text_count_ = 0;
+  };
+
+  const DlComplexityCostTable& table_;
+  unsigned int ceiling_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_TABLE_H_
@@ -5,6 +5,7 @@
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
+#include "flutter/display_list/benchmarking/dl_complexity_table.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_sampling_options.h"
@@ -29,6 +30,11 @@ std::vector<DisplayListComplexityCalculator*> AccumulatorCalculators() {
           DisplayListGLComplexityCalculator::GetInstance()};
 }
 
+// A table with no costs, which the table tests fill in as needed.
+DlComplexityCostTable MakeTestCostTable() {
+  return {.name = "Test", .cache_threshold = 200000u};
+}
+
 std::vector<DlPoint> GetTestPoints() {
   std::vector<DlPoint> points;
   points.emplace_back(0, 0);
@@ -418,5 +424,71 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexity, TableUsesTableCosts) {
+  DlComplexityCostTable table = MakeTestCostTable();
+  table.rect.fill = {.fixed = 10.0f, .per_unit = 1.0f, .per_area = 0.5f};
+  table.rect.stroke = {.fixed = 20.0f, .per_unit = 2.0f, .per_area = 0.0f};
+  DisplayListTableComplexityCalculator calculator(table);
+
+  DisplayListBuilder builder_filled;
+  builder_filled.DrawRect(DlRect::MakeXYWH(10, 10, 20, 40), DlPaint());
+  auto display_list_filled = builder_filled.Build();
+  // 10 + 1 * (20 + 40) / 2 + 0.5 * 20 * 40
+  EXPECT_EQ(calculator.Compute(display_list_filled.get()), 440u);
+
+  DisplayListBuilder builder_stroked;
+  builder_stroked.DrawRect(DlRect::MakeXYWH(10, 10, 20, 40),
+                           DlPaint()
+                               .setDrawStyle(DlDrawStyle::kStroke)
+                               .setStrokeWidth(2.0f));
+  auto display_list_stroked = builder_stroked.Build();
+  // 20 + 2 * (20 + 40) / 2
+  EXPECT_EQ(calculator.Compute(display_list_stroked.get()), 80u);
+}
+
+TEST(DisplayListComplexity, TableChargesBatchedFixedCostOnce) {
+  DlComplexityCostTable table = MakeTestCostTable();
+  table.save_layer = {.fixed = 1000.0f, .per_unit = 100.0f, .per_area = 0.0f};
+  DisplayListTableComplexityCalculator calculator(table);
+
+  DisplayListBuilder builder;
+  builder.SaveLayer(std::nullopt, nullptr);
+  builder.Restore();
+  builder.SaveLayer(std::nullopt, nullptr);
+  builder.Restore();
+  builder.SaveLayer(std::nullopt, nullptr);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(calculator.Compute(display_list.get()), 1300u);
+}
+
+TEST(DisplayListComplexity, TableClampsNegativeAndHugeCosts) {
+  DlComplexityCostTable table = MakeTestCostTable();
+  table.oval.fill = {.fixed = -50.0f, .per_unit = 0.0f, .per_area = 0.0f};
+  table.circle.fill = {.fixed = 0.0f, .per_unit = 0.0f, .per_area = 1e9f};
+  DisplayListTableComplexityCalculator calculator(table);
+
+  DisplayListBuilder builder_oval;
+  builder_oval.DrawOval(DlRect::MakeXYWH(10, 10, 20, 40), DlPaint());
+  auto display_list_oval = builder_oval.Build();
+  EXPECT_EQ(calculator.Compute(display_list_oval.get()), 0u);
+
+  DisplayListBuilder builder_circle;
+  builder_circle.DrawCircle(DlPoint(50, 50), 50, DlPaint());
+  auto display_list_circle = builder_circle.Build();
+  EXPECT_EQ(calculator.Compute(display_list_circle.get()),
+            std::numeric_limits<unsigned int>::max());
+}
+
+TEST(DisplayListComplexity, TableCacheThreshold) {
+  DlComplexityCostTable table = MakeTestCostTable();
+  table.cache_threshold = 1000u;
+  DisplayListTableComplexityCalculator calculator(table);
+
+  EXPECT_FALSE(calculator.ShouldBeCached(1000u));
+  EXPECT_TRUE(calculator.ShouldBeCached(1001u));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -76,6 +76,20 @@ class SkRegionAdapter {
     return result;
   }
 
+  static SkRegionAdapter subtractRegions(const SkRegionAdapter& a1,
+                                         const SkRegionAdapter& a2) {
+    SkRegionAdapter result(a1);
+    result.region_.op(a2.region_, SkRegion::kDifference_Op);
+    return result;
+  }
+
+  static SkRegionAdapter subtractRects(const SkRegionAdapter& a1,
+                                       const std::vector<DlIRect>& rects) {
+    SkRegionAdapter result(a1);
+    result.region_.op(SkRegionAdapter(rects).region_, SkRegion::kDifference_Op);
+    return result;
+  }
+
   bool intersects(const SkRegionAdapter& region) {
     return region_.intersects(region.region_);
   }
@@ -115,6 +129,18 @@ class DlRegionAdapter {
         flutter::DlRegion::MakeIntersection(a1.region_, a2.region_));
   }
 
+  static DlRegionAdapter subtractRegions(const DlRegionAdapter& a1,
+                                         const DlRegionAdapter& a2) {
+    return DlRegionAdapter(
+        flutter::DlRegion::MakeDifference(a1.region_, a2.region_));
+  }
+
+  static DlRegionAdapter subtractRects(const DlRegionAdapter& a1,
+                                       const std::vector<DlIRect>& rects) {
+    return DlRegionAdapter(
+        flutter::DlRegion::MakeDifference(a1.region_, rects));
+  }
+
   DlIRect getBounds() { return region_.bounds(); }
 
   bool intersects(const DlRegionAdapter& region) {
@@ -133,7 +159,9 @@ class DlRegionAdapter {
 };
 
 template <typename Region>
-void RunFromRectsBenchmark(benchmark::State& state, int maxSize) {
+void RunFromRectsBenchmark(benchmark::State& state,
+                           int maxSize,
+                           int rectCount = 2000) {
   std::random_device d;
   std::seed_seq seed{2, 1, 3};
   std::mt19937 rng(seed);
@@ -142,7 +170,7 @@ void RunFromRectsBenchmark(benchmark::State& state, int maxSize) {
   std::uniform_int_distribution size(1, maxSize);
 
   std::vector<DlIRect> rects;
-  for (int i = 0; i < 2000; ++i) {
+  for (int i = 0; i < rectCount; ++i) {
     DlIRect rect = DlIRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng));
     rects.push_back(rect);
   }
@@ -153,7 +181,9 @@ void RunFromRectsBenchmark(benchmark::State& state, int maxSize) {
 }
 
 template <typename Region>
-void RunGetRectsBenchmark(benchmark::State& state, int maxSize) {
+void RunGetRectsBenchmark(benchmark::State& state,
+                          int maxSize,
+                          int rectCount = 2000) {
   std::random_device d;
   std::seed_seq seed{2, 1, 3};
   std::mt19937 rng(seed);
@@ -162,7 +192,7 @@ void RunGetRectsBenchmark(benchmark::State& state, int maxSize) {
   std::uniform_int_distribution size(1, maxSize);
 
   std::vector<DlIRect> rects;
-  for (int i = 0; i < 2000; ++i) {
+  for (int i = 0; i < rectCount; ++i) {
     DlIRect rect = DlIRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng));
     rects.push_back(rect);
   }
@@ -174,7 +204,7 @@ void RunGetRectsBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
-enum RegionOp { kUnion, kIntersection };
+enum RegionOp { kUnion, kIntersection, kDifference };
 
 template <typename Region>
 void RunRegionOpBenchmark(benchmark::State& state,
@@ -207,6 +237,30 @@ void RunRegionOpBenchmark(benchmark::State& state,
         Region::intersectRegions(region1, region2);
       }
       break;
+    case kDifference:
+      while (state.KeepRunning()) {
+        Region::subtractRegions(region1, region2);
+      }
+      break;
+  }
+}
+
+// Subtracts the damage of a heavy partial repaint, given as a list of
+// |rectCount| rectangles, from a region.
+template <typename Region>
+void RunSubtractRectsBenchmark(benchmark::State& state,
+                               int maxSize,
+                               int rectCount) {
+  std::random_device d;
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  DlIRect bounds = DlIRect::MakeWH(4000, 4000);
+  Region region(GenerateRects(rng, bounds, 500, 1500));
+  auto rects = GenerateRects(rng, bounds, rectCount, maxSize);
+
+  while (state.KeepRunning()) {
+    Region::subtractRects(region, rects);
   }
 }
 
@@ -265,20 +319,40 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
 
 namespace flutter {
 
-static void BM_DlRegion_FromRects(benchmark::State& state, int maxSize) {
-  RunFromRectsBenchmark<DlRegionAdapter>(state, maxSize);
+static void BM_DlRegion_FromRects(benchmark::State& state,
+                                  int maxSize,
+                                  int rectCount = 2000) {
+  RunFromRectsBenchmark<DlRegionAdapter>(state, maxSize, rectCount);
+}
+
+static void BM_SkRegion_FromRects(benchmark::State& state,
+                                  int maxSize,
+                                  int rectCount = 2000) {
+  RunFromRectsBenchmark<SkRegionAdapter>(state, maxSize, rectCount);
 }
 
-static void BM_SkRegion_FromRects(benchmark::State& state, int maxSize) {
-  RunFromRectsBenchmark<SkRegionAdapter>(state, maxSize);
+static void BM_DlRegion_GetRects(benchmark::State& state,
+                                 int maxSize,
+                                 int rectCount = 2000) {
+  RunGetRectsBenchmark<DlRegionAdapter>(state, maxSize, rectCount);
 }
 
-static void BM_DlRegion_GetRects(benchmark::State& state, int maxSize) {
-  RunGetRectsBenchmark<DlRegionAdapter>(state, maxSize);
+static void BM_SkRegion_GetRects(benchmark::State& state,
+                                 int maxSize,
+                                 int rectCount = 2000) {
+  RunGetRectsBenchmark<SkRegionAdapter>(state, maxSize, rectCount);
 }
 
-static void BM_SkRegion_GetRects(benchmark::State& state, int maxSize) {
-  RunGetRectsBenchmark<SkRegionAdapter>(state, maxSize);
+static void BM_DlRegion_SubtractRects(benchmark::State& state,
+                                      int maxSize,
+                                      int rectCount) {
+  RunSubtractRectsBenchmark<DlRegionAdapter>(state, maxSize, rectCount);
+}
+
+static void BM_SkRegion_SubtractRects(benchmark::State& state,
+                                      int maxSize,
+                                      int rectCount) {
+  RunSubtractRectsBenchmark<SkRegionAdapter>(state, maxSize, rectCount);
 }
 
 static void BM_DlRegion_Operation(benchmark::State& state,
@@ -717,4 +791,64 @@ BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large, 1500)
 BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large, 1500)
     ->Unit(benchmark::kMicrosecond);
 
-}  // namespace flutter
\ No newline at end of file
+BENCHMARK_CAPTURE(BM_DlRegion_Operation,
+                  Difference_Small,
+                  RegionOp::kDifference,
+                  false,
+                  100,
+                  1.0)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_Operation,
+                  Difference_Small,
+                  RegionOp::kDifference,
+                  false,
+                  100,
+                  1.0)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_Operation,
+                  Difference_Large,
+                  RegionOp::kDifference,
+                  false,
+                  1500,
+                  1.0)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_Operation,
+                  Difference_Large,
+                  RegionOp::kDifference,
+                  false,
+                  1500,
+                  1.0)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_FromRects, Small_10000, 100, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_FromRects, Small_10000, 100, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_FromRects, Large_10000, 1500, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_FromRects, Large_10000, 1500, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_FromRects, Small_50000, 100, 50000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_FromRects, Small_50000, 100, 50000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_FromRects, Large_50000, 1500, 50000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_FromRects, Large_50000, 1500, 50000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large_10000, 1500, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large_10000, 1500, 10000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_SubtractRects, Small_10000, 100, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_SubtractRects, Small_10000, 100, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_SubtractRects, Large_10000, 1500, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_SubtractRects, Large_10000, 1500, 10000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/geometry/dl_packed_rtree.h"
+#include "flutter/display_list/geometry/dl_rtree.h"
+
+#include <algorithm>
+#include <random>
+
+namespace flutter {
+
+namespace {
+
+constexpr float kViewportWidth = 1080.0f;
+constexpr float kViewportHeight = 1920.0f;
+constexpr float kItemHeight = 48.0f;
+
+// Produces the bounds of the items of a long scrolling list where each
+// item draws a background, an icon and a line of text.
+// If |shuffled| is true the rects are recorded in a random order, as
+// when the items are drawn by independently updated layers.
+std::vector<DlRect> GenerateScrollingListRects(int count,
+                                               bool shuffled = false) {
+  std::mt19937 random(count);
+  std::uniform_real_distribution<float> text_width(100.0f, 900.0f);
+  std::vector<DlRect> rects;
+  rects.reserve(count);
+  for (int i = 0; static_cast<int>(rects.size()) < count; i++) {
+    float top = i * kItemHeight;
+    rects.push_back(DlRect::MakeXYWH(0, top, kViewportWidth, kItemHeight));
+    rects.push_back(DlRect::MakeXYWH(16, top + 8, 32, 32));
+    rects.push_back(DlRect::MakeXYWH(64, top + 12, text_width(random), 24));
+  }
+  rects.resize(count);
+  if (shuffled) {
+    std::shuffle(rects.begin(), rects.end(), random);
+  }
+  return rects;
+}
+
+// Returns viewport queries at random scroll offsets within the list.
+std::vector<DlRect> GenerateViewportQueries(int count) {
+  std::mt19937 random(42);
+  float list_height = (count / 3) * kItemHeight;
+  std::uniform_real_distribution<float> offset(
+      0.0f, std::max(list_height - kViewportHeight, 1.0f));
+  std::vector<DlRect> queries;
+  for (int i = 0; i < 64; i++) {
+    queries.push_back(
+        DlRect::MakeXYWH(0, offset(random), kViewportWidth, kViewportHeight));
+  }
+  return queries;
+}
+
+}  // namespace
+
+static void BM_RTreeSearch(benchmark::State& state, bool shuffled) {
+  auto rects = GenerateScrollingListRects(state.range(0), shuffled);
+  auto queries = GenerateViewportQueries(state.range(0));
+  DlRTree rtree(rects.data(), rects.size());
+  std::vector<int> results;
+  size_t query_index = 0;
+  for (auto _ : state) {
+    results.clear();
+    rtree.search(queries[query_index++ % queries.size()], &results);
+    benchmark::DoNotOptimize(results.data());
+  }
+}
+
+static void BM_PackedRTreeSearch(benchmark::State& state, bool shuffled) {
+  auto rects = GenerateScrollingListRects(state.range(0), shuffled);
+  auto queries = GenerateViewportQueries(state.range(0));
+  DlRTree rtree(rects.data(), rects.size());
+  DlPackedRTree packed(rtree);
+  std::vector<int> results;
+  size_t query_index = 0;
+  for (auto _ : state) {
+    results.clear();
+    packed.search(queries[query_index++ % queries.size()], &results);
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.counters["PackedBytes"] = packed.bytes_used();
+}
+
+static void BM_PackedRTreeForEachHit(benchmark::State& state,
+                                     bool shuffled) {
+  auto rects = GenerateScrollingListRects(state.range(0), shuffled);
+  auto queries = GenerateViewportQueries(state.range(0));
+  DlRTree rtree(rects.data(), rects.size());
+  DlPackedRTree packed(rtree);
+  size_t query_index = 0;
+  for (auto _ : state) {
+    int hits = 0;
+    packed.ForEachHit(queries[query_index++ % queries.size()],
+                      [&hits](int leaf) {
+                        hits++;
+                        return true;
+                      });
+    benchmark::DoNotOptimize(hits);
+  }
+}
+
+static void BM_PackedRTreeBuild(benchmark::State& state) {
+  auto rects = GenerateScrollingListRects(state.range(0));
+  DlRTree rtree(rects.data(), rects.size());
+  for (auto _ : state) {
+    DlPackedRTree packed(rtree);
+    benchmark::DoNotOptimize(packed.leaf_count());
+  }
+}
+
+BENCHMARK_CAPTURE(BM_RTreeSearch, Sorted, false)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK_CAPTURE(BM_RTreeSearch, Shuffled, true)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK_CAPTURE(BM_PackedRTreeSearch, Sorted, false)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK_CAPTURE(BM_PackedRTreeSearch, Shuffled, true)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK_CAPTURE(BM_PackedRTreeForEachHit, Sorted, false)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK_CAPTURE(BM_PackedRTreeForEachHit, Shuffled, true)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK(BM_PackedRTreeBuild)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+namespace {
+
+enum class DisplayListSerializationBenchmarkType {
+  // Only plain data records that can be dispatched from the mapping.
+  kPlainData,
+  // Plain data records mixed with paths and color sources that must be
+  // reconstructed when the DisplayList is loaded.
+  kMixed,
+};
+
+class DlOpReceiverIgnore : public IgnoreAttributeDispatchHelper,
+                           public IgnoreTransformDispatchHelper,
+                           public IgnoreClipDispatchHelper,
+                           public IgnoreDrawDispatchHelper {};
+
+static void BuildContent(DisplayListBuilder& builder,
+                         DisplayListSerializationBenchmarkType type,
+                         int count) {
+  DlPaint paint;
+  for (int i = 0; i < count; i++) {
+    DlScalar x = (i % 32) * 20.0f;
+    DlScalar y = (i / 32) * 20.0f;
+    paint.setColor(DlColor(0xFF000000 | (i * 0x10101)));
+    builder.Save();
+    builder.Translate(x, y);
+    builder.ClipRect(DlRect::MakeWH(18, 18));
+    builder.DrawRect(DlRect::MakeLTRB(1, 1, 17, 17), paint);
+    builder.DrawCircle(DlPoint(9, 9), 5, paint);
+    if (type == DisplayListSerializationBenchmarkType::kMixed &&
+        (i % 4) == 0) {
+      DlPaint mixed_paint = paint;
+      mixed_paint.setColorSource(testing::kTestSource2);
+      builder.DrawPath(testing::kTestPath1, mixed_paint);
+    }
+    builder.Restore();
+  }
+}
+
+static sk_sp<DisplayList> BuildDisplayList(
+    DisplayListSerializationBenchmarkType type,
+    int count) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  BuildContent(builder, type, count);
+  return builder.Build();
+}
+
+}  // namespace
+
+// Measures the cost of recording the content with a DisplayListBuilder,
+// which is the cost that a cached serialized DisplayList avoids.
+static void BM_DisplayListBuildFromScratch(
+    benchmark::State& state,
+    DisplayListSerializationBenchmarkType type) {
+  int count = state.range(0);
+  size_t bytes = 0u;
+  while (state.KeepRunning()) {
+    sk_sp<DisplayList> display_list = BuildDisplayList(type, count);
+    bytes = display_list->bytes();
+    benchmark::DoNotOptimize(display_list->rtree());
+  }
+  state.counters["HeapBytes"] = bytes;
+  state.counters["MappedBytes"] = 0;
+}
+
+// Measures the cost of loading the same content from a file that was
+// written by |DisplayListSerialization::Serialize| and mapped into memory.
+static void BM_DisplayListLoadFromMapping(
+    benchmark::State& state,
+    DisplayListSerializationBenchmarkType type) {
+  int count = state.range(0);
+  sk_sp<DisplayList> source = BuildDisplayList(type, count);
+  std::unique_ptr<fml::Mapping> serialized =
+      DisplayListSerialization::Serialize(*source);
+  if (!serialized) {
+    state.SkipWithError("DisplayList could not be serialized");
+    return;
+  }
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  if (!fml::WriteAtomically(temp_dir.fd(), "display_list.bin", *serialized)) {
+    state.SkipWithError("Unable to write the serialized DisplayList");
+    return;
+  }
+  std::shared_ptr<const fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(temp_dir.fd(), "display_list.bin");
+  if (!mapping) {
+    state.SkipWithError("Unable to map the serialized DisplayList");
+    return;
+  }
+
+  bool mapped = false;
+  while (state.KeepRunning()) {
+    sk_sp<DisplayList> display_list =
+        DisplayListSerialization::Deserialize(mapping);
+    mapped = DisplayListSerialization::IsMapped(*display_list);
+    benchmark::DoNotOptimize(display_list->rtree());
+  }
+  size_t mapping_size = mapping->GetSize();
+  state.counters["HeapBytes"] = mapped ? 0 : source->bytes();
+  state.counters["MappedBytes"] = mapped ? mapping_size : 0;
+}
+
+// Measures dispatching a loaded DisplayList, which for plain data content
+// reads the records directly from the pages of the mapped file.
+static void BM_DisplayListDispatchFromMapping(
+    benchmark::State& state,
+    DisplayListSerializationBenchmarkType type) {
+  int count = state.range(0);
+  sk_sp<DisplayList> source = BuildDisplayList(type, count);
+  std::shared_ptr<const fml::Mapping> mapping =
+      DisplayListSerialization::Serialize(*source);
+  if (!mapping) {
+    state.SkipWithError("DisplayList could not be serialized");
+    return;
+  }
+  sk_sp<DisplayList> display_list =
+      DisplayListSerialization::Deserialize(mapping);
+  DlOpReceiverIgnore receiver;
+  while (state.KeepRunning()) {
+    display_list->Dispatch(receiver);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_DisplayListBuildFromScratch,
+                  kPlainData,
+                  DisplayListSerializationBenchmarkType::kPlainData)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuildFromScratch,
+                  kMixed,
+                  DisplayListSerializationBenchmarkType::kMixed)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListLoadFromMapping,
+                  kPlainData,
+                  DisplayListSerializationBenchmarkType::kPlainData)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListLoadFromMapping,
+                  kMixed,
+                  DisplayListSerializationBenchmarkType::kMixed)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListDispatchFromMapping,
+                  kPlainData,
+                  DisplayListSerializationBenchmarkType::kPlainData)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListDispatchFromMapping,
+                  kMixed,
+                  DisplayListSerializationBenchmarkType::kMixed)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <thread>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_tiled_dispatcher.h"
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int32_t kPictureSize = 2048;
+constexpr int32_t kTileSize = 256;
+
+static sk_sp<DisplayList> MakeLargePicture() {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint fill_paint;
+  DlPaint stroke_paint;
+  stroke_paint.setDrawStyle(DlDrawStyle::kStroke);
+  stroke_paint.setStrokeWidth(3.0f);
+  DlPaint gradient_paint;
+  gradient_paint.setColorSource(testing::kTestSource2);
+  for (int y = 0; y < kPictureSize; y += 32) {
+    for (int x = 0; x < kPictureSize; x += 32) {
+      fill_paint.setColor(DlColor(0xFF000000 | ((x * 97 + y * 31) & 0xFFFFFF)));
+      builder.DrawRect(DlRect::MakeXYWH(x + 2, y + 2, 28, 28), fill_paint);
+      builder.DrawCircle(DlPoint(x + 16, y + 16), 10, stroke_paint);
+      builder.Save();
+      builder.Translate(x + 11, y + 11);
+      builder.DrawPath(testing::kTestPath1, gradient_paint);
+      builder.Restore();
+    }
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+// Renders a large DisplayList into 256x256 software tiles, dispatching
+// the tiles on the number of threads given by the benchmark argument.
+static void BM_DisplayListTiledDispatchSoftware(benchmark::State& state) {
+  size_t thread_count = state.range(0);
+  sk_sp<DisplayList> display_list = MakeLargePicture();
+
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop;
+  if (thread_count > 1u) {
+    loop = fml::ConcurrentMessageLoop::Create(thread_count - 1u);
+  }
+  DlTiledDispatcher dispatcher(loop ? loop->GetTaskRunner() : nullptr,
+                               thread_count);
+
+  std::vector<DlIRect> tile_bounds = DlTiledDispatcher::ComputeTileBounds(
+      DlIRect::MakeWH(kPictureSize, kPictureSize),
+      DlISize(kTileSize, kTileSize));
+  std::vector<sk_sp<SkSurface>> surfaces;
+  for (size_t i = 0; i < tile_bounds.size(); i++) {
+    surfaces.push_back(
+        SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kTileSize, kTileSize)));
+  }
+
+  while (state.KeepRunning()) {
+    std::vector<std::unique_ptr<DlSkCanvasDispatcher>> receivers;
+    std::vector<DlTiledDispatcher::Tile> tiles;
+    receivers.reserve(tile_bounds.size());
+    tiles.reserve(tile_bounds.size());
+    for (size_t i = 0; i < tile_bounds.size(); i++) {
+      const DlIRect& bounds = tile_bounds[i];
+      SkCanvas* canvas = surfaces[i]->getCanvas();
+      canvas->restoreToCount(1);
+      canvas->save();
+      canvas->translate(-bounds.GetLeft(), -bounds.GetTop());
+      receivers.push_back(std::make_unique<DlSkCanvasDispatcher>(canvas));
+      tiles.push_back({bounds, receivers.back().get()});
+    }
+    dispatcher.Dispatch(*display_list, tiles);
+  }
+
+  state.counters["Tiles"] = tile_bounds.size();
+  if (loop) {
+    loop->Terminate();
+  }
+}
+
+static void ThreadCounts(benchmark::internal::Benchmark* b) {
+  int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (int threads = 1; threads < max_threads; threads *= 2) {
+    b->Arg(threads);
+  }
+  b->Arg(max_threads);
+}
+
+BENCHMARK(BM_DisplayListTiledDispatchSoftware)
+    ->Apply(ThreadCounts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
@@ -6,6 +6,8 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "flutter/display_list/geometry/dl_bulk_bounds.h"
+#include "flutter/display_list/utils/dl_accumulation_rect.h"
 #include "flutter/impeller/geometry/matrix.h"
 #include "flutter/impeller/geometry/rect.h"
 #include "third_party/skia/include/core/SkM44.h"
@@ -847,4 +849,100 @@ BENCHMARK_CAPTURE_ALL_SETUP(BM_TransformAndClipRect, PerspectiveClipTwo);
 BENCHMARK_CAPTURE_ALL_SETUP(BM_TransformAndClipRect, PerspectiveClipThree);
 BENCHMARK_CAPTURE_ALL_SETUP(BM_TransformAndClipRect, PerspectiveClipFour);
 
+static std::vector<DlPoint> MakeBoundsBenchmarkPoints(size_t count) {
+  std::vector<DlPoint> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    points.emplace_back((i * 37) % 1001 * 0.75f, (i * 53) % 997 * 0.5f);
+  }
+  return points;
+}
+
+static void BM_PointBoundsAccumulationRect(benchmark::State& state) {
+  std::vector<DlPoint> points = MakeBoundsBenchmarkPoints(state.range(0));
+  while (state.KeepRunning()) {
+    AccumulationRect accumulator;
+    for (const DlPoint& point : points) {
+      accumulator.accumulate(point);
+    }
+    benchmark::DoNotOptimize(accumulator.GetBounds());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_PointBoundsBulk(benchmark::State& state) {
+  std::vector<DlPoint> points = MakeBoundsBenchmarkPoints(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        DlBulkBounds::PointBounds(points.data(), points.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_AtlasBoundsQuads(benchmark::State& state) {
+  std::vector<DlPoint> origins = MakeBoundsBenchmarkPoints(state.range(0));
+  std::vector<DlRSTransform> xforms;
+  std::vector<DlRect> tex;
+  for (size_t i = 0; i < origins.size(); i++) {
+    xforms.push_back(DlRSTransform::Make(origins[i], 1.5f,
+                                         DlDegrees(static_cast<float>(i))));
+    tex.push_back(DlRect::MakeXYWH(0, 0, 16.0f + i % 7, 16.0f + i % 5));
+  }
+  while (state.KeepRunning()) {
+    AccumulationRect accumulator;
+    DlQuad quad;
+    for (size_t i = 0; i < xforms.size(); i++) {
+      xforms[i].GetQuad(tex[i].GetWidth(), tex[i].GetHeight(), quad);
+      for (const DlPoint& corner : quad) {
+        accumulator.accumulate(corner);
+      }
+    }
+    benchmark::DoNotOptimize(accumulator.GetBounds());
+  }
+  state.SetItemsProcessed(state.iterations() * xforms.size());
+}
+
+static void BM_AtlasBoundsBulk(benchmark::State& state) {
+  std::vector<DlPoint> origins = MakeBoundsBenchmarkPoints(state.range(0));
+  std::vector<DlRSTransform> xforms;
+  std::vector<DlRect> tex;
+  for (size_t i = 0; i < origins.size(); i++) {
+    xforms.push_back(DlRSTransform::Make(origins[i], 1.5f,
+                                         DlDegrees(static_cast<float>(i))));
+    tex.push_back(DlRect::MakeXYWH(0, 0, 16.0f + i % 7, 16.0f + i % 5));
+  }
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        DlBulkBounds::AtlasBounds(xforms.data(), tex.data(), xforms.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * xforms.size());
+}
+
+static void BM_TransformRectBounds(benchmark::State& state) {
+  DlMatrix matrix = DlMatrix::MakeTranslation({10.3f, 6.9f}) *
+                    DlMatrix::MakeRotationZ(DlDegrees(30)) *
+                    DlMatrix::MakeScale({3.5f, 3.5f, 1.0f});
+  DlRect rect = DlRect::MakeLTRB(100, 100, 200, 200);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(rect.TransformBounds(matrix));
+  }
+}
+
+static void BM_TransformRectBoundsBulk(benchmark::State& state) {
+  DlMatrix matrix = DlMatrix::MakeTranslation({10.3f, 6.9f}) *
+                    DlMatrix::MakeRotationZ(DlDegrees(30)) *
+                    DlMatrix::MakeScale({3.5f, 3.5f, 1.0f});
+  DlRect rect = DlRect::MakeLTRB(100, 100, 200, 200);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(DlBulkBounds::TransformedRectBounds(matrix, rect));
+  }
+}
+
+BENCHMARK(BM_PointBoundsAccumulationRect)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_PointBoundsBulk)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_AtlasBoundsQuads)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_AtlasBoundsBulk)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_TransformRectBounds);
+BENCHMARK(BM_TransformRectBoundsBulk);
+
 }  // namespace flutter
@@ -7,6 +7,7 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_records.h"
 #include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/display_list/utils/dl_op_profiler.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -60,7 +61,7 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       root_is_unbounded_(root_is_unbounded),
       max_root_blend_mode_(max_root_blend_mode),
       rtree_(std::move(rtree)) {
-  FML_DCHECK(storage_.capacity() == storage_.size());
+  FML_DCHECK(storage_.is_pooled() || storage_.capacity() == storage_.size());
 }
 
 DisplayList::~DisplayList() {
@@ -181,6 +182,13 @@ void DisplayList::RTreeResultsToIndexVector(
 
 void DisplayList::Dispatch(DlOpReceiver& receiver) const {
   const uint8_t* base = storage_.base();
+  if (DlOpProfiler::IsEnabled() && receiver.IsRenderingReceiver()) {
+    DlOpProfileScope profile_scope(unique_id_);
+    for (size_t offset : offsets_) {
+      DispatchOneOpProfiled(profile_scope, receiver, base + offset);
+    }
+    return;
+  }
   for (size_t offset : offsets_) {
     DispatchOneOp(receiver, base + offset);
   }
@@ -201,12 +209,27 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   } else {
     auto op_indices = GetCulledIndices(cull_rect);
     const uint8_t* base = storage_.base();
+    if (DlOpProfiler::IsEnabled() && receiver.IsRenderingReceiver()) {
+      DlOpProfileScope profile_scope(unique_id_);
+      for (DlIndex index : op_indices) {
+        DispatchOneOpProfiled(profile_scope, receiver, base + offsets_[index]);
+      }
+      return;
+    }
     for (DlIndex index : op_indices) {
       DispatchOneOp(receiver, base + offsets_[index]);
     }
   }
 }
 
+void DisplayList::DispatchOneOpProfiled(DlOpProfileScope& profile_scope,
+                                        DlOpReceiver& receiver,
+                                        const uint8_t* ptr) const {
+  profile_scope.BeginOp(reinterpret_cast<const DLOp*>(ptr)->type);
+  DispatchOneOp(receiver, ptr);
+  profile_scope.EndOp();
+}
+
 void DisplayList::DispatchOneOp(DlOpReceiver& receiver,
                                 const uint8_t* ptr) const {
   auto op = reinterpret_cast<const DLOp*>(ptr);
@@ -367,13 +390,28 @@ static void FillAllIndices(std::vector<DlIndex>& indices, DlIndex size) {
   }
 }
 
+const DlPackedRTree* DisplayList::GetPackedRTree() const {
+  if (!rtree_ || rtree_->leaf_count() < kMinPackedRTreeLeafCount) {
+    return nullptr;
+  }
+  std::call_once(packed_rtree_once_, [this]() {
+    TRACE_EVENT0("flutter", "DisplayList::GetPackedRTree");
+    packed_rtree_ = std::make_unique<DlPackedRTree>(*rtree_);
+  });
+  return packed_rtree_.get();
+}
+
 std::vector<DlIndex> DisplayList::GetCulledIndices(
     const DlRect& cull_rect) const {
   std::vector<DlIndex> indices;
   if (!cull_rect.IsEmpty()) {
     if (rtree_) {
       std::vector<int> rect_indices;
-      rtree_->search(cull_rect, &rect_indices);
+      if (const DlPackedRTree* packed_rtree = GetPackedRTree()) {
+        packed_rtree->search(cull_rect, &rect_indices);
+      } else {
+        rtree_->search(cull_rect, &rect_indices);
+      }
       RTreeResultsToIndexVector(indices, rect_indices);
     } else {
       FillAllIndices(indices, offsets_.size());
@@ -5,9 +5,13 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <memory>
+#include <mutex>
+
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_storage.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
+#include "flutter/display_list/geometry/dl_packed_rtree.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
@@ -162,6 +166,7 @@ enum class DisplayListOpCategory {
 };
 
 class DlOpReceiver;
+class DlOpProfileScope;
 class DisplayListBuilder;
 
 class SaveLayerOptions {
@@ -542,12 +547,30 @@ class DisplayList : public SkRefCnt {
 
   const sk_sp<const DlRTree> rtree_;
 
+  // The minimum number of leaves in |rtree_| for which culling queries
+  // are performed against a |DlPackedRTree| built from it.
+  static constexpr int kMinPackedRTreeLeafCount = 1024;
+
+  // The packed form of |rtree_|, built by the first culling query of a
+  // DisplayList with at least |kMinPackedRTreeLeafCount| leaves.
+  mutable std::once_flag packed_rtree_once_;
+  mutable std::unique_ptr<const DlPackedRTree> packed_rtree_;
+
+  const DlPackedRTree* GetPackedRTree() const;
+
   void DispatchOneOp(DlOpReceiver& receiver, const uint8_t* ptr) const;
 
+  // Dispatches one op while the |DlOpProfiler| is enabled.
+  void DispatchOneOpProfiled(DlOpProfileScope& profile_scope,
+                             DlOpReceiver& receiver,
+                             const uint8_t* ptr) const;
+
   void RTreeResultsToIndexVector(std::vector<DlIndex>& indices,
                                  const std::vector<int>& rtree_results) const;
 
   friend class DisplayListBuilder;
+  friend class DisplayListDelta;
+  friend class DisplayListSerialization;
 };
 
 }  // namespace flutter
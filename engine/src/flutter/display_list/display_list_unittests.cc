@@ -3386,6 +3386,35 @@ TEST_F(DisplayListTest, RTreeRenderCulling) {
   }
 }
 
+TEST_F(DisplayListTest, RTreeRenderCullingLargeDisplayList) {
+  // Enough rects for culling queries to use a packed copy of the RTree.
+  const int kRows = 64;
+  const int kColumns = 64;
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  for (int y = 0; y < kRows; y++) {
+    for (int x = 0; x < kColumns; x++) {
+      builder.DrawRect(DlRect::MakeXYWH(x * 20, y * 20, 10, 10), DlPaint());
+    }
+  }
+  auto display_list = builder.Build();
+  ASSERT_GE(display_list->rtree()->leaf_count(), 1024);
+
+  auto test = [&display_list](const DlRect& cull_rect) {
+    std::vector<int> rtree_indices;
+    display_list->rtree()->search(cull_rect, &rtree_indices);
+    std::vector<DlIndex> expected;
+    for (int index : rtree_indices) {
+      expected.push_back(display_list->rtree()->id(index));
+    }
+    EXPECT_EQ(display_list->GetCulledIndices(cull_rect), expected)
+        << "using cull rect " << cull_rect;
+  };
+  test(DlRect::MakeLTRB(0, 0, 1280, 1280));
+  test(DlRect::MakeLTRB(95, 95, 305, 305));
+  test(DlRect::MakeLTRB(11, 11, 19, 19));
+  test(DlRect::MakeLTRB(1000, 0, 1001, 1280));
+}
+
 TEST_F(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   DisplayListBuilder builder;
   builder.DrawCircle(DlPoint(10, 10), 5, DlPaint());
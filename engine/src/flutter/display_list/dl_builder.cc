@@ -8,10 +8,12 @@
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/display_list/dl_storage_pool.h"
 #include "flutter/display_list/effects/dl_color_filters.h"
 #include "flutter/display_list/effects/dl_color_source.h"
 #include "flutter/display_list/effects/dl_image_filters.h"
 #include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/geometry/dl_bulk_bounds.h"
 #include "flutter/display_list/geometry/dl_geometry_conversions.h"
 #include "flutter/display_list/geometry/dl_path_builder.h"
 #include "flutter/display_list/utils/dl_accumulation_rect.h"
@@ -107,7 +109,7 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   Init(rtree != nullptr);
 
   storage_.trim();
-  DisplayListStorage storage;
+  DisplayListStorage storage(storage_.pool());
   std::vector<size_t> offsets;
   std::swap(offsets, offsets_);
   std::swap(storage, storage_);
@@ -128,7 +130,8 @@ static const DlRect& ProtectEmpty(const DlRect& rect) {
 
 DisplayListBuilder::DisplayListBuilder(const DlRect& cull_rect,
                                        bool prepare_rtree)
-    : original_cull_rect_(ProtectEmpty(cull_rect)) {
+    : storage_(DisplayListStoragePool::GetForCurrentThread()),
+      original_cull_rect_(ProtectEmpty(cull_rect)) {
   Init(prepare_rtree);
 }
 
@@ -1355,11 +1358,8 @@ void DisplayListBuilder::drawPoints(DlPointMode mode,
 
   FML_DCHECK(count < DlOpReceiver::kMaxDrawPointsCount);
   int bytes = count * sizeof(DlPoint);
-  AccumulationRect accumulator;
-  for (size_t i = 0; i < count; i++) {
-    accumulator.accumulate(pts[i]);
-  }
-  if (!AccumulateOpBounds(accumulator.GetBounds(), flags)) {
+  DlRect bounds = DlBulkBounds::PointBounds(pts, count).value_or(DlRect());
+  if (!AccumulateOpBounds(bounds, flags)) {
     return;
   }
 
@@ -1547,11 +1547,26 @@ void DisplayListBuilder::drawAtlas(const sk_sp<DlImage> atlas,
   }
   DlQuad quad;
   AccumulationRect accumulator;
-  for (int i = 0; i < count; i++) {
-    const DlRect& src = tex[i];
-    xform[i].GetQuad(src.GetWidth(), src.GetHeight(), quad);
-    for (int j = 0; j < 4; j++) {
-      accumulator.accumulate(quad[j]);
+  int i = 0;
+  // Detecting the overlap of the quads requires accumulating their corners
+  // one by one, but once an overlap has been found, or if the layer has
+  // already detected one, the bounds of the remaining quads are computed
+  // in bulk.
+  if (!current_layer().layer_local_accumulator.overlap_detected()) {
+    for (; i < count && !accumulator.overlap_detected(); i++) {
+      const DlRect& src = tex[i];
+      xform[i].GetQuad(src.GetWidth(), src.GetHeight(), quad);
+      for (int j = 0; j < 4; j++) {
+        accumulator.accumulate(quad[j]);
+      }
+    }
+  }
+  if (i < count) {
+    std::optional<DlRect> remaining =
+        DlBulkBounds::AtlasBounds(xform + i, tex + i, count - i);
+    if (remaining.has_value()) {
+      accumulator.accumulate(remaining->GetLeftTop());
+      accumulator.accumulate(remaining->GetRightBottom());
     }
   }
   if (accumulator.is_empty() ||
@@ -0,0 +1,182 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_delta.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+DisplayListDelta DisplayListDelta::Compute(
+    const DisplayList& old_display_list,
+    const DisplayList& new_display_list) {
+  TRACE_EVENT0("flutter", "DisplayListDelta::Compute");
+  DisplayListDelta delta;
+
+  DlIndex old_count = old_display_list.GetRecordCount();
+  DlIndex new_count = new_display_list.GetRecordCount();
+  if (&old_display_list == &new_display_list) {
+    delta.common_prefix_ = old_count;
+    delta.old_changed_end_ = old_count;
+    delta.new_changed_end_ = new_count;
+    return delta;
+  }
+
+  DlIndex min_count = std::min(old_count, new_count);
+  DlIndex prefix = 0u;
+  while (prefix < min_count &&
+         RecordEquals(old_display_list, prefix, new_display_list, prefix)) {
+    prefix++;
+  }
+  DlIndex suffix = 0u;
+  while (suffix < min_count - prefix &&
+         RecordEquals(old_display_list, old_count - suffix - 1,
+                      new_display_list, new_count - suffix - 1)) {
+    suffix++;
+  }
+
+  delta.common_prefix_ = prefix;
+  delta.common_suffix_ = suffix;
+  delta.old_changed_end_ = old_count - suffix;
+  delta.new_changed_end_ = new_count - suffix;
+  if (delta.is_equal()) {
+    return delta;
+  }
+
+  if (!old_display_list.has_rtree() || !new_display_list.has_rtree() ||
+      old_display_list.root_is_unbounded() ||
+      new_display_list.root_is_unbounded() ||
+      HasBackdropFilter(old_display_list, prefix) ||
+      HasBackdropFilter(new_display_list, prefix)) {
+    delta.is_bounded_ = false;
+    delta.damage_ =
+        old_display_list.GetBounds().Union(new_display_list.GetBounds());
+    return delta;
+  }
+
+  // If only rendering records changed, then every other record renders
+  // with the same state in both DisplayLists and only the changed records
+  // contribute to the damage. Otherwise any of the records following the
+  // start of the change may now be rendered with a different state.
+  DlIndex old_damage_end = delta.old_changed_end_;
+  DlIndex new_damage_end = delta.new_changed_end_;
+  if (ChangesState(old_display_list, prefix, old_damage_end) ||
+      ChangesState(new_display_list, prefix, new_damage_end)) {
+    old_damage_end = old_count;
+    new_damage_end = new_count;
+  }
+  AccumulateDamage(old_display_list, prefix, old_damage_end, delta.damage_);
+  AccumulateDamage(new_display_list, prefix, new_damage_end, delta.damage_);
+  return delta;
+}
+
+bool DisplayListDelta::RecordEquals(const DisplayList& a,
+                                    DlIndex index_a,
+                                    const DisplayList& b,
+                                    DlIndex index_b) {
+  size_t offset_a = a.offsets_[index_a];
+  size_t offset_b = b.offsets_[index_b];
+  auto op_a = reinterpret_cast<const DLOp*>(a.storage_.base() + offset_a);
+  auto op_b = reinterpret_cast<const DLOp*>(b.storage_.base() + offset_b);
+  if (op_a->type != op_b->type) {
+    return false;
+  }
+  if (op_a->type == DisplayListOpType::kSave) {
+    // A plain save record only holds the index of its matching restore
+    // and the depth of its content, which differ whenever the number of
+    // records between them changes, but which do not change how the
+    // records that follow it are rendered.
+    return true;
+  }
+
+  DisplayListCompare result;
+  switch (op_a->type) {
+#define DL_OP_EQUALS(name)                               \
+  case DisplayListOpType::k##name:                       \
+    result = static_cast<const name##Op*>(op_a)->equals( \
+        static_cast<const name##Op*>(op_b));             \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
+
+#undef DL_OP_EQUALS
+
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+  switch (result) {
+    case DisplayListCompare::kNotEqual:
+      return false;
+    case DisplayListCompare::kEqual:
+      return true;
+    case DisplayListCompare::kUseBulkCompare:
+      break;
+  }
+
+  size_t end_a = index_a + 1 < a.offsets_.size() ? a.offsets_[index_a + 1]
+                                                 : a.storage_.size();
+  size_t end_b = index_b + 1 < b.offsets_.size() ? b.offsets_[index_b + 1]
+                                                 : b.storage_.size();
+  size_t size = end_a - offset_a;
+  return size == end_b - offset_b && memcmp(op_a, op_b, size) == 0;
+}
+
+bool DisplayListDelta::HasBackdropFilter(const DisplayList& display_list,
+                                         DlIndex start) {
+  const uint8_t* base = display_list.storage_.base();
+  for (DlIndex i = start; i < display_list.offsets_.size(); i++) {
+    auto op = reinterpret_cast<const DLOp*>(base + display_list.offsets_[i]);
+    switch (op->type) {
+      case DisplayListOpType::kSaveLayerBackdrop:
+        return true;
+      case DisplayListOpType::kDrawDisplayList: {
+        auto draw_op = static_cast<const DrawDisplayListOp*>(op);
+        if (HasBackdropFilter(*draw_op->display_list, 0u)) {
+          return true;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+bool DisplayListDelta::ChangesState(const DisplayList& display_list,
+                                    DlIndex start,
+                                    DlIndex end) {
+  for (DlIndex i = start; i < end; i++) {
+    switch (display_list.GetOpCategory(i)) {
+      case DisplayListOpCategory::kRendering:
+      case DisplayListOpCategory::kSubDisplayList:
+        break;
+      default:
+        return true;
+    }
+  }
+  return false;
+}
+
+void DisplayListDelta::AccumulateDamage(const DisplayList& display_list,
+                                        DlIndex start,
+                                        DlIndex end,
+                                        DlRect& damage) {
+  const DlRTree* rtree = display_list.rtree_.get();
+  FML_DCHECK(rtree != nullptr);
+  for (int i = 0; i < rtree->leaf_count(); i++) {
+    int id = rtree->id(i);
+    if (id >= 0 && static_cast<DlIndex>(id) >= start &&
+        static_cast<DlIndex>(id) < end) {
+      damage = damage.Union(rtree->bounds(i));
+    }
+  }
+}
+
+}  // namespace flutter
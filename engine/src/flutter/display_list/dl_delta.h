@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_DELTA_H_
+#define FLUTTER_DISPLAY_LIST_DL_DELTA_H_
+
+#include "flutter/display_list/display_list.h"
+
+namespace flutter {
+
+/// @brief   Describes the differences between two DisplayLists, typically
+///          the DisplayList recorded for a picture in the current frame and
+///          the one that was recorded for it in the previous frame.
+///
+/// The delta is expressed as the length of the runs of records at the start
+/// and at the end of both DisplayLists that compare as equal, which leaves
+/// one contiguous range of changed records in each of them, along with a
+/// damage rectangle that bounds all of the pixels that may render
+/// differently between the two DisplayLists.
+///
+/// The damage is computed from the |DlRTree| of both DisplayLists. If the
+/// changed records only contain rendering operations then the damage is the
+/// union of the bounds of the changed records. If any attributes,
+/// transforms, clips or save/restore records changed, then all rendering
+/// records that follow the start of the change in either DisplayList may
+/// render differently and the damage includes all of them.
+///
+/// The damage is not bounded, and |is_bounded| returns false, if either
+/// DisplayList lacks an RTree or is unbounded, or if a backdrop filter
+/// follows the start of the change, since it may spread the changes to
+/// content that did not itself change. In that case the damage covers the
+/// bounds of both DisplayLists.
+class DisplayListDelta {
+ public:
+  /// @brief   Computes the delta between the two DisplayLists.
+  static DisplayListDelta Compute(const DisplayList& old_display_list,
+                                  const DisplayList& new_display_list);
+
+  /// @brief   Returns true if the DisplayLists contain equivalent records.
+  bool is_equal() const {
+    return old_changed_end_ == common_prefix_ &&
+           new_changed_end_ == common_prefix_;
+  }
+
+  /// @brief   The number of records at the start of both DisplayLists that
+  ///          compare as equal.
+  DlIndex common_prefix() const { return common_prefix_; }
+
+  /// @brief   The number of records at the end of both DisplayLists that
+  ///          compare as equal.
+  DlIndex common_suffix() const { return common_suffix_; }
+
+  /// @brief   The end (exclusive) of the range of records of the old
+  ///          DisplayList that changed. The range starts at the index
+  ///          |common_prefix|.
+  DlIndex old_changed_end() const { return old_changed_end_; }
+
+  /// @brief   The end (exclusive) of the range of records of the new
+  ///          DisplayList that changed. The range starts at the index
+  ///          |common_prefix|.
+  DlIndex new_changed_end() const { return new_changed_end_; }
+
+  /// @brief   Returns true if |damage| was computed from the bounds of the
+  ///          records that may render differently, rather than from the
+  ///          bounds of both DisplayLists as a whole.
+  bool is_bounded() const { return is_bounded_; }
+
+  /// @brief   The bounds of all pixels that may render differently, in the
+  ///          coordinate space of the DisplayLists.
+  const DlRect& damage() const { return damage_; }
+
+ private:
+  DisplayListDelta() = default;
+
+  static bool RecordEquals(const DisplayList& a,
+                           DlIndex index_a,
+                           const DisplayList& b,
+                           DlIndex index_b);
+
+  static bool HasBackdropFilter(const DisplayList& display_list,
+                                DlIndex start);
+
+  static bool ChangesState(const DisplayList& display_list,
+                           DlIndex start,
+                           DlIndex end);
+
+  static void AccumulateDamage(const DisplayList& display_list,
+                               DlIndex start,
+                               DlIndex end,
+                               DlRect& damage);
+
+  DlIndex common_prefix_ = 0u;
+  DlIndex common_suffix_ = 0u;
+  DlIndex old_changed_end_ = 0u;
+  DlIndex new_changed_end_ = 0u;
+  bool is_bounded_ = true;
+  DlRect damage_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_DELTA_H_
@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_delta.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/image_filters/dl_blur_image_filter.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr DlRect kRect1 = DlRect::MakeLTRB(10, 10, 30, 30);
+constexpr DlRect kRect2 = DlRect::MakeLTRB(50, 10, 70, 30);
+constexpr DlRect kRect3 = DlRect::MakeLTRB(10, 50, 30, 70);
+constexpr DlRect kRect4 = DlRect::MakeLTRB(50, 50, 70, 70);
+
+sk_sp<DisplayList> MakeRects(const std::vector<DlRect>& rects,
+                             bool prepare_rtree = true) {
+  DisplayListBuilder builder(prepare_rtree);
+  for (const DlRect& rect : rects) {
+    builder.DrawRect(rect, DlPaint());
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST(DisplayListDelta, SameInstance) {
+  auto display_list = MakeRects({kRect1, kRect2});
+  auto delta = DisplayListDelta::Compute(*display_list, *display_list);
+  EXPECT_TRUE(delta.is_equal());
+  EXPECT_TRUE(delta.is_bounded());
+  EXPECT_TRUE(delta.damage().IsEmpty());
+}
+
+TEST(DisplayListDelta, EqualDisplayLists) {
+  auto delta = DisplayListDelta::Compute(*MakeRects({kRect1, kRect2}),
+                                         *MakeRects({kRect1, kRect2}));
+  EXPECT_TRUE(delta.is_equal());
+  EXPECT_EQ(delta.common_prefix(), 2u);
+  EXPECT_TRUE(delta.damage().IsEmpty());
+}
+
+TEST(DisplayListDelta, ChangedRenderingRecord) {
+  auto old_display_list = MakeRects({kRect1, kRect2, kRect3});
+  auto new_display_list = MakeRects({kRect1, kRect4, kRect3});
+  auto delta = DisplayListDelta::Compute(*old_display_list, *new_display_list);
+  EXPECT_FALSE(delta.is_equal());
+  EXPECT_TRUE(delta.is_bounded());
+  EXPECT_EQ(delta.common_prefix(), 1u);
+  EXPECT_EQ(delta.common_suffix(), 1u);
+  EXPECT_EQ(delta.old_changed_end(), 2u);
+  EXPECT_EQ(delta.new_changed_end(), 2u);
+  EXPECT_EQ(delta.damage(), kRect2.Union(kRect4));
+}
+
+TEST(DisplayListDelta, InsertedRenderingRecord) {
+  auto old_display_list = MakeRects({kRect1, kRect3});
+  auto new_display_list = MakeRects({kRect1, kRect2, kRect3});
+  auto delta = DisplayListDelta::Compute(*old_display_list, *new_display_list);
+  EXPECT_TRUE(delta.is_bounded());
+  EXPECT_EQ(delta.common_prefix(), 1u);
+  EXPECT_EQ(delta.common_suffix(), 1u);
+  EXPECT_EQ(delta.old_changed_end(), 1u);
+  EXPECT_EQ(delta.new_changed_end(), 2u);
+  EXPECT_EQ(delta.damage(), kRect2);
+}
+
+TEST(DisplayListDelta, RemovedRenderingRecord) {
+  auto old_display_list = MakeRects({kRect1, kRect2, kRect3});
+  auto new_display_list = MakeRects({kRect1, kRect3});
+  auto delta = DisplayListDelta::Compute(*old_display_list, *new_display_list);
+  EXPECT_TRUE(delta.is_bounded());
+  EXPECT_EQ(delta.damage(), kRect2);
+}
+
+TEST(DisplayListDelta, ChangedAttributeDamagesFollowingRecords) {
+  auto make_display_list = [](DlColor color) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(kRect1, DlPaint());
+    builder.DrawRect(kRect2, DlPaint(color));
+    builder.DrawRect(kRect3, DlPaint(color));
+    builder.DrawRect(kRect4, DlPaint(DlColor::kGreen()));
+    return builder.Build();
+  };
+  auto delta = DisplayListDelta::Compute(*make_display_list(DlColor::kRed()),
+                                         *make_display_list(DlColor::kBlue()));
+  EXPECT_TRUE(delta.is_bounded());
+  // Only the SetColor record differs, but it changes how all of the
+  // records that follow it are rendered.
+  EXPECT_EQ(delta.old_changed_end(), delta.common_prefix() + 1);
+  EXPECT_EQ(delta.damage(), kRect2.Union(kRect3).Union(kRect4));
+}
+
+TEST(DisplayListDelta, ChangeWithinSave) {
+  auto make_display_list = [](const std::vector<DlRect>& rects) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(kRect1, DlPaint());
+    builder.Save();
+    builder.ClipRect(DlRect::MakeLTRB(0, 0, 100, 100));
+    for (const DlRect& rect : rects) {
+      builder.DrawRect(rect, DlPaint());
+    }
+    builder.Restore();
+    builder.DrawRect(kRect4, DlPaint());
+    return builder.Build();
+  };
+  auto delta = DisplayListDelta::Compute(*make_display_list({kRect2}),
+                                         *make_display_list({kRect2, kRect3}));
+  // The save records match even though the index of their restore
+  // record changed.
+  EXPECT_TRUE(delta.is_bounded());
+  EXPECT_EQ(delta.damage(), kRect3);
+}
+
+TEST(DisplayListDelta, NoRTreeIsUnbounded) {
+  auto old_display_list = MakeRects({kRect1, kRect2}, false);
+  auto new_display_list = MakeRects({kRect1, kRect4}, false);
+  auto delta = DisplayListDelta::Compute(*old_display_list, *new_display_list);
+  EXPECT_FALSE(delta.is_equal());
+  EXPECT_FALSE(delta.is_bounded());
+  EXPECT_EQ(delta.damage(), DlRect::MakeLTRB(10, 10, 70, 70));
+}
+
+TEST(DisplayListDelta, BackdropFilterIsUnbounded) {
+  auto make_display_list = [](const DlRect& rect) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(rect, DlPaint());
+    DlBlurImageFilter blur(5.0, 5.0, DlTileMode::kClamp);
+    builder.SaveLayer(kRect4, nullptr, &blur);
+    builder.Restore();
+    return builder.Build();
+  };
+  auto delta = DisplayListDelta::Compute(*make_display_list(kRect1),
+                                         *make_display_list(kRect2));
+  EXPECT_FALSE(delta.is_bounded());
+}
+
+}  // namespace testing
+}  // namespace flutter
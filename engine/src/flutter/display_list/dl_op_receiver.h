@@ -92,6 +92,11 @@ class DlOpReceiver {
   // MaxDrawPointsCount * sizeof(DlPoint) must be less than 1 << 32
   static constexpr int kMaxDrawPointsCount = ((1 << 29) - 1);
 
+  // Whether this receiver renders the ops that are dispatched to it, as
+  // opposed to recording or analyzing them. Only the dispatches to rendering
+  // receivers are timed by the |DlOpProfiler|.
+  virtual bool IsRenderingReceiver() const { return false; }
+
   // The following methods are nearly 1:1 with the methods on DlPaint and
   // carry the same meanings. Each method sets a persistent value for the
   // attribute for the rest of the display list or until it is reset by
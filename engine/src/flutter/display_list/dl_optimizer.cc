@@ -0,0 +1,732 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// Flags describing each record, as collected by the |RecordAnalyzer|.
+enum RecordFlags : uint8_t {
+  // The record is dispatched outside of any saveLayer.
+  kRootLevel = 1 << 0,
+  // The record may read the pixels rendered by the records before it.
+  kBarrier = 1 << 1,
+  // The record replaces all pixels within its |occluder| rect.
+  kOccluder = 1 << 2,
+  // The record is a saveLayer that has no effect if its content is empty.
+  kRemovableLayer = 1 << 3,
+};
+
+// The maximum number of occluder rects that are tracked at any time
+// while looking for records that they cover.
+constexpr size_t kMaxOccluders = 4u;
+
+// Information about a drawRect record used to merge it with its
+// neighbors.
+struct RectInfo {
+  DlIndex index;
+  DlRect rect;
+  // The scale and translation of the transform it was drawn with.
+  DlScalar scale_x;
+  DlScalar scale_y;
+  DlScalar translate_x;
+  DlScalar translate_y;
+  bool is_aa;
+  bool is_mergeable;
+};
+
+// Collects the information needed by the optimizer about each record of
+// a DisplayList that is dispatched to it one index at a time.
+class RecordAnalyzer final : public IgnoreDrawDispatchHelper {
+ public:
+  explicit RecordAnalyzer(DlIndex record_count) : flags_(record_count, 0u) {
+    states_.emplace_back(DisplayListBuilder::kMaxCullRect);
+  }
+
+  void set_index(DlIndex index) {
+    index_ = index;
+    if (layer_depth_ == 0) {
+      flags_[index] |= kRootLevel;
+    }
+  }
+
+  const std::vector<uint8_t>& flags() const { return flags_; }
+  const std::vector<std::pair<DlIndex, DlIRect>>& occluders() const {
+    return occluders_;
+  }
+  const std::vector<RectInfo>& rects() const { return rects_; }
+
+  void setAntiAlias(bool aa) override { is_aa_ = aa; }
+  void setInvertColors(bool invert) override {}
+  void setStrokeCap(DlStrokeCap cap) override {}
+  void setStrokeJoin(DlStrokeJoin join) override {}
+  void setDrawStyle(DlDrawStyle style) override { style_ = style; }
+  void setStrokeWidth(float width) override {}
+  void setStrokeMiter(float limit) override {}
+  void setColor(DlColor color) override { color_ = color; }
+  void setBlendMode(DlBlendMode mode) override { blend_mode_ = mode; }
+  void setColorSource(const DlColorSource* source) override {
+    has_color_source_ = source != nullptr;
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    has_image_filter_ = filter != nullptr;
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    has_color_filter_ = filter != nullptr;
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    has_mask_filter_ = filter != nullptr;
+  }
+
+  void save() override {
+    states_.push_back(states_.back());
+    states_.back().is_layer = false;
+  }
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    if (backdrop != nullptr) {
+      flags_[index_] |= kBarrier;
+    } else if (!options.renders_with_attributes()) {
+      flags_[index_] |= kRemovableLayer;
+    }
+    states_.push_back(states_.back());
+    states_.back().is_layer = true;
+    layer_depth_++;
+  }
+  void restore() override {
+    if (states_.size() > 1u) {
+      if (states_.back().is_layer) {
+        layer_depth_--;
+      }
+      states_.pop_back();
+    }
+  }
+
+  void translate(DlScalar tx, DlScalar ty) override {
+    matrix_clip().translate(tx, ty);
+  }
+  void scale(DlScalar sx, DlScalar sy) override {
+    matrix_clip().scale(sx, sy);
+  }
+  void rotate(DlScalar degrees) override {
+    matrix_clip().rotate(DlDegrees(degrees));
+  }
+  void skew(DlScalar sx, DlScalar sy) override { matrix_clip().skew(sx, sy); }
+  // clang-format off
+  void transform2DAffine(DlScalar mxx, DlScalar mxy, DlScalar mxt,
+                         DlScalar myx, DlScalar myy, DlScalar myt) override {
+    matrix_clip().transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+  }
+  void transformFullPerspective(
+      DlScalar mxx, DlScalar mxy, DlScalar mxz, DlScalar mxt,
+      DlScalar myx, DlScalar myy, DlScalar myz, DlScalar myt,
+      DlScalar mzx, DlScalar mzy, DlScalar mzz, DlScalar mzt,
+      DlScalar mwx, DlScalar mwy, DlScalar mwz, DlScalar mwt) override {
+    matrix_clip().transformFullPerspective(mxx, mxy, mxz, mxt,
+                                           myx, myy, myz, myt,
+                                           mzx, mzy, mzz, mzt,
+                                           mwx, mwy, mwz, mwt);
+  }
+  // clang-format on
+  void transformReset() override { matrix_clip().setIdentity(); }
+
+  void clipRect(const DlRect& rect, DlClipOp clip_op, bool is_aa) override {
+    DlRect device_rect;
+    if (clip_op == DlClipOp::kIntersect &&
+        matrix_clip().mapRect(rect, &device_rect)) {
+      State& state = states_.back();
+      state.inner_clip =
+          state.inner_clip.Intersection(device_rect).value_or(DlRect());
+    } else {
+      ClearInnerClip();
+    }
+  }
+  void clipOval(const DlRect& bounds, DlClipOp clip_op, bool is_aa) override {
+    ClearInnerClip();
+  }
+  void clipRoundRect(const DlRoundRect& rrect,
+                     DlClipOp clip_op,
+                     bool is_aa) override {
+    ClearInnerClip();
+  }
+  void clipRoundSuperellipse(const DlRoundSuperellipse& rse,
+                             DlClipOp clip_op,
+                             bool is_aa) override {
+    ClearInnerClip();
+  }
+  void clipPath(const DlPath& path, DlClipOp clip_op, bool is_aa) override {
+    ClearInnerClip();
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    if (mode == DlBlendMode::kSrc || mode == DlBlendMode::kClear ||
+        (mode == DlBlendMode::kSrcOver && color.isOpaque())) {
+      AddOccluder(states_.back().inner_clip);
+    }
+  }
+  void drawPaint() override {
+    if (PaintReplacesPixels()) {
+      AddOccluder(states_.back().inner_clip);
+    }
+  }
+  void drawRect(const DlRect& rect) override {
+    DlRect device_rect;
+    if (style_ == DlDrawStyle::kFill && PaintReplacesPixels() &&
+        matrix_clip().mapRect(rect, &device_rect)) {
+      AddOccluder(device_rect.Intersection(states_.back().inner_clip)
+                      .value_or(DlRect()));
+    }
+    const DlMatrix& matrix = matrix_clip().matrix();
+    bool is_mergeable = style_ == DlDrawStyle::kFill && !has_mask_filter_ &&
+                        !has_image_filter_ && !rect.IsEmpty() &&
+                        matrix.IsTranslationScaleOnly();
+    rects_.push_back({index_, rect, matrix.m[0], matrix.m[5], matrix.m[12],
+                      matrix.m[13], is_aa_, is_mergeable});
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    if (display_list->root_has_backdrop_filter()) {
+      flags_[index_] |= kBarrier;
+    }
+  }
+
+ private:
+  struct State {
+    explicit State(const DlRect& cull_rect)
+        : matrix_clip(cull_rect), inner_clip(cull_rect) {}
+
+    // Only the matrix of the tracker is used since its clip is an outer
+    // bound of the clip rather than an inner bound.
+    DisplayListMatrixClipState matrix_clip;
+    // A device space rect within which all pixels are inside the clip.
+    DlRect inner_clip;
+    bool is_layer = false;
+  };
+
+  DisplayListMatrixClipState& matrix_clip() {
+    return states_.back().matrix_clip;
+  }
+
+  void ClearInnerClip() { states_.back().inner_clip = DlRect(); }
+
+  // Returns true if a draw with the current attributes replaces every
+  // pixel it fully covers, regardless of the content below it.
+  bool PaintReplacesPixels() const {
+    if (has_mask_filter_ || has_image_filter_) {
+      return false;
+    }
+    switch (blend_mode_) {
+      case DlBlendMode::kSrc:
+      case DlBlendMode::kClear:
+        return true;
+      case DlBlendMode::kSrcOver:
+        return color_.isOpaque() && !has_color_source_ && !has_color_filter_;
+      default:
+        return false;
+    }
+  }
+
+  void AddOccluder(const DlRect& device_coverage) {
+    if (layer_depth_ > 0) {
+      return;
+    }
+    // Only the pixels entirely inside of the coverage are guaranteed to
+    // be replaced, whether or not the draw is antialiased.
+    DlIRect pixels = DlIRect::RoundIn(device_coverage);
+    if (!pixels.IsEmpty()) {
+      flags_[index_] |= kOccluder;
+      occluders_.emplace_back(index_, pixels);
+    }
+  }
+
+  DlIndex index_ = 0u;
+  int layer_depth_ = 0;
+  std::vector<State> states_;
+  std::vector<uint8_t> flags_;
+  std::vector<std::pair<DlIndex, DlIRect>> occluders_;
+  std::vector<RectInfo> rects_;
+
+  bool is_aa_ = false;
+  DlDrawStyle style_ = DlDrawStyle::kFill;
+  DlColor color_ = DlColor::kBlack();
+  DlBlendMode blend_mode_ = DlBlendMode::kSrcOver;
+  bool has_color_source_ = false;
+  bool has_color_filter_ = false;
+  bool has_mask_filter_ = false;
+  bool has_image_filter_ = false;
+};
+
+// Records the records dispatched to it into a |DlCanvas|, passing the
+// current attributes along with each rendering record.
+class CanvasRecordingReceiver final : public virtual DlOpReceiver {
+ public:
+  explicit CanvasRecordingReceiver(DlCanvas& canvas) : canvas_(canvas) {}
+
+  void setAntiAlias(bool aa) override { paint_.setAntiAlias(aa); }
+  void setInvertColors(bool invert) override {
+    paint_.setInvertColors(invert);
+  }
+  void setStrokeCap(DlStrokeCap cap) override { paint_.setStrokeCap(cap); }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    paint_.setStrokeJoin(join);
+  }
+  void setDrawStyle(DlDrawStyle style) override { paint_.setDrawStyle(style); }
+  void setStrokeWidth(float width) override { paint_.setStrokeWidth(width); }
+  void setStrokeMiter(float limit) override { paint_.setStrokeMiter(limit); }
+  void setColor(DlColor color) override { paint_.setColor(color); }
+  void setBlendMode(DlBlendMode mode) override { paint_.setBlendMode(mode); }
+  void setColorSource(const DlColorSource* source) override {
+    paint_.setColorSource(source);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    paint_.setImageFilter(filter);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    paint_.setColorFilter(filter);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    paint_.setMaskFilter(filter);
+  }
+
+  void save() override { canvas_.Save(); }
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    std::optional<DlRect> layer_bounds;
+    if (options.bounds_from_caller()) {
+      layer_bounds = bounds;
+    }
+    canvas_.SaveLayer(layer_bounds,
+                      Attributes(options.renders_with_attributes()), backdrop,
+                      backdrop_id);
+  }
+  void restore() override { canvas_.Restore(); }
+
+  void translate(DlScalar tx, DlScalar ty) override {
+    canvas_.Translate(tx, ty);
+  }
+  void scale(DlScalar sx, DlScalar sy) override { canvas_.Scale(sx, sy); }
+  void rotate(DlScalar degrees) override { canvas_.Rotate(degrees); }
+  void skew(DlScalar sx, DlScalar sy) override { canvas_.Skew(sx, sy); }
+  // clang-format off
+  void transform2DAffine(DlScalar mxx, DlScalar mxy, DlScalar mxt,
+                         DlScalar myx, DlScalar myy, DlScalar myt) override {
+    canvas_.Transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+  }
+  void transformFullPerspective(
+      DlScalar mxx, DlScalar mxy, DlScalar mxz, DlScalar mxt,
+      DlScalar myx, DlScalar myy, DlScalar myz, DlScalar myt,
+      DlScalar mzx, DlScalar mzy, DlScalar mzz, DlScalar mzt,
+      DlScalar mwx, DlScalar mwy, DlScalar mwz, DlScalar mwt) override {
+    canvas_.TransformFullPerspective(mxx, mxy, mxz, mxt,
+                                     myx, myy, myz, myt,
+                                     mzx, mzy, mzz, mzt,
+                                     mwx, mwy, mwz, mwt);
+  }
+  // clang-format on
+  void transformReset() override { canvas_.TransformReset(); }
+
+  void clipRect(const DlRect& rect, DlClipOp clip_op, bool is_aa) override {
+    canvas_.ClipRect(rect, clip_op, is_aa);
+  }
+  void clipOval(const DlRect& bounds, DlClipOp clip_op, bool is_aa) override {
+    canvas_.ClipOval(bounds, clip_op, is_aa);
+  }
+  void clipRoundRect(const DlRoundRect& rrect,
+                     DlClipOp clip_op,
+                     bool is_aa) override {
+    canvas_.ClipRoundRect(rrect, clip_op, is_aa);
+  }
+  void clipRoundSuperellipse(const DlRoundSuperellipse& rse,
+                             DlClipOp clip_op,
+                             bool is_aa) override {
+    canvas_.ClipRoundSuperellipse(rse, clip_op, is_aa);
+  }
+  void clipPath(const DlPath& path, DlClipOp clip_op, bool is_aa) override {
+    canvas_.ClipPath(path, clip_op, is_aa);
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    canvas_.DrawColor(color, mode);
+  }
+  void drawPaint() override { canvas_.DrawPaint(paint_); }
+  void drawLine(const DlPoint& p0, const DlPoint& p1) override {
+    canvas_.DrawLine(p0, p1, paint_);
+  }
+  void drawDashedLine(const DlPoint& p0,
+                      const DlPoint& p1,
+                      DlScalar on_length,
+                      DlScalar off_length) override {
+    canvas_.DrawDashedLine(p0, p1, on_length, off_length, paint_);
+  }
+  void drawRect(const DlRect& rect) override { canvas_.DrawRect(rect, paint_); }
+  void drawOval(const DlRect& bounds) override {
+    canvas_.DrawOval(bounds, paint_);
+  }
+  void drawCircle(const DlPoint& center, DlScalar radius) override {
+    canvas_.DrawCircle(center, radius, paint_);
+  }
+  void drawRoundRect(const DlRoundRect& rrect) override {
+    canvas_.DrawRoundRect(rrect, paint_);
+  }
+  void drawDiffRoundRect(const DlRoundRect& outer,
+                         const DlRoundRect& inner) override {
+    canvas_.DrawDiffRoundRect(outer, inner, paint_);
+  }
+  void drawRoundSuperellipse(const DlRoundSuperellipse& rse) override {
+    canvas_.DrawRoundSuperellipse(rse, paint_);
+  }
+  void drawPath(const DlPath& path) override { canvas_.DrawPath(path, paint_); }
+  void drawArc(const DlRect& oval_bounds,
+               DlScalar start_degrees,
+               DlScalar sweep_degrees,
+               bool use_center) override {
+    canvas_.DrawArc(oval_bounds, start_degrees, sweep_degrees, use_center,
+                    paint_);
+  }
+  void drawPoints(DlPointMode mode,
+                  uint32_t count,
+                  const DlPoint points[]) override {
+    canvas_.DrawPoints(mode, count, points, paint_);
+  }
+  void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                    DlBlendMode mode) override {
+    canvas_.DrawVertices(vertices, mode, paint_);
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const DlPoint& point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    canvas_.DrawImage(image, point, sampling,
+                      Attributes(render_with_attributes));
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const DlRect& src,
+                     const DlRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     DlSrcRectConstraint constraint) override {
+    canvas_.DrawImageRect(image, src, dst, sampling,
+                          Attributes(render_with_attributes), constraint);
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const DlIRect& center,
+                     const DlRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    canvas_.DrawImageNine(image, center, dst, filter,
+                          Attributes(render_with_attributes));
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const DlRSTransform xform[],
+                 const DlRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const DlRect* cull_rect,
+                 bool render_with_attributes) override {
+    canvas_.DrawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                      cull_rect, Attributes(render_with_attributes));
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    canvas_.DrawDisplayList(display_list, opacity);
+  }
+  void drawText(const std::shared_ptr<DlText>& text,
+                DlScalar x,
+                DlScalar y) override {
+    canvas_.DrawText(text, x, y, paint_);
+  }
+  void drawShadow(const DlPath& path,
+                  const DlColor color,
+                  const DlScalar elevation,
+                  bool transparent_occluder,
+                  DlScalar dpr) override {
+    canvas_.DrawShadow(path, color, elevation, transparent_occluder, dpr);
+  }
+
+ private:
+  const DlPaint* Attributes(bool render_with_attributes) const {
+    return render_with_attributes ? &paint_ : nullptr;
+  }
+
+  DlCanvas& canvas_;
+  DlPaint paint_;
+};
+
+// Returns the number of pixels in the rect, which may overflow the
+// coordinate type for rects as large as |DisplayListBuilder::kMaxCullRect|.
+int64_t PixelCount(const DlIRect& rect) {
+  return static_cast<int64_t>(rect.GetWidth()) * rect.GetHeight();
+}
+
+// Returns true if the rects share a whole edge and drawing their union
+// renders the same pixels as drawing both of them.
+bool CanMergeRects(const RectInfo& info, const DlRect& run_rect) {
+  const DlRect& rect = info.rect;
+  if (rect.GetTop() == run_rect.GetTop() &&
+      rect.GetBottom() == run_rect.GetBottom()) {
+    DlScalar edge;
+    if (rect.GetLeft() == run_rect.GetRight()) {
+      edge = rect.GetLeft();
+    } else if (rect.GetRight() == run_rect.GetLeft()) {
+      edge = rect.GetRight();
+    } else {
+      return false;
+    }
+    // Antialiased rects only render the shared edge without a seam if it
+    // falls on a pixel boundary.
+    DlScalar device_edge = edge * info.scale_x + info.translate_x;
+    return !info.is_aa || std::floor(device_edge) == device_edge;
+  }
+  if (rect.GetLeft() == run_rect.GetLeft() &&
+      rect.GetRight() == run_rect.GetRight()) {
+    DlScalar edge;
+    if (rect.GetTop() == run_rect.GetBottom()) {
+      edge = rect.GetTop();
+    } else if (rect.GetBottom() == run_rect.GetTop()) {
+      edge = rect.GetBottom();
+    } else {
+      return false;
+    }
+    DlScalar device_edge = edge * info.scale_y + info.translate_y;
+    return !info.is_aa || std::floor(device_edge) == device_edge;
+  }
+  return false;
+}
+
+}  // namespace
+
+sk_sp<DisplayList> DisplayListOptimizer::Optimize(
+    const sk_sp<DisplayList>& display_list,
+    Stats* stats) {
+  TRACE_EVENT0("flutter", "DisplayListOptimizer::Optimize");
+  Stats local_stats;
+  if (stats == nullptr) {
+    stats = &local_stats;
+  }
+  *stats = Stats();
+
+  const DlIndex count = display_list->GetRecordCount();
+  RecordAnalyzer analyzer(count);
+  for (DlIndex i = 0u; i < count; i++) {
+    analyzer.set_index(i);
+    display_list->Dispatch(analyzer, i);
+  }
+  const std::vector<uint8_t>& flags = analyzer.flags();
+  std::vector<bool> removed(count, false);
+
+  // Remove the rendering records in the root layer that are covered by
+  // the rect of a later occluder, walking backwards from the end so that
+  // the occluders that follow each record are known. Any record that may
+  // read the pixels of the records before it stops the search.
+  if (display_list->has_rtree()) {
+    const DlRTree* rtree = display_list->rtree().get();
+    std::vector<DlRect> bounds(count);
+    for (int i = 0; i < rtree->leaf_count(); i++) {
+      int id = rtree->id(i);
+      if (id >= 0 && static_cast<DlIndex>(id) < count) {
+        bounds[id] = bounds[id].Union(rtree->bounds(i));
+      }
+    }
+    const std::vector<std::pair<DlIndex, DlIRect>>& occluder_records =
+        analyzer.occluders();
+    size_t next_occluder = occluder_records.size();
+    std::vector<DlIRect> occluders;
+    for (DlIndex i = count; i-- > 0u;) {
+      if ((flags[i] & kBarrier) != 0) {
+        occluders.clear();
+        continue;
+      }
+      if ((flags[i] & kRootLevel) == 0) {
+        continue;
+      }
+      switch (display_list->GetOpCategory(i)) {
+        case DisplayListOpCategory::kRendering:
+        case DisplayListOpCategory::kSubDisplayList:
+          break;
+        default:
+          continue;
+      }
+      if (!bounds[i].IsEmpty()) {
+        DlIRect pixels = DlIRect::RoundOut(bounds[i]);
+        for (const DlIRect& occluder : occluders) {
+          if (occluder.Contains(pixels)) {
+            removed[i] = true;
+            stats->occluded_op_count++;
+            break;
+          }
+        }
+      }
+      if ((flags[i] & kOccluder) == 0) {
+        continue;
+      }
+      while (next_occluder > 0u &&
+             occluder_records[next_occluder - 1].first >= i) {
+        next_occluder--;
+      }
+      const DlIRect& occluder = occluder_records[next_occluder].second;
+      if (removed[i]) {
+        continue;
+      }
+      if (occluders.size() < kMaxOccluders) {
+        occluders.push_back(occluder);
+      } else {
+        // Replace the smallest occluder if the new one is larger.
+        auto smallest = std::min_element(
+            occluders.begin(), occluders.end(),
+            [](const DlIRect& a, const DlIRect& b) {
+              return PixelCount(a) < PixelCount(b);
+            });
+        if (PixelCount(*smallest) < PixelCount(occluder)) {
+          *smallest = occluder;
+        }
+      }
+    }
+  }
+
+  // Remove the save and saveLayer records, along with their restore
+  // records, that have no effect on the rendering records they contain.
+  struct Scope {
+    DlIndex save_index;
+    bool is_layer;
+    bool is_removable_layer;
+    bool changes_state;
+    bool has_rendering;
+  };
+  std::vector<Scope> scopes;
+  for (DlIndex i = 0u; i < count; i++) {
+    switch (display_list->GetOpCategory(i)) {
+      case DisplayListOpCategory::kSave:
+        scopes.push_back({i, false, false, false, false});
+        break;
+      case DisplayListOpCategory::kSaveLayer:
+        scopes.push_back(
+            {i, true, (flags[i] & kRemovableLayer) != 0, false, false});
+        break;
+      case DisplayListOpCategory::kTransform:
+      case DisplayListOpCategory::kClip:
+        if (!scopes.empty()) {
+          scopes.back().changes_state = true;
+        }
+        break;
+      case DisplayListOpCategory::kRendering:
+      case DisplayListOpCategory::kSubDisplayList:
+        if (!removed[i] && !scopes.empty()) {
+          scopes.back().has_rendering = true;
+        }
+        break;
+      case DisplayListOpCategory::kRestore: {
+        if (scopes.empty()) {
+          break;
+        }
+        Scope scope = scopes.back();
+        scopes.pop_back();
+        if (!scope.has_rendering &&
+            (!scope.is_layer || scope.is_removable_layer)) {
+          // Nothing is rendered within the scope, so none of the records
+          // in it other than the attributes, which are not affected by
+          // the restore record, have any effect.
+          for (DlIndex j = scope.save_index; j <= i; j++) {
+            if (!removed[j] && display_list->GetOpCategory(j) !=
+                                   DisplayListOpCategory::kAttribute) {
+              removed[j] = true;
+              stats->removed_state_op_count++;
+            }
+          }
+          break;
+        }
+        if (!scope.is_layer && !scope.changes_state) {
+          removed[scope.save_index] = true;
+          removed[i] = true;
+          stats->removed_state_op_count += 2;
+        }
+        if (!scopes.empty()) {
+          scopes.back().has_rendering = true;
+        }
+        break;
+      }
+      case DisplayListOpCategory::kAttribute:
+      case DisplayListOpCategory::kInvalidCategory:
+        break;
+    }
+  }
+
+  // Merge runs of adjacent rects drawn with the same attributes and
+  // transform. Any record other than a rect that remains between two
+  // rects may change how they are drawn, so it ends the run.
+  std::vector<std::pair<DlIndex, DlRect>> merged_rects;
+  const std::vector<RectInfo>& rects = analyzer.rects();
+  std::optional<DlRect> run_rect;
+  DlIndex run_index = 0u;
+  size_t next_rect = 0u;
+  for (DlIndex i = 0u; i < count; i++) {
+    if (removed[i]) {
+      continue;
+    }
+    while (next_rect < rects.size() && rects[next_rect].index < i) {
+      next_rect++;
+    }
+    if (next_rect == rects.size() || rects[next_rect].index != i) {
+      run_rect.reset();
+      continue;
+    }
+    const RectInfo& info = rects[next_rect];
+    if (!info.is_mergeable) {
+      run_rect.reset();
+    } else if (run_rect.has_value() && CanMergeRects(info, *run_rect)) {
+      run_rect = run_rect->Union(info.rect);
+      if (merged_rects.empty() || merged_rects.back().first != run_index) {
+        merged_rects.emplace_back(run_index, *run_rect);
+      } else {
+        merged_rects.back().second = *run_rect;
+      }
+      removed[i] = true;
+      stats->merged_op_count++;
+    } else {
+      run_rect = info.rect;
+      run_index = i;
+    }
+  }
+
+  if (stats->occluded_op_count == 0u && stats->merged_op_count == 0u &&
+      stats->removed_state_op_count == 0u) {
+    return display_list;
+  }
+
+  DisplayListBuilder builder(display_list->has_rtree());
+  CanvasRecordingReceiver receiver(builder);
+  size_t next_merged = 0u;
+  for (DlIndex i = 0u; i < count; i++) {
+    if (removed[i]) {
+      continue;
+    }
+    if (next_merged < merged_rects.size() &&
+        merged_rects[next_merged].first == i) {
+      receiver.drawRect(merged_rects[next_merged++].second);
+    } else {
+      display_list->Dispatch(receiver, i);
+    }
+  }
+  return builder.Build();
+}
+
+}  // namespace flutter
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_OPTIMIZER_H_
+#define FLUTTER_DISPLAY_LIST_DL_OPTIMIZER_H_
+
+#include "flutter/display_list/display_list.h"
+
+namespace flutter {
+
+/// @brief   An optional pass over a finished DisplayList that records an
+///          equivalent DisplayList with fewer records, typically for a
+///          picture that will be rendered many times, such as one that is
+///          held in a raster cache or reused across frames.
+///
+/// The pass performs the following optimizations:
+///
+/// - Rendering records in the root layer whose bounds, as reported by the
+///   |DlRTree| of the DisplayList, are entirely covered by a later draw of
+///   an opaque rect, paint or color in the root layer are removed, unless
+///   a backdrop filter between the two records may read the pixels of the
+///   covered record. Only draws whose device coverage is an axis aligned
+///   rectangle within a clip made only of axis aligned rectangles can
+///   cover other records.
+///
+/// - Save/restore pairs that contain no transform or clip records are
+///   removed, as are save/restore pairs and saveLayer/restore pairs
+///   without attributes or backdrop filters that contain no rendering
+///   records at all, along with the transform and clip records they
+///   contain.
+///
+/// - Consecutive filled rects drawn with the same attributes and state
+///   which share a whole edge are merged into a single rect, as long as
+///   the merged rect renders the same pixels. For antialiased rects the
+///   shared edge must fall on a pixel boundary.
+///
+/// - The remaining records are recorded into a new DisplayList through
+///   the |DlCanvas| interface, which only records the attributes that are
+///   used by each rendering record and drops attribute records that are
+///   redundant or whose values were never used.
+///
+/// The optimizer is conservative and leaves anything it does not fully
+/// understand in place. If no records could be removed, the original
+/// DisplayList is returned.
+class DisplayListOptimizer {
+ public:
+  struct Stats {
+    /// The number of rendering records that were removed because they
+    /// were covered by later opaque draws.
+    uint32_t occluded_op_count = 0u;
+
+    /// The number of rect records that were merged into a preceding rect.
+    uint32_t merged_op_count = 0u;
+
+    /// The number of save, saveLayer, restore, transform and clip records
+    /// that were removed because they had no effect.
+    uint32_t removed_state_op_count = 0u;
+  };
+
+  /// @brief   Returns an optimized equivalent of the DisplayList, or the
+  ///          DisplayList itself if it could not be optimized. The
+  ///          returned DisplayList has an RTree if the original did.
+  static sk_sp<DisplayList> Optimize(const sk_sp<DisplayList>& display_list,
+                                     Stats* stats = nullptr);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_OPTIMIZER_H_
@@ -0,0 +1,297 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_optimizer.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/image_filters/dl_blur_image_filter.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr DlRect kSmallRect = DlRect::MakeLTRB(10, 10, 30, 30);
+constexpr DlRect kLargeRect = DlRect::MakeLTRB(0, 0, 100, 100);
+
+const DlPaint kRedPaint = DlPaint(DlColor::kRed());
+const DlPaint kBluePaint = DlPaint(DlColor::kBlue());
+
+sk_sp<DisplayList> Optimize(const sk_sp<DisplayList>& display_list,
+                            DisplayListOptimizer::Stats* stats = nullptr) {
+  return DisplayListOptimizer::Optimize(display_list, stats);
+}
+
+}  // namespace
+
+TEST(DisplayListOptimizer, NothingToOptimizeReturnsSameDisplayList) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kLargeRect, kRedPaint);
+  builder.Save();
+  builder.Translate(10, 10);
+  builder.DrawRect(kSmallRect, kBluePaint);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  EXPECT_EQ(Optimize(display_list, &stats), display_list);
+  EXPECT_EQ(stats.occluded_op_count, 0u);
+  EXPECT_EQ(stats.merged_op_count, 0u);
+  EXPECT_EQ(stats.removed_state_op_count, 0u);
+}
+
+TEST(DisplayListOptimizer, EmptySaveRestoreIsRemoved) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.Save();
+  builder.Translate(10, 10);
+  builder.ClipRect(kLargeRect);
+  builder.Restore();
+  builder.DrawRect(kSmallRect, kRedPaint);
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder(/*prepare_rtree=*/true);
+  expected_builder.DrawRect(kSmallRect, kRedPaint);
+  auto expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  auto optimized = Optimize(display_list, &stats);
+  EXPECT_EQ(stats.removed_state_op_count, 4u);
+  EXPECT_TRUE(optimized->Equals(expected));
+  EXPECT_EQ(optimized->GetBounds(), display_list->GetBounds());
+}
+
+TEST(DisplayListOptimizer, EmptySaveLayerIsRemoved) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.SaveLayer(kLargeRect);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder(/*prepare_rtree=*/true);
+  expected_builder.DrawRect(kSmallRect, kRedPaint);
+  auto expected = expected_builder.Build();
+
+  auto optimized = Optimize(display_list);
+  EXPECT_TRUE(optimized->Equals(expected));
+}
+
+TEST(DisplayListOptimizer, EmptyBackdropSaveLayerIsKept) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  DlBlurImageFilter blur(5.0, 5.0, DlTileMode::kClamp);
+  builder.SaveLayer(kLargeRect, nullptr, &blur);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, OccludedDrawIsRemoved) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.DrawRect(kLargeRect, kBluePaint);
+  auto display_list = builder.Build();
+
+  // The attribute record for the occluded draw is dropped as well.
+  DisplayListBuilder expected_builder(/*prepare_rtree=*/true);
+  expected_builder.DrawRect(kLargeRect, kBluePaint);
+  auto expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  auto optimized = Optimize(display_list, &stats);
+  EXPECT_EQ(stats.occluded_op_count, 1u);
+  EXPECT_TRUE(optimized->Equals(expected));
+  EXPECT_TRUE(optimized->has_rtree());
+  EXPECT_LT(optimized->GetRecordCount(), display_list->GetRecordCount());
+}
+
+TEST(DisplayListOptimizer, DrawColorOccludesEverythingBeforeIt) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.DrawRect(kLargeRect, kBluePaint);
+  builder.DrawColor(DlColor::kGreen(), DlBlendMode::kSrc);
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  auto optimized = Optimize(display_list, &stats);
+  EXPECT_EQ(stats.occluded_op_count, 2u);
+  EXPECT_EQ(optimized->op_count(), 1u);
+}
+
+TEST(DisplayListOptimizer, LargestOccludersAreTracked) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.DrawPaint(kBluePaint);
+  for (int i = 0; i < 8; i++) {
+    builder.DrawRect(DlRect::MakeXYWH(i * 20, 200, 10, 10), kRedPaint);
+  }
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  Optimize(display_list, &stats);
+  EXPECT_EQ(stats.occluded_op_count, 1u);
+}
+
+TEST(DisplayListOptimizer, TranslucentDrawDoesNotOcclude) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.DrawRect(kLargeRect, DlPaint(DlColor::kBlue().withAlpha(0x80)));
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, StrokedDrawDoesNotOcclude) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  DlPaint stroke_paint =
+      DlPaint(DlColor::kBlue()).setDrawStyle(DlDrawStyle::kStroke);
+  builder.DrawRect(kLargeRect, stroke_paint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, PartiallyCoveredDrawIsKept) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeLTRB(90, 90, 110, 110), kRedPaint);
+  builder.DrawRect(kLargeRect, kBluePaint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, AntiAliasedOccluderOnlyCoversInnerPixels) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeLTRB(0, 0, 10, 10), kRedPaint);
+  builder.DrawRect(DlRect::MakeLTRB(0.5, 0.5, 100.5, 100.5),
+                   DlPaint(DlColor::kBlue()).setAntiAlias(true));
+  auto display_list = builder.Build();
+
+  // The red rect renders into the partially covered pixels on the
+  // left and top edges of the blue rect.
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, OccluderUsesRectClip) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.DrawRect(DlRect::MakeLTRB(50, 50, 60, 60), kRedPaint);
+  builder.Save();
+  builder.ClipRect(DlRect::MakeLTRB(0, 0, 40, 40));
+  builder.DrawPaint(kBluePaint);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  auto optimized = Optimize(display_list, &stats);
+  EXPECT_EQ(stats.occluded_op_count, 1u);
+  EXPECT_EQ(optimized->op_count(), display_list->op_count() - 1u);
+}
+
+TEST(DisplayListOptimizer, OccluderWithinComplexClipDoesNotOcclude) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.Save();
+  builder.ClipOval(kLargeRect);
+  builder.DrawPaint(kBluePaint);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, OccluderInSaveLayerDoesNotOcclude) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.SaveLayer(std::nullopt, &kBluePaint);
+  builder.DrawRect(kLargeRect, kBluePaint);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, BackdropFilterPreventsOcclusion) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  DlBlurImageFilter blur(5.0, 5.0, DlTileMode::kClamp);
+  builder.SaveLayer(kLargeRect, nullptr, &blur);
+  builder.DrawRect(kSmallRect, kBluePaint);
+  builder.Restore();
+  builder.DrawRect(kLargeRect, kBluePaint);
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  Optimize(display_list, &stats);
+  EXPECT_EQ(stats.occluded_op_count, 0u);
+}
+
+TEST(DisplayListOptimizer, NoRTreeSkipsOcclusion) {
+  DisplayListBuilder builder(/*prepare_rtree=*/false);
+  builder.DrawRect(kSmallRect, kRedPaint);
+  builder.DrawRect(kLargeRect, kBluePaint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, AdjacentRectsAreMerged) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  for (int i = 0; i < 4; i++) {
+    builder.DrawRect(DlRect::MakeXYWH(i * 10, 0, 10, 20), kRedPaint);
+  }
+  builder.DrawRect(DlRect::MakeXYWH(0, 20, 40, 10), kRedPaint);
+  builder.DrawRect(kLargeRect.Shift(200, 0), kBluePaint);
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder(/*prepare_rtree=*/true);
+  expected_builder.DrawRect(DlRect::MakeXYWH(0, 0, 40, 30), kRedPaint);
+  expected_builder.DrawRect(kLargeRect.Shift(200, 0), kBluePaint);
+  auto expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  auto optimized = Optimize(display_list, &stats);
+  EXPECT_EQ(stats.merged_op_count, 4u);
+  EXPECT_TRUE(optimized->Equals(expected));
+  EXPECT_EQ(optimized->GetBounds(), display_list->GetBounds());
+}
+
+TEST(DisplayListOptimizer, RectsWithDifferentAttributesAreNotMerged) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeXYWH(0, 0, 10, 10), kRedPaint);
+  builder.DrawRect(DlRect::MakeXYWH(10, 0, 10, 10), kBluePaint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, OverlappingRectsAreNotMerged) {
+  DlPaint paint = DlPaint(DlColor::kRed().withAlpha(0x80));
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeXYWH(0, 0, 10, 10), paint);
+  builder.DrawRect(DlRect::MakeXYWH(5, 0, 10, 10), paint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Optimize(display_list), display_list);
+}
+
+TEST(DisplayListOptimizer, AntiAliasedRectsMergeOnlyOnPixelBoundaries) {
+  DlPaint paint = DlPaint(DlColor::kRed()).setAntiAlias(true);
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeLTRB(0, 0, 10.5, 10), paint);
+  builder.DrawRect(DlRect::MakeLTRB(10.5, 0, 20, 10), paint);
+  builder.Scale(2, 2);
+  builder.DrawRect(DlRect::MakeLTRB(0, 20, 10.5, 30), paint);
+  builder.DrawRect(DlRect::MakeLTRB(10.5, 20, 20, 30), paint);
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  Optimize(display_list, &stats);
+  EXPECT_EQ(stats.merged_op_count, 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
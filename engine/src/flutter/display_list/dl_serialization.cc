@@ -0,0 +1,1231 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "flutter/display_list/dl_op_records.h"
+#include "flutter/display_list/effects/dl_color_filters.h"
+#include "flutter/display_list/effects/dl_color_sources.h"
+#include "flutter/display_list/effects/dl_image_filters.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// All sections of the serialized form, and any nested DisplayLists
+// stored in the payload section, start on this alignment relative to
+// the start of the data so that the op records can be dispatched in
+// place from a mapping that is itself suitably aligned.
+static constexpr size_t kSectionAlignment = 16u;
+static_assert(kSectionAlignment >= alignof(void*));
+
+static constexpr size_t AlignSize(size_t size) {
+  return (size + kSectionAlignment - 1u) & ~(kSectionAlignment - 1u);
+}
+
+#define DL_OP_RECORD_SIZE(name) sizeof(name##Op),
+static constexpr size_t kOpRecordSizes[] = {
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_RECORD_SIZE)  //
+};
+#undef DL_OP_RECORD_SIZE
+static_assert(std::size(kOpRecordSizes) ==
+              static_cast<size_t>(DisplayListOpType::kMaxOp));
+
+// A hash of the properties of this build that determine the layout of
+// the op records. Data written by a build with a different layout will
+// be rejected.
+static constexpr uint32_t ComputeLayoutSignature() {
+  uint32_t hash = 2166136261u;
+  hash = (hash ^ static_cast<uint32_t>(sizeof(void*))) * 16777619u;
+  hash = (hash ^ static_cast<uint32_t>(alignof(std::max_align_t))) * 16777619u;
+  hash = (hash ^ static_cast<uint32_t>(DisplayListOpType::kMaxOp)) * 16777619u;
+  for (size_t size : kOpRecordSizes) {
+    hash = (hash ^ static_cast<uint32_t>(size)) * 16777619u;
+  }
+  return hash;
+}
+static constexpr uint32_t kLayoutSignature = ComputeLayoutSignature();
+
+struct SerializedSection {
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct SerializedHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t layout_signature;
+  uint32_t flags;
+
+  uint32_t op_count;
+  uint32_t nested_op_count;
+  uint32_t total_depth;
+  uint32_t max_root_blend_mode;
+
+  uint64_t nested_byte_count;
+  DlRect bounds;
+
+  uint32_t record_count;
+  uint32_t fixup_count;
+  int32_t rtree_leaf_count;
+  int32_t rtree_invalid_id;
+  uint32_t rtree_node_count;
+  uint32_t rtree_node_size;
+
+  SerializedSection records;
+  SerializedSection offsets;
+  SerializedSection rtree_nodes;
+  SerializedSection fixups;
+  SerializedSection payload;
+};
+static_assert(std::is_trivially_copyable_v<SerializedHeader>);
+
+enum SerializedFlags : uint32_t {
+  kCanApplyGroupOpacity = 1u << 0,
+  kIsUIThreadSafe = 1u << 1,
+  kModifiesTransparentBlack = 1u << 2,
+  kRootHasBackdropFilter = 1u << 3,
+  kRootIsUnbounded = 1u << 4,
+  kHasRTree = 1u << 5,
+};
+
+// Describes a record whose bytes in the records section were zeroed out
+// by the writer and must be reconstructed from the indicated range of
+// the payload section by the reader.
+struct SerializedFixup {
+  uint32_t record_index;
+  uint32_t op_type;
+  uint64_t payload_offset;
+  uint64_t payload_size;
+};
+static_assert(std::is_trivially_copyable_v<SerializedFixup>);
+
+enum class RecordEncoding {
+  // The record contains only plain data and is stored as is.
+  kVerbatim,
+  // The record refers to heap objects and is stored in a portable form
+  // in the payload section.
+  kFixup,
+  // The record refers to objects that cannot be serialized.
+  kUnsupported,
+};
+
+constexpr RecordEncoding GetRecordEncoding(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSetPodColorFilter:
+    case DisplayListOpType::kSetPodColorSource:
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetPodMaskFilter:
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferencePath:
+    case DisplayListOpType::kDrawPath:
+    case DisplayListOpType::kDrawVertices:
+    case DisplayListOpType::kDrawDisplayList:
+    case DisplayListOpType::kDrawShadow:
+    case DisplayListOpType::kDrawShadowTransparentOccluder:
+      return RecordEncoding::kFixup;
+
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+    case DisplayListOpType::kSetSharedImageFilter:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kDrawImage:
+    case DisplayListOpType::kDrawImageWithAttr:
+    case DisplayListOpType::kDrawImageRect:
+    case DisplayListOpType::kDrawImageNine:
+    case DisplayListOpType::kDrawImageNineWithAttr:
+    case DisplayListOpType::kDrawAtlas:
+    case DisplayListOpType::kDrawAtlasCulled:
+    case DisplayListOpType::kDrawText:
+    case DisplayListOpType::kInvalidOp:
+      return RecordEncoding::kUnsupported;
+
+    default:
+      return RecordEncoding::kVerbatim;
+  }
+}
+
+// Records that are stored verbatim are also dispatched directly from
+// read-only mappings and are never destroyed individually.
+#define DL_OP_CHECK_VERBATIM(name)                                           \
+  static_assert(GetRecordEncoding(DisplayListOpType::k##name) !=             \
+                        RecordEncoding::kVerbatim ||                         \
+                    std::is_trivially_destructible_v<name##Op>,              \
+                "Only plain data records can be serialized verbatim: " #name);
+FOR_EACH_DISPLAY_LIST_OP(DL_OP_CHECK_VERBATIM)
+#undef DL_OP_CHECK_VERBATIM
+
+template <typename T>
+bool IsValidEnum(T value, T last) {
+  return static_cast<uint32_t>(value) <= static_cast<uint32_t>(last);
+}
+
+class SerializationWriter {
+ public:
+  explicit SerializationWriter(std::vector<uint8_t>& buffer)
+      : buffer_(buffer) {}
+
+  size_t offset() const { return buffer_.size(); }
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  void WriteBytes(const void* data, size_t size) {
+    if (size > 0u) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+  }
+
+  void Align() { buffer_.resize(AlignSize(buffer_.size()), 0u); }
+
+ private:
+  std::vector<uint8_t>& buffer_;
+};
+
+class SerializationReader {
+ public:
+  SerializationReader(const uint8_t* data, size_t size)
+      : data_(data), size_(size) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const uint8_t* bytes = ReadBytes(sizeof(T));
+    if (!bytes) {
+      return false;
+    }
+    memcpy(value, bytes, sizeof(T));
+    return true;
+  }
+
+  template <typename T>
+  bool ReadArray(std::vector<T>* values, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (count > remaining() / sizeof(T)) {
+      return false;
+    }
+    values->resize(count);
+    memcpy(values->data(), ReadBytes(count * sizeof(T)), count * sizeof(T));
+    return true;
+  }
+
+  const uint8_t* ReadBytes(size_t size) {
+    if (size > remaining()) {
+      return nullptr;
+    }
+    const uint8_t* bytes = data_ + position_;
+    position_ += size;
+    return bytes;
+  }
+
+  bool Align() {
+    size_t aligned = AlignSize(position_);
+    if (aligned > size_) {
+      return false;
+    }
+    position_ = aligned;
+    return true;
+  }
+
+  bool is_done() const { return position_ == size_; }
+
+ private:
+  size_t remaining() const { return size_ - position_; }
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_ = 0u;
+};
+
+void WritePath(SerializationWriter& writer, const DlPath& path) {
+  const SkPath& sk_path = path.GetSkPath();
+  size_t size = sk_path.writeToMemory(nullptr);
+  std::vector<uint8_t> bytes(size);
+  sk_path.writeToMemory(bytes.data());
+  writer.Write(static_cast<uint64_t>(size));
+  writer.WriteBytes(bytes.data(), size);
+}
+
+bool ReadPath(SerializationReader& reader, DlPath* path) {
+  uint64_t size;
+  if (!reader.Read(&size)) {
+    return false;
+  }
+  const uint8_t* bytes = reader.ReadBytes(size);
+  if (!bytes) {
+    return false;
+  }
+  SkPath sk_path;
+  if (sk_path.readFromMemory(bytes, size) != size) {
+    return false;
+  }
+  if (SkPathFillType_IsInverse(sk_path.getFillType())) {
+    return false;
+  }
+  *path = DlPath(sk_path);
+  return true;
+}
+
+void WriteGradient(SerializationWriter& writer,
+                   const DlGradientColorSourceBase* gradient) {
+  uint32_t stop_count = gradient->stop_count();
+  writer.Write(gradient->tile_mode());
+  writer.Write(gradient->matrix());
+  writer.Write(stop_count);
+  writer.WriteBytes(gradient->colors(), stop_count * sizeof(DlColor));
+  writer.WriteBytes(gradient->stops(), stop_count * sizeof(float));
+}
+
+struct GradientData {
+  DlTileMode tile_mode;
+  DlMatrix matrix;
+  std::vector<DlColor> colors;
+  std::vector<float> stops;
+
+  uint32_t stop_count() const { return colors.size(); }
+};
+
+bool ReadGradient(SerializationReader& reader, GradientData* gradient) {
+  uint32_t stop_count;
+  return reader.Read(&gradient->tile_mode) &&
+         IsValidEnum(gradient->tile_mode, DlTileMode::kDecal) &&
+         reader.Read(&gradient->matrix) &&  //
+         reader.Read(&stop_count) &&
+         reader.ReadArray(&gradient->colors, stop_count) &&
+         reader.ReadArray(&gradient->stops, stop_count);
+}
+
+bool WriteColorFilter(SerializationWriter& writer,
+                      const DlColorFilter* filter) {
+  writer.Write(filter->type());
+  switch (filter->type()) {
+    case DlColorFilterType::kBlend: {
+      const DlBlendColorFilter* blend = filter->asBlend();
+      writer.Write(blend->color());
+      writer.Write(blend->mode());
+      return true;
+    }
+    case DlColorFilterType::kMatrix: {
+      float matrix[20];
+      filter->asMatrix()->get_matrix(matrix);
+      writer.Write(matrix);
+      return true;
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+    case DlColorFilterType::kLinearToSrgbGamma:
+      return true;
+  }
+  return false;
+}
+
+bool WriteImageFilter(SerializationWriter& writer,
+                      const DlImageFilter* filter) {
+  writer.Write(filter->type());
+  switch (filter->type()) {
+    case DlImageFilterType::kBlur: {
+      const DlBlurImageFilter* blur = filter->asBlur();
+      std::optional<DlRect> bounds = blur->bounds();
+      writer.Write(blur->sigma_x());
+      writer.Write(blur->sigma_y());
+      writer.Write(blur->tile_mode());
+      writer.Write(static_cast<uint32_t>(bounds.has_value()));
+      writer.Write(bounds.value_or(DlRect()));
+      return true;
+    }
+    case DlImageFilterType::kDilate: {
+      const DlDilateImageFilter* dilate = filter->asDilate();
+      writer.Write(dilate->radius_x());
+      writer.Write(dilate->radius_y());
+      return true;
+    }
+    case DlImageFilterType::kErode: {
+      const DlErodeImageFilter* erode = filter->asErode();
+      writer.Write(erode->radius_x());
+      writer.Write(erode->radius_y());
+      return true;
+    }
+    case DlImageFilterType::kMatrix: {
+      const DlMatrixImageFilter* matrix = filter->asMatrix();
+      writer.Write(matrix->matrix());
+      writer.Write(matrix->sampling());
+      return true;
+    }
+    case DlImageFilterType::kRuntimeEffect:
+    case DlImageFilterType::kColorFilter:
+    case DlImageFilterType::kCompose:
+    case DlImageFilterType::kLocalMatrix:
+      // These filters are never stored inline in the op buffer.
+      return false;
+  }
+  return false;
+}
+
+bool WriteColorSource(SerializationWriter& writer,
+                      const DlColorSource* source) {
+  writer.Write(source->type());
+  switch (source->type()) {
+    case DlColorSourceType::kLinearGradient: {
+      const DlLinearGradientColorSource* linear = source->asLinearGradient();
+      writer.Write(linear->start_point());
+      writer.Write(linear->end_point());
+      WriteGradient(writer, linear);
+      return true;
+    }
+    case DlColorSourceType::kRadialGradient: {
+      const DlRadialGradientColorSource* radial = source->asRadialGradient();
+      writer.Write(radial->center());
+      writer.Write(radial->radius());
+      WriteGradient(writer, radial);
+      return true;
+    }
+    case DlColorSourceType::kConicalGradient: {
+      const DlConicalGradientColorSource* conical =
+          source->asConicalGradient();
+      writer.Write(conical->start_center());
+      writer.Write(conical->start_radius());
+      writer.Write(conical->end_center());
+      writer.Write(conical->end_radius());
+      WriteGradient(writer, conical);
+      return true;
+    }
+    case DlColorSourceType::kSweepGradient: {
+      const DlSweepGradientColorSource* sweep = source->asSweepGradient();
+      writer.Write(sweep->center());
+      writer.Write(sweep->start());
+      writer.Write(sweep->end());
+      WriteGradient(writer, sweep);
+      return true;
+    }
+    case DlColorSourceType::kImage:
+    case DlColorSourceType::kRuntimeEffect:
+      // These sources are never stored inline in the op buffer.
+      return false;
+  }
+  return false;
+}
+
+void WriteVertices(SerializationWriter& writer, const DlVertices* vertices) {
+  int vertex_count = vertices->vertex_count();
+  int index_count = vertices->index_count();
+  const DlPoint* texture_coordinates = vertices->texture_coordinate_data();
+  const DlColor* colors = vertices->colors();
+  writer.Write(vertices->mode());
+  writer.Write(static_cast<uint32_t>(vertex_count));
+  writer.Write(static_cast<uint32_t>(index_count));
+  writer.Write(static_cast<uint32_t>(texture_coordinates != nullptr));
+  writer.Write(static_cast<uint32_t>(colors != nullptr));
+  writer.Write(vertices->GetBounds());
+  writer.WriteBytes(vertices->vertex_data(), vertex_count * sizeof(DlPoint));
+  if (texture_coordinates) {
+    writer.WriteBytes(texture_coordinates, vertex_count * sizeof(DlPoint));
+  }
+  if (colors) {
+    writer.WriteBytes(colors, vertex_count * sizeof(DlColor));
+  }
+  writer.WriteBytes(vertices->indices(), index_count * sizeof(uint16_t));
+}
+
+std::shared_ptr<DlVertices> ReadVertices(SerializationReader& reader) {
+  DlVertexMode mode;
+  uint32_t vertex_count;
+  uint32_t index_count;
+  uint32_t has_texture_coordinates;
+  uint32_t has_colors;
+  DlRect bounds;
+  if (!reader.Read(&mode) ||
+      !IsValidEnum(mode, DlVertexMode::kTriangleFan) ||
+      !reader.Read(&vertex_count) || !reader.Read(&index_count) ||
+      !reader.Read(&has_texture_coordinates) || !reader.Read(&has_colors) ||
+      !reader.Read(&bounds)) {
+    return nullptr;
+  }
+  std::vector<DlPoint> points;
+  std::vector<DlPoint> texture_coordinates;
+  std::vector<DlColor> colors;
+  std::vector<uint16_t> indices;
+  if (!reader.ReadArray(&points, vertex_count) ||
+      (has_texture_coordinates &&
+       !reader.ReadArray(&texture_coordinates, vertex_count)) ||
+      (has_colors && !reader.ReadArray(&colors, vertex_count)) ||
+      !reader.ReadArray(&indices, index_count)) {
+    return nullptr;
+  }
+  return DlVertices::Make(
+      mode, vertex_count, points.data(),
+      has_texture_coordinates ? texture_coordinates.data() : nullptr,
+      has_colors ? colors.data() : nullptr, index_count,
+      index_count > 0 ? indices.data() : nullptr, &bounds);
+}
+
+// Writes the portable form of a record that cannot be stored verbatim.
+bool WriteRecordPayload(SerializationWriter& writer, const DLOp* op) {
+  switch (op->type) {
+    case DisplayListOpType::kSetPodColorFilter:
+      return WriteColorFilter(
+          writer, reinterpret_cast<const DlColorFilter*>(
+                      static_cast<const SetPodColorFilterOp*>(op) + 1));
+    case DisplayListOpType::kSetPodImageFilter:
+      return WriteImageFilter(
+          writer, reinterpret_cast<const DlImageFilter*>(
+                      static_cast<const SetPodImageFilterOp*>(op) + 1));
+    case DisplayListOpType::kSetPodColorSource:
+      return WriteColorSource(
+          writer, reinterpret_cast<const DlColorSource*>(
+                      static_cast<const SetPodColorSourceOp*>(op) + 1));
+    case DisplayListOpType::kSetPodMaskFilter: {
+      const DlMaskFilter* filter = reinterpret_cast<const DlMaskFilter*>(
+          static_cast<const SetPodMaskFilterOp*>(op) + 1);
+      const DlBlurMaskFilter* blur = filter->asBlur();
+      if (!blur) {
+        return false;
+      }
+      writer.Write(blur->style());
+      writer.Write(blur->sigma());
+      writer.Write(static_cast<uint32_t>(blur->respectCTM()));
+      return true;
+    }
+    case DisplayListOpType::kClipIntersectPath: {
+      auto clip_op = static_cast<const ClipIntersectPathOp*>(op);
+      writer.Write(static_cast<uint32_t>(clip_op->is_aa));
+      WritePath(writer, clip_op->path);
+      return true;
+    }
+    case DisplayListOpType::kClipDifferencePath: {
+      auto clip_op = static_cast<const ClipDifferencePathOp*>(op);
+      writer.Write(static_cast<uint32_t>(clip_op->is_aa));
+      WritePath(writer, clip_op->path);
+      return true;
+    }
+    case DisplayListOpType::kDrawPath:
+      WritePath(writer, static_cast<const DrawPathOp*>(op)->path);
+      return true;
+    case DisplayListOpType::kDrawShadow: {
+      auto shadow_op = static_cast<const DrawShadowOp*>(op);
+      writer.Write(shadow_op->color);
+      writer.Write(shadow_op->elevation);
+      writer.Write(shadow_op->dpr);
+      WritePath(writer, shadow_op->path);
+      return true;
+    }
+    case DisplayListOpType::kDrawShadowTransparentOccluder: {
+      auto shadow_op = static_cast<const DrawShadowTransparentOccluderOp*>(op);
+      writer.Write(shadow_op->color);
+      writer.Write(shadow_op->elevation);
+      writer.Write(shadow_op->dpr);
+      WritePath(writer, shadow_op->path);
+      return true;
+    }
+    case DisplayListOpType::kDrawVertices: {
+      auto vertices_op = static_cast<const DrawVerticesOp*>(op);
+      writer.Write(vertices_op->mode);
+      WriteVertices(writer, vertices_op->vertices.get());
+      return true;
+    }
+    default:
+      // DrawDisplayList is handled by the caller since it recurses.
+      FML_DCHECK(false);
+      return false;
+  }
+}
+
+bool IsValidSection(const SerializedSection& section, size_t size) {
+  return section.offset % kSectionAlignment == 0u &&  //
+         section.offset <= size &&                    //
+         section.size <= size - section.offset;
+}
+
+}  // namespace
+
+bool DisplayListSerialization::CanSerialize(const DisplayList& display_list) {
+  const uint8_t* base = display_list.GetStorage().base();
+  for (size_t offset : display_list.offsets_) {
+    auto op = reinterpret_cast<const DLOp*>(base + offset);
+    switch (GetRecordEncoding(op->type)) {
+      case RecordEncoding::kVerbatim:
+        break;
+      case RecordEncoding::kFixup:
+        if (op->type == DisplayListOpType::kDrawDisplayList &&
+            !CanSerialize(*static_cast<const DrawDisplayListOp*>(op)
+                               ->display_list)) {
+          return false;
+        }
+        break;
+      case RecordEncoding::kUnsupported:
+        return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> DisplayListSerialization::Serialize(
+    const DisplayList& display_list) {
+  TRACE_EVENT0("flutter", "DisplayListSerialization::Serialize");
+  std::vector<uint8_t> buffer;
+  if (!SerializeTo(display_list, buffer)) {
+    return nullptr;
+  }
+  return std::make_unique<fml::DataMapping>(std::move(buffer));
+}
+
+std::optional<uint64_t> DisplayListSerialization::ContentHash(
+    const DisplayList& display_list) {
+  TRACE_EVENT0("flutter", "DisplayListSerialization::ContentHash");
+  std::vector<uint8_t> buffer;
+  if (!SerializeTo(display_list, buffer)) {
+    return std::nullopt;
+  }
+  // 64-bit FNV-1a.
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (uint8_t byte : buffer) {
+    hash = (hash ^ byte) * 0x100000001b3u;
+  }
+  return hash;
+}
+
+bool DisplayListSerialization::SerializeTo(const DisplayList& display_list,
+                                           std::vector<uint8_t>& buffer) {
+  const DisplayListStorage& storage = display_list.GetStorage();
+  const std::vector<size_t>& offsets = display_list.offsets_;
+  const uint8_t* base = storage.base();
+
+  std::vector<uint8_t> records(base, base + storage.size());
+  std::vector<SerializedFixup> fixups;
+  std::vector<uint8_t> payload;
+  SerializationWriter payload_writer(payload);
+
+  for (size_t i = 0; i < offsets.size(); i++) {
+    auto op = reinterpret_cast<const DLOp*>(base + offsets[i]);
+    switch (GetRecordEncoding(op->type)) {
+      case RecordEncoding::kVerbatim:
+        continue;
+      case RecordEncoding::kUnsupported:
+        return false;
+      case RecordEncoding::kFixup:
+        break;
+    }
+
+    size_t payload_start = payload_writer.offset();
+    if (op->type == DisplayListOpType::kDrawDisplayList) {
+      auto nested_op = static_cast<const DrawDisplayListOp*>(op);
+      payload_writer.Write(nested_op->opacity);
+      payload_writer.Align();
+      if (!SerializeTo(*nested_op->display_list, payload)) {
+        return false;
+      }
+    } else if (!WriteRecordPayload(payload_writer, op)) {
+      return false;
+    }
+    fixups.push_back({
+        .record_index = static_cast<uint32_t>(i),
+        .op_type = static_cast<uint32_t>(op->type),
+        .payload_offset = payload_start,
+        .payload_size = payload_writer.offset() - payload_start,
+    });
+    payload_writer.Align();
+
+    // The in-memory record refers to heap objects, none of which should
+    // end up in the serialized data.
+    size_t record_end =
+        (i + 1 < offsets.size()) ? offsets[i + 1] : storage.size();
+    std::fill(records.begin() + offsets[i], records.begin() + record_end, 0u);
+  }
+
+  std::vector<uint8_t> rtree_nodes;
+  sk_sp<const DlRTree> rtree = display_list.rtree();
+  if (rtree) {
+    const uint8_t* node_bytes =
+        reinterpret_cast<const uint8_t*>(rtree->nodes_.data());
+    size_t node_bytes_size = rtree->nodes_.size() * sizeof(DlRTree::Node);
+    rtree_nodes.assign(node_bytes, node_bytes + node_bytes_size);
+  }
+
+  uint32_t flags = 0u;
+  if (display_list.can_apply_group_opacity()) {
+    flags |= kCanApplyGroupOpacity;
+  }
+  if (display_list.isUIThreadSafe()) {
+    flags |= kIsUIThreadSafe;
+  }
+  if (display_list.modifies_transparent_black()) {
+    flags |= kModifiesTransparentBlack;
+  }
+  if (display_list.root_has_backdrop_filter()) {
+    flags |= kRootHasBackdropFilter;
+  }
+  if (display_list.root_is_unbounded()) {
+    flags |= kRootIsUnbounded;
+  }
+  if (rtree) {
+    flags |= kHasRTree;
+  }
+
+  SerializedHeader header = {
+      .magic = kMagic,
+      .version = kVersion,
+      .layout_signature = kLayoutSignature,
+      .flags = flags,
+      .op_count = display_list.op_count_,
+      .nested_op_count = display_list.nested_op_count_,
+      .total_depth = display_list.total_depth_,
+      .max_root_blend_mode =
+          static_cast<uint32_t>(display_list.max_root_blend_mode_),
+      .nested_byte_count = display_list.nested_byte_count_,
+      .bounds = display_list.bounds_,
+      .record_count = static_cast<uint32_t>(offsets.size()),
+      .fixup_count = static_cast<uint32_t>(fixups.size()),
+      .rtree_leaf_count = rtree ? rtree->leaf_count_ : 0,
+      .rtree_invalid_id = rtree ? rtree->invalid_id_ : -1,
+      .rtree_node_count =
+          rtree ? static_cast<uint32_t>(rtree->nodes_.size()) : 0u,
+      .rtree_node_size = sizeof(DlRTree::Node),
+  };
+
+  // Lay out the sections relative to the start of this DisplayList's data
+  // which the caller has aligned within the buffer.
+  FML_DCHECK(buffer.size() % kSectionAlignment == 0u);
+  size_t start = buffer.size();
+  size_t next = AlignSize(sizeof(SerializedHeader));
+  auto place = [&next](SerializedSection& section, size_t size) {
+    section.offset = next;
+    section.size = size;
+    next = AlignSize(next + size);
+  };
+  place(header.records, records.size());
+  place(header.offsets, offsets.size() * sizeof(size_t));
+  place(header.rtree_nodes, rtree_nodes.size());
+  place(header.fixups, fixups.size() * sizeof(SerializedFixup));
+  place(header.payload, payload.size());
+
+  buffer.resize(start + next, 0u);
+  uint8_t* data = buffer.data() + start;
+  memcpy(data, &header, sizeof(header));
+  auto copy = [data](const SerializedSection& section, const void* src) {
+    if (section.size > 0u) {
+      memcpy(data + section.offset, src, section.size);
+    }
+  };
+  copy(header.records, records.data());
+  copy(header.offsets, offsets.data());
+  copy(header.rtree_nodes, rtree_nodes.data());
+  copy(header.fixups, fixups.data());
+  copy(header.payload, payload.data());
+  return true;
+}
+
+sk_sp<DisplayList> DisplayListSerialization::Deserialize(
+    const std::shared_ptr<const fml::Mapping>& mapping) {
+  TRACE_EVENT0("flutter", "DisplayListSerialization::Deserialize");
+  if (!mapping || !mapping->GetMapping()) {
+    return nullptr;
+  }
+  return DeserializeFrom(mapping, mapping->GetMapping(), mapping->GetSize());
+}
+
+sk_sp<DisplayList> DisplayListSerialization::DeserializeFrom(
+    const std::shared_ptr<const fml::Mapping>& mapping,
+    const uint8_t* data,
+    size_t size) {
+  SerializedHeader header;
+  if (size < sizeof(header)) {
+    return nullptr;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.layout_signature != kLayoutSignature ||
+      header.rtree_node_size != sizeof(DlRTree::Node) ||
+      !IsValidEnum(static_cast<DlBlendMode>(header.max_root_blend_mode),
+                   DlBlendMode::kLastMode)) {
+    return nullptr;
+  }
+  if (!IsValidSection(header.records, size) ||
+      !IsValidSection(header.offsets, size) ||
+      !IsValidSection(header.rtree_nodes, size) ||
+      !IsValidSection(header.fixups, size) ||
+      !IsValidSection(header.payload, size)) {
+    return nullptr;
+  }
+
+  // Record offsets must be in increasing order, aligned the same way that
+  // the |DisplayListBuilder| aligns them, and leave room for the record.
+  const size_t record_count = header.record_count;
+  const size_t records_size = header.records.size;
+  if (header.offsets.size != record_count * sizeof(size_t)) {
+    return nullptr;
+  }
+  std::vector<size_t> offsets(record_count);
+  if (record_count > 0u) {
+    memcpy(offsets.data(), data + header.offsets.offset, header.offsets.size);
+  }
+  for (size_t i = 0; i < record_count; i++) {
+    size_t record_end = (i + 1 < record_count) ? offsets[i + 1] : records_size;
+    if ((offsets[i] & (alignof(void*) - 1u)) != 0u ||
+        offsets[i] >= record_end || record_end > records_size ||
+        (i == 0u && offsets[i] != 0u)) {
+      return nullptr;
+    }
+  }
+
+  const size_t fixup_count = header.fixup_count;
+  if (header.fixups.size != fixup_count * sizeof(SerializedFixup)) {
+    return nullptr;
+  }
+  std::vector<SerializedFixup> fixups(fixup_count);
+  if (fixup_count > 0u) {
+    memcpy(fixups.data(), data + header.fixups.offset, header.fixups.size);
+  }
+
+  // Every record must either be a plain data record of a known type or be
+  // described by exactly one fixup, in order.
+  const uint8_t* records = data + header.records.offset;
+  size_t fixup_index = 0u;
+  for (size_t i = 0; i < record_count; i++) {
+    size_t record_size =
+        ((i + 1 < record_count) ? offsets[i + 1] : records_size) - offsets[i];
+    if (fixup_index < fixup_count &&
+        fixups[fixup_index].record_index == i) {
+      const SerializedFixup& fixup = fixups[fixup_index++];
+      if (fixup.op_type >= static_cast<uint32_t>(DisplayListOpType::kMaxOp)) {
+        return nullptr;
+      }
+      auto type = static_cast<DisplayListOpType>(fixup.op_type);
+      if (GetRecordEncoding(type) != RecordEncoding::kFixup ||
+          record_size < kOpRecordSizes[fixup.op_type] ||
+          fixup.payload_offset > header.payload.size ||
+          fixup.payload_size > header.payload.size - fixup.payload_offset) {
+        return nullptr;
+      }
+      continue;
+    }
+    auto op = reinterpret_cast<const DLOp*>(records + offsets[i]);
+    auto type_index = static_cast<uint32_t>(op->type);
+    if (type_index >= static_cast<uint32_t>(DisplayListOpType::kMaxOp) ||
+        GetRecordEncoding(op->type) != RecordEncoding::kVerbatim ||
+        record_size < kOpRecordSizes[type_index]) {
+      return nullptr;
+    }
+    switch (op->type) {
+      case DisplayListOpType::kDrawPoints:
+      case DisplayListOpType::kDrawLines:
+      case DisplayListOpType::kDrawPolygon: {
+        // All three point ops share the same layout.
+        auto points_op = static_cast<const DrawPointsOp*>(op);
+        if (points_op->count >
+            (record_size - sizeof(DrawPointsOp)) / sizeof(DlPoint)) {
+          return nullptr;
+        }
+        break;
+      }
+      case DisplayListOpType::kSave:
+      case DisplayListOpType::kSaveLayer: {
+        auto save_op = static_cast<const SaveOpBase*>(op);
+        if (save_op->restore_index <= i ||
+            save_op->restore_index >= record_count) {
+          return nullptr;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  if (fixup_index != fixup_count) {
+    return nullptr;
+  }
+
+  sk_sp<DlRTree> rtree;
+  if (header.flags & kHasRTree) {
+    const int leaf_count = header.rtree_leaf_count;
+    const size_t node_count = header.rtree_node_count;
+    if (header.rtree_nodes.size != node_count * sizeof(DlRTree::Node) ||
+        leaf_count < 0 || static_cast<size_t>(leaf_count) > node_count ||
+        (leaf_count == 0) != (node_count == 0u) ||
+        (node_count == 1u && leaf_count != 1)) {
+      return nullptr;
+    }
+    std::vector<DlRTree::Node> nodes(node_count);
+    if (node_count > 0u) {
+      memcpy(nodes.data(), data + header.rtree_nodes.offset,
+             header.rtree_nodes.size);
+    }
+    for (size_t i = 0; i < node_count; i++) {
+      const DlRTree::Node& node = nodes[i];
+      if (i < static_cast<size_t>(leaf_count)) {
+        if (node.id < 0 || static_cast<size_t>(node.id) >= record_count) {
+          return nullptr;
+        }
+      } else if (node.child.count == 0u || node.child.index >= i ||
+                 node.child.count > i - node.child.index) {
+        // Internal nodes only ever refer to nodes that precede them.
+        return nullptr;
+      }
+    }
+    rtree = sk_sp<DlRTree>(new DlRTree(std::move(nodes), leaf_count,
+                                       header.rtree_invalid_id));
+  }
+
+  DisplayListStorage storage;
+  if (fixup_count == 0u &&
+      reinterpret_cast<uintptr_t>(records) % alignof(std::max_align_t) == 0u) {
+    storage = DisplayListStorage(mapping, records, records_size);
+  } else if (records_size > 0u) {
+    memcpy(storage.allocate(records_size), records, records_size);
+    storage.trim();
+
+    const uint8_t* payload = data + header.payload.offset;
+    std::vector<size_t> reconstructed_offsets;
+    reconstructed_offsets.reserve(fixup_count);
+    for (const SerializedFixup& fixup : fixups) {
+      size_t index = fixup.record_index;
+      size_t record_end =
+          (index + 1 < record_count) ? offsets[index + 1] : records_size;
+      uint8_t* record = storage.base() + offsets[index];
+      if (!ReconstructRecord(mapping, record, record_end - offsets[index],
+                             static_cast<DisplayListOpType>(fixup.op_type),
+                             payload + fixup.payload_offset,
+                             fixup.payload_size)) {
+        DisplayList::DisposeOps(storage, reconstructed_offsets);
+        return nullptr;
+      }
+      reconstructed_offsets.push_back(offsets[index]);
+    }
+  }
+
+  return sk_sp<DisplayList>(new DisplayList(
+      std::move(storage), std::move(offsets), header.op_count,
+      header.nested_byte_count, header.nested_op_count, header.total_depth,
+      header.bounds, header.flags & kCanApplyGroupOpacity,
+      header.flags & kIsUIThreadSafe, header.flags & kModifiesTransparentBlack,
+      static_cast<DlBlendMode>(header.max_root_blend_mode),
+      header.flags & kRootHasBackdropFilter, header.flags & kRootIsUnbounded,
+      std::move(rtree)));
+}
+
+bool DisplayListSerialization::ReconstructRecord(
+    const std::shared_ptr<const fml::Mapping>& mapping,
+    uint8_t* record,
+    size_t record_size,
+    DisplayListOpType type,
+    const uint8_t* payload,
+    size_t payload_size) {
+  SerializationReader reader(payload, payload_size);
+
+  // Checks that the attribute object that follows an op record fits
+  // within the space that the builder reserved for the record.
+  auto fits = [record_size](size_t op_size, size_t attribute_size) {
+    return op_size + attribute_size <= record_size;
+  };
+
+  switch (type) {
+    case DisplayListOpType::kSetPodColorFilter: {
+      DlColorFilterType filter_type;
+      if (!reader.Read(&filter_type)) {
+        return false;
+      }
+      void* pod = record + sizeof(SetPodColorFilterOp);
+      switch (filter_type) {
+        case DlColorFilterType::kBlend: {
+          DlColor color;
+          DlBlendMode mode;
+          if (!reader.Read(&color) || !reader.Read(&mode) ||
+              !IsValidEnum(mode, DlBlendMode::kLastMode) ||
+              !fits(sizeof(SetPodColorFilterOp), sizeof(DlBlendColorFilter))) {
+            return false;
+          }
+          new (pod) DlBlendColorFilter(color, mode);
+          break;
+        }
+        case DlColorFilterType::kMatrix: {
+          float matrix[20];
+          if (!reader.Read(&matrix) ||
+              !fits(sizeof(SetPodColorFilterOp), sizeof(DlMatrixColorFilter))) {
+            return false;
+          }
+          new (pod) DlMatrixColorFilter(matrix);
+          break;
+        }
+        case DlColorFilterType::kSrgbToLinearGamma:
+          if (!fits(sizeof(SetPodColorFilterOp),
+                    sizeof(DlSrgbToLinearGammaColorFilter))) {
+            return false;
+          }
+          new (pod) DlSrgbToLinearGammaColorFilter();
+          break;
+        case DlColorFilterType::kLinearToSrgbGamma:
+          if (!fits(sizeof(SetPodColorFilterOp),
+                    sizeof(DlLinearToSrgbGammaColorFilter))) {
+            return false;
+          }
+          new (pod) DlLinearToSrgbGammaColorFilter();
+          break;
+        default:
+          return false;
+      }
+      new (record) SetPodColorFilterOp();
+      return reader.is_done();
+    }
+
+    case DisplayListOpType::kSetPodImageFilter: {
+      DlImageFilterType filter_type;
+      if (!reader.Read(&filter_type)) {
+        return false;
+      }
+      void* pod = record + sizeof(SetPodImageFilterOp);
+      switch (filter_type) {
+        case DlImageFilterType::kBlur: {
+          DlScalar sigma_x;
+          DlScalar sigma_y;
+          DlTileMode tile_mode;
+          uint32_t has_bounds;
+          DlRect bounds;
+          if (!reader.Read(&sigma_x) || !reader.Read(&sigma_y) ||
+              !reader.Read(&tile_mode) ||
+              !IsValidEnum(tile_mode, DlTileMode::kDecal) ||
+              !reader.Read(&has_bounds) || !reader.Read(&bounds) ||
+              !fits(sizeof(SetPodImageFilterOp), sizeof(DlBlurImageFilter))) {
+            return false;
+          }
+          new (pod) DlBlurImageFilter(
+              sigma_x, sigma_y, tile_mode,
+              has_bounds ? std::optional<DlRect>(bounds) : std::nullopt);
+          break;
+        }
+        case DlImageFilterType::kDilate: {
+          DlScalar radius_x;
+          DlScalar radius_y;
+          if (!reader.Read(&radius_x) || !reader.Read(&radius_y) ||
+              !fits(sizeof(SetPodImageFilterOp),
+                    sizeof(DlDilateImageFilter))) {
+            return false;
+          }
+          new (pod) DlDilateImageFilter(radius_x, radius_y);
+          break;
+        }
+        case DlImageFilterType::kErode: {
+          DlScalar radius_x;
+          DlScalar radius_y;
+          if (!reader.Read(&radius_x) || !reader.Read(&radius_y) ||
+              !fits(sizeof(SetPodImageFilterOp), sizeof(DlErodeImageFilter))) {
+            return false;
+          }
+          new (pod) DlErodeImageFilter(radius_x, radius_y);
+          break;
+        }
+        case DlImageFilterType::kMatrix: {
+          DlMatrix matrix;
+          DlImageSampling sampling;
+          if (!reader.Read(&matrix) || !reader.Read(&sampling) ||
+              !IsValidEnum(sampling, DlImageSampling::kCubic) ||
+              !fits(sizeof(SetPodImageFilterOp),
+                    sizeof(DlMatrixImageFilter))) {
+            return false;
+          }
+          new (pod) DlMatrixImageFilter(matrix, sampling);
+          break;
+        }
+        default:
+          return false;
+      }
+      new (record) SetPodImageFilterOp();
+      return reader.is_done();
+    }
+
+    case DisplayListOpType::kSetPodColorSource: {
+      DlColorSourceType source_type;
+      if (!reader.Read(&source_type)) {
+        return false;
+      }
+      void* pod = record + sizeof(SetPodColorSourceOp);
+      GradientData gradient;
+      switch (source_type) {
+        case DlColorSourceType::kLinearGradient: {
+          DlPoint start_point;
+          DlPoint end_point;
+          if (!reader.Read(&start_point) || !reader.Read(&end_point) ||
+              !ReadGradient(reader, &gradient)) {
+            return false;
+          }
+          auto source = DlColorSource::MakeLinear(
+              start_point, end_point, gradient.stop_count(),
+              gradient.colors.data(), gradient.stops.data(),
+              gradient.tile_mode, &gradient.matrix);
+          if (!source ||
+              !fits(sizeof(SetPodColorSourceOp), source->size())) {
+            return false;
+          }
+          new (pod) DlLinearGradientColorSource(source->asLinearGradient());
+          break;
+        }
+        case DlColorSourceType::kRadialGradient: {
+          DlPoint center;
+          DlScalar radius;
+          if (!reader.Read(&center) || !reader.Read(&radius) ||
+              !ReadGradient(reader, &gradient)) {
+            return false;
+          }
+          auto source = DlColorSource::MakeRadial(
+              center, radius, gradient.stop_count(), gradient.colors.data(),
+              gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+          if (!source ||
+              !fits(sizeof(SetPodColorSourceOp), source->size())) {
+            return false;
+          }
+          new (pod) DlRadialGradientColorSource(source->asRadialGradient());
+          break;
+        }
+        case DlColorSourceType::kConicalGradient: {
+          DlPoint start_center;
+          DlScalar start_radius;
+          DlPoint end_center;
+          DlScalar end_radius;
+          if (!reader.Read(&start_center) || !reader.Read(&start_radius) ||
+              !reader.Read(&end_center) || !reader.Read(&end_radius) ||
+              !ReadGradient(reader, &gradient)) {
+            return false;
+          }
+          auto source = DlColorSource::MakeConical(
+              start_center, start_radius, end_center, end_radius,
+              gradient.stop_count(), gradient.colors.data(),
+              gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+          if (!source ||
+              !fits(sizeof(SetPodColorSourceOp), source->size())) {
+            return false;
+          }
+          new (pod) DlConicalGradientColorSource(source->asConicalGradient());
+          break;
+        }
+        case DlColorSourceType::kSweepGradient: {
+          DlPoint center;
+          DlScalar start;
+          DlScalar end;
+          if (!reader.Read(&center) || !reader.Read(&start) ||
+              !reader.Read(&end) || !ReadGradient(reader, &gradient)) {
+            return false;
+          }
+          auto source = DlColorSource::MakeSweep(
+              center, start, end, gradient.stop_count(),
+              gradient.colors.data(), gradient.stops.data(),
+              gradient.tile_mode, &gradient.matrix);
+          if (!source ||
+              !fits(sizeof(SetPodColorSourceOp), source->size())) {
+            return false;
+          }
+          new (pod) DlSweepGradientColorSource(source->asSweepGradient());
+          break;
+        }
+        default:
+          return false;
+      }
+      new (record) SetPodColorSourceOp();
+      return reader.is_done();
+    }
+
+    case DisplayListOpType::kSetPodMaskFilter: {
+      DlBlurStyle style;
+      DlScalar sigma;
+      uint32_t respect_ctm;
+      if (!reader.Read(&style) || !IsValidEnum(style, DlBlurStyle::kInner) ||
+          !reader.Read(&sigma) || !reader.Read(&respect_ctm) ||
+          !fits(sizeof(SetPodMaskFilterOp), sizeof(DlBlurMaskFilter))) {
+        return false;
+      }
+      new (record + sizeof(SetPodMaskFilterOp))
+          DlBlurMaskFilter(style, sigma, respect_ctm != 0u);
+      new (record) SetPodMaskFilterOp();
+      return reader.is_done();
+    }
+
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferencePath: {
+      uint32_t is_aa;
+      DlPath path;
+      if (!reader.Read(&is_aa) || !ReadPath(reader, &path) ||
+          !reader.is_done()) {
+        return false;
+      }
+      if (type == DisplayListOpType::kClipIntersectPath) {
+        new (record) ClipIntersectPathOp(path, is_aa != 0u);
+      } else {
+        new (record) ClipDifferencePathOp(path, is_aa != 0u);
+      }
+      return true;
+    }
+
+    case DisplayListOpType::kDrawPath: {
+      DlPath path;
+      if (!ReadPath(reader, &path) || !reader.is_done()) {
+        return false;
+      }
+      new (record) DrawPathOp(path);
+      return true;
+    }
+
+    case DisplayListOpType::kDrawShadow:
+    case DisplayListOpType::kDrawShadowTransparentOccluder: {
+      DlColor color;
+      DlScalar elevation;
+      DlScalar dpr;
+      DlPath path;
+      if (!reader.Read(&color) || !reader.Read(&elevation) ||
+          !reader.Read(&dpr) || !ReadPath(reader, &path) ||
+          !reader.is_done()) {
+        return false;
+      }
+      if (type == DisplayListOpType::kDrawShadow) {
+        new (record) DrawShadowOp(path, color, elevation, dpr);
+      } else {
+        new (record)
+            DrawShadowTransparentOccluderOp(path, color, elevation, dpr);
+      }
+      return true;
+    }
+
+    case DisplayListOpType::kDrawVertices: {
+      DlBlendMode mode;
+      if (!reader.Read(&mode) || !IsValidEnum(mode, DlBlendMode::kLastMode)) {
+        return false;
+      }
+      std::shared_ptr<DlVertices> vertices = ReadVertices(reader);
+      if (!vertices || !reader.is_done()) {
+        return false;
+      }
+      new (record) DrawVerticesOp(vertices, mode);
+      return true;
+    }
+
+    case DisplayListOpType::kDrawDisplayList: {
+      DlScalar opacity;
+      if (!reader.Read(&opacity) || !reader.Align()) {
+        return false;
+      }
+      size_t nested_size = payload_size - AlignSize(sizeof(opacity));
+      const uint8_t* nested_data = reader.ReadBytes(nested_size);
+      if (!nested_data) {
+        return false;
+      }
+      sk_sp<DisplayList> nested =
+          DeserializeFrom(mapping, nested_data, nested_size);
+      if (!nested) {
+        return false;
+      }
+      new (record) DrawDisplayListOp(nested, opacity);
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+/// @brief   Utilities to convert a |DisplayList| to and from a flat,
+///          versioned binary form that can be cached on disk and loaded
+///          back by mapping the file into memory.
+///
+/// The serialized form stores the op records in exactly the layout that
+/// |DisplayListStorage| uses in memory, along with the record offsets, the
+/// nodes of the |DlRTree| (if any) and the summary properties computed by
+/// the |DisplayListBuilder|. Loading a serialized DisplayList never runs
+/// the builder again.
+///
+/// Most records (attributes, transforms, clips and simple geometry) are
+/// plain data and are dispatched directly from the bytes of the mapping
+/// when a DisplayList consists entirely of such records. Records that
+/// reference heap objects (paths, vertices, the attribute objects that
+/// are embedded in the op buffer, and nested DisplayLists) are written
+/// to a side table in a portable form and are reconstructed in place in
+/// a private copy of the op buffer when the DisplayList is loaded.
+///
+/// DisplayLists that refer to images, text, runtime effects or image
+/// filters that are not stored inline in the op buffer cannot be
+/// serialized and |Serialize| will return nullptr for them.
+///
+/// The format depends on the in-memory layout of the op records and is
+/// only intended to be read back by the same build of the engine that
+/// wrote it. Data written by a different build, or data that fails any
+/// of the structural checks performed while loading, is rejected.
+class DisplayListSerialization {
+ public:
+  static constexpr uint32_t kMagic = 0x464c5344;  // 'DSLF'
+  static constexpr uint32_t kVersion = 1u;
+
+  /// @brief   Returns true if every record in the DisplayList, and in any
+  ///          DisplayLists nested within it, can be serialized.
+  static bool CanSerialize(const DisplayList& display_list);
+
+  /// @brief   Returns a mapping holding the serialized form of the
+  ///          DisplayList, or nullptr if it contains any records that
+  ///          cannot be serialized.
+  ///
+  /// @see |CanSerialize|
+  static std::unique_ptr<fml::Mapping> Serialize(
+      const DisplayList& display_list);
+
+  /// @brief   Returns a hash of the serialized form of the DisplayList, or
+  ///          std::nullopt if it cannot be serialized.
+  ///
+  /// Unlike |DisplayList::unique_id|, the hash is the same for DisplayLists
+  /// with the same content that were recorded in different runs of the
+  /// same build of the engine, so it can identify data derived from the
+  /// content, such as rasterized images, that is cached on disk.
+  ///
+  /// @see |CanSerialize|
+  static std::optional<uint64_t> ContentHash(const DisplayList& display_list);
+
+  /// @brief   Returns a DisplayList that renders the same content as the
+  ///          one that was serialized into the mapping, or nullptr if the
+  ///          mapping does not hold a valid serialized DisplayList written
+  ///          by this build of the engine.
+  ///
+  /// When possible, the returned DisplayList refers to the op records
+  /// stored in the mapping without copying them and holds a reference to
+  /// the mapping for as long as it lives.
+  static sk_sp<DisplayList> Deserialize(
+      const std::shared_ptr<const fml::Mapping>& mapping);
+
+  /// @brief   Returns true if the DisplayList dispatches its records
+  ///          directly from the bytes of a mapping.
+  static bool IsMapped(const DisplayList& display_list) {
+    return display_list.GetStorage().is_mapped();
+  }
+
+ private:
+  static bool SerializeTo(const DisplayList& display_list,
+                          std::vector<uint8_t>& buffer);
+
+  static sk_sp<DisplayList> DeserializeFrom(
+      const std::shared_ptr<const fml::Mapping>& mapping,
+      const uint8_t* data,
+      size_t size);
+
+  static bool ReconstructRecord(
+      const std::shared_ptr<const fml::Mapping>& mapping,
+      uint8_t* record,
+      size_t record_size,
+      DisplayListOpType type,
+      const uint8_t* payload,
+      size_t payload_size);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
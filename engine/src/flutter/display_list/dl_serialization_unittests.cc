@@ -0,0 +1,293 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+
+// Defined in display_list_unittests.cc
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+namespace {
+
+class VerticesCapturingReceiver : public IgnoreAttributeDispatchHelper,
+                                  public IgnoreTransformDispatchHelper,
+                                  public IgnoreClipDispatchHelper,
+                                  public IgnoreDrawDispatchHelper {
+ public:
+  void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                    DlBlendMode mode) override {
+    vertices_.push_back(vertices);
+  }
+
+  const std::vector<std::shared_ptr<DlVertices>>& vertices() const {
+    return vertices_;
+  }
+
+ private:
+  std::vector<std::shared_ptr<DlVertices>> vertices_;
+};
+
+sk_sp<DisplayList> RoundTrip(const sk_sp<DisplayList>& display_list) {
+  std::shared_ptr<const fml::Mapping> mapping =
+      DisplayListSerialization::Serialize(*display_list);
+  if (!mapping) {
+    return nullptr;
+  }
+  return DisplayListSerialization::Deserialize(mapping);
+}
+
+sk_sp<DisplayList> MakePlainDataDisplayList() {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint paint;
+  for (int i = 0; i < 10; i++) {
+    paint.setColor(DlColor(0xFF000000 | (i * 0x102030)));
+    builder.Save();
+    builder.Translate(i * 30.0f, i * 10.0f);
+    builder.ClipRect(DlRect::MakeWH(25, 25));
+    builder.DrawRect(DlRect::MakeLTRB(2, 2, 20, 20), paint);
+    builder.DrawCircle(DlPoint(10, 10), 5, paint);
+    builder.Restore();
+  }
+  builder.SaveLayer(std::nullopt, nullptr);
+  builder.DrawRoundRect(kTestRRect, paint);
+  builder.Restore();
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST(DisplayListSerialization, PlainDataRoundTripIsMapped) {
+  sk_sp<DisplayList> display_list = MakePlainDataDisplayList();
+  ASSERT_TRUE(DisplayListSerialization::CanSerialize(*display_list));
+
+  sk_sp<DisplayList> loaded = RoundTrip(display_list);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(DisplayListSerialization::IsMapped(*loaded));
+  EXPECT_FALSE(DisplayListSerialization::IsMapped(*display_list));
+
+  EXPECT_TRUE(loaded->Equals(display_list));
+  EXPECT_EQ(loaded->GetBounds(), display_list->GetBounds());
+  EXPECT_EQ(loaded->op_count(), display_list->op_count());
+  EXPECT_EQ(loaded->op_count(true), display_list->op_count(true));
+  EXPECT_EQ(loaded->total_depth(), display_list->total_depth());
+  EXPECT_EQ(loaded->GetRecordCount(), display_list->GetRecordCount());
+  EXPECT_EQ(loaded->can_apply_group_opacity(),
+            display_list->can_apply_group_opacity());
+  EXPECT_EQ(loaded->isUIThreadSafe(), display_list->isUIThreadSafe());
+
+  ASSERT_TRUE(loaded->has_rtree());
+  DlRect cull_rect = DlRect::MakeLTRB(40, 0, 100, 40);
+  EXPECT_EQ(loaded->GetCulledIndices(cull_rect),
+            display_list->GetCulledIndices(cull_rect));
+  EXPECT_EQ(loaded->rtree()->search(cull_rect),
+            display_list->rtree()->search(cull_rect));
+}
+
+TEST(DisplayListSerialization, MixedContentRoundTrip) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint paint;
+  paint.setColorSource(kTestSource2);
+  builder.DrawPath(kTestPath1, paint);
+  paint.setColorSource(kTestSource3);
+  paint.setMaskFilter(&kTestMaskFilter1);
+  builder.DrawRect(kTestBounds, paint);
+  paint.setColorSource(kTestSource4);
+  paint.setMaskFilter(nullptr);
+  paint.setColorFilter(kTestMatrixColorFilter1);
+  builder.DrawOval(kTestBounds, paint);
+  paint.setColorSource(kTestSource5);
+  paint.setColorFilter(kTestBlendColorFilter1);
+  paint.setImageFilter(&kTestBlurImageFilter1);
+  builder.DrawCircle(DlPoint(20, 20), 10, paint);
+  builder.ClipPath(kTestPath2, DlClipOp::kIntersect, true);
+  builder.DrawShadow(kTestPath3, DlColor::kBlue(), 3.0f, false, 1.0f);
+  builder.DrawShadow(kTestPath3, DlColor::kRed(), 5.0f, true, 2.0f);
+  builder.DrawDisplayList(TestDisplayList1, 0.5f);
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_TRUE(DisplayListSerialization::CanSerialize(*display_list));
+
+  sk_sp<DisplayList> loaded = RoundTrip(display_list);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_FALSE(DisplayListSerialization::IsMapped(*loaded));
+  EXPECT_TRUE(loaded->Equals(display_list));
+  EXPECT_EQ(loaded->GetBounds(), display_list->GetBounds());
+  EXPECT_EQ(loaded->op_count(true), display_list->op_count(true));
+  EXPECT_EQ(loaded->total_depth(), display_list->total_depth());
+}
+
+TEST(DisplayListSerialization, VerticesRoundTrip) {
+  DisplayListBuilder builder;
+  builder.DrawVertices(kTestVertices1, DlBlendMode::kSrcOver, DlPaint());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  sk_sp<DisplayList> loaded = RoundTrip(display_list);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->GetBounds(), display_list->GetBounds());
+
+  // DrawVertices records compare their vertices by identity, so the
+  // loaded vertices are compared by value here instead.
+  VerticesCapturingReceiver receiver;
+  loaded->Dispatch(receiver);
+  ASSERT_EQ(receiver.vertices().size(), 1u);
+  ASSERT_NE(receiver.vertices()[0], nullptr);
+  EXPECT_NE(receiver.vertices()[0], kTestVertices1);
+  EXPECT_TRUE(*receiver.vertices()[0] == *kTestVertices1);
+}
+
+TEST(DisplayListSerialization, EmptyDisplayListRoundTrip) {
+  sk_sp<DisplayList> display_list = DisplayListBuilder().Build();
+
+  sk_sp<DisplayList> loaded = RoundTrip(display_list);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(loaded->Equals(display_list));
+  EXPECT_EQ(loaded->GetRecordCount(), 0u);
+}
+
+TEST(DisplayListSerialization, ImagesAreNotSupported) {
+  DisplayListBuilder builder;
+  builder.DrawRect(kTestBounds, DlPaint());
+  builder.DrawImage(kTestImage1, DlPoint(10, 10), DlImageSampling::kLinear);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_FALSE(DisplayListSerialization::CanSerialize(*display_list));
+  EXPECT_EQ(DisplayListSerialization::Serialize(*display_list), nullptr);
+}
+
+TEST(DisplayListSerialization, NestedImagesAreNotSupported) {
+  DisplayListBuilder nested_builder;
+  nested_builder.DrawImage(kTestImage1, DlPoint(10, 10),
+                           DlImageSampling::kLinear);
+  DisplayListBuilder builder;
+  builder.DrawDisplayList(nested_builder.Build());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_FALSE(DisplayListSerialization::CanSerialize(*display_list));
+  EXPECT_EQ(DisplayListSerialization::Serialize(*display_list), nullptr);
+}
+
+TEST(DisplayListSerialization, ContentHashDependsOnlyOnContent) {
+  sk_sp<DisplayList> display_list = MakePlainDataDisplayList();
+  sk_sp<DisplayList> same_content = MakePlainDataDisplayList();
+  ASSERT_NE(display_list->unique_id(), same_content->unique_id());
+
+  std::optional<uint64_t> hash =
+      DisplayListSerialization::ContentHash(*display_list);
+  ASSERT_TRUE(hash.has_value());
+  EXPECT_EQ(hash, DisplayListSerialization::ContentHash(*same_content));
+
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawDisplayList(MakePlainDataDisplayList());
+  builder.DrawPath(kTestPath1, DlPaint());
+  sk_sp<DisplayList> nested = builder.Build();
+  std::optional<uint64_t> nested_hash =
+      DisplayListSerialization::ContentHash(*nested);
+  ASSERT_TRUE(nested_hash.has_value());
+  EXPECT_NE(nested_hash, hash);
+
+  DisplayListBuilder other_builder(/*prepare_rtree=*/true);
+  other_builder.DrawDisplayList(MakePlainDataDisplayList());
+  other_builder.DrawPath(kTestPath2, DlPaint());
+  EXPECT_NE(DisplayListSerialization::ContentHash(*other_builder.Build()),
+            nested_hash);
+}
+
+TEST(DisplayListSerialization, ContentHashOfImagesIsNotSupported) {
+  DisplayListBuilder builder;
+  builder.DrawImage(kTestImage1, DlPoint(10, 10), DlImageSampling::kLinear);
+  EXPECT_FALSE(DisplayListSerialization::ContentHash(*builder.Build()));
+}
+
+TEST(DisplayListSerialization, RejectsInvalidData) {
+  std::unique_ptr<fml::Mapping> serialized =
+      DisplayListSerialization::Serialize(*MakePlainDataDisplayList());
+  ASSERT_NE(serialized, nullptr);
+  std::vector<uint8_t> bytes(serialized->GetMapping(),
+                             serialized->GetMapping() + serialized->GetSize());
+
+  EXPECT_EQ(DisplayListSerialization::Deserialize(nullptr), nullptr);
+  EXPECT_EQ(DisplayListSerialization::Deserialize(
+                std::make_shared<fml::DataMapping>(std::vector<uint8_t>())),
+            nullptr);
+
+  std::vector<uint8_t> bad_magic = bytes;
+  bad_magic[0] ^= 0xFF;
+  EXPECT_EQ(DisplayListSerialization::Deserialize(
+                std::make_shared<fml::DataMapping>(bad_magic)),
+            nullptr);
+
+  std::vector<uint8_t> bad_version = bytes;
+  bad_version[sizeof(uint32_t)] ^= 0xFF;
+  EXPECT_EQ(DisplayListSerialization::Deserialize(
+                std::make_shared<fml::DataMapping>(bad_version)),
+            nullptr);
+
+  std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 16);
+  EXPECT_EQ(DisplayListSerialization::Deserialize(
+                std::make_shared<fml::DataMapping>(truncated)),
+            nullptr);
+
+  EXPECT_NE(DisplayListSerialization::Deserialize(
+                std::make_shared<fml::DataMapping>(bytes)),
+            nullptr);
+}
+
+TEST(DisplayListSerialization, FileRoundTripIsMapped) {
+  sk_sp<DisplayList> display_list = MakePlainDataDisplayList();
+  std::unique_ptr<fml::Mapping> serialized =
+      DisplayListSerialization::Serialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(
+      fml::WriteAtomically(temp_dir.fd(), "display_list.bin", *serialized));
+  std::shared_ptr<const fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(temp_dir.fd(), "display_list.bin");
+  ASSERT_NE(mapping, nullptr);
+
+  sk_sp<DisplayList> loaded = DisplayListSerialization::Deserialize(mapping);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(DisplayListSerialization::IsMapped(*loaded));
+  EXPECT_TRUE(loaded->Equals(display_list));
+
+  // The DisplayList keeps the mapping alive on its own.
+  mapping.reset();
+  EXPECT_TRUE(loaded->Equals(display_list));
+}
+
+TEST(DisplayListSerialization, RoundTripsAllSerializableOps) {
+  for (auto& group : CreateAllGroups()) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      auto& invocation = group.variants[i];
+      DisplayListBuilder builder;
+      invocation.Invoke(DisplayListBuilderTestingAccessor(builder));
+      sk_sp<DisplayList> display_list = builder.Build();
+      if (!DisplayListSerialization::CanSerialize(*display_list)) {
+        continue;
+      }
+      sk_sp<DisplayList> loaded = RoundTrip(display_list);
+      ASSERT_NE(loaded, nullptr) << group.op_name << "(variant " << i << ")";
+      EXPECT_EQ(loaded->GetRecordCount(), display_list->GetRecordCount())
+          << group.op_name << "(variant " << i << ")";
+      EXPECT_EQ(loaded->GetBounds(), display_list->GetBounds())
+          << group.op_name << "(variant " << i << ")";
+      if (group.op_name != "DrawVertices") {
+        EXPECT_TRUE(loaded->Equals(display_list))
+            << group.op_name << "(variant " << i << ")";
+      }
+    }
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
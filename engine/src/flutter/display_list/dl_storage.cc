@@ -4,6 +4,9 @@
 
 #include "flutter/display_list/dl_storage.h"
 
+#include "flutter/display_list/dl_storage_pool.h"
+#include "flutter/fml/mapping.h"
+
 namespace flutter {
 
 static constexpr inline bool is_power_of_two(int value) {
@@ -31,12 +34,46 @@ size_t DisplayListStorage::NextPowerOfTwoSize(size_t x) {
 }
 
 void DisplayListStorage::realloc(size_t count) {
+  FML_DCHECK(!is_mapped());
+  if (is_pooled()) {
+    FML_DCHECK(count >= used_);
+    size_t capacity;
+    uint8_t* buffer = pool_->Acquire(count, capacity);
+    if (used_ > 0u) {
+      memcpy(buffer, ptr_.get(), used_);
+    }
+    // Buffers drawn from the pool may hold the records of an older
+    // DisplayList, the unused space is cleared the same way that the
+    // newly allocated space is cleared below.
+    memset(buffer + used_, 0, capacity - used_);
+    pool_->Recycle(ptr_.release(), allocated_);
+    ptr_.reset(buffer);
+    allocated_ = capacity;
+    return;
+  }
   ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
   FML_CHECK(ptr_);
   allocated_ = count;
 }
 
+void DisplayListStorage::trim() {
+  if (is_pooled()) {
+    size_t unused = allocated_ - used_;
+    if (unused <= std::max(kDLPageSize, used_ / 4u)) {
+      return;
+    }
+    // The buffer is malloc allocated and returned to the pool with its new
+    // size when the storage is released.
+    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), used_)));
+    FML_CHECK(ptr_);
+    allocated_ = used_;
+    return;
+  }
+  realloc(used_);
+}
+
 uint8_t* DisplayListStorage::allocate(size_t needed) {
+  FML_DCHECK(!is_mapped());
   if (used_ + needed > allocated_) {
     static_assert(is_power_of_two(kDLPageSize),
                   "This math needs updating for non-pow2.");
@@ -46,10 +83,12 @@ uint8_t* DisplayListStorage::allocate(size_t needed) {
     size_t old_size = allocated_;
     realloc(new_size);
     FML_CHECK(ptr_.get());
-    FML_CHECK(allocated_ == new_size);
+    FML_CHECK(allocated_ >= new_size);
     FML_CHECK(allocated_ >= old_size);
     FML_CHECK(used_ + needed <= allocated_);
-    memset(ptr_.get() + used_, 0, allocated_ - old_size);
+    if (!is_pooled()) {
+      memset(ptr_.get() + used_, 0, allocated_ - old_size);
+    }
   }
   uint8_t* ret = ptr_.get() + used_;
   used_ += needed;
@@ -57,24 +96,64 @@ uint8_t* DisplayListStorage::allocate(size_t needed) {
   return ret;
 }
 
+DisplayListStorage::DisplayListStorage(
+    std::shared_ptr<const fml::Mapping> mapping,
+    const uint8_t* base,
+    size_t size)
+    : mapping_(std::move(mapping)),
+      mapped_base_(base),
+      used_(size),
+      allocated_(size) {
+  FML_CHECK(mapping_);
+  FML_DCHECK(base >= mapping_->GetMapping());
+  FML_DCHECK(base + size <= mapping_->GetMapping() + mapping_->GetSize());
+}
+
+DisplayListStorage::DisplayListStorage(
+    std::shared_ptr<DisplayListStoragePool> pool)
+    : pool_(std::move(pool)) {}
+
+DisplayListStorage::~DisplayListStorage() {
+  ReleaseBuffer();
+}
+
+void DisplayListStorage::ReleaseBuffer() {
+  if (is_pooled()) {
+    pool_->Recycle(ptr_.release(), allocated_);
+  } else {
+    ptr_.reset();
+  }
+}
+
 DisplayListStorage::DisplayListStorage(DisplayListStorage&& source) {
   ptr_ = std::move(source.ptr_);
+  mapping_ = std::move(source.mapping_);
+  mapped_base_ = source.mapped_base_;
+  pool_ = std::move(source.pool_);
   used_ = source.used_;
   allocated_ = source.allocated_;
+  source.mapped_base_ = nullptr;
   source.used_ = 0u;
   source.allocated_ = 0u;
 }
 
 void DisplayListStorage::reset() {
-  ptr_.reset();
+  ReleaseBuffer();
+  mapping_.reset();
+  mapped_base_ = nullptr;
   used_ = 0u;
   allocated_ = 0u;
 }
 
 DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& source) {
+  ReleaseBuffer();
   ptr_ = std::move(source.ptr_);
+  mapping_ = std::move(source.mapping_);
+  mapped_base_ = source.mapped_base_;
+  pool_ = std::move(source.pool_);
   used_ = source.used_;
   allocated_ = source.allocated_;
+  source.mapped_base_ = nullptr;
   source.used_ = 0u;
   source.allocated_ = 0u;
   return *this;
@@ -10,9 +10,18 @@
 
 #include "flutter/fml/logging.h"
 
+namespace fml {
+class Mapping;
+}  // namespace fml
+
 namespace flutter {
 
-// Manages a buffer allocated with malloc.
+class DisplayListStoragePool;
+
+// Manages a buffer allocated with malloc or drawn from a
+// |DisplayListStoragePool|, or a read-only range of bytes within an
+// |fml::Mapping| that was previously written by the
+// |DisplayListSerialization| utilities.
 class DisplayListStorage {
  public:
   static const constexpr size_t kDLPageSize = 4096u;
@@ -20,9 +29,42 @@ class DisplayListStorage {
   DisplayListStorage() = default;
   DisplayListStorage(DisplayListStorage&&);
 
+  /// Constructs an empty storage object that draws its buffers from the
+  /// indicated pool and returns them to it when they are no longer needed.
+  /// A null pool results in the same behavior as the default constructor.
+  explicit DisplayListStorage(std::shared_ptr<DisplayListStoragePool> pool);
+
+  ~DisplayListStorage();
+
+  /// Constructs a read-only storage object that refers to the indicated
+  /// range of bytes within the mapping rather than copying them. The
+  /// storage holds a reference to the mapping for as long as it lives.
+  ///
+  /// Storage constructed in this manner can not be used to allocate
+  /// more space.
+  DisplayListStorage(std::shared_ptr<const fml::Mapping> mapping,
+                     const uint8_t* base,
+                     size_t size);
+
   /// Returns a pointer to the base of the storage.
-  uint8_t* base() { return ptr_.get(); }
-  const uint8_t* base() const { return ptr_.get(); }
+  uint8_t* base() {
+    FML_DCHECK(!is_mapped());
+    return ptr_.get();
+  }
+  const uint8_t* base() const {
+    return is_mapped() ? mapped_base_ : ptr_.get();
+  }
+
+  /// Returns true if the storage refers to the bytes of an |fml::Mapping|
+  /// rather than to its own malloc allocated buffer.
+  bool is_mapped() const { return mapping_ != nullptr; }
+
+  /// Returns true if the buffer of the storage is drawn from a
+  /// |DisplayListStoragePool|.
+  bool is_pooled() const { return pool_ != nullptr; }
+
+  /// Returns the pool that the buffer of the storage is drawn from, if any.
+  const std::shared_ptr<DisplayListStoragePool>& pool() const { return pool_; }
 
   /// Returns the currently allocated size
   size_t size() const { return used_; }
@@ -37,7 +79,12 @@ class DisplayListStorage {
 
   /// Trims the storage to the currently allocated size and invalidates
   /// any outstanding pointers into the storage.
-  void trim() { realloc(used_); }
+  ///
+  /// Pooled storage keeps the size it was drawn from the pool with, so that
+  /// its buffer can be reused for a DisplayList of a similar size, unless
+  /// more than |kDLPageSize| bytes and more than a quarter of the used size
+  /// would be left unused.
+  void trim();
 
   /// Resets the storage and allocation of the object to an empty state
   void reset();
@@ -49,12 +96,18 @@ class DisplayListStorage {
 
  private:
   void realloc(size_t count);
+  void ReleaseBuffer();
 
   struct FreeDeleter {
     void operator()(uint8_t* p) { std::free(p); }
   };
   std::unique_ptr<uint8_t, FreeDeleter> ptr_;
 
+  std::shared_ptr<const fml::Mapping> mapping_;
+  const uint8_t* mapped_base_ = nullptr;
+
+  std::shared_ptr<DisplayListStoragePool> pool_;
+
   size_t used_ = 0u;
   size_t allocated_ = 0u;
 };
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_storage_pool.h"
+
+#include <cstdlib>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+static thread_local std::shared_ptr<DisplayListStoragePool> tls_storage_pool;
+
+std::shared_ptr<DisplayListStoragePool> DisplayListStoragePool::Create(
+    size_t max_pooled_bytes) {
+  return std::shared_ptr<DisplayListStoragePool>(
+      new DisplayListStoragePool(max_pooled_bytes));
+}
+
+const std::shared_ptr<DisplayListStoragePool>&
+DisplayListStoragePool::GetForCurrentThread() {
+  return tls_storage_pool;
+}
+
+void DisplayListStoragePool::SetForCurrentThread(
+    std::shared_ptr<DisplayListStoragePool> pool) {
+  tls_storage_pool = std::move(pool);
+}
+
+DisplayListStoragePool::DisplayListStoragePool(size_t max_pooled_bytes)
+    : max_pooled_bytes_(max_pooled_bytes) {}
+
+DisplayListStoragePool::~DisplayListStoragePool() {
+  Clear();
+}
+
+DisplayListStoragePool::Stats DisplayListStoragePool::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void DisplayListStoragePool::Clear() {
+  std::scoped_lock lock(mutex_);
+  for (auto& [size, buffer] : free_buffers_) {
+    std::free(buffer);
+  }
+  free_buffers_.clear();
+  stats_.pooled_bytes = 0u;
+}
+
+uint8_t* DisplayListStoragePool::Acquire(size_t min_size, size_t& capacity) {
+  {
+    std::scoped_lock lock(mutex_);
+    // Buffers are only reused for requests of a similar size so that a
+    // large buffer is not held by a DisplayList that only needs a fraction
+    // of it.
+    auto it = free_buffers_.lower_bound(min_size);
+    if (it != free_buffers_.end() && it->first <= min_size * 2) {
+      capacity = it->first;
+      uint8_t* buffer = it->second;
+      free_buffers_.erase(it);
+      stats_.pooled_bytes -= capacity;
+      stats_.reused_bytes += capacity;
+      return buffer;
+    }
+    stats_.allocated_bytes += min_size;
+  }
+  capacity = min_size;
+  auto buffer = static_cast<uint8_t*>(std::malloc(min_size));
+  FML_CHECK(buffer);
+  return buffer;
+}
+
+void DisplayListStoragePool::Recycle(uint8_t* buffer, size_t capacity) {
+  if (!buffer) {
+    return;
+  }
+  if (capacity <= kMaxPooledBufferSize) {
+    std::scoped_lock lock(mutex_);
+    if (stats_.pooled_bytes + capacity <= max_pooled_bytes_) {
+      free_buffers_.emplace(capacity, buffer);
+      stats_.pooled_bytes += capacity;
+      return;
+    }
+  }
+  std::free(buffer);
+}
+
+}  // namespace flutter
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_STORAGE_POOL_H_
+#define FLUTTER_DISPLAY_LIST_DL_STORAGE_POOL_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+/// @brief   A pool of buffers that |DisplayListStorage| objects draw their
+///          memory from and return it to when they are destroyed, so that
+///          the op buffers of the DisplayLists recorded for one frame can
+///          be reused by the DisplayListBuilders of the following frames.
+///
+/// A pool is typically installed for the UI thread with
+/// |SetForCurrentThread| and every |DisplayListBuilder| constructed on that
+/// thread then uses it. Buffers may be returned to the pool from any thread
+/// since the DisplayLists that own them are often released on the raster
+/// thread.
+///
+/// Storage drawn from a pool keeps its power of two capacity when the
+/// DisplayList is built, so that the buffer can be reused for a DisplayList
+/// of a similar size when it is returned, as long as that leaves little
+/// unused memory in the DisplayLists that are retained for many frames.
+/// See |DisplayListStorage::trim|.
+class DisplayListStoragePool {
+ public:
+  /// The default maximum number of bytes held by a pool in its free list.
+  static constexpr size_t kDefaultMaxPooledBytes = 16u * 1024u * 1024u;
+
+  /// The largest buffer that will be kept in the free list of a pool.
+  static constexpr size_t kMaxPooledBufferSize = 2u * 1024u * 1024u;
+
+  struct Stats {
+    /// The total number of bytes of the buffers handed out by the pool
+    /// that were reused from its free list.
+    size_t reused_bytes = 0u;
+
+    /// The total number of bytes of the buffers handed out by the pool
+    /// that were freshly allocated.
+    size_t allocated_bytes = 0u;
+
+    /// The number of bytes currently held in the free list of the pool.
+    size_t pooled_bytes = 0u;
+  };
+
+  static std::shared_ptr<DisplayListStoragePool> Create(
+      size_t max_pooled_bytes = kDefaultMaxPooledBytes);
+
+  /// @brief   Returns the pool that |DisplayListBuilder| objects constructed
+  ///          on the current thread draw their storage from, or nullptr.
+  static const std::shared_ptr<DisplayListStoragePool>& GetForCurrentThread();
+
+  /// @brief   Sets the pool that |DisplayListBuilder| objects constructed
+  ///          on the current thread draw their storage from.
+  static void SetForCurrentThread(std::shared_ptr<DisplayListStoragePool> pool);
+
+  ~DisplayListStoragePool();
+
+  Stats GetStats() const;
+
+  /// @brief   Frees all buffers held in the free list of the pool. Buffers
+  ///          that are in use are not affected and will be returned to the
+  ///          pool as usual.
+  void Clear();
+
+ private:
+  friend class DisplayListStorage;
+
+  explicit DisplayListStoragePool(size_t max_pooled_bytes);
+
+  /// Returns a buffer of at least |min_size| bytes, either from the free
+  /// list or freshly allocated, and stores its actual size in |capacity|.
+  uint8_t* Acquire(size_t min_size, size_t& capacity);
+
+  /// Returns a buffer that was previously acquired from the pool.
+  void Recycle(uint8_t* buffer, size_t capacity);
+
+  const size_t max_pooled_bytes_;
+
+  mutable std::mutex mutex_;
+  std::multimap<size_t, uint8_t*> free_buffers_;
+  Stats stats_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStoragePool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_STORAGE_POOL_H_
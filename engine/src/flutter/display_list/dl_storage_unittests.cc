@@ -4,6 +4,12 @@
 
 #include "flutter/display_list/dl_storage.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_storage_pool.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/testing/testing.h"
 
 namespace flutter {
@@ -43,6 +49,158 @@ TEST(DisplayListStorage, PostMove) {
   EXPECT_EQ(moved.capacity(), DisplayListStorage::kDLPageSize);
 }
 
+TEST(DisplayListStorage, Mapped) {
+  auto mapping =
+      std::make_shared<fml::DataMapping>(std::vector<uint8_t>(64u, 0x5a));
+  const uint8_t* bytes = mapping->GetMapping();
+  DisplayListStorage storage(mapping, bytes + 16u, 32u);
+  EXPECT_TRUE(storage.is_mapped());
+  EXPECT_EQ(std::as_const(storage).base(), bytes + 16u);
+  EXPECT_EQ(storage.size(), 32u);
+
+  // The storage keeps the mapping alive.
+  std::weak_ptr<fml::DataMapping> weak_mapping = mapping;
+  mapping.reset();
+  EXPECT_FALSE(weak_mapping.expired());
+
+  DisplayListStorage moved = std::move(storage);
+  EXPECT_TRUE(moved.is_mapped());
+  EXPECT_EQ(std::as_const(moved).base(), bytes + 16u);
+  EXPECT_EQ(moved.size(), 32u);
+  EXPECT_EQ(std::as_const(moved).base()[0], 0x5a);
+
+  moved.reset();
+  EXPECT_FALSE(moved.is_mapped());
+  EXPECT_TRUE(weak_mapping.expired());
+}
+
+TEST(DisplayListStorage, PooledBuffersAreRecycled) {
+  auto pool = DisplayListStoragePool::Create();
+  uint8_t* first_base;
+  {
+    DisplayListStorage storage(pool);
+    EXPECT_TRUE(storage.is_pooled());
+    EXPECT_NE(storage.allocate(10u), nullptr);
+    EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize);
+    first_base = storage.base();
+    storage.trim();
+    EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize);
+  }
+  EXPECT_EQ(pool->GetStats().allocated_bytes, DisplayListStorage::kDLPageSize);
+  EXPECT_EQ(pool->GetStats().pooled_bytes, DisplayListStorage::kDLPageSize);
+
+  DisplayListStorage storage(pool);
+  uint8_t* bytes = storage.allocate(20u);
+  EXPECT_EQ(storage.base(), first_base);
+  for (size_t i = 0; i < storage.capacity(); i++) {
+    ASSERT_EQ(storage.base()[i], 0u) << "at " << i;
+  }
+  memset(bytes, 0xff, 20u);
+  EXPECT_EQ(pool->GetStats().reused_bytes, DisplayListStorage::kDLPageSize);
+  EXPECT_EQ(pool->GetStats().pooled_bytes, 0u);
+
+  // Growing the storage copies its contents to a larger buffer and returns
+  // the old buffer to the pool.
+  storage.allocate(DisplayListStorage::kDLPageSize);
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize * 2);
+  EXPECT_EQ(storage.base()[19], 0xff);
+  EXPECT_EQ(storage.base()[20], 0u);
+  EXPECT_EQ(pool->GetStats().pooled_bytes, DisplayListStorage::kDLPageSize);
+
+  storage.reset();
+  EXPECT_TRUE(storage.is_pooled());
+  EXPECT_EQ(pool->GetStats().pooled_bytes,
+            DisplayListStorage::kDLPageSize * 3);
+
+  pool->Clear();
+  EXPECT_EQ(pool->GetStats().pooled_bytes, 0u);
+}
+
+TEST(DisplayListStorage, PooledStorageIsTrimmedWhenMostlyUnused) {
+  auto pool = DisplayListStoragePool::Create();
+  constexpr size_t kPageSize = DisplayListStorage::kDLPageSize;
+
+  DisplayListStorage small_storage(pool);
+  small_storage.allocate(10u);
+  small_storage.trim();
+  EXPECT_EQ(small_storage.capacity(), kPageSize);
+
+  DisplayListStorage full_storage(pool);
+  full_storage.allocate(kPageSize * 7);
+  full_storage.trim();
+  EXPECT_EQ(full_storage.capacity(), kPageSize * 8);
+
+  DisplayListStorage large_storage(pool);
+  uint8_t* bytes = large_storage.allocate(kPageSize * 4 + 8u);
+  memset(bytes, 0xff, kPageSize * 4 + 8u);
+  EXPECT_EQ(large_storage.capacity(), kPageSize * 8);
+  large_storage.trim();
+  EXPECT_EQ(large_storage.capacity(), kPageSize * 4 + 8u);
+  EXPECT_EQ(large_storage.base()[kPageSize * 4 + 7u], 0xff);
+  EXPECT_TRUE(large_storage.is_pooled());
+
+  large_storage.reset();
+  EXPECT_EQ(pool->GetStats().pooled_bytes, kPageSize * 4 + 8u);
+}
+
+TEST(DisplayListStorage, RetainedPooledDisplayListHasLittleUnusedMemory) {
+  auto pool = DisplayListStoragePool::Create();
+  DisplayListStoragePool::SetForCurrentThread(pool);
+  for (int rect_count : {1, 100, 1000, 3000, 10000}) {
+    DisplayListBuilder builder;
+    for (int i = 0; i < rect_count; i++) {
+      builder.DrawRect(DlRect::MakeXYWH(i, i, 10, 10), DlPaint());
+    }
+    sk_sp<DisplayList> display_list = builder.Build();
+    ASSERT_TRUE(display_list->GetStorage().is_pooled());
+
+    size_t used = display_list->bytes(false) - sizeof(DisplayList);
+    size_t max_capacity =
+        used + std::max(DisplayListStorage::kDLPageSize, used / 4u);
+    EXPECT_LE(display_list->GetStorage().capacity(), max_capacity)
+        << rect_count << " rects";
+  }
+  DisplayListStoragePool::SetForCurrentThread(nullptr);
+}
+
+TEST(DisplayListStorage, PoolRespectsByteLimit) {
+  auto pool = DisplayListStoragePool::Create(DisplayListStorage::kDLPageSize);
+  {
+    DisplayListStorage storage1(pool);
+    DisplayListStorage storage2(pool);
+    storage1.allocate(10u);
+    storage2.allocate(10u);
+  }
+  EXPECT_EQ(pool->GetStats().allocated_bytes,
+            DisplayListStorage::kDLPageSize * 2);
+  EXPECT_EQ(pool->GetStats().pooled_bytes, DisplayListStorage::kDLPageSize);
+}
+
+TEST(DisplayListStorage, BuilderUsesThreadPool) {
+  auto pool = DisplayListStoragePool::Create();
+  DisplayListStoragePool::SetForCurrentThread(pool);
+  auto make_display_list = [] {
+    DisplayListBuilder builder;
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+    return builder.Build();
+  };
+
+  sk_sp<DisplayList> display_list = make_display_list();
+  EXPECT_TRUE(display_list->GetStorage().is_pooled());
+  display_list.reset();
+  EXPECT_GT(pool->GetStats().pooled_bytes, 0u);
+
+  display_list = make_display_list();
+  EXPECT_GT(pool->GetStats().reused_bytes, 0u);
+  EXPECT_EQ(pool->GetStats().allocated_bytes,
+            pool->GetStats().reused_bytes);
+
+  DisplayListStoragePool::SetForCurrentThread(nullptr);
+  sk_sp<DisplayList> unpooled = make_display_list();
+  EXPECT_FALSE(unpooled->GetStorage().is_pooled());
+  EXPECT_TRUE(unpooled->Equals(display_list));
+}
+
 TEST(DisplayListStorage, NextPowerOfTwoSize) {
   EXPECT_EQ(DisplayListStorage::NextPowerOfTwoSize(0), 1u);
   EXPECT_EQ(DisplayListStorage::NextPowerOfTwoSize(1), 1u);
@@ -4,7 +4,7 @@
 
 #include "flutter/display_list/dl_vertices.h"
 
-#include "flutter/display_list/utils/dl_accumulation_rect.h"
+#include "flutter/display_list/geometry/dl_bulk_bounds.h"
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -90,11 +90,7 @@ size_t DlVertices::size() const {
 }
 
 static DlRect compute_bounds(const DlPoint* points, int count) {
-  AccumulationRect accumulator;
-  for (int i = 0; i < count; i++) {
-    accumulator.accumulate(points[i]);
-  }
-  return accumulator.GetBounds();
+  return DlBulkBounds::PointBounds(points, count).value_or(DlRect());
 }
 
 DlVertices::DlVertices(DlVertexMode mode,
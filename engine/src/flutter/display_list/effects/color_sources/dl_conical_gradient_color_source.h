@@ -63,6 +63,7 @@ class DlConicalGradientColorSource final : public DlGradientColorSourceBase {
 
   friend class DlColorSource;
   friend class DisplayListBuilder;
+  friend class DisplayListSerialization;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(DlConicalGradientColorSource);
 };
@@ -55,6 +55,7 @@ class DlRadialGradientColorSource final : public DlGradientColorSourceBase {
 
   friend class DlColorSource;
   friend class DisplayListBuilder;
+  friend class DisplayListSerialization;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(DlRadialGradientColorSource);
 };
@@ -58,6 +58,7 @@ class DlSweepGradientColorSource final : public DlGradientColorSourceBase {
 
   friend class DlColorSource;
   friend class DisplayListBuilder;
+  friend class DisplayListSerialization;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(DlSweepGradientColorSource);
 };
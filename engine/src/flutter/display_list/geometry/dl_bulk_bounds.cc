@@ -0,0 +1,311 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/geometry/dl_bulk_bounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "flutter/fml/logging.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DL_BULK_BOUNDS_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DL_BULK_BOUNDS_NEON 1
+#endif
+
+namespace flutter {
+
+namespace {
+
+static_assert(sizeof(DlPoint) == 2 * sizeof(DlScalar));
+static_assert(sizeof(DlScalar) == sizeof(float));
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// A vector of 4 floats which generally holds the coordinates of 2 points
+// as [x0, y0, x1, y1] so that the x and y bounds are accumulated in the
+// same lanes.
+#if defined(DL_BULK_BOUNDS_SSE2)
+
+struct F4 {
+  __m128 v;
+
+  static F4 Load(const float* p) { return {_mm_loadu_ps(p)}; }
+  static F4 Make(float a, float b, float c, float d) {
+    return {_mm_setr_ps(a, b, c, d)};
+  }
+  static F4 Splat(float f) { return {_mm_set1_ps(f)}; }
+
+  friend F4 operator+(F4 a, F4 b) { return {_mm_add_ps(a.v, b.v)}; }
+  friend F4 operator*(F4 a, F4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+  static F4 Min(F4 a, F4 b) { return {_mm_min_ps(a.v, b.v)}; }
+  static F4 Max(F4 a, F4 b) { return {_mm_max_ps(a.v, b.v)}; }
+
+  // [v0, v0, v2, v2]
+  F4 EvenLanes() const {
+    return {_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0))};
+  }
+  // [v1, v1, v3, v3]
+  F4 OddLanes() const {
+    return {_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1))};
+  }
+  // [v0, v1, v0, v1]
+  F4 LowPair() const { return {_mm_movelh_ps(v, v)}; }
+  // [v2, v3, v2, v3]
+  F4 HighPair() const { return {_mm_movehl_ps(v, v)}; }
+
+  // Replaces both coordinates of any point which has a non-finite
+  // coordinate with the corresponding lanes of |replacement|.
+  F4 SelectFinitePoints(F4 replacement) const {
+    // x - x is NaN for infinities and NaN, and NaN never compares equal.
+    __m128 mask = _mm_cmpeq_ps(_mm_sub_ps(v, v), _mm_setzero_ps());
+    __m128 swapped = _mm_shuffle_ps(mask, mask, _MM_SHUFFLE(2, 3, 0, 1));
+    mask = _mm_and_ps(mask, swapped);
+    return {_mm_or_ps(_mm_and_ps(mask, v),  //
+                      _mm_andnot_ps(mask, replacement.v))};
+  }
+
+  void Store(float out[4]) const { _mm_storeu_ps(out, v); }
+};
+
+#elif defined(DL_BULK_BOUNDS_NEON)
+
+struct F4 {
+  float32x4_t v;
+
+  static F4 Load(const float* p) { return {vld1q_f32(p)}; }
+  static F4 Make(float a, float b, float c, float d) {
+    const float values[4] = {a, b, c, d};
+    return {vld1q_f32(values)};
+  }
+  static F4 Splat(float f) { return {vdupq_n_f32(f)}; }
+
+  friend F4 operator+(F4 a, F4 b) { return {vaddq_f32(a.v, b.v)}; }
+  friend F4 operator*(F4 a, F4 b) { return {vmulq_f32(a.v, b.v)}; }
+  static F4 Min(F4 a, F4 b) { return {vminq_f32(a.v, b.v)}; }
+  static F4 Max(F4 a, F4 b) { return {vmaxq_f32(a.v, b.v)}; }
+
+  // [v0, v0, v2, v2]
+  F4 EvenLanes() const { return {vtrnq_f32(v, v).val[0]}; }
+  // [v1, v1, v3, v3]
+  F4 OddLanes() const { return {vtrnq_f32(v, v).val[1]}; }
+  // [v0, v1, v0, v1]
+  F4 LowPair() const {
+    return {vcombine_f32(vget_low_f32(v), vget_low_f32(v))};
+  }
+  // [v2, v3, v2, v3]
+  F4 HighPair() const {
+    return {vcombine_f32(vget_high_f32(v), vget_high_f32(v))};
+  }
+
+  // Replaces both coordinates of any point which has a non-finite
+  // coordinate with the corresponding lanes of |replacement|.
+  F4 SelectFinitePoints(F4 replacement) const {
+    // x - x is NaN for infinities and NaN, and NaN never compares equal.
+    uint32x4_t mask = vceqq_f32(vsubq_f32(v, v), vdupq_n_f32(0.0f));
+    mask = vandq_u32(mask, vrev64q_u32(mask));
+    return {vbslq_f32(mask, v, replacement.v)};
+  }
+
+  void Store(float out[4]) const { vst1q_f32(out, v); }
+};
+
+#else
+
+struct F4 {
+  float v[4];
+
+  static F4 Load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+  static F4 Make(float a, float b, float c, float d) { return {{a, b, c, d}}; }
+  static F4 Splat(float f) { return {{f, f, f, f}}; }
+
+  friend F4 operator+(F4 a, F4 b) {
+    return {{a.v[0] + b.v[0], a.v[1] + b.v[1],  //
+             a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+  }
+  friend F4 operator*(F4 a, F4 b) {
+    return {{a.v[0] * b.v[0], a.v[1] * b.v[1],  //
+             a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+  }
+  static F4 Min(F4 a, F4 b) {
+    return {{std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1]),
+             std::min(a.v[2], b.v[2]), std::min(a.v[3], b.v[3])}};
+  }
+  static F4 Max(F4 a, F4 b) {
+    return {{std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]),
+             std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3])}};
+  }
+
+  F4 EvenLanes() const { return {{v[0], v[0], v[2], v[2]}}; }
+  F4 OddLanes() const { return {{v[1], v[1], v[3], v[3]}}; }
+  F4 LowPair() const { return {{v[0], v[1], v[0], v[1]}}; }
+  F4 HighPair() const { return {{v[2], v[3], v[2], v[3]}}; }
+
+  F4 SelectFinitePoints(F4 replacement) const {
+    bool first = std::isfinite(v[0]) && std::isfinite(v[1]);
+    bool second = std::isfinite(v[2]) && std::isfinite(v[3]);
+    return {{first ? v[0] : replacement.v[0],  //
+             first ? v[1] : replacement.v[1],  //
+             second ? v[2] : replacement.v[2],
+             second ? v[3] : replacement.v[3]}};
+  }
+
+  void Store(float out[4]) const {
+    out[0] = v[0];
+    out[1] = v[1];
+    out[2] = v[2];
+    out[3] = v[3];
+  }
+};
+
+#endif
+
+// Accumulates the bounds of pairs of points held in the lanes of an F4,
+// optionally skipping the points which are not finite.
+class PairBounds {
+ public:
+  PairBounds()
+      : min_(F4::Splat(kInfinity)),
+        max_(F4::Splat(-kInfinity)),
+        infinity_(F4::Splat(kInfinity)),
+        negative_infinity_(F4::Splat(-kInfinity)) {}
+
+  void AccumulateFinite(F4 points) {
+    min_ = F4::Min(min_, points.SelectFinitePoints(infinity_));
+    max_ = F4::Max(max_, points.SelectFinitePoints(negative_infinity_));
+  }
+
+  void Accumulate(F4 points) {
+    min_ = F4::Min(min_, points);
+    max_ = F4::Max(max_, points);
+  }
+
+  std::optional<DlRect> GetBounds() const {
+    float min[4];
+    float max[4];
+    min_.Store(min);
+    max_.Store(max);
+    float left = std::min(min[0], min[2]);
+    float top = std::min(min[1], min[3]);
+    float right = std::max(max[0], max[2]);
+    float bottom = std::max(max[1], max[3]);
+    if (!(left <= right && top <= bottom)) {
+      return std::nullopt;
+    }
+    return DlRect::MakeLTRB(left, top, right, bottom);
+  }
+
+ private:
+  F4 min_;
+  F4 max_;
+  const F4 infinity_;
+  const F4 negative_infinity_;
+};
+
+}  // namespace
+
+std::optional<DlRect> DlBulkBounds::PointBounds(const DlPoint points[],
+                                                size_t count) {
+  const float* coords = reinterpret_cast<const float*>(points);
+  PairBounds bounds;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    bounds.AccumulateFinite(F4::Load(coords + i * 2));
+    bounds.AccumulateFinite(F4::Load(coords + i * 2 + 4));
+  }
+  for (; i + 2 <= count; i += 2) {
+    bounds.AccumulateFinite(F4::Load(coords + i * 2));
+  }
+  if (i < count) {
+    const DlPoint& p = points[i];
+    bounds.AccumulateFinite(F4::Make(p.x, p.y, p.x, p.y));
+  }
+  return bounds.GetBounds();
+}
+
+std::optional<DlRect> DlBulkBounds::TransformedPointBounds(
+    const DlMatrix& matrix,
+    const DlPoint points[],
+    size_t count) {
+  FML_DCHECK(!matrix.HasPerspective2D());
+  const F4 scale_x = F4::Make(matrix.m[0], matrix.m[1], matrix.m[0],
+                              matrix.m[1]);
+  const F4 scale_y = F4::Make(matrix.m[4], matrix.m[5], matrix.m[4],
+                              matrix.m[5]);
+  const F4 translate = F4::Make(matrix.m[12], matrix.m[13], matrix.m[12],
+                                matrix.m[13]);
+  auto transform = [&](F4 p) {
+    return p.EvenLanes() * scale_x + p.OddLanes() * scale_y + translate;
+  };
+
+  const float* coords = reinterpret_cast<const float*>(points);
+  PairBounds bounds;
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    bounds.AccumulateFinite(transform(F4::Load(coords + i * 2)));
+  }
+  if (i < count) {
+    const DlPoint& p = points[i];
+    bounds.AccumulateFinite(transform(F4::Make(p.x, p.y, p.x, p.y)));
+  }
+  return bounds.GetBounds();
+}
+
+DlRect DlBulkBounds::TransformedRectBounds(const DlMatrix& matrix,
+                                           const DlRect& rect) {
+  FML_DCHECK(!matrix.HasPerspective2D());
+  if (rect.IsEmpty()) {
+    return {};
+  }
+  const F4 scale_x = F4::Make(matrix.m[0], matrix.m[1], matrix.m[0],
+                              matrix.m[1]);
+  const F4 scale_y = F4::Make(matrix.m[4], matrix.m[5], matrix.m[4],
+                              matrix.m[5]);
+  const F4 translate = F4::Make(matrix.m[12], matrix.m[13], matrix.m[12],
+                                matrix.m[13]);
+  // The x coordinates of both corners of a horizontal edge are the same
+  // lanes of |xs| and their mapped contributions are shared between the
+  // top and bottom edges.
+  F4 xs = F4::Make(rect.GetLeft(), rect.GetLeft(), rect.GetRight(),
+                   rect.GetRight()) *
+          scale_x;
+  F4 top = F4::Splat(rect.GetTop()) * scale_y;
+  F4 bottom = F4::Splat(rect.GetBottom()) * scale_y;
+  PairBounds bounds;
+  bounds.Accumulate(xs + top + translate);
+  bounds.Accumulate(xs + bottom + translate);
+  return bounds.GetBounds().value_or(DlRect());
+}
+
+std::optional<DlRect> DlBulkBounds::AtlasBounds(const DlRSTransform xform[],
+                                                const DlRect tex[],
+                                                size_t count) {
+  PairBounds bounds;
+  for (size_t i = 0; i < count; i++) {
+    const DlRSTransform& transform = xform[i];
+    DlScalar width = tex[i].GetWidth();
+    DlScalar height = tex[i].GetHeight();
+    // [dx.x, dx.y, dy.x, dy.y] as computed by DlRSTransform::GetQuad.
+    F4 deltas = F4::Make(width, width, height, height) *
+                F4::Make(transform.scaled_cos, transform.scaled_sin,
+                         -transform.scaled_sin, transform.scaled_cos);
+    F4 origin = F4::Make(transform.translate_x, transform.translate_y,
+                         transform.translate_x, transform.translate_y);
+    // [origin + dx, origin + dy]
+    F4 corners = origin + deltas;
+    // [origin + dx + dy, origin + dx + dy]
+    F4 far_corner = corners.LowPair() + deltas.HighPair();
+    bounds.AccumulateFinite(origin);
+    bounds.AccumulateFinite(corners);
+    bounds.AccumulateFinite(far_corner);
+  }
+  return bounds.GetBounds();
+}
+
+}  // namespace flutter
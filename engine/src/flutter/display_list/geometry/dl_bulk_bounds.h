@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_BULK_BOUNDS_H_
+#define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_BULK_BOUNDS_H_
+
+#include <optional>
+
+#include "flutter/display_list/geometry/dl_geometry_types.h"
+
+namespace flutter {
+
+/// @brief   Kernels that compute the bounds of batches of points, quads and
+///          transformed rectangles. The kernels process several coordinates
+///          at once using SSE2 or NEON instructions where they are available
+///          and fall back to scalar code otherwise, producing the same
+///          results in either case.
+class DlBulkBounds {
+ public:
+  /// @brief   Returns the bounds of the finite points in the array, or
+  ///          std::nullopt if none of the points are finite. Points with a
+  ///          non-finite coordinate are ignored, as in |AccumulationRect|.
+  static std::optional<DlRect> PointBounds(const DlPoint points[],
+                                           size_t count);
+
+  /// @brief   Returns the bounds of the finite results of transforming the
+  ///          points in the array by the matrix, or std::nullopt if none of
+  ///          the transformed points are finite.
+  ///
+  /// The matrix must not have perspective components in the XY plane.
+  static std::optional<DlRect> TransformedPointBounds(const DlMatrix& matrix,
+                                                      const DlPoint points[],
+                                                      size_t count);
+
+  /// @brief   Returns the bounds of the corners of the rect transformed by
+  ///          the matrix, producing the same result as
+  ///          |DlRect::TransformBounds|.
+  ///
+  /// The matrix must not have perspective components in the XY plane.
+  static DlRect TransformedRectBounds(const DlMatrix& matrix,
+                                      const DlRect& rect);
+
+  /// @brief   Returns the bounds of the finite corners of the quads that the
+  ///          sizes of the texture rects map to under the corresponding
+  ///          transforms, as computed by |DlRSTransform::GetQuad|, or
+  ///          std::nullopt if none of the corners are finite.
+  static std::optional<DlRect> AtlasBounds(const DlRSTransform xform[],
+                                           const DlRect tex[],
+                                           size_t count);
+
+ private:
+  DlBulkBounds() = delete;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_GEOMETRY_DL_BULK_BOUNDS_H_
@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/geometry/dl_bulk_bounds.h"
+
+#include <limits>
+#include <vector>
+
+#include "flutter/display_list/utils/dl_accumulation_rect.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr DlScalar kInf = std::numeric_limits<DlScalar>::infinity();
+constexpr DlScalar kNaN = std::numeric_limits<DlScalar>::quiet_NaN();
+
+std::vector<DlPoint> MakePoints(size_t count) {
+  std::vector<DlPoint> points;
+  for (size_t i = 0; i < count; i++) {
+    // A deterministic scattering of points around the origin.
+    DlScalar x = static_cast<DlScalar>((i * 37) % 101) - 50.5f;
+    DlScalar y = static_cast<DlScalar>((i * 53) % 89) - 40.25f;
+    points.emplace_back(x, y);
+  }
+  return points;
+}
+
+std::optional<DlRect> AccumulatedBounds(const std::vector<DlPoint>& points) {
+  AccumulationRect accumulator;
+  bool any_finite = false;
+  for (const DlPoint& point : points) {
+    accumulator.accumulate(point);
+    if (std::isfinite(point.x) && std::isfinite(point.y)) {
+      any_finite = true;
+    }
+  }
+  if (!any_finite) {
+    return std::nullopt;
+  }
+  return accumulator.GetBounds();
+}
+
+}  // namespace
+
+TEST(DlBulkBounds, EmptyPointBounds) {
+  EXPECT_EQ(DlBulkBounds::PointBounds(nullptr, 0u), std::nullopt);
+}
+
+TEST(DlBulkBounds, SinglePointBounds) {
+  DlPoint point(10.5f, -3.0f);
+  EXPECT_EQ(DlBulkBounds::PointBounds(&point, 1u),
+            DlRect::MakeLTRB(10.5f, -3.0f, 10.5f, -3.0f));
+}
+
+TEST(DlBulkBounds, PointBoundsMatchAccumulationRect) {
+  // Cover every combination of the vector loops and the scalar tail.
+  for (size_t count = 1; count < 20; count++) {
+    std::vector<DlPoint> points = MakePoints(count);
+    EXPECT_EQ(DlBulkBounds::PointBounds(points.data(), count),
+              AccumulatedBounds(points))
+        << "count: " << count;
+  }
+}
+
+TEST(DlBulkBounds, PointBoundsIgnoreNonFinitePoints) {
+  for (size_t count = 1; count < 12; count++) {
+    for (size_t bad = 0; bad < count; bad++) {
+      std::vector<DlPoint> points = MakePoints(count);
+      points[bad] = DlPoint(bad % 2 ? kInf : 0.0f, bad % 2 ? 0.0f : kNaN);
+      EXPECT_EQ(DlBulkBounds::PointBounds(points.data(), count),
+                AccumulatedBounds(points))
+          << "count: " << count << ", non-finite index: " << bad;
+    }
+  }
+}
+
+TEST(DlBulkBounds, AllNonFinitePoints) {
+  DlPoint points[] = {
+      DlPoint(kInf, 0.0f),
+      DlPoint(0.0f, -kInf),
+      DlPoint(kNaN, kNaN),
+  };
+  EXPECT_EQ(DlBulkBounds::PointBounds(points, 3u), std::nullopt);
+}
+
+TEST(DlBulkBounds, TransformedPointBounds) {
+  DlMatrix matrix = DlMatrix::MakeTranslation({12.0f, -7.5f}) *
+                    DlMatrix::MakeRotationZ(DlDegrees(30)) *
+                    DlMatrix::MakeScale({2.0f, 0.5f, 1.0f});
+  for (size_t count = 1; count < 12; count++) {
+    std::vector<DlPoint> points = MakePoints(count);
+    std::vector<DlPoint> transformed;
+    for (const DlPoint& point : points) {
+      transformed.push_back(matrix * point);
+    }
+    EXPECT_EQ(DlBulkBounds::TransformedPointBounds(matrix, points.data(),
+                                                   count),
+              AccumulatedBounds(transformed))
+        << "count: " << count;
+  }
+}
+
+TEST(DlBulkBounds, TransformedRectBoundsMatchTransformBounds) {
+  DlRect rect = DlRect::MakeLTRB(-10.5f, 3.25f, 40.0f, 27.75f);
+  DlMatrix matrices[] = {
+      DlMatrix(),
+      DlMatrix::MakeTranslation({5.0f, 6.0f}),
+      DlMatrix::MakeScale({-2.0f, 3.0f, 1.0f}),
+      DlMatrix::MakeRotationZ(DlDegrees(45)),
+      DlMatrix::MakeTranslation({12.0f, -7.5f}) *
+          DlMatrix::MakeRotationZ(DlDegrees(-110)) *
+          DlMatrix::MakeScale({2.0f, 0.5f, 1.0f}),
+  };
+  for (const DlMatrix& matrix : matrices) {
+    EXPECT_EQ(DlBulkBounds::TransformedRectBounds(matrix, rect),
+              rect.TransformBounds(matrix))
+        << matrix;
+  }
+  EXPECT_TRUE(
+      DlBulkBounds::TransformedRectBounds(DlMatrix(), DlRect()).IsEmpty());
+}
+
+TEST(DlBulkBounds, AtlasBoundsMatchQuads) {
+  std::vector<DlRSTransform> xforms;
+  std::vector<DlRect> tex;
+  std::vector<DlPoint> corners;
+  for (int i = 0; i < 7; i++) {
+    xforms.push_back(DlRSTransform::Make(DlPoint(i * 13.0f, i * -7.0f),
+                                         0.5f + i * 0.25f,
+                                         DlDegrees(i * 50.0f)));
+    tex.push_back(DlRect::MakeXYWH(i * 2.0f, 0.0f, 10.0f + i, 20.0f - i));
+    DlQuad quad;
+    xforms.back().GetQuad(tex.back().GetWidth(), tex.back().GetHeight(), quad);
+    corners.insert(corners.end(), quad.begin(), quad.end());
+    EXPECT_EQ(DlBulkBounds::AtlasBounds(xforms.data(), tex.data(), i + 1),
+              AccumulatedBounds(corners))
+        << "count: " << (i + 1);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
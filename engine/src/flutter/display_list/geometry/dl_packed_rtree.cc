@@ -0,0 +1,273 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/geometry/dl_packed_rtree.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DL_PACKED_RTREE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DL_PACKED_RTREE_NEON 1
+#endif
+
+namespace flutter {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// The number of bits used for each coordinate of the Hilbert curve.
+constexpr uint32_t kHilbertBits = 16;
+
+// The Hilbert order is used only if the total area of the leaf parents it
+// produces is below this fraction of the area for the original order.
+constexpr double kMinHilbertAreaRatio = 0.75;
+
+// Returns the distance along a Hilbert curve filling a square grid of
+// 2^kHilbertBits cells on a side to the indicated cell.
+uint32_t HilbertDistance(uint32_t x, uint32_t y) {
+  uint32_t distance = 0u;
+  for (uint32_t s = 1u << (kHilbertBits - 1); s > 0u; s >>= 1) {
+    uint32_t rx = (x & s) > 0u ? 1u : 0u;
+    uint32_t ry = (y & s) > 0u ? 1u : 0u;
+    distance += s * s * ((3u * rx) ^ ry);
+    // Rotate the quadrant so that the curve in it has the orientation
+    // of the curve through the whole square.
+    if (ry == 0u) {
+      if (rx == 1u) {
+        x = s - 1u - (x & (s - 1u));
+        y = s - 1u - (y & (s - 1u));
+      }
+      std::swap(x, y);
+    }
+  }
+  return distance;
+}
+
+uint32_t RoundUpToNodeSize(uint32_t count) {
+  return (count + DlPackedRTree::kNodeSize - 1u) &
+         ~(DlPackedRTree::kNodeSize - 1u);
+}
+
+// Returns the total area of the bounds of the leaf parents that would be
+// produced by packing the leaves in the order given by |leaf_at|.
+template <typename LeafAt>
+double LeafParentArea(const DlRTree& rtree, uint32_t count, LeafAt leaf_at) {
+  double area = 0.0;
+  for (uint32_t first = 0; first < count; first += DlPackedRTree::kNodeSize) {
+    uint32_t end = std::min(first + DlPackedRTree::kNodeSize, count);
+    DlRect bounds = rtree.bounds(leaf_at(first));
+    for (uint32_t i = first + 1; i < end; i++) {
+      bounds = bounds.Union(rtree.bounds(leaf_at(i)));
+    }
+    area += static_cast<double>(bounds.GetWidth()) * bounds.GetHeight();
+  }
+  return area;
+}
+
+}  // namespace
+
+DlPackedRTree::DlPackedRTree(const DlRTree& rtree)
+    : leaf_count_(rtree.leaf_count()) {
+  if (leaf_count_ <= 0) {
+    leaf_count_ = 0;
+    return;
+  }
+  uint32_t count = static_cast<uint32_t>(leaf_count_);
+
+  // Sort the leaves by the Hilbert distance of their centers within the
+  // bounds of the whole tree, breaking ties by their original order.
+  //
+  // DisplayLists recorded from page layouts often have their rendering
+  // ops already mostly sorted by location, in which case keeping the
+  // original order packs the leaves nearly as tightly and has the
+  // advantage that |search| does not need to sort its results. The
+  // Hilbert order is only used if it reduces the total area of the leaf
+  // parents significantly.
+  const DlRect& tree_bounds = rtree.bounds();
+  constexpr float kMaxCell = static_cast<float>((1u << kHilbertBits) - 1u);
+  float scale_x = tree_bounds.GetWidth() > 0
+                      ? kMaxCell / tree_bounds.GetWidth()
+                      : 0.0f;
+  float scale_y = tree_bounds.GetHeight() > 0
+                      ? kMaxCell / tree_bounds.GetHeight()
+                      : 0.0f;
+  std::vector<uint64_t> keys(count);
+  for (uint32_t i = 0; i < count; i++) {
+    DlPoint center = rtree.bounds(i).GetCenter();
+    float cell_x = (center.x - tree_bounds.GetLeft()) * scale_x;
+    float cell_y = (center.y - tree_bounds.GetTop()) * scale_y;
+    uint32_t x = static_cast<uint32_t>(std::clamp(cell_x, 0.0f, kMaxCell));
+    uint32_t y = static_cast<uint32_t>(std::clamp(cell_y, 0.0f, kMaxCell));
+    keys[i] = (static_cast<uint64_t>(HilbertDistance(x, y)) << 32) | i;
+  }
+  std::sort(keys.begin(), keys.end());
+  double hilbert_area = LeafParentArea(rtree, count, [&keys](uint32_t i) {
+    return static_cast<uint32_t>(keys[i]);
+  });
+  double original_area =
+      LeafParentArea(rtree, count, [](uint32_t i) { return i; });
+  leaves_in_order_ = hilbert_area >= original_area * kMinHilbertAreaRatio;
+
+  // Count all of the entries so that the arrays are only allocated once.
+  size_t total_size = RoundUpToNodeSize(count);
+  for (uint32_t level_count = count; level_count > 1u;) {
+    level_count = (level_count + kNodeSize - 1u) / kNodeSize;
+    total_size += RoundUpToNodeSize(level_count);
+  }
+  if (count == 1u) {
+    total_size += kNodeSize;
+  }
+  lefts_.reserve(total_size);
+  tops_.reserve(total_size);
+  rights_.reserve(total_size);
+  bottoms_.reserve(total_size);
+  indices_.reserve(total_size);
+
+  uint32_t level_start = AppendLevel(count);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t leaf = leaves_in_order_ ? i : static_cast<uint32_t>(keys[i]);
+    const DlRect& bounds = rtree.bounds(leaf);
+    lefts_[i] = bounds.GetLeft();
+    tops_[i] = bounds.GetTop();
+    rights_[i] = bounds.GetRight();
+    bottoms_[i] = bounds.GetBottom();
+    indices_[i] = leaf;
+  }
+
+  // Group each level into parent nodes until a level only has a single
+  // node, which is the root. A single leaf still gets a root so that the
+  // leaves are always reached through a leaf parent.
+  uint32_t level_count = count;
+  do {
+    uint32_t parent_count = (level_count + kNodeSize - 1u) / kNodeSize;
+    uint32_t parent_start = AppendLevel(parent_count);
+    uint32_t level_end = level_start + level_count;
+    for (uint32_t k = 0; k < parent_count; k++) {
+      uint32_t first = level_start + k * kNodeSize;
+      uint32_t end = std::min(first + kNodeSize, level_end);
+      uint32_t parent = parent_start + k;
+      float left = kInfinity;
+      float top = kInfinity;
+      float right = -kInfinity;
+      float bottom = -kInfinity;
+      for (uint32_t child = first; child < end; child++) {
+        left = std::min(left, lefts_[child]);
+        top = std::min(top, tops_[child]);
+        right = std::max(right, rights_[child]);
+        bottom = std::max(bottom, bottoms_[child]);
+      }
+      lefts_[parent] = left;
+      tops_[parent] = top;
+      rights_[parent] = right;
+      bottoms_[parent] = bottom;
+      indices_[parent] = first;
+    }
+    if (level_start == 0u) {
+      leaf_parents_end_ = parent_start + parent_count;
+    }
+    level_start = parent_start;
+    level_count = parent_count;
+  } while (level_count > 1u);
+  root_ = level_start;
+  FML_DCHECK(lefts_.size() == total_size);
+}
+
+uint32_t DlPackedRTree::AppendLevel(uint32_t count) {
+  uint32_t start = static_cast<uint32_t>(lefts_.size());
+  size_t end = start + RoundUpToNodeSize(count);
+  // The padding entries are inverted so that they fail every
+  // intersection test.
+  lefts_.resize(end, kInfinity);
+  tops_.resize(end, kInfinity);
+  rights_.resize(end, -kInfinity);
+  bottoms_.resize(end, -kInfinity);
+  indices_.resize(end, 0u);
+  return start;
+}
+
+size_t DlPackedRTree::bytes_used() const {
+  return sizeof(DlPackedRTree) +
+         lefts_.capacity() * sizeof(float) * 4u +
+         indices_.capacity() * sizeof(uint32_t);
+}
+
+uint32_t DlPackedRTree::CollectChildHits(uint32_t node,
+                                         const DlRect& query,
+                                         uint32_t hits[kNodeSize]) const {
+  uint32_t first = indices_[node];
+  FML_DCHECK(first + kNodeSize <= lefts_.size());
+  uint32_t hit_count = 0u;
+#if defined(DL_PACKED_RTREE_SSE2)
+  const __m128 query_left = _mm_set1_ps(query.GetLeft());
+  const __m128 query_top = _mm_set1_ps(query.GetTop());
+  const __m128 query_right = _mm_set1_ps(query.GetRight());
+  const __m128 query_bottom = _mm_set1_ps(query.GetBottom());
+  for (uint32_t i = first; i < first + kNodeSize; i += 4u) {
+    __m128 mask = _mm_and_ps(
+        _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&lefts_[i]), query_right),
+                   _mm_cmplt_ps(_mm_loadu_ps(&tops_[i]), query_bottom)),
+        _mm_and_ps(_mm_cmpgt_ps(_mm_loadu_ps(&rights_[i]), query_left),
+                   _mm_cmpgt_ps(_mm_loadu_ps(&bottoms_[i]), query_top)));
+    uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(mask));
+    while (bits != 0u) {
+      uint32_t lane = static_cast<uint32_t>(__builtin_ctz(bits));
+      hits[hit_count++] = i + lane;
+      bits &= bits - 1u;
+    }
+  }
+#elif defined(DL_PACKED_RTREE_NEON)
+  const float32x4_t query_left = vdupq_n_f32(query.GetLeft());
+  const float32x4_t query_top = vdupq_n_f32(query.GetTop());
+  const float32x4_t query_right = vdupq_n_f32(query.GetRight());
+  const float32x4_t query_bottom = vdupq_n_f32(query.GetBottom());
+  const uint32_t kLaneBitValues[4] = {1u, 2u, 4u, 8u};
+  const uint32x4_t lane_bits = vld1q_u32(kLaneBitValues);
+  for (uint32_t i = first; i < first + kNodeSize; i += 4u) {
+    uint32x4_t mask = vandq_u32(
+        vandq_u32(vcltq_f32(vld1q_f32(&lefts_[i]), query_right),
+                  vcltq_f32(vld1q_f32(&tops_[i]), query_bottom)),
+        vandq_u32(vcgtq_f32(vld1q_f32(&rights_[i]), query_left),
+                  vcgtq_f32(vld1q_f32(&bottoms_[i]), query_top)));
+    uint32x4_t masked_bits = vandq_u32(mask, lane_bits);
+    uint32x2_t sum =
+        vadd_u32(vget_low_u32(masked_bits), vget_high_u32(masked_bits));
+    uint32_t bits = vget_lane_u32(vpadd_u32(sum, sum), 0);
+    while (bits != 0u) {
+      uint32_t lane = static_cast<uint32_t>(__builtin_ctz(bits));
+      hits[hit_count++] = i + lane;
+      bits &= bits - 1u;
+    }
+  }
+#else
+  for (uint32_t i = first; i < first + kNodeSize; i++) {
+    if (lefts_[i] < query.GetRight() && tops_[i] < query.GetBottom() &&
+        rights_[i] > query.GetLeft() && bottoms_[i] > query.GetTop()) {
+      hits[hit_count++] = i;
+    }
+  }
+#endif
+  return hit_count;
+}
+
+void DlPackedRTree::search(const DlRect& query,
+                           std::vector<int>* results) const {
+  FML_DCHECK(results != nullptr);
+  size_t start = results->size();
+  ForEachHit(query, [results](int leaf) {
+    results->push_back(leaf);
+    return true;
+  });
+  if (!leaves_in_order_) {
+    std::sort(results->begin() + start, results->end());
+  }
+  FML_DCHECK(std::is_sorted(results->begin() + start, results->end()));
+}
+
+}  // namespace flutter
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_PACKED_RTREE_H_
+#define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_PACKED_RTREE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/display_list/geometry/dl_rtree.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+/// A static, packed R-Tree over the leaf rectangles of a |DlRTree| which
+/// is optimized for repeated queries against a large number of leaves.
+///
+/// The leaves are sorted along a Hilbert curve through the centers of
+/// their bounds, unless their original order already groups them nearly
+/// as well, and then grouped into fixed size nodes, level by level, so
+/// that nearby rectangles share nodes. The bounds of all nodes are
+/// stored as separate arrays of left, top, right and bottom coordinates,
+/// which allows the children of a node to be tested against a query
+/// several at a time using SSE2 or NEON instructions where available.
+///
+/// Query results are reported as the leaf indices of the |DlRTree| the
+/// packed tree was built from, so that they can be passed to its |id|
+/// and |bounds| methods. |ForEachHit| reports them in increasing order
+/// only if the leaves were not reordered, while |search| always produces
+/// the same results as |DlRTree::search|, sorting them if necessary.
+class DlPackedRTree {
+ public:
+  /// The number of children grouped into each internal node.
+  static constexpr uint32_t kNodeSize = 16;
+
+  /// Builds a packed R-Tree from the leaves of the indicated R-Tree.
+  explicit DlPackedRTree(const DlRTree& rtree);
+
+  /// Returns the number of leaves in the R-Tree.
+  int leaf_count() const { return leaf_count_; }
+
+  /// Returns the bytes used by the object and all of its node data.
+  size_t bytes_used() const;
+
+  /// Returns true if the leaves were packed in their original order
+  /// rather than in Hilbert order.
+  bool leaves_in_order() const { return leaves_in_order_; }
+
+  /// Calls |visitor| with the |DlRTree| leaf index of every leaf whose
+  /// bounds intersect the query, without allocating memory. The leaves
+  /// are visited in the order in which they were packed, which is only
+  /// their original order if |leaves_in_order| returns true. The search
+  /// stops early if the visitor returns false.
+  template <typename Visitor>
+  void ForEachHit(const DlRect& query, Visitor&& visitor) const {
+    if (leaf_count_ == 0 || query.IsEmpty()) {
+      return;
+    }
+    uint32_t stack[kStackSize];
+    uint32_t stack_size = 0u;
+    uint32_t hits[kNodeSize];
+    stack[stack_size++] = root_;
+    while (stack_size > 0u) {
+      uint32_t node = stack[--stack_size];
+      uint32_t hit_count = CollectChildHits(node, query, hits);
+      if (IsLeafParent(node)) {
+        for (uint32_t i = 0; i < hit_count; i++) {
+          if (!visitor(static_cast<int>(indices_[hits[i]]))) {
+            return;
+          }
+        }
+      } else {
+        FML_DCHECK(stack_size + hit_count <= kStackSize);
+        // Push the children in reverse so that they are visited in order.
+        while (hit_count > 0u) {
+          stack[stack_size++] = hits[--hit_count];
+        }
+      }
+    }
+  }
+
+  /// Search the rectangles and return a vector of the |DlRTree| leaf
+  /// indices of the rectangles that intersect the query, in increasing
+  /// order, matching the results of |DlRTree::search|.
+  void search(const DlRect& query, std::vector<int>* results) const;
+
+ private:
+  // Enough space for the children of one node on each level of a tree
+  // holding up to 2^32 leaves.
+  static constexpr uint32_t kMaxLevels = 9;
+  static constexpr uint32_t kStackSize = kNodeSize * kMaxLevels;
+
+  // Stores the positions of the children of |node| whose bounds intersect
+  // the query into |hits| and returns their count.
+  uint32_t CollectChildHits(uint32_t node,
+                            const DlRect& query,
+                            uint32_t hits[kNodeSize]) const;
+
+  // Returns true if the children of the node are leaves.
+  bool IsLeafParent(uint32_t node) const { return node < leaf_parents_end_; }
+
+  // Appends |count| nodes to the arrays, followed by padding up to a
+  // multiple of |kNodeSize| entries which never intersect a query, and
+  // returns the position of the first node.
+  uint32_t AppendLevel(uint32_t count);
+
+  int leaf_count_ = 0;
+  bool leaves_in_order_ = true;
+  uint32_t root_ = 0u;
+  uint32_t leaf_parents_end_ = 0u;
+
+  // The bounds of every node, leaves first and then each level of
+  // internal nodes up to the root. Each level is padded to a multiple of
+  // |kNodeSize| entries so that the children of every internal node can
+  // be tested as a whole group of |kNodeSize| entries.
+  std::vector<float> lefts_;
+  std::vector<float> tops_;
+  std::vector<float> rights_;
+  std::vector<float> bottoms_;
+
+  // For leaves, the index of the leaf in the source |DlRTree|. For
+  // internal nodes, the position of the first child.
+  std::vector<uint32_t> indices_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_GEOMETRY_DL_PACKED_RTREE_H_
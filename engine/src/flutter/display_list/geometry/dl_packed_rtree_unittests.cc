@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/geometry/dl_packed_rtree.h"
+
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::vector<int> PackedSearch(const DlPackedRTree& packed,
+                              const DlRect& query) {
+  std::vector<int> results;
+  packed.search(query, &results);
+  return results;
+}
+
+std::vector<int> RTreeSearch(const DlRTree& rtree, const DlRect& query) {
+  std::vector<int> results;
+  rtree.search(query, &results);
+  return results;
+}
+
+}  // namespace
+
+TEST(DisplayListPackedRTree, EmptyTree) {
+  DlRTree rtree(nullptr, 0);
+  DlPackedRTree packed(rtree);
+  EXPECT_EQ(packed.leaf_count(), 0);
+  EXPECT_TRUE(
+      PackedSearch(packed, DlRect::MakeLTRB(-1e6, -1e6, 1e6, 1e6)).empty());
+}
+
+TEST(DisplayListPackedRTree, SingleLeaf) {
+  DlRect rect = DlRect::MakeLTRB(10, 10, 20, 20);
+  DlRTree rtree(&rect, 1);
+  DlPackedRTree packed(rtree);
+  EXPECT_EQ(packed.leaf_count(), 1);
+  EXPECT_EQ(PackedSearch(packed, DlRect::MakeLTRB(15, 15, 30, 30)),
+            std::vector<int>{0});
+  EXPECT_TRUE(PackedSearch(packed, DlRect::MakeLTRB(20, 20, 30, 30)).empty());
+  EXPECT_TRUE(PackedSearch(packed, DlRect::MakeLTRB(15, 15, 15, 30)).empty());
+}
+
+TEST(DisplayListPackedRTree, MatchesRTreeSearch) {
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float> position(0.0f, 2000.0f);
+  std::uniform_real_distribution<float> size(1.0f, 100.0f);
+  for (int count : {2, 15, 16, 17, 255, 256, 257, 5000}) {
+    std::vector<DlRect> rects;
+    std::vector<int> ids;
+    for (int i = 0; i < count; i++) {
+      rects.push_back(
+          DlRect::MakeXYWH(position(random), position(random), size(random),
+                           size(random)));
+      ids.push_back(i * 3);
+    }
+    DlRTree rtree(rects.data(), count, ids.data());
+    DlPackedRTree packed(rtree);
+    ASSERT_EQ(packed.leaf_count(), rtree.leaf_count());
+    for (int q = 0; q < 50; q++) {
+      DlRect query = DlRect::MakeXYWH(position(random), position(random),
+                                      size(random) * 5, size(random) * 5);
+      auto desc = "count = " + std::to_string(count) +
+                  ", query = " + std::to_string(q);
+      EXPECT_EQ(PackedSearch(packed, query), RTreeSearch(rtree, query))
+          << desc;
+    }
+    DlRect everything = DlRect::MakeLTRB(-1, -1, 3000, 3000);
+    EXPECT_EQ(PackedSearch(packed, everything).size(),
+              static_cast<size_t>(count));
+  }
+}
+
+TEST(DisplayListPackedRTree, SortedLeavesKeepTheirOrder) {
+  std::vector<DlRect> rects;
+  for (int i = 0; i < 1000; i++) {
+    rects.push_back(DlRect::MakeXYWH((i % 3) * 100, (i / 3) * 50, 80, 40));
+  }
+  DlRTree rtree(rects.data(), rects.size());
+  DlPackedRTree packed(rtree);
+  EXPECT_TRUE(packed.leaves_in_order());
+
+  std::vector<int> visited;
+  DlRect query = DlRect::MakeLTRB(50, 1000, 250, 3000);
+  packed.ForEachHit(query, [&visited](int leaf) {
+    visited.push_back(leaf);
+    return true;
+  });
+  EXPECT_EQ(visited, RTreeSearch(rtree, query));
+}
+
+TEST(DisplayListPackedRTree, ShuffledLeavesUseHilbertOrder) {
+  std::vector<DlRect> rects;
+  for (int i = 0; i < 1000; i++) {
+    rects.push_back(DlRect::MakeXYWH((i % 40) * 10, (i / 40) * 10, 10, 10));
+  }
+  std::shuffle(rects.begin(), rects.end(), std::mt19937(42));
+  DlRTree rtree(rects.data(), rects.size());
+  DlPackedRTree packed(rtree);
+  EXPECT_FALSE(packed.leaves_in_order());
+
+  DlRect query = DlRect::MakeLTRB(95, 95, 205, 205);
+  EXPECT_EQ(PackedSearch(packed, query), RTreeSearch(rtree, query));
+}
+
+TEST(DisplayListPackedRTree, ForEachHitStopsEarly) {
+  std::vector<DlRect> rects;
+  for (int i = 0; i < 1000; i++) {
+    rects.push_back(DlRect::MakeXYWH(0, i * 10, 100, 10));
+  }
+  DlRTree rtree(rects.data(), rects.size());
+  DlPackedRTree packed(rtree);
+  int visited = 0;
+  packed.ForEachHit(DlRect::MakeLTRB(0, 0, 100, 10000), [&visited](int leaf) {
+    visited++;
+    return visited < 5;
+  });
+  EXPECT_EQ(visited, 5);
+}
+
+TEST(DisplayListPackedRTree, ForEachHitReportsEachLeafOnce) {
+  std::vector<DlRect> rects;
+  for (int i = 0; i < 1000; i++) {
+    rects.push_back(DlRect::MakeXYWH((i % 40) * 10, (i / 40) * 10, 10, 10));
+  }
+  DlRTree rtree(rects.data(), rects.size());
+  DlPackedRTree packed(rtree);
+  std::vector<int> counts(rects.size(), 0);
+  packed.ForEachHit(DlRect::MakeLTRB(95, 95, 205, 205), [&counts](int leaf) {
+    counts[leaf]++;
+    return true;
+  });
+  for (size_t i = 0; i < rects.size(); i++) {
+    bool intersects = rects[i].IntersectsWithRect(
+        DlRect::MakeLTRB(95, 95, 205, 205));
+    EXPECT_EQ(counts[i], intersects ? 1 : 0) << "leaf " << i;
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
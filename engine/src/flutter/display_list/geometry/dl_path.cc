@@ -7,6 +7,7 @@
 #include "flutter/display_list/geometry/dl_geometry_conversions.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
 #include "flutter/display_list/geometry/dl_path_builder.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace {
 inline constexpr flutter::DlPathFillType ToDlFillType(SkPathFillType sk_type) {
@@ -248,6 +249,48 @@ bool DlPath::operator==(const DlPath& other) const {
   return GetSkPath() == other.GetSkPath();
 }
 
+uint64_t DlPath::GetContentHash() const {
+  if (data_->content_hash.has_value()) {
+    return data_->content_hash.value();
+  }
+  const SkPath& path = data_->sk_path;
+  std::size_t hash = fml::HashCombine(path.getFillType());
+  auto iterator = SkPath::Iter(path, false);
+  SkPoint points[4];
+  auto verb = SkPath::Verb::kDone_Verb;
+  do {
+    verb = iterator.next(points);
+    fml::HashCombineSeed(hash, verb);
+    switch (verb) {
+      case SkPath::kMove_Verb:
+        fml::HashCombineSeed(hash, points[0].fX, points[0].fY);
+        break;
+      case SkPath::kLine_Verb:
+        fml::HashCombineSeed(hash, points[1].fX, points[1].fY);
+        break;
+      case SkPath::kQuad_Verb:
+        fml::HashCombineSeed(hash, points[1].fX, points[1].fY,  //
+                             points[2].fX, points[2].fY);
+        break;
+      case SkPath::kConic_Verb:
+        fml::HashCombineSeed(hash, points[1].fX, points[1].fY,  //
+                             points[2].fX, points[2].fY,        //
+                             iterator.conicWeight());
+        break;
+      case SkPath::kCubic_Verb:
+        fml::HashCombineSeed(hash, points[1].fX, points[1].fY,  //
+                             points[2].fX, points[2].fY,        //
+                             points[3].fX, points[3].fY);
+        break;
+      case SkPath::kClose_Verb:
+      case SkPath::kDone_Verb:
+        break;
+    }
+  } while (verb != SkPath::Verb::kDone_Verb);
+  data_->content_hash = hash;
+  return hash;
+}
+
 bool DlPath::IsVolatile() const {
   return GetSkPath().isVolatile();
 }
@@ -6,6 +6,7 @@
 #define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_PATH_H_
 
 #include <functional>
+#include <optional>
 
 #include "flutter/display_list/geometry/dl_geometry_types.h"
 #include "flutter/impeller/geometry/path_source.h"
@@ -93,6 +94,12 @@ class DlPath : public impeller::PathSource {
 
   bool operator==(const DlPath& other) const;
 
+  /// Returns a hash of the verbs, points, conic weights and fill type of
+  /// the path. Unlike the generation ID of the SkPath, it is the same for
+  /// paths that are rebuilt with the same contents every frame. It is
+  /// computed on the first call and shared by all of the copies of the path.
+  uint64_t GetContentHash() const;
+
   bool IsVolatile() const;
   bool IsConvex() const override;
 
@@ -106,6 +113,7 @@ class DlPath : public impeller::PathSource {
 
     SkPath sk_path;
     uint32_t render_count = 0u;
+    std::optional<uint64_t> content_hash;
   };
 
   std::shared_ptr<Data> data_;
@@ -816,6 +816,25 @@ TEST(DisplayListPath, DispatchImplicitMoveAfterClosePathBuilder) {
   TestPathDispatchImplicitMoveAfterClose(path_builder.TakePath());
 }
 
+TEST(DisplayListPath, ContentHashMatchesRebuiltPaths) {
+  auto make_path = [](DlScalar x) {
+    DlPathBuilder path_builder;
+    path_builder.MoveTo({x, 10});
+    path_builder.QuadraticCurveTo({50, 0}, {90, 10});
+    path_builder.ConicCurveTo({90, 50}, {50, 90}, 0.5f);
+    path_builder.CubicCurveTo({40, 90}, {20, 70}, {x, 50});
+    path_builder.Close();
+    return path_builder.TakePath();
+  };
+  DlPath path = make_path(10);
+
+  EXPECT_EQ(path.GetContentHash(), make_path(10).GetContentHash());
+  EXPECT_NE(path.GetContentHash(), make_path(11).GetContentHash());
+  EXPECT_NE(path.GetContentHash(),
+            path.WithFillType(DlPathFillType::kOdd).GetContentHash());
+  EXPECT_NE(path.GetContentHash(), DlPath().GetContentHash());
+}
+
 #ifndef NDEBUG
 // Tests that verify we don't try to use inverse path modes as they aren't
 // supported by either Flutter public APIs or Impeller
@@ -4,6 +4,9 @@
 
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -12,6 +15,126 @@ namespace flutter {
 // search.
 const int kBinarySearchThreshold = 10;
 
+// Threshold for switching from the active list scan to the sweep line
+// over a coverage tree when creating a region from a list of rectangles,
+// in terms of the average number of rectangles crossing each line of the
+// region. The active list scan visits all of them on every line, while the
+// sweep line only visits the rectangles starting or ending on a line, but
+// has a higher constant cost per rectangle.
+const int64_t kSweepLineMinAverageActiveRects = 1024;
+
+namespace {
+
+// Tracks how many times each interval between consecutive distinct x
+// coordinates is covered by the rectangles crossed by a sweep line, and
+// enumerates the covered spans within a range of x coordinates in time
+// proportional to their number times the depth of the tree.
+class CoverageTree {
+ public:
+  explicit CoverageTree(const std::vector<int32_t>& xs)
+      : xs_(xs),
+        interval_count_(xs.size() - 1),
+        counts_(interval_count_ * 4, 0),
+        states_(interval_count_ * 4, kUncovered) {
+    FML_DCHECK(xs.size() >= 2u);
+  }
+
+  // Adds |delta| to the cover count of the intervals from xs[left] to
+  // xs[right].
+  void update(size_t left, size_t right, int32_t delta) {
+    update(1, 0, interval_count_, left, right, delta);
+  }
+
+  // Calls |emit| with the left and right of each maximal covered span
+  // between xs[left] and xs[right], in increasing order.
+  template <typename Emit>
+  void collect(size_t left, size_t right, Emit&& emit) const {
+    int32_t span_left = 0;
+    int32_t span_right = 0;
+    bool has_span = false;
+    auto merge = [&](int32_t interval_left, int32_t interval_right) {
+      if (has_span && interval_left == span_right) {
+        span_right = interval_right;
+      } else {
+        if (has_span) {
+          emit(span_left, span_right);
+        }
+        span_left = interval_left;
+        span_right = interval_right;
+        has_span = true;
+      }
+    };
+    collect(1, 0, interval_count_, left, right, merge);
+    if (has_span) {
+      emit(span_left, span_right);
+    }
+  }
+
+ private:
+  enum State : uint8_t { kUncovered, kPartial, kCovered };
+
+  void update(size_t node,
+              size_t lo,
+              size_t hi,
+              size_t left,
+              size_t right,
+              int32_t delta) {
+    if (right <= lo || hi <= left) {
+      return;
+    }
+    if (left <= lo && hi <= right) {
+      counts_[node] += delta;
+      FML_DCHECK(counts_[node] >= 0);
+    } else {
+      size_t mid = (lo + hi) / 2;
+      update(node * 2, lo, mid, left, right, delta);
+      update(node * 2 + 1, mid, hi, left, right, delta);
+    }
+    if (counts_[node] > 0) {
+      states_[node] = kCovered;
+    } else if (hi - lo == 1) {
+      states_[node] = kUncovered;
+    } else if (states_[node * 2] == states_[node * 2 + 1] &&
+               states_[node * 2] != kPartial) {
+      states_[node] = states_[node * 2];
+    } else {
+      states_[node] = kPartial;
+    }
+  }
+
+  template <typename Merge>
+  void collect(size_t node,
+               size_t lo,
+               size_t hi,
+               size_t left,
+               size_t right,
+               Merge& merge) const {
+    if (right <= lo || hi <= left) {
+      return;
+    }
+    switch (states_[node]) {
+      case kUncovered:
+        return;
+      case kCovered:
+        merge(xs_[std::max(lo, left)], xs_[std::min(hi, right)]);
+        return;
+      case kPartial: {
+        size_t mid = (lo + hi) / 2;
+        collect(node * 2, lo, mid, left, right, merge);
+        collect(node * 2 + 1, mid, hi, left, right, merge);
+        return;
+      }
+    }
+  }
+
+  const std::vector<int32_t>& xs_;
+  const size_t interval_count_;
+  std::vector<int32_t> counts_;
+  std::vector<State> states_;
+};
+
+}  // namespace
+
 DlRegion::SpanBuffer::SpanBuffer(DlRegion::SpanBuffer&& m)
     : capacity_(m.capacity_), size_(m.size_), spans_(m.spans_) {
   m.size_ = 0;
@@ -248,16 +371,86 @@ size_t DlRegion::intersectLineSpans(std::vector<Span>& res,
   return new_span - res.data();
 }
 
+size_t DlRegion::subtractLineSpans(std::vector<Span>& res,
+                                   const SpanBuffer& a_buffer,
+                                   SpanChunkHandle a_handle,
+                                   const SpanBuffer& b_buffer,
+                                   SpanChunkHandle b_handle) {
+  const Span *begin1, *end1;
+  a_buffer.getSpans(a_handle, begin1, end1);
+
+  const Span *begin2, *end2;
+  b_buffer.getSpans(b_handle, begin2, end2);
+
+  // Worst case scenario, every span of b splits a span of a in two
+  //   AAAAAAAAAAAAAA
+  //     XX  YY  ZZ
+  size_t min_size = (end1 - begin1) + (end2 - begin2);
+  if (res.size() < min_size) {
+    res.resize(min_size);
+  }
+
+  // Pointer to the next span to be written.
+  Span* new_span = res.data();
+
+  for (; begin1 != end1; ++begin1) {
+    int32_t left = begin1->left;
+    int32_t right = begin1->right;
+    while (begin2 != end2 && begin2->right <= left) {
+      ++begin2;
+    }
+    // The spans of b that overlap this span of a may also overlap the
+    // next one, so they are only skipped by the loop above.
+    for (const Span* cut = begin2; cut != end2 && cut->left < right; ++cut) {
+      if (cut->left > left) {
+        *new_span++ = {left, cut->left};
+      }
+      left = cut->right;
+      if (left >= right) {
+        break;
+      }
+    }
+    if (left < right) {
+      *new_span++ = {left, right};
+    }
+  }
+  FML_DCHECK(new_span <= res.data() + res.size());
+
+  return new_span - res.data();
+}
+
 void DlRegion::setRects(const std::vector<DlIRect>& unsorted_rects) {
   // setRects can only be called on empty regions.
   FML_DCHECK(lines_.empty());
 
-  size_t count = unsorted_rects.size();
-  std::vector<const DlIRect*> rects(count);
-  for (size_t i = 0; i < count; i++) {
-    rects[i] = &unsorted_rects[i];
-    bounds_ = bounds_.Union(unsorted_rects[i]);
+  if (unsorted_rects.size() >=
+      static_cast<size_t>(kSweepLineMinAverageActiveRects)) {
+    int64_t total_height = 0;
+    DlIRect bounds;
+    for (const DlIRect& rect : unsorted_rects) {
+      if (!rect.IsEmpty()) {
+        total_height += rect.GetHeight();
+        bounds = bounds.Union(rect);
+      }
+    }
+    if (total_height >=
+        bounds.GetHeight() * kSweepLineMinAverageActiveRects) {
+      setRectsWithSweepLine(unsorted_rects);
+      return;
+    }
+  }
+
+  // Empty rects do not contribute to the region and are left out of the
+  // active list entirely.
+  std::vector<const DlIRect*> rects;
+  rects.reserve(unsorted_rects.size());
+  for (const DlIRect& rect : unsorted_rects) {
+    if (!rect.IsEmpty()) {
+      rects.push_back(&rect);
+      bounds_ = bounds_.Union(rect);
+    }
   }
+  size_t count = rects.size();
   std::sort(rects.begin(), rects.end(), [](const DlIRect* a, const DlIRect* b) {
     if (a->GetTop() < b->GetTop()) {
       return true;
@@ -387,6 +580,105 @@ void DlRegion::setRects(const std::vector<DlIRect>& unsorted_rects) {
 #endif
 }
 
+void DlRegion::setRectsWithSweepLine(const std::vector<DlIRect>& rects) {
+  // setRects can only be called on empty regions.
+  FML_DCHECK(lines_.empty());
+
+  // Collect the distinct x coordinates of the non-empty rectangles, which
+  // delimit the intervals tracked by the coverage tree.
+  std::vector<int32_t> xs;
+  xs.reserve(rects.size() * 2);
+  for (const DlIRect& rect : rects) {
+    if (!rect.IsEmpty()) {
+      xs.push_back(rect.GetLeft());
+      xs.push_back(rect.GetRight());
+      bounds_ = bounds_.Union(rect);
+    }
+  }
+  if (xs.empty()) {
+    return;
+  }
+  std::sort(xs.begin(), xs.end());
+  xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+  auto x_index = [&xs](int32_t x) {
+    return static_cast<uint32_t>(std::lower_bound(xs.begin(), xs.end(), x) -
+                                 xs.begin());
+  };
+
+  // Each rectangle adds to the coverage of its intervals at its top and
+  // removes it again at its bottom.
+  struct Event {
+    int32_t y;
+    int32_t delta;
+    uint32_t left;
+    uint32_t right;
+  };
+  std::vector<Event> events;
+  events.reserve(xs.size());
+  for (const DlIRect& rect : rects) {
+    if (!rect.IsEmpty()) {
+      uint32_t left = x_index(rect.GetLeft());
+      uint32_t right = x_index(rect.GetRight());
+      events.push_back({rect.GetTop(), 1, left, right});
+      events.push_back({rect.GetBottom(), -1, left, right});
+    }
+  }
+  std::sort(events.begin(), events.end(),
+            [](const Event& a, const Event& b) { return a.y < b.y; });
+
+  // The coverage only changes between the left and right of the rects
+  // starting or ending at each event, so the spans of the previous line
+  // outside of that range are reused and only the spans within it are
+  // collected from the tree.
+  CoverageTree coverage(xs);
+  SpanVec spans;
+  SpanVec next_spans;
+  size_t next_event = 0;
+  while (next_event < events.size()) {
+    int32_t cur_y = events[next_event].y;
+    uint32_t dirty_left = std::numeric_limits<uint32_t>::max();
+    uint32_t dirty_right = 0u;
+    while (next_event < events.size() && events[next_event].y == cur_y) {
+      const Event& event = events[next_event++];
+      coverage.update(event.left, event.right, event.delta);
+      dirty_left = std::min(dirty_left, event.left);
+      dirty_right = std::max(dirty_right, event.right);
+    }
+    if (next_event == events.size()) {
+      break;
+    }
+
+    // Extend the range to cover the previous spans that overlap or touch
+    // it, so that the spans outside of it stay separate from the spans
+    // collected within it.
+    int32_t range_left = xs[dirty_left];
+    int32_t range_right = xs[dirty_right];
+    auto first = std::lower_bound(
+        spans.begin(), spans.end(), range_left,
+        [](const Span& span, int32_t x) { return span.right < x; });
+    auto last = std::upper_bound(
+        first, spans.end(), range_right,
+        [](int32_t x, const Span& span) { return x < span.left; });
+    if (first != last) {
+      range_left = std::min(range_left, first->left);
+      range_right = std::max(range_right, (last - 1)->right);
+    }
+
+    next_spans.assign(spans.begin(), first);
+    coverage.collect(x_index(range_left), x_index(range_right),
+                     [&next_spans](int32_t left, int32_t right) {
+                       next_spans.emplace_back(left, right);
+                     });
+    next_spans.insert(next_spans.end(), last, spans.end());
+    std::swap(spans, next_spans);
+
+    if (!spans.empty()) {
+      appendLine(cur_y, events[next_event].y, spans.data(),
+                 spans.data() + spans.size());
+    }
+  }
+}
+
 void DlRegion::appendLine(int32_t top,
                           int32_t bottom,
                           const Span* begin,
@@ -557,6 +849,91 @@ DlRegion DlRegion::MakeIntersection(const DlRegion& a, const DlRegion& b) {
   return res;
 }
 
+DlRegion DlRegion::MakeDifference(const DlRegion& a, const DlRegion& b) {
+  if (a.isEmpty() || b.isEmpty() ||
+      !a.bounds_.IntersectsWithRect(b.bounds_)) {
+    return a;
+  } else if (b.isSimple() && b.bounds_.Contains(a.bounds_)) {
+    return DlRegion();
+  }
+
+  DlRegion res;
+  res.span_buffer_.reserve(a.span_buffer_.capacity() +
+                           b.span_buffer_.capacity());
+
+  auto& lines = res.lines_;
+  lines.reserve(a.lines_.size() + b.lines_.size());
+
+  auto a_it = a.lines_.begin();
+  auto b_it = b.lines_.begin();
+  auto a_end = a.lines_.end();
+  auto b_end = b.lines_.end();
+
+  auto& a_buffer = a.span_buffer_;
+  auto& b_buffer = b.span_buffer_;
+
+  std::vector<Span> tmp;
+
+  auto append_line = [&res](int32_t top, int32_t bottom, const Span* begin,
+                            const Span* end) {
+    res.appendLine(top, bottom, begin, end);
+    res.bounds_ = res.bounds_.Union(
+        DlIRect::MakeLTRB(begin->left, top, (end - 1)->right, bottom));
+  };
+
+  int32_t cur_top = std::numeric_limits<int32_t>::min();
+
+  while (a_it != a_end) {
+    auto a_top = std::max(cur_top, a_it->top);
+    while (b_it != b_end && b_it->bottom <= a_top) {
+      ++b_it;
+    }
+    if (b_it == b_end || a_it->bottom <= b_it->top) {
+      // Nothing is subtracted from the rest of this line.
+      const Span *begin, *end;
+      a_buffer.getSpans(a_it->chunk_handle, begin, end);
+      append_line(a_top, a_it->bottom, begin, end);
+      cur_top = a_it->bottom;
+      ++a_it;
+    } else if (a_top < b_it->top) {
+      // Nothing is subtracted from the part of this line above b.
+      const Span *begin, *end;
+      a_buffer.getSpans(a_it->chunk_handle, begin, end);
+      append_line(a_top, b_it->top, begin, end);
+      cur_top = b_it->top;
+    } else {
+      auto bottom = std::min(a_it->bottom, b_it->bottom);
+      FML_DCHECK(a_top < bottom);
+      auto size = subtractLineSpans(tmp, a_buffer, a_it->chunk_handle,
+                                    b_buffer, b_it->chunk_handle);
+      if (size > 0) {
+        append_line(a_top, bottom, tmp.data(), tmp.data() + size);
+      }
+      cur_top = bottom;
+      if (cur_top == a_it->bottom) {
+        ++a_it;
+      }
+    }
+  }
+
+  return res;
+}
+
+DlRegion DlRegion::MakeUnion(const DlRegion& a,
+                             const std::vector<DlIRect>& rects) {
+  return MakeUnion(a, DlRegion(rects));
+}
+
+DlRegion DlRegion::MakeIntersection(const DlRegion& a,
+                                    const std::vector<DlIRect>& rects) {
+  return MakeIntersection(a, DlRegion(rects));
+}
+
+DlRegion DlRegion::MakeDifference(const DlRegion& a,
+                                  const std::vector<DlIRect>& rects) {
+  return MakeDifference(a, DlRegion(rects));
+}
+
 std::vector<DlIRect> DlRegion::getRects(bool deband) const {
   std::vector<DlIRect> rects;
   if (isEmpty()) {
@@ -22,6 +22,9 @@ class DlRegion {
 
   /// Creates region by bulk adding the rectangles.
   /// Matches SkRegion::op(rect, SkRegion::kUnion_Op) behavior.
+  /// Large lists of rectangles are processed with a sweep line over a
+  /// coverage tree, which takes O(n log n) time plus time proportional to
+  /// the size of the resulting region.
   explicit DlRegion(const std::vector<DlIRect>& rects);
 
   /// Creates region covering area of a rectangle.
@@ -41,6 +44,26 @@ class DlRegion {
   /// Matches SkRegion a; a.op(b, SkRegion::kIntersect_Op) behavior.
   static DlRegion MakeIntersection(const DlRegion& a, const DlRegion& b);
 
+  /// Creates region covering the area of region a that is not in region b.
+  /// Matches SkRegion a; a.op(b, SkRegion::kDifference_Op) behavior.
+  static DlRegion MakeDifference(const DlRegion& a, const DlRegion& b);
+
+  /// Creates union region of region a and all of the rectangles.
+  /// The rectangles are combined into a single region first, which is
+  /// much faster than adding them to region a one at a time.
+  static DlRegion MakeUnion(const DlRegion& a,
+                            const std::vector<DlIRect>& rects);
+
+  /// Creates region covering the area of region a that is inside any of
+  /// the rectangles.
+  static DlRegion MakeIntersection(const DlRegion& a,
+                                   const std::vector<DlIRect>& rects);
+
+  /// Creates region covering the area of region a that is outside all of
+  /// the rectangles.
+  static DlRegion MakeDifference(const DlRegion& a,
+                                 const std::vector<DlIRect>& rects);
+
   /// Returns list of non-overlapping rectangles that cover current region.
   /// If |deband| is false, each span line will result in separate rectangles,
   /// closely matching SkRegion::Iterator behavior.
@@ -119,6 +142,7 @@ class DlRegion {
   };
 
   void setRects(const std::vector<DlIRect>& rects);
+  void setRectsWithSweepLine(const std::vector<DlIRect>& rects);
 
   void appendLine(int32_t top,
                   int32_t bottom,
@@ -149,6 +173,11 @@ class DlRegion {
                                    SpanChunkHandle a_handle,
                                    const SpanBuffer& b_buffer,
                                    SpanChunkHandle b_handle);
+  static size_t subtractLineSpans(std::vector<Span>& res,
+                                  const SpanBuffer& a_buffer,
+                                  SpanChunkHandle a_handle,
+                                  const SpanBuffer& b_buffer,
+                                  SpanChunkHandle b_handle);
 
   bool spansEqual(SpanLine& line, const Span* begin, const Span* end) const;
 
@@ -358,6 +358,113 @@ TEST(DisplayListRegion, UnionEmpty) {
   }
 }
 
+TEST(DisplayListRegion, Difference1) {
+  DlRegion region1({
+      DlIRect::MakeXYWH(0, 0, 40, 40),
+  });
+  DlRegion region2({
+      DlIRect::MakeXYWH(10, 10, 20, 20),
+  });
+  DlRegion d = DlRegion::MakeDifference(region1, region2);
+  EXPECT_EQ(d.bounds(), DlIRect::MakeXYWH(0, 0, 40, 40));
+  std::vector<DlIRect> expected{
+      DlIRect::MakeLTRB(0, 0, 40, 10),
+      DlIRect::MakeLTRB(0, 10, 10, 30),
+      DlIRect::MakeLTRB(30, 10, 40, 30),
+      DlIRect::MakeLTRB(0, 30, 40, 40),
+  };
+  EXPECT_EQ(d.getRects(false), expected);
+}
+
+TEST(DisplayListRegion, Difference2) {
+  DlRegion region1({
+      DlIRect::MakeXYWH(0, 0, 20, 20),
+      DlIRect::MakeXYWH(40, 0, 20, 20),
+  });
+  DlRegion region2({
+      DlIRect::MakeXYWH(10, 0, 40, 30),
+  });
+  DlRegion d = DlRegion::MakeDifference(region1, region2);
+  EXPECT_EQ(d.bounds(), DlIRect::MakeLTRB(0, 0, 60, 20));
+  std::vector<DlIRect> expected{
+      DlIRect::MakeLTRB(0, 0, 10, 20),
+      DlIRect::MakeLTRB(50, 0, 60, 20),
+  };
+  EXPECT_EQ(d.getRects(false), expected);
+}
+
+TEST(DisplayListRegion, DifferenceEmpty) {
+  DlRegion region1({
+      DlIRect::MakeXYWH(10, 10, 20, 20),
+  });
+  DlRegion region2({
+      DlIRect::MakeXYWH(0, 0, 40, 40),
+  });
+  DlRegion d = DlRegion::MakeDifference(region1, region2);
+  EXPECT_TRUE(d.isEmpty());
+  EXPECT_TRUE(d.bounds().IsEmpty());
+
+  d = DlRegion::MakeDifference(region1, DlRegion());
+  EXPECT_EQ(d.getRects(), region1.getRects());
+
+  d = DlRegion::MakeDifference(DlRegion(), region2);
+  EXPECT_TRUE(d.isEmpty());
+}
+
+TEST(DisplayListRegion, OperationsWithRectList) {
+  DlRegion region({
+      DlIRect::MakeXYWH(0, 0, 40, 40),
+  });
+  std::vector<DlIRect> rects{
+      DlIRect::MakeXYWH(20, 0, 40, 20),
+      DlIRect::MakeXYWH(20, 20, 40, 20),
+  };
+  EXPECT_EQ(DlRegion::MakeUnion(region, rects).getRects(),
+            std::vector<DlIRect>{DlIRect::MakeXYWH(0, 0, 60, 40)});
+  EXPECT_EQ(DlRegion::MakeIntersection(region, rects).getRects(),
+            std::vector<DlIRect>{DlIRect::MakeXYWH(20, 0, 20, 40)});
+  EXPECT_EQ(DlRegion::MakeDifference(region, rects).getRects(),
+            std::vector<DlIRect>{DlIRect::MakeXYWH(0, 0, 20, 40)});
+}
+
+TEST(DisplayListRegion, EmptyRectanglesAreIgnored) {
+  for (size_t count : {10u, 5000u}) {
+    std::vector<DlIRect> rects;
+    for (size_t i = 0; i < count; ++i) {
+      rects.push_back(DlIRect::MakeXYWH(i % 10, 0, 0, 100));
+      rects.push_back(DlIRect::MakeXYWH(i % 10, 0, 10, 100));
+    }
+    DlRegion region(rects);
+    EXPECT_EQ(region.bounds(), DlIRect::MakeLTRB(0, 0, 19, 100));
+    EXPECT_EQ(region.getRects(),
+              std::vector<DlIRect>{DlIRect::MakeLTRB(0, 0, 19, 100)});
+  }
+}
+
+TEST(DisplayListRegion, ManyOverlappingRectanglesMatchUnion) {
+  // Enough tall rectangles to be combined with a sweep line rather than
+  // the active list scan.
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution pos(0, 1000);
+  std::uniform_int_distribution width(1, 20);
+  std::uniform_int_distribution height(500, 1000);
+  std::vector<DlIRect> rects;
+  for (int i = 0; i < 3000; ++i) {
+    rects.push_back(DlIRect::MakeXYWH(pos(rng) * 4, pos(rng) / 2, width(rng),
+                                      height(rng)));
+  }
+  DlRegion region(rects);
+
+  DlRegion expected;
+  for (size_t i = 0; i < rects.size(); i += 100) {
+    std::vector<DlIRect> chunk(rects.begin() + i, rects.begin() + i + 100);
+    expected = DlRegion::MakeUnion(expected, DlRegion(chunk));
+  }
+  EXPECT_EQ(region.bounds(), expected.bounds());
+  EXPECT_EQ(region.getRects(false), expected.getRects(false));
+}
+
 void CheckEquality(const DlRegion& dl_region, const SkRegion& sk_region) {
   EXPECT_EQ(dl_region.bounds(), ToDlIRect(sk_region.getBounds()));
 
@@ -442,10 +549,36 @@ TEST(DisplayListRegion, TestAgainstSkRegion) {
         SkRegion sk_intersection(sk_region1);
         sk_intersection.op(sk_region2, SkRegion::kIntersect_Op);
         CheckEquality(dl_intersection, sk_intersection);
+
+        DlRegion dl_difference = DlRegion::MakeDifference(region1, region2);
+        SkRegion sk_difference(sk_region1);
+        sk_difference.op(sk_region2, SkRegion::kDifference_Op);
+        CheckEquality(dl_difference, sk_difference);
       }
     }
   }
 }
 
+TEST(DisplayListRegion, TestAgainstSkRegionManyRects) {
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+
+  for (int max_size : {100, 1500}) {
+    std::uniform_int_distribution pos(0, 4000);
+    std::uniform_int_distribution size(1, max_size);
+
+    std::vector<DlIRect> rects_in;
+    for (int i = 0; i < 10000; ++i) {
+      rects_in.push_back(
+          DlIRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng)));
+    }
+
+    DlRegion region(rects_in);
+    SkRegion sk_region;
+    sk_region.setRects(ToSkIRects(rects_in.data()), rects_in.size());
+    CheckEquality(region, sk_region);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -139,6 +139,14 @@ DlRTree::DlRTree(const DlRect rects[],
   FML_DCHECK(gen_start + gen_count == total_node_count);
 }
 
+DlRTree::DlRTree(std::vector<Node> nodes, int leaf_count, int invalid_id)
+    : nodes_(std::move(nodes)),
+      leaf_count_(leaf_count),
+      invalid_id_(invalid_id) {
+  FML_DCHECK(leaf_count_ >= 0);
+  FML_DCHECK(static_cast<size_t>(leaf_count_) <= nodes_.size());
+}
+
 void DlRTree::search(const DlRect& query, std::vector<int>* results) const {
   FML_DCHECK(results != nullptr);
   if (query.IsEmpty()) {
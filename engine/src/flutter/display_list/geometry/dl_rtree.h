@@ -138,6 +138,11 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr DlRect kEmpty = DlRect();
 
+  // Adopts a node list that was previously produced by the public
+  // constructor, used by |DisplayListSerialization| to restore an
+  // R-Tree without recomputing its internal nodes.
+  DlRTree(std::vector<Node> nodes, int leaf_count, int invalid_id);
+
   void search(const Node& parent,
               const DlRect& query,
               std::vector<int>* results) const;
@@ -146,6 +151,8 @@ class DlRTree : public SkRefCnt {
   int leaf_count_ = 0;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
+
+  friend class DisplayListSerialization;
 };
 
 }  // namespace flutter
@@ -27,6 +27,9 @@ class DlSkCanvasDispatcher : public virtual DlOpReceiver,
 
   const SkPaint* safe_paint(bool use_attributes);
 
+  // |DlOpReceiver|
+  bool IsRenderingReceiver() const override { return true; }
+
   void save() override;
   void restore() override;
   void saveLayer(const DlRect& bounds,
@@ -5,6 +5,7 @@
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
 
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/geometry/dl_bulk_bounds.h"
 #include "flutter/fml/logging.h"
 #include "flutter/impeller/geometry/round_superellipse_param.h"
 
@@ -32,7 +33,7 @@ bool DisplayListMatrixClipState::inverseTransform(
 
 bool DisplayListMatrixClipState::mapAndClipRect(const DlRect& src,
                                                 DlRect* mapped) const {
-  DlRect dl_mapped = src.TransformAndClipBounds(matrix_);
+  DlRect dl_mapped = transformBounds(src);
   auto dl_intersected = dl_mapped.Intersection(cull_rect_);
   if (dl_intersected.has_value()) {
     *mapped = dl_intersected.value();
@@ -42,6 +43,13 @@ bool DisplayListMatrixClipState::mapAndClipRect(const DlRect& src,
   return false;
 }
 
+DlRect DisplayListMatrixClipState::transformBounds(const DlRect& src) const {
+  if (matrix_.HasPerspective2D()) {
+    return src.TransformAndClipBounds(matrix_);
+  }
+  return DlBulkBounds::TransformedRectBounds(matrix_, src);
+}
+
 void DisplayListMatrixClipState::clipRect(const DlRect& rect,
                                           DlClipOp op,
                                           bool is_aa) {
@@ -95,7 +95,7 @@ class DisplayListMatrixClipState {
 
   bool mapRect(DlRect* rect) const { return mapRect(*rect, rect); }
   bool mapRect(const DlRect& src, DlRect* mapped) const {
-    *mapped = src.TransformAndClipBounds(matrix_);
+    *mapped = transformBounds(src);
     return matrix_.IsAligned2D();
   }
 
@@ -165,6 +165,10 @@ class DisplayListMatrixClipState {
 
   void adjustCullRect(const DlRect& clip, DlClipOp op, bool is_aa);
 
+  // Equivalent to |src.TransformAndClipBounds(matrix_)|, using the bulk
+  // bounds kernels for matrices without perspective.
+  DlRect transformBounds(const DlRect& src) const;
+
   static bool GetLocalCorners(DlPoint corners[4],
                               const DlRect& rect,
                               const DlMatrix& matrix);
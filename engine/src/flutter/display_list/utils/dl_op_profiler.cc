@@ -0,0 +1,450 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_op_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+std::atomic<bool> DlOpProfiler::enabled_ = false;
+
+namespace {
+
+// The call tree is keyed by op type for op nodes and by this key for
+// DisplayList nodes. Every DisplayList shares the key, so the size of the
+// tree only depends on the distinct paths of ops, not on the number of
+// DisplayLists that are created while the profiler runs. The time of each
+// DisplayList is kept in a separate, bounded table.
+constexpr uint64_t kDisplayListKey = uint64_t{1} << 32;
+
+bool IsDisplayListKey(uint64_t key) {
+  return key == kDisplayListKey;
+}
+
+uint64_t OpKey(DisplayListOpType type) {
+  return static_cast<uint64_t>(type);
+}
+
+struct CallNode {
+  uint64_t count = 0u;
+  uint64_t total_ns = 0u;
+  uint64_t self_ns = 0u;
+  std::map<uint64_t, std::unique_ptr<CallNode>> children;
+
+  CallNode* GetChild(uint64_t key) {
+    std::unique_ptr<CallNode>& child = children[key];
+    if (!child) {
+      child = std::make_unique<CallNode>();
+    }
+    return child.get();
+  }
+
+  void MergeFrom(const CallNode& other) {
+    count += other.count;
+    total_ns += other.total_ns;
+    self_ns += other.self_ns;
+    for (const auto& [key, child] : other.children) {
+      GetChild(key)->MergeFrom(*child);
+    }
+  }
+};
+
+struct TraceEvent {
+  uint64_t key;
+  uint32_t display_list_id;
+  uint32_t thread_index;
+  int64_t start_ns;
+  int64_t duration_ns;
+};
+
+struct Frame {
+  CallNode* node;
+  uint64_t key;
+  uint32_t display_list_id;
+  int64_t start_ns;
+  uint64_t child_ns;
+};
+
+// Samples are collected into a per-thread call tree without any locking
+// and merged into the global tree when the outermost dispatch on the
+// thread completes.
+using DisplayListStatsMap =
+    std::unordered_map<uint32_t, DlOpProfiler::DisplayListStats>;
+
+struct ThreadState {
+  uint32_t thread_index;
+  CallNode root;
+  DisplayListStatsMap display_lists;
+  std::vector<Frame> stack;
+  std::vector<TraceEvent> events;
+  size_t dropped_events = 0u;
+};
+
+struct GlobalState {
+  std::mutex mutex;
+  CallNode root;
+  DisplayListStatsMap display_lists;
+  std::vector<TraceEvent> events;
+  std::atomic<size_t> max_events = DlOpProfiler::kDefaultMaxTraceEvents;
+  size_t dropped_events = 0u;
+  int64_t origin_ns = 0;
+  std::atomic<uint32_t> next_thread_index = 1u;
+};
+
+GlobalState& GetGlobalState() {
+  static GlobalState* state = new GlobalState();
+  return *state;
+}
+
+ThreadState& GetThreadState() {
+  thread_local ThreadState state{
+      .thread_index = GetGlobalState().next_thread_index.fetch_add(
+          1u, std::memory_order_relaxed),
+  };
+  return state;
+}
+
+int64_t NowNanos() {
+  return fml::TimePoint::Now().ToEpochDelta().ToNanoseconds();
+}
+
+void PushFrame(ThreadState& state, uint64_t key, uint32_t display_list_id) {
+  CallNode* parent =
+      state.stack.empty() ? &state.root : state.stack.back().node;
+  state.stack.push_back({
+      .node = parent->GetChild(key),
+      .key = key,
+      .display_list_id = display_list_id,
+      .start_ns = NowNanos(),
+      .child_ns = 0u,
+  });
+}
+
+void PopFrame(ThreadState& state) {
+  FML_DCHECK(!state.stack.empty());
+  Frame frame = state.stack.back();
+  state.stack.pop_back();
+
+  int64_t end_ns = NowNanos();
+  uint64_t elapsed_ns = static_cast<uint64_t>(end_ns - frame.start_ns);
+  frame.node->count++;
+  frame.node->total_ns += elapsed_ns;
+  uint64_t self_ns = elapsed_ns - std::min(elapsed_ns, frame.child_ns);
+  frame.node->self_ns += self_ns;
+  if (!state.stack.empty()) {
+    state.stack.back().child_ns += elapsed_ns;
+  }
+
+  DlOpProfiler::DisplayListStats& stats =
+      state.display_lists[frame.display_list_id];
+  stats.unique_id = frame.display_list_id;
+  if (IsDisplayListKey(frame.key)) {
+    stats.dispatch_count++;
+    stats.total_ns += elapsed_ns;
+  } else {
+    stats.op_count++;
+    stats.self_ns += self_ns;
+  }
+
+  GlobalState& global = GetGlobalState();
+  if (state.events.size() < global.max_events.load(std::memory_order_relaxed)) {
+    state.events.push_back({
+        .key = frame.key,
+        .display_list_id = frame.display_list_id,
+        .thread_index = state.thread_index,
+        .start_ns = frame.start_ns,
+        .duration_ns = static_cast<int64_t>(elapsed_ns),
+    });
+  } else {
+    state.dropped_events++;
+  }
+}
+
+// Keeps the DisplayLists with the most total time once more than
+// |kMaxDisplayListStats| have been recorded. Half of them are dropped at a
+// time, so that the cost of the eviction is amortized over many merges.
+void EvictDisplayListStats(DisplayListStatsMap& display_lists) {
+  if (display_lists.size() <= DlOpProfiler::kMaxDisplayListStats) {
+    return;
+  }
+  std::vector<uint64_t> total_times;
+  total_times.reserve(display_lists.size());
+  for (const auto& [unique_id, stats] : display_lists) {
+    total_times.push_back(stats.total_ns);
+  }
+  auto threshold = total_times.begin() + DlOpProfiler::kMaxDisplayListStats / 2;
+  std::nth_element(total_times.begin(), threshold, total_times.end(),
+                   std::greater<uint64_t>());
+  uint64_t min_total_ns = *threshold;
+  for (auto it = display_lists.begin(); it != display_lists.end();) {
+    if (it->second.total_ns <= min_total_ns) {
+      it = display_lists.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void MergeThreadState(ThreadState& state) {
+  GlobalState& global = GetGlobalState();
+  {
+    std::scoped_lock lock(global.mutex);
+    global.root.MergeFrom(state.root);
+    for (const auto& [unique_id, stats] : state.display_lists) {
+      DlOpProfiler::DisplayListStats& merged =
+          global.display_lists[unique_id];
+      merged.unique_id = unique_id;
+      merged.dispatch_count += stats.dispatch_count;
+      merged.op_count += stats.op_count;
+      merged.self_ns += stats.self_ns;
+      merged.total_ns += stats.total_ns;
+    }
+    EvictDisplayListStats(global.display_lists);
+    size_t room = global.max_events.load(std::memory_order_relaxed);
+    room -= std::min(room, global.events.size());
+    size_t kept = std::min(room, state.events.size());
+    global.events.insert(global.events.end(), state.events.begin(),
+                         state.events.begin() + kept);
+    global.dropped_events +=
+        state.dropped_events + (state.events.size() - kept);
+  }
+  state.root.children.clear();
+  state.display_lists.clear();
+  state.events.clear();
+  state.dropped_events = 0u;
+}
+
+void WriteFrameName(std::ostream& out, uint64_t key) {
+  if (IsDisplayListKey(key)) {
+    out << "DisplayList";
+  } else {
+    out << DlOpProfiler::GetOpTypeName(static_cast<DisplayListOpType>(key));
+  }
+}
+
+void WriteFoldedNode(std::ostream& out,
+                     const std::string& prefix,
+                     uint64_t key,
+                     const CallNode& node) {
+  std::ostringstream name;
+  WriteFrameName(name, key);
+  std::string path = prefix.empty() ? name.str() : prefix + ";" + name.str();
+  if (node.self_ns > 0u) {
+    out << path << " " << node.self_ns << "\n";
+  }
+  for (const auto& [child_key, child] : node.children) {
+    WriteFoldedNode(out, path, child_key, *child);
+  }
+}
+
+void CollectOpTypeStats(
+    uint64_t key,
+    const CallNode& node,
+    std::unordered_map<uint64_t, DlOpProfiler::OpTypeStats>& op_stats) {
+  if (!IsDisplayListKey(key)) {
+    auto [it, inserted] = op_stats.try_emplace(key);
+    DlOpProfiler::OpTypeStats& stats = it->second;
+    stats.type = static_cast<DisplayListOpType>(key);
+    stats.count += node.count;
+    stats.self_ns += node.self_ns;
+  }
+  for (const auto& [child_key, child] : node.children) {
+    CollectOpTypeStats(child_key, *child, op_stats);
+  }
+}
+
+}  // namespace
+
+const char* DlOpProfiler::GetOpTypeName(DisplayListOpType type) {
+  switch (type) {
+#define DL_OP_NAME(name)           \
+  case DisplayListOpType::k##name: \
+    return #name;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_NAME)
+
+#undef DL_OP_NAME
+
+    case DisplayListOpType::kInvalidOp:
+      break;
+  }
+  return "InvalidOp";
+}
+
+void DlOpProfiler::Start(size_t max_trace_events) {
+  GlobalState& global = GetGlobalState();
+  {
+    std::scoped_lock lock(global.mutex);
+    global.max_events.store(max_trace_events, std::memory_order_relaxed);
+    if (global.root.children.empty() && global.events.empty()) {
+      global.origin_ns = NowNanos();
+    }
+  }
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void DlOpProfiler::Stop() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void DlOpProfiler::Reset() {
+  GlobalState& global = GetGlobalState();
+  std::scoped_lock lock(global.mutex);
+  global.root.children.clear();
+  global.display_lists.clear();
+  global.events.clear();
+  global.dropped_events = 0u;
+  global.origin_ns = NowNanos();
+}
+
+std::vector<DlOpProfiler::OpTypeStats> DlOpProfiler::GetOpTypeStats() {
+  std::unordered_map<uint64_t, OpTypeStats> op_stats;
+  {
+    GlobalState& global = GetGlobalState();
+    std::scoped_lock lock(global.mutex);
+    for (const auto& [key, child] : global.root.children) {
+      CollectOpTypeStats(key, *child, op_stats);
+    }
+  }
+
+  std::vector<OpTypeStats> result;
+  result.reserve(op_stats.size());
+  for (const auto& [key, stats] : op_stats) {
+    result.push_back(stats);
+  }
+  std::sort(result.begin(), result.end(),
+            [](const OpTypeStats& a, const OpTypeStats& b) {
+              if (a.self_ns != b.self_ns) {
+                return a.self_ns > b.self_ns;
+              }
+              return a.type < b.type;
+            });
+  return result;
+}
+
+std::vector<DlOpProfiler::DisplayListStats>
+DlOpProfiler::GetDisplayListStats() {
+  std::vector<DisplayListStats> result;
+  {
+    GlobalState& global = GetGlobalState();
+    std::scoped_lock lock(global.mutex);
+    result.reserve(global.display_lists.size());
+    for (const auto& [unique_id, stats] : global.display_lists) {
+      result.push_back(stats);
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const DisplayListStats& a, const DisplayListStats& b) {
+              if (a.total_ns != b.total_ns) {
+                return a.total_ns > b.total_ns;
+              }
+              return a.unique_id < b.unique_id;
+            });
+  return result;
+}
+
+size_t DlOpProfiler::GetDroppedTraceEventCount() {
+  GlobalState& global = GetGlobalState();
+  std::scoped_lock lock(global.mutex);
+  return global.dropped_events;
+}
+
+void DlOpProfiler::WriteFoldedStacks(std::ostream& out) {
+  GlobalState& global = GetGlobalState();
+  std::scoped_lock lock(global.mutex);
+  for (const auto& [key, child] : global.root.children) {
+    WriteFoldedNode(out, "", key, *child);
+  }
+}
+
+void DlOpProfiler::WriteTraceEvents(std::ostream& out) {
+  GlobalState& global = GetGlobalState();
+  std::scoped_lock lock(global.mutex);
+
+  // Timestamps and durations are in microseconds, with the nanoseconds
+  // kept as a fraction.
+  auto write_micros = [&out](int64_t ns) {
+    if (ns < 0) {
+      out << "-";
+      ns = -ns;
+    }
+    out << ns / 1000 << ".";
+    int64_t fraction = ns % 1000;
+    out << static_cast<char>('0' + fraction / 100)
+        << static_cast<char>('0' + fraction / 10 % 10)
+        << static_cast<char>('0' + fraction % 10);
+  };
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (const TraceEvent& event : global.events) {
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << "{\"name\":\"";
+    WriteFrameName(out, event.key);
+    out << "\",\"cat\":\"DisplayList\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+        << event.thread_index << ",\"ts\":";
+    write_micros(event.start_ns - global.origin_ns);
+    out << ",\"dur\":";
+    write_micros(event.duration_ns);
+    out << ",\"args\":{\"display_list\":" << event.display_list_id << "}}";
+  }
+  out << "\n],\"otherData\":{\"dropped_events\":" << global.dropped_events
+      << "}}\n";
+}
+
+bool DlOpProfiler::WriteToFile(const std::string& path) {
+  std::ofstream out(path, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    FML_LOG(ERROR) << "Could not open " << path
+                   << " to write the DisplayList op profile.";
+    return false;
+  }
+  constexpr std::string_view kJsonSuffix = ".json";
+  if (path.size() >= kJsonSuffix.size() &&
+      path.compare(path.size() - kJsonSuffix.size(), kJsonSuffix.size(),
+                   kJsonSuffix) == 0) {
+    WriteTraceEvents(out);
+  } else {
+    WriteFoldedStacks(out);
+  }
+  out.close();
+  return !out.fail();
+}
+
+DlOpProfileScope::DlOpProfileScope(uint32_t display_list_id) {
+  PushFrame(GetThreadState(), kDisplayListKey, display_list_id);
+}
+
+DlOpProfileScope::~DlOpProfileScope() {
+  ThreadState& state = GetThreadState();
+  PopFrame(state);
+  if (state.stack.empty()) {
+    MergeThreadState(state);
+  }
+}
+
+void DlOpProfileScope::BeginOp(DisplayListOpType type) {
+  ThreadState& state = GetThreadState();
+  FML_DCHECK(!state.stack.empty());
+  PushFrame(state, OpKey(type), state.stack.back().display_list_id);
+}
+
+void DlOpProfileScope::EndOp() {
+  PopFrame(GetThreadState());
+}
+
+}  // namespace flutter
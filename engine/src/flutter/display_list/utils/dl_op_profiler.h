@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_OP_PROFILER_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_OP_PROFILER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+
+namespace flutter {
+
+/// A process wide profiler that measures the time spent rasterizing each
+/// op of every DisplayList.
+///
+/// While the profiler is enabled, |DisplayList::Dispatch| times every op
+/// that it dispatches to a receiver that renders it, as reported by
+/// |DlOpReceiver::IsRenderingReceiver|, and attributes the time to the type
+/// of the op and to the |DisplayList::unique_id| of the list that contains
+/// it. The time of a DrawDisplayList op includes the time spent dispatching
+/// the nested DisplayList, which is recorded as a child of the op, so the
+/// collected samples form a call tree of op types that can be written out
+/// either as folded stacks for flamegraph tools or as Chrome trace events
+/// that can be loaded into Perfetto.
+///
+/// The profile stays bounded however long the profiler runs: the call tree
+/// only grows with the distinct nestings of op types, at most
+/// |kMaxDisplayListStats| DisplayLists are tracked, and at most
+/// |max_trace_events| trace events are kept.
+///
+/// When the profiler is disabled, the only cost is a relaxed atomic load
+/// for each call to |DisplayList::Dispatch|.
+class DlOpProfiler {
+ public:
+  /// The default maximum number of trace events that are kept.
+  static constexpr size_t kDefaultMaxTraceEvents = 1 << 20;
+
+  /// The maximum number of DisplayLists whose statistics are kept. When
+  /// more are recorded, the ones with the least total time are dropped.
+  static constexpr size_t kMaxDisplayListStats = 4096;
+
+  /// The aggregate time spent in all ops of one type, excluding the time
+  /// spent in the DisplayLists nested in those ops.
+  struct OpTypeStats {
+    DisplayListOpType type;
+    uint64_t count = 0u;
+    uint64_t self_ns = 0u;
+  };
+
+  /// The aggregate time spent dispatching the DisplayList with the
+  /// indicated unique id.
+  struct DisplayListStats {
+    uint32_t unique_id;
+
+    /// The number of times the DisplayList was dispatched.
+    uint64_t dispatch_count = 0u;
+
+    /// The number of ops dispatched from the DisplayList.
+    uint64_t op_count = 0u;
+
+    /// The time spent in the ops of the DisplayList, excluding the time
+    /// spent in the DisplayLists nested in those ops.
+    uint64_t self_ns = 0u;
+
+    /// The wall time of all of the dispatches of the DisplayList.
+    uint64_t total_ns = 0u;
+  };
+
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /// Starts collecting samples, in addition to any that were collected
+  /// before. At most |max_trace_events| individual ops and dispatches are
+  /// kept for |WriteTraceEvents|, the statistics of the op types and the
+  /// call tree are always complete.
+  static void Start(size_t max_trace_events = kDefaultMaxTraceEvents);
+
+  /// Stops collecting samples. Dispatches that are in progress on other
+  /// threads will still record their samples when they complete.
+  static void Stop();
+
+  /// Discards all of the collected samples.
+  static void Reset();
+
+  /// Returns the statistics of every op type that was dispatched, sorted
+  /// by decreasing self time.
+  static std::vector<OpTypeStats> GetOpTypeStats();
+
+  /// Returns the statistics of the DisplayLists that were dispatched, at
+  /// most |kMaxDisplayListStats| of them, sorted by decreasing total time.
+  static std::vector<DisplayListStats> GetDisplayListStats();
+
+  /// The number of trace events that were discarded because more than
+  /// |max_trace_events| were recorded.
+  static size_t GetDroppedTraceEventCount();
+
+  /// Writes the call tree in the folded stack format that is read by
+  /// flamegraph.pl, speedscope and similar tools, one line per distinct
+  /// stack with the self time in nanoseconds, e.g.:
+  ///
+  ///     DisplayList;DrawDisplayList;DisplayList;DrawRect 5120
+  static void WriteFoldedStacks(std::ostream& out);
+
+  /// Writes the recorded ops and dispatches as complete ("X") events in
+  /// the Chrome JSON trace event format.
+  static void WriteTraceEvents(std::ostream& out);
+
+  /// Writes the trace events if the path ends with ".json" and the folded
+  /// stacks otherwise. Returns false if the file could not be written.
+  static bool WriteToFile(const std::string& path);
+
+  /// Returns the name of the op type as it is written to the profiles,
+  /// e.g. "DrawRect".
+  static const char* GetOpTypeName(DisplayListOpType type);
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+/// Records the dispatch of one DisplayList, and of each of its ops, on
+/// the current thread. This is only used by |DisplayList::Dispatch| while
+/// the |DlOpProfiler| is enabled.
+class DlOpProfileScope {
+ public:
+  explicit DlOpProfileScope(uint32_t display_list_id);
+
+  ~DlOpProfileScope();
+
+  void BeginOp(DisplayListOpType type);
+
+  void EndOp();
+
+ private:
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(DlOpProfileScope);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_OP_PROFILER_H_
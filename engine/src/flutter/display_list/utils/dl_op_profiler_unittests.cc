@@ -0,0 +1,238 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_op_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class NestingReceiver : public IgnoreAttributeDispatchHelper,
+                        public IgnoreTransformDispatchHelper,
+                        public IgnoreClipDispatchHelper,
+                        public IgnoreDrawDispatchHelper {
+ public:
+  explicit NestingReceiver(bool is_rendering = true)
+      : is_rendering_(is_rendering) {}
+
+  bool IsRenderingReceiver() const override { return is_rendering_; }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    display_list->Dispatch(*this);
+  }
+
+ private:
+  const bool is_rendering_;
+};
+
+class DlOpProfilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { DlOpProfiler::Reset(); }
+
+  void TearDown() override {
+    DlOpProfiler::Stop();
+    DlOpProfiler::Reset();
+  }
+};
+
+sk_sp<DisplayList> MakeRectsDisplayList(int rect_count) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < rect_count; i++) {
+    builder.DrawRect(DlRect::MakeXYWH(i * 10, 0, 8, 8), DlPaint());
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST_F(DlOpProfilerTest, DisabledRecordsNothing) {
+  NestingReceiver receiver;
+  MakeRectsDisplayList(3)->Dispatch(receiver);
+
+  EXPECT_FALSE(DlOpProfiler::IsEnabled());
+  EXPECT_TRUE(DlOpProfiler::GetOpTypeStats().empty());
+  EXPECT_TRUE(DlOpProfiler::GetDisplayListStats().empty());
+}
+
+TEST_F(DlOpProfilerTest, OnlyRenderingReceiversAreRecorded) {
+  DlOpProfiler::Start();
+  NestingReceiver receiver(/*is_rendering=*/false);
+  MakeRectsDisplayList(3)->Dispatch(receiver);
+  DlOpProfiler::Stop();
+
+  EXPECT_TRUE(DlOpProfiler::GetOpTypeStats().empty());
+  EXPECT_TRUE(DlOpProfiler::GetDisplayListStats().empty());
+}
+
+TEST_F(DlOpProfilerTest, RecordsOpTypesAndDisplayLists) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder.DrawRect(DlRect::MakeLTRB(20, 0, 30, 10), DlPaint());
+  builder.DrawOval(DlRect::MakeLTRB(0, 20, 10, 30), DlPaint());
+  auto display_list = builder.Build();
+
+  DlOpProfiler::Start();
+  EXPECT_TRUE(DlOpProfiler::IsEnabled());
+  NestingReceiver receiver;
+  display_list->Dispatch(receiver);
+  display_list->Dispatch(receiver);
+  DlOpProfiler::Stop();
+
+  // Dispatches after the profiler is stopped are not recorded.
+  display_list->Dispatch(receiver);
+
+  auto op_stats = DlOpProfiler::GetOpTypeStats();
+  ASSERT_EQ(op_stats.size(), 2u);
+  uint64_t rect_count = 0u;
+  uint64_t oval_count = 0u;
+  for (const auto& stats : op_stats) {
+    if (stats.type == DisplayListOpType::kDrawRect) {
+      rect_count = stats.count;
+    } else if (stats.type == DisplayListOpType::kDrawOval) {
+      oval_count = stats.count;
+    }
+  }
+  EXPECT_EQ(rect_count, 4u);
+  EXPECT_EQ(oval_count, 2u);
+
+  auto dl_stats = DlOpProfiler::GetDisplayListStats();
+  ASSERT_EQ(dl_stats.size(), 1u);
+  EXPECT_EQ(dl_stats[0].unique_id, display_list->unique_id());
+  EXPECT_EQ(dl_stats[0].dispatch_count, 2u);
+  EXPECT_EQ(dl_stats[0].op_count, 6u);
+  EXPECT_LE(dl_stats[0].self_ns, dl_stats[0].total_ns);
+}
+
+TEST_F(DlOpProfilerTest, CulledDispatchIsRecorded) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder.DrawRect(DlRect::MakeLTRB(100, 100, 110, 110), DlPaint());
+  auto display_list = builder.Build();
+
+  DlOpProfiler::Start();
+  NestingReceiver receiver;
+  display_list->Dispatch(receiver, DlRect::MakeLTRB(0, 0, 20, 20));
+  DlOpProfiler::Stop();
+
+  auto dl_stats = DlOpProfiler::GetDisplayListStats();
+  ASSERT_EQ(dl_stats.size(), 1u);
+  EXPECT_EQ(dl_stats[0].dispatch_count, 1u);
+  EXPECT_EQ(dl_stats[0].op_count, 1u);
+}
+
+TEST_F(DlOpProfilerTest, NestedDisplayListsFormCallTree) {
+  auto inner = MakeRectsDisplayList(2);
+  DisplayListBuilder builder;
+  builder.DrawDisplayList(inner);
+  auto outer = builder.Build();
+
+  DlOpProfiler::Start();
+  NestingReceiver receiver;
+  outer->Dispatch(receiver);
+  DlOpProfiler::Stop();
+
+  auto dl_stats = DlOpProfiler::GetDisplayListStats();
+  ASSERT_EQ(dl_stats.size(), 2u);
+  // The outer DisplayList includes the time of the inner one.
+  EXPECT_EQ(dl_stats[0].unique_id, outer->unique_id());
+  EXPECT_EQ(dl_stats[1].unique_id, inner->unique_id());
+  EXPECT_GE(dl_stats[0].total_ns, dl_stats[1].total_ns);
+  EXPECT_EQ(dl_stats[0].op_count, 1u);
+  EXPECT_EQ(dl_stats[1].op_count, 2u);
+
+  std::ostringstream folded;
+  DlOpProfiler::WriteFoldedStacks(folded);
+  EXPECT_NE(
+      folded.str().find("DisplayList;DrawDisplayList;DisplayList;DrawRect "),
+      std::string::npos)
+      << folded.str();
+}
+
+TEST_F(DlOpProfilerTest, ProfileOfManyDisplayListsIsBounded) {
+  DlOpProfiler::Start(/*max_trace_events=*/0);
+  NestingReceiver receiver;
+  for (size_t i = 0; i <= DlOpProfiler::kMaxDisplayListStats; i++) {
+    MakeRectsDisplayList(1)->Dispatch(receiver);
+  }
+  DlOpProfiler::Stop();
+
+  EXPECT_LE(DlOpProfiler::GetDisplayListStats().size(),
+            DlOpProfiler::kMaxDisplayListStats);
+  auto op_stats = DlOpProfiler::GetOpTypeStats();
+  ASSERT_EQ(op_stats.size(), 1u);
+  EXPECT_EQ(op_stats[0].count, DlOpProfiler::kMaxDisplayListStats + 1);
+
+  // The DisplayLists share their stacks, one for the ops and one for the
+  // time spent in the DisplayLists between the ops.
+  std::ostringstream folded;
+  DlOpProfiler::WriteFoldedStacks(folded);
+  const std::string& stacks = folded.str();
+  EXPECT_LE(std::count(stacks.begin(), stacks.end(), '\n'), 2) << stacks;
+  EXPECT_NE(stacks.find("DisplayList;DrawRect "), std::string::npos) << stacks;
+}
+
+TEST_F(DlOpProfilerTest, TraceEventsAreCapped) {
+  auto display_list = MakeRectsDisplayList(3);
+
+  DlOpProfiler::Start(/*max_trace_events=*/2);
+  NestingReceiver receiver;
+  display_list->Dispatch(receiver);
+  DlOpProfiler::Stop();
+
+  // 3 ops and 1 dispatch were recorded, but only 2 events are kept.
+  EXPECT_EQ(DlOpProfiler::GetDroppedTraceEventCount(), 2u);
+  auto op_stats = DlOpProfiler::GetOpTypeStats();
+  ASSERT_EQ(op_stats.size(), 1u);
+  EXPECT_EQ(op_stats[0].count, 3u);
+
+  std::ostringstream json;
+  DlOpProfiler::WriteTraceEvents(json);
+  const std::string& trace = json.str();
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+  EXPECT_NE(trace.find("\"name\":\"DrawRect\""), std::string::npos);
+  EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(trace.find("\"dropped_events\":2"), std::string::npos);
+}
+
+TEST_F(DlOpProfilerTest, WriteToFileSelectsFormatFromExtension) {
+  DlOpProfiler::Start();
+  NestingReceiver receiver;
+  MakeRectsDisplayList(1)->Dispatch(receiver);
+  DlOpProfiler::Stop();
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto read_file = [](const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+  };
+
+  std::string json_path = fml::paths::JoinPaths({temp_dir.path(), "ops.json"});
+  ASSERT_TRUE(DlOpProfiler::WriteToFile(json_path));
+  EXPECT_EQ(read_file(json_path).find("{\"displayTimeUnit\""), 0u);
+
+  std::string folded_path =
+      fml::paths::JoinPaths({temp_dir.path(), "ops.folded"});
+  ASSERT_TRUE(DlOpProfiler::WriteToFile(folded_path));
+  EXPECT_EQ(read_file(folded_path).find("DisplayList"), 0u);
+
+  EXPECT_FALSE(DlOpProfiler::WriteToFile(
+      fml::paths::JoinPaths({temp_dir.path(), "missing", "ops.json"})));
+}
+
+}  // namespace testing
+}  // namespace flutter
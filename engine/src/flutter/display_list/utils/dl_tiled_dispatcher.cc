@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_tiled_dispatcher.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+std::vector<DlIRect> DlTiledDispatcher::ComputeTileBounds(
+    const DlIRect& bounds,
+    const DlISize& tile_size) {
+  std::vector<DlIRect> tiles;
+  if (bounds.IsEmpty() || tile_size.IsEmpty()) {
+    return tiles;
+  }
+  int64_t tile_width = tile_size.width;
+  int64_t tile_height = tile_size.height;
+  int64_t columns = (bounds.GetWidth() + tile_width - 1) / tile_width;
+  int64_t rows = (bounds.GetHeight() + tile_height - 1) / tile_height;
+  tiles.reserve(columns * rows);
+  for (int64_t top = bounds.GetTop(); top < bounds.GetBottom();
+       top += tile_height) {
+    int64_t bottom = std::min<int64_t>(bounds.GetBottom(), top + tile_height);
+    for (int64_t left = bounds.GetLeft(); left < bounds.GetRight();
+         left += tile_width) {
+      int64_t right = std::min<int64_t>(bounds.GetRight(), left + tile_width);
+      tiles.push_back(DlIRect::MakeLTRB(
+          static_cast<int32_t>(left), static_cast<int32_t>(top),
+          static_cast<int32_t>(right), static_cast<int32_t>(bottom)));
+    }
+  }
+  return tiles;
+}
+
+DlTiledDispatcher::DlTiledDispatcher(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner,
+    size_t concurrency)
+    : task_runner_(std::move(task_runner)),
+      concurrency_(task_runner_ ? std::max<size_t>(concurrency, 1u) : 1u) {}
+
+void DlTiledDispatcher::Dispatch(const DisplayList& display_list,
+                                 const std::vector<Tile>& tiles) const {
+  TRACE_EVENT0("flutter", "DlTiledDispatcher::Dispatch");
+  if (tiles.empty()) {
+    return;
+  }
+
+  std::atomic_size_t next_tile = 0u;
+  auto dispatch_tiles = [&display_list, &tiles, &next_tile]() {
+    size_t index;
+    while ((index = next_tile.fetch_add(1u)) < tiles.size()) {
+      const Tile& tile = tiles[index];
+      FML_DCHECK(tile.receiver != nullptr);
+      display_list.Dispatch(*tile.receiver, DlRect::Make(tile.bounds));
+    }
+  };
+
+  size_t helper_count = std::min(concurrency_, tiles.size()) - 1u;
+  if (helper_count == 0u) {
+    dispatch_tiles();
+    return;
+  }
+
+  // The helper tasks only refer to state on this stack frame, so this
+  // method must wait for every one of them to run, even those that start
+  // after all of the tiles have already been claimed.
+  fml::CountDownLatch latch(helper_count);
+  for (size_t i = 0; i < helper_count; i++) {
+    task_runner_->PostTask([&dispatch_tiles, &latch]() {
+      dispatch_tiles();
+      latch.CountDown();
+    });
+  }
+  dispatch_tiles();
+  latch.Wait();
+}
+
+}  // namespace flutter
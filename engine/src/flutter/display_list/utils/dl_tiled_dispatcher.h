@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_TILED_DISPATCHER_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_TILED_DISPATCHER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/geometry/dl_geometry_types.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Dispatches a |DisplayList| to a number of independent
+///             receivers, one per tile of the output, using several threads.
+///
+/// Each tile is culled against the |DlRTree| of the DisplayList (if it has
+/// one) so that every receiver only sees the ops that intersect its own
+/// bounds, and the tiles are handed out to the calling thread and to
+/// helper tasks posted to the task runner as they become free.
+///
+/// The receivers must not share any state with each other, and each one is
+/// expected to apply its own translation and clip for the tile it renders,
+/// for example a |DlSkCanvasDispatcher| drawing into a separate surface. The
+/// DisplayList must not contain any content that can only be rendered on a
+/// specific thread.
+///
+/// @see       DisplayList::Dispatch(DlOpReceiver&, const DlRect&)
+class DlTiledDispatcher {
+ public:
+  struct Tile {
+    /// The device bounds covered by the tile, used for culling.
+    DlIRect bounds;
+
+    /// The receiver that will receive the ops for the tile.
+    DlOpReceiver* receiver;
+  };
+
+  /// Returns the bounds of the tiles of at most |tile_size| needed to
+  /// cover the |bounds|, in row major order. The tiles along the right
+  /// and bottom edges are clipped to the bounds.
+  static std::vector<DlIRect> ComputeTileBounds(const DlIRect& bounds,
+                                                const DlISize& tile_size);
+
+  /// Creates a dispatcher that uses up to |concurrency| threads, including
+  /// the calling thread, to dispatch the tiles. If the task runner is null
+  /// or the concurrency is 1 or less, all of the tiles are dispatched on
+  /// the calling thread.
+  DlTiledDispatcher(std::shared_ptr<fml::BasicTaskRunner> task_runner,
+                    size_t concurrency);
+
+  size_t concurrency() const { return concurrency_; }
+
+  /// Dispatches the DisplayList to the receiver of each of the tiles and
+  /// returns once all of them have been dispatched.
+  ///
+  /// This method waits for tasks posted to the task runner and must not be
+  /// called from a task that is running on that same task runner.
+  void Dispatch(const DisplayList& display_list,
+                const std::vector<Tile>& tiles) const;
+
+ private:
+  std::shared_ptr<fml::BasicTaskRunner> task_runner_;
+  size_t concurrency_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_TILED_DISPATCHER_H_
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_tiled_dispatcher.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class RectRecordingReceiver : public IgnoreAttributeDispatchHelper,
+                              public IgnoreTransformDispatchHelper,
+                              public IgnoreClipDispatchHelper,
+                              public IgnoreDrawDispatchHelper {
+ public:
+  void drawRect(const DlRect& rect) override { rects_.push_back(rect); }
+
+  const std::vector<DlRect>& rects() const { return rects_; }
+
+ private:
+  std::vector<DlRect> rects_;
+};
+
+sk_sp<DisplayList> MakeGridDisplayList(int columns, int rows) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  for (int y = 0; y < rows; y++) {
+    for (int x = 0; x < columns; x++) {
+      builder.DrawRect(DlRect::MakeXYWH(x * 10 + 1, y * 10 + 1, 8, 8),
+                       DlPaint());
+    }
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST(DisplayListTiledDispatcher, ComputeTileBoundsEmpty) {
+  auto empty_bounds =
+      DlTiledDispatcher::ComputeTileBounds(DlIRect(), DlISize(10, 10));
+  EXPECT_TRUE(empty_bounds.empty());
+
+  auto empty_tile_size = DlTiledDispatcher::ComputeTileBounds(
+      DlIRect::MakeWH(100, 100), DlISize(0, 10));
+  EXPECT_TRUE(empty_tile_size.empty());
+}
+
+TEST(DisplayListTiledDispatcher, ComputeTileBoundsExact) {
+  auto tiles = DlTiledDispatcher::ComputeTileBounds(
+      DlIRect::MakeLTRB(10, 20, 50, 40), DlISize(20, 10));
+  ASSERT_EQ(tiles.size(), 4u);
+  EXPECT_EQ(tiles[0], DlIRect::MakeLTRB(10, 20, 30, 30));
+  EXPECT_EQ(tiles[1], DlIRect::MakeLTRB(30, 20, 50, 30));
+  EXPECT_EQ(tiles[2], DlIRect::MakeLTRB(10, 30, 30, 40));
+  EXPECT_EQ(tiles[3], DlIRect::MakeLTRB(30, 30, 50, 40));
+}
+
+TEST(DisplayListTiledDispatcher, ComputeTileBoundsClipsEdges) {
+  auto tiles = DlTiledDispatcher::ComputeTileBounds(DlIRect::MakeWH(25, 15),
+                                                    DlISize(10, 10));
+  ASSERT_EQ(tiles.size(), 6u);
+  EXPECT_EQ(tiles[2], DlIRect::MakeLTRB(20, 0, 25, 10));
+  EXPECT_EQ(tiles[5], DlIRect::MakeLTRB(20, 10, 25, 15));
+}
+
+TEST(DisplayListTiledDispatcher, NullTaskRunnerIsSerial) {
+  DlTiledDispatcher dispatcher(nullptr, 8u);
+  EXPECT_EQ(dispatcher.concurrency(), 1u);
+
+  sk_sp<DisplayList> display_list = MakeGridDisplayList(4, 4);
+  RectRecordingReceiver receiver;
+  dispatcher.Dispatch(*display_list, {{DlIRect::MakeWH(20, 20), &receiver}});
+  EXPECT_EQ(receiver.rects().size(), 4u);
+}
+
+TEST(DisplayListTiledDispatcher, TilesMatchCulledDispatch) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  DlTiledDispatcher dispatcher(loop->GetTaskRunner(), 4u);
+
+  sk_sp<DisplayList> display_list = MakeGridDisplayList(16, 16);
+  std::vector<DlIRect> tile_bounds = DlTiledDispatcher::ComputeTileBounds(
+      DlIRect::MakeWH(160, 160), DlISize(35, 35));
+  std::vector<RectRecordingReceiver> receivers(tile_bounds.size());
+  std::vector<DlTiledDispatcher::Tile> tiles;
+  for (size_t i = 0; i < tile_bounds.size(); i++) {
+    tiles.push_back({tile_bounds[i], &receivers[i]});
+  }
+
+  dispatcher.Dispatch(*display_list, tiles);
+
+  size_t total = 0u;
+  for (size_t i = 0; i < tiles.size(); i++) {
+    RectRecordingReceiver expected;
+    display_list->Dispatch(expected, tile_bounds[i]);
+    EXPECT_EQ(receivers[i].rects(), expected.rects()) << "tile " << i;
+    EXPECT_FALSE(receivers[i].rects().empty()) << "tile " << i;
+    total += receivers[i].rects().size();
+  }
+  // Rects that straddle a tile edge are sent to both tiles.
+  EXPECT_GE(total, 256u);
+
+  loop->Terminate();
+}
+
+TEST(DisplayListTiledDispatcher, MoreThreadsThanTiles) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  DlTiledDispatcher dispatcher(loop->GetTaskRunner(), 16u);
+
+  sk_sp<DisplayList> display_list = MakeGridDisplayList(2, 1);
+  RectRecordingReceiver left;
+  RectRecordingReceiver right;
+  std::vector<DlTiledDispatcher::Tile> tiles = {
+      {DlIRect::MakeLTRB(0, 0, 10, 10), &left},
+      {DlIRect::MakeLTRB(10, 0, 20, 10), &right},
+  };
+  dispatcher.Dispatch(*display_list, tiles);
+  ASSERT_EQ(left.rects().size(), 1u);
+  ASSERT_EQ(right.rects().size(), 1u);
+  EXPECT_EQ(left.rects()[0], DlRect::MakeXYWH(1, 1, 8, 8));
+  EXPECT_EQ(right.rects()[0], DlRect::MakeXYWH(11, 1, 8, 8));
+
+  loop->Terminate();
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -6,6 +6,7 @@
 
 #include <optional>
 #include <utility>
+#include "flutter/display_list/geometry/dl_path_builder.h"
 #include "flutter/flow/layers/layer_tree.h"
 
 namespace flutter {
@@ -37,19 +38,40 @@ std::optional<DlRect> FrameDamage::ComputeClipRect(
 
     damage_ =
         context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
-                              vertical_clip_alignment_);
+                              vertical_clip_alignment_, damage_rect_policy_);
     return DlRect::Make(damage_->buffer_damage);
   }
   return std::nullopt;
 }
 
+#if !SLIMPELLER
+static constexpr RasterCachePolicy kRasterCachePolicy = {
+    .byte_budget = RasterCacheUtil::kDefaultByteBudget,
+    .eviction_grace_frames = RasterCacheUtil::kDefaultEvictionGraceFrames,
+};
+#endif  //  !SLIMPELLER
+
 CompositorContext::CompositorContext()
-    : texture_registry_(std::make_shared<TextureRegistry>()),
+    :
+#if !SLIMPELLER
+      raster_cache_(
+          /*access_threshold=*/3,
+          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+          kRasterCachePolicy),
+#endif  //  !SLIMPELLER
+      texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(fixed_refresh_rate_updater_),
       ui_time_(fixed_refresh_rate_updater_) {}
 
 CompositorContext::CompositorContext(Stopwatch::RefreshRateUpdater& updater)
-    : texture_registry_(std::make_shared<TextureRegistry>()),
+    :
+#if !SLIMPELLER
+      raster_cache_(
+          /*access_threshold=*/3,
+          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+          kRasterCachePolicy),
+#endif  //  !SLIMPELLER
+      texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(updater),
       ui_time_(updater) {}
 
@@ -118,6 +140,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   TRACE_EVENT0("flutter", "CompositorContext::ScopedFrame::Raster");
 
   std::optional<DlRect> clip_rect;
+  std::vector<DlIRect> clip_rects;
   if (frame_damage) {
     clip_rect = frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
                                               !gr_context_);
@@ -127,6 +150,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
       clip_rect = std::nullopt;
       frame_damage->Reset();
     }
+    clip_rects = frame_damage->GetBufferDamageRects();
   }
 
   bool root_needs_readback = layer_tree.Preroll(
@@ -148,7 +172,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (aiks_context_) {
     PaintLayerTreeImpeller(layer_tree, clip_rect, ignore_raster_cache);
   } else {
-    PaintLayerTreeSkia(layer_tree, clip_rect, needs_save_layer,
+    PaintLayerTreeSkia(layer_tree, clip_rect, clip_rects, needs_save_layer,
                        ignore_raster_cache);
   }
   return RasterStatus::kSuccess;
@@ -157,12 +181,20 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 void CompositorContext::ScopedFrame::PaintLayerTreeSkia(
     flutter::LayerTree& layer_tree,
     std::optional<DlRect> clip_rect,
+    const std::vector<DlIRect>& clip_rects,
     bool needs_save_layer,
     bool ignore_raster_cache) {
   DlAutoCanvasRestore restore(canvas(), clip_rect.has_value());
 
   if (canvas()) {
-    if (clip_rect) {
+    if (clip_rect && clip_rects.size() > 1) {
+      // Only the damaged rectangles are painted, not the area between them.
+      DlPathBuilder builder;
+      for (const DlIRect& rect : clip_rects) {
+        builder.AddRect(DlRect::Make(rect));
+      }
+      canvas()->ClipPath(builder.TakePath());
+    } else if (clip_rect) {
       canvas()->ClipRect(*clip_rect);
     }
 
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/macros.h"
@@ -57,7 +58,14 @@ class FrameDamage {
   // Adds additional damage (accumulated for double / triple buffering).
   // This is area that will be repainted alongside any changed part.
   void AddAdditionalDamage(const DlIRect& damage) {
-    additional_damage_ = additional_damage_.Union(damage);
+    additional_damage_.push_back(damage);
+  }
+
+  // Adds additional damage made of separate rectangles. Each rectangle is
+  // merged into the damage on its own rather than through their union.
+  void AddAdditionalDamage(const std::vector<DlIRect>& damage) {
+    additional_damage_.insert(additional_damage_.end(), damage.begin(),
+                              damage.end());
   }
 
   // Specifies clip rect alignment.
@@ -66,6 +74,11 @@ class FrameDamage {
     vertical_clip_alignment_ = vertical;
   }
 
+  // Specifies how many rectangles describe the damage.
+  void SetDamageRectPolicy(const DamageRectPolicy& policy) {
+    damage_rect_policy_ = policy;
+  }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provided damage.
   // If previous layer tree is not specified, clip rect will be nullopt,
@@ -87,6 +100,17 @@ class FrameDamage {
                : std::nullopt;
   }
 
+  // See Damage::frame_damage_rects.
+  std::vector<DlIRect> GetFrameDamageRects() const {
+    return damage_ ? damage_->frame_damage_rects : std::vector<DlIRect>();
+  }
+
+  // See Damage::buffer_damage_rects.
+  std::vector<DlIRect> GetBufferDamageRects() const {
+    return (damage_ && !ignore_damage_) ? damage_->buffer_damage_rects
+                                        : std::vector<DlIRect>();
+  }
+
   // Remove reported buffer_damage to inform clients that a partial repaint
   // should not be performed on this frame.
   // frame_damage is required to correctly track accumulated damage for
@@ -94,11 +118,12 @@ class FrameDamage {
   void Reset() { ignore_damage_ = true; }
 
  private:
-  DlIRect additional_damage_;
+  std::vector<DlIRect> additional_damage_;
   std::optional<Damage> damage_;
   const LayerTree* prev_layer_tree_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
+  DamageRectPolicy damage_rect_policy_;
   bool ignore_damage_ = false;
 };
 
@@ -141,6 +166,7 @@ class CompositorContext {
    private:
     void PaintLayerTreeSkia(flutter::LayerTree& layer_tree,
                             std::optional<DlRect> clip_rect,
+                            const std::vector<DlIRect>& clip_rects,
                             bool needs_save_layer,
                             bool ignore_raster_cache);
 
@@ -4,6 +4,11 @@
 
 #include "flutter/flow/diff_context.h"
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache_util.h"
 
@@ -101,10 +106,157 @@ void DiffContext::AlignRect(DlIRect& rect,
   rect = DlIRect::MakeLTRB(left, top, right, bottom);
 }
 
+namespace {
+
+// The number of rectangles above which the damage is not split into
+// rectangles, because finding the rectangles to merge is quadratic in their
+// count. That many changes usually cover most of the frame anyway.
+constexpr size_t kMaxDamageRectCandidates = 128;
+
+// Repeatedly merges the pair of rectangles with the lowest cost into their
+// bounds, for as long as |should_merge| accepts the cost of that pair and
+// the current number of rectangles.
+template <typename CostFunction, typename ShouldMergeFunction>
+void MergeRectPairs(std::vector<DlIRect>& rects,
+                    const CostFunction& cost,
+                    const ShouldMergeFunction& should_merge) {
+  struct Candidate {
+    double cost;
+    size_t first;
+    size_t second;
+    // The versions of the two rectangles when the cost was computed, so that
+    // candidates of rectangles that have since grown are skipped.
+    size_t first_version;
+    size_t second_version;
+
+    bool operator>(const Candidate& other) const { return cost > other.cost; }
+  };
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>>
+      candidates;
+  std::vector<size_t> versions(rects.size(), 1u);
+  for (size_t i = 0; i < rects.size(); i++) {
+    for (size_t j = i + 1; j < rects.size(); j++) {
+      candidates.push({cost(rects[i], rects[j]), i, j, 1u, 1u});
+    }
+  }
+
+  // A version of 0 marks a rectangle that was merged into another one.
+  size_t count = rects.size();
+  while (count > 1 && !candidates.empty()) {
+    Candidate candidate = candidates.top();
+    if (versions[candidate.first] != candidate.first_version ||
+        versions[candidate.second] != candidate.second_version) {
+      candidates.pop();
+      continue;
+    }
+    if (!should_merge(candidate.cost, count)) {
+      break;
+    }
+    candidates.pop();
+    size_t merged = candidate.first;
+    rects[merged] = rects[merged].Union(rects[candidate.second]);
+    versions[merged]++;
+    versions[candidate.second] = 0u;
+    count--;
+    for (size_t i = 0; i < rects.size(); i++) {
+      if (i != merged && versions[i] != 0u) {
+        size_t first = std::min(i, merged);
+        size_t second = std::max(i, merged);
+        candidates.push({cost(rects[first], rects[second]), first, second,
+                         versions[first], versions[second]});
+      }
+    }
+  }
+
+  size_t kept = 0;
+  for (size_t i = 0; i < rects.size(); i++) {
+    if (versions[i] != 0u) {
+      rects[kept++] = rects[i];
+    }
+  }
+  rects.resize(kept);
+}
+
+// The area covered by either of the rectangles.
+int64_t CoveredArea(const DlIRect& a, const DlIRect& b) {
+  return a.Area() + b.Area() - a.IntersectionOrEmpty(b).Area();
+}
+
+DlIRect GetBounds(const std::vector<DlIRect>& rects) {
+  DlIRect bounds;
+  for (const DlIRect& rect : rects) {
+    bounds = bounds.IsEmpty() ? rect : bounds.Union(rect);
+  }
+  return bounds;
+}
+
+}  // namespace
+
+std::vector<DlIRect> DiffContext::MergeDamageRects(
+    std::vector<DlIRect> rects,
+    const DamageRectPolicy& policy) {
+  size_t max_rect_count = std::max(policy.max_rect_count, size_t{1});
+  if (rects.size() > 1 && max_rect_count > 1) {
+    // Removes the overlap between the rectangles, and rectangles that are
+    // contained in others.
+    rects = DlRegion(rects).getRects(true);
+  }
+  if (rects.size() <= 1) {
+    return rects;
+  }
+  if (max_rect_count == 1 || rects.size() > kMaxDamageRectCandidates) {
+    return {GetBounds(rects)};
+  }
+
+  // First merge the rectangles that are close enough to be cheaper to
+  // repaint as one...
+  MergeRectPairs(
+      rects,
+      [](const DlIRect& a, const DlIRect& b) {
+        return static_cast<double>(a.Union(b).Area()) /
+               static_cast<double>(CoveredArea(a, b));
+      },
+      [&policy](double area_ratio, size_t count) {
+        return area_ratio <= 1.0 + policy.merge_area_ratio;
+      });
+  // ...then merge the ones that add the least area to the damage until
+  // there are few enough of them.
+  MergeRectPairs(
+      rects,
+      [](const DlIRect& a, const DlIRect& b) {
+        return static_cast<double>(a.Union(b).Area() - CoveredArea(a, b));
+      },
+      [max_rect_count](double added_area, size_t count) {
+        return count > max_rect_count;
+      });
+  return rects;
+}
+
 Damage DiffContext::ComputeDamage(const DlIRect& accumulated_buffer_damage,
                                   int horizontal_clip_alignment,
-                                  int vertical_clip_alignment) const {
-  DlRect buffer_damage = DlRect::Make(accumulated_buffer_damage).Union(damage_);
+                                  int vertical_clip_alignment,
+                                  const DamageRectPolicy& damage_rect_policy)
+    const {
+  return ComputeDamage(std::vector<DlIRect>{accumulated_buffer_damage},
+                       horizontal_clip_alignment, vertical_clip_alignment,
+                       damage_rect_policy);
+}
+
+Damage DiffContext::ComputeDamage(
+    const std::vector<DlIRect>& accumulated_buffer_damage,
+    int horizontal_clip_alignment,
+    int vertical_clip_alignment,
+    const DamageRectPolicy& damage_rect_policy) const {
+  if (damage_rect_policy.max_rect_count > 1) {
+    return ComputeDamageRects(accumulated_buffer_damage,
+                              horizontal_clip_alignment,
+                              vertical_clip_alignment, damage_rect_policy);
+  }
+
+  DlRect buffer_damage = damage_;
+  for (const DlIRect& rect : accumulated_buffer_damage) {
+    buffer_damage = buffer_damage.Union(DlRect::Make(rect));
+  }
   DlRect frame_damage(damage_);
 
   for (const auto& r : readbacks_) {
@@ -133,6 +285,63 @@ Damage DiffContext::ComputeDamage(const DlIRect& accumulated_buffer_damage,
     AlignRect(res.frame_damage, horizontal_clip_alignment,
               vertical_clip_alignment);
   }
+  if (!res.frame_damage.IsEmpty()) {
+    res.frame_damage_rects.push_back(res.frame_damage);
+  }
+  if (!res.buffer_damage.IsEmpty()) {
+    res.buffer_damage_rects.push_back(res.buffer_damage);
+  }
+  return res;
+}
+
+Damage DiffContext::ComputeDamageRects(
+    const std::vector<DlIRect>& accumulated_buffer_damage,
+    int horizontal_clip_alignment,
+    int vertical_clip_alignment,
+    const DamageRectPolicy& damage_rect_policy) const {
+  DlIRect frame_clip = DlIRect::MakeSize(frame_size_);
+  auto add_rect = [&](std::vector<DlIRect>& rects, const DlIRect& rect) {
+    DlIRect device_rect = rect.IntersectionOrEmpty(frame_clip);
+    if (device_rect.IsEmpty()) {
+      return;
+    }
+    if (horizontal_clip_alignment > 1 || vertical_clip_alignment > 1) {
+      AlignRect(device_rect, horizontal_clip_alignment,
+                vertical_clip_alignment);
+    }
+    rects.push_back(device_rect);
+  };
+
+  std::vector<DlIRect> frame_rects;
+  for (const DlRect& rect : damage_rects_) {
+    add_rect(frame_rects, DlIRect::RoundOut(rect));
+  }
+
+  for (const auto& r : readbacks_) {
+    // Changes either in readback or paint rect require repainting both
+    // readback and paint rect.
+    bool damaged = std::any_of(
+        frame_rects.begin(), frame_rects.end(), [&r](const DlIRect& rect) {
+          return rect.IntersectsWithRect(r.paint_rect) ||
+                 rect.IntersectsWithRect(r.readback_rect);
+        });
+    if (damaged) {
+      add_rect(frame_rects, r.readback_rect);
+      add_rect(frame_rects, r.paint_rect);
+    }
+  }
+
+  Damage res;
+  res.frame_damage_rects =
+      MergeDamageRects(std::move(frame_rects), damage_rect_policy);
+  std::vector<DlIRect> buffer_rects = res.frame_damage_rects;
+  for (const DlIRect& rect : accumulated_buffer_damage) {
+    add_rect(buffer_rects, rect);
+  }
+  res.buffer_damage_rects =
+      MergeDamageRects(std::move(buffer_rects), damage_rect_policy);
+  res.frame_damage = GetBounds(res.frame_damage_rects);
+  res.buffer_damage = GetBounds(res.buffer_damage_rects);
   return res;
 }
 
@@ -169,19 +378,28 @@ void DiffContext::MarkSubtreeDirty(const DlRect& previous_paint_region) {
   state_.dirty = true;
 }
 
-void DiffContext::AddLayerBounds(const DlRect& rect) {
+bool DiffContext::MapLayerRect(const DlRect& rect, DlRect& result) {
   // During painting we cull based on non-overriden transform and then
   // override the transform right before paint. Do the same thing here to get
   // identical paint rect.
   auto transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
-  if (transformed_rect.IntersectsWithRect(
+  if (!transformed_rect.IntersectsWithRect(
           state_.matrix_clip.GetDeviceCullCoverage())) {
-    if (state_.integral_transform) {
-      DisplayListMatrixClipState temp_state = state_.matrix_clip;
-      MakeTransformIntegral(temp_state);
-      temp_state.mapRect(rect, &transformed_rect);
-      transformed_rect = ApplyFilterBoundsAdjustment(transformed_rect);
-    }
+    return false;
+  }
+  if (state_.integral_transform) {
+    DisplayListMatrixClipState temp_state = state_.matrix_clip;
+    MakeTransformIntegral(temp_state);
+    temp_state.mapRect(rect, &transformed_rect);
+    transformed_rect = ApplyFilterBoundsAdjustment(transformed_rect);
+  }
+  result = transformed_rect;
+  return true;
+}
+
+void DiffContext::AddLayerBounds(const DlRect& rect) {
+  DlRect transformed_rect;
+  if (MapLayerRect(rect, transformed_rect)) {
     rects_->push_back(transformed_rect);
     if (IsSubtreeDirty()) {
       AddDamage(transformed_rect);
@@ -189,6 +407,13 @@ void DiffContext::AddLayerBounds(const DlRect& rect) {
   }
 }
 
+void DiffContext::AddLayerDamage(const DlRect& rect) {
+  DlRect transformed_rect;
+  if (MapLayerRect(rect, transformed_rect)) {
+    AddDamage(transformed_rect);
+  }
+}
+
 void DiffContext::MarkSubtreeHasTextureLayer() {
   // Set the has_texture flag on current state and all parent states. That
   // way we'll know that we can't skip diff for retained layers because
@@ -230,12 +455,15 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_ = damage_.Union(r);
+    AddDamage(r);
   }
 }
 
 void DiffContext::AddDamage(const DlRect& rect) {
   damage_ = damage_.Union(rect);
+  if (!rect.IsEmpty()) {
+    damage_rects_.push_back(rect);
+  }
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
@@ -262,7 +490,8 @@ void DiffContext::Statistics::LogStatistics() {
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
-                    different_instance_but_equal_pictures_);
+                    different_instance_but_equal_pictures_,
+                    "PartiallyChangedPictures", partially_changed_pictures_);
 #endif  // !FLUTTER_RELEASE
 }
 
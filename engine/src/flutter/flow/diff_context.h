@@ -32,6 +32,29 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   DlIRect buffer_damage;
+
+  // The rectangles that make up frame_damage, which is their bounds. There
+  // are at most DamageRectPolicy::max_rect_count of them, and none if there
+  // is no damage.
+  std::vector<DlIRect> frame_damage_rects;
+
+  // The rectangles that make up buffer_damage, which is their bounds.
+  std::vector<DlIRect> buffer_damage_rects;
+};
+
+// Controls how many rectangles describe the damage of a frame.
+struct DamageRectPolicy {
+  // The maximum number of rectangles. With 1, the damage is the bounds of
+  // all of the changes, so changes in opposite corners of the frame repaint
+  // the whole frame.
+  size_t max_rect_count = 1;
+
+  // Two rectangles are merged into their bounds, even when there are fewer
+  // than max_rect_count rectangles, if the bounds are at most this fraction
+  // larger than the area the two rectangles cover. Every rectangle adds to
+  // the cost of the clip of the frame and of the composition, so nearby
+  // changes are cheaper to repaint as one rectangle.
+  double merge_area_ratio = 0.25;
 };
 
 // Layer Unique Id to PaintRegion
@@ -111,6 +134,12 @@ class DiffContext {
   // coordinates.
   void AddLayerBounds(const DlRect& rect);
 
+  // Add the rect, in "local" (layer) coordinates, to the damage without
+  // marking the subtree dirty. Used by layers that can determine which part
+  // of their content changed since the layer they are updating (see
+  // Layer::IsUpdating).
+  void AddLayerDamage(const DlRect& rect);
+
   // Add entire paint region of retained layer for current subtree. This can
   // only be used in subtrees that are not dirty, otherwise ancestor transforms
   // or clips may result in different paint region.
@@ -139,9 +168,26 @@ class DiffContext {
   //
   // clip_alignment controls the alignment of resulting frame and surface
   // damage.
+  //
+  // damage_rect_policy controls the number of rectangles of the damage.
   Damage ComputeDamage(const DlIRect& additional_damage,
                        int horizontal_clip_alignment = 0,
-                       int vertical_clip_alignment = 0) const;
+                       int vertical_clip_alignment = 0,
+                       const DamageRectPolicy& damage_rect_policy = {}) const;
+
+  // Same as above, with the accumulated frame_damage given as separate
+  // rectangles. With a single-rectangle policy they are unioned, otherwise
+  // each of them is merged into the buffer damage on its own.
+  Damage ComputeDamage(const std::vector<DlIRect>& additional_damage,
+                       int horizontal_clip_alignment = 0,
+                       int vertical_clip_alignment = 0,
+                       const DamageRectPolicy& damage_rect_policy = {}) const;
+
+  // Reduces the rectangles to at most policy.max_rect_count rectangles that
+  // cover all of them, merging the rectangles whose bounds add the least
+  // area first.
+  static std::vector<DlIRect> MergeDamageRects(std::vector<DlIRect> rects,
+                                               const DamageRectPolicy& policy);
 
   // Adds the region to current damage. Used for removed layers, where instead
   // of diffing the layer its paint region is direcly added to damage.
@@ -185,6 +231,10 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Picture replaced by different picture, where only the damage of the
+    // changed records was added
+    void AddPartiallyChangedPicture() { ++partially_changed_pictures_; }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -194,6 +244,7 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int partially_changed_pictures_ = 0;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -243,6 +294,8 @@ class DiffContext {
   DlRect ApplyFilterBoundsAdjustment(DlRect rect) const;
 
   DlRect damage_;
+  // The individual rectangles of damage_.
+  std::vector<DlRect> damage_rects_;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
@@ -251,6 +304,16 @@ class DiffContext {
 
   void AddDamage(const DlRect& rect);
 
+  // Maps a rect in "local" (layer) coordinates to the rect that will be
+  // painted in screen coordinates. Returns false if the rect is culled.
+  bool MapLayerRect(const DlRect& rect, DlRect& result);
+
+  Damage ComputeDamageRects(
+      const std::vector<DlIRect>& accumulated_buffer_damage,
+      int horizontal_clip_alignment,
+      int vertical_clip_alignment,
+      const DamageRectPolicy& damage_rect_policy) const;
+
   void AlignRect(DlIRect& rect,
                  int horizontal_alignment,
                  int vertical_clip_alignment) const;
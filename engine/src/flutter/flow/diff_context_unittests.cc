@@ -69,5 +69,117 @@ TEST_F(DiffContextTest, DisjointDamage) {
   EXPECT_EQ(damage.buffer_damage, DlIRect());
 }
 
+TEST_F(DiffContextTest, SingleDamageRectByDefault) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(DlRect::MakeLTRB(0, 0, 50, 50))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(DlRect::MakeLTRB(950, 950, 1000, 1000))));
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(0, 0, 1000, 1000));
+  EXPECT_EQ(damage.frame_damage_rects,
+            std::vector<DlIRect>{DlIRect::MakeLTRB(0, 0, 1000, 1000)});
+  EXPECT_EQ(damage.buffer_damage_rects,
+            std::vector<DlIRect>{DlIRect::MakeLTRB(0, 0, 1000, 1000)});
+}
+
+TEST_F(DiffContextTest, MultipleDamageRects) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(DlRect::MakeLTRB(0, 0, 50, 50))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(DlRect::MakeLTRB(950, 950, 1000, 1000))));
+  auto damage = DiffLayerTree(t1, MockLayerTree(), DlIRect(), 0, 0, true,
+                              false, {.max_rect_count = 4});
+  std::vector<DlIRect> expected_rects = {
+      DlIRect::MakeLTRB(0, 0, 50, 50),
+      DlIRect::MakeLTRB(950, 950, 1000, 1000),
+  };
+  EXPECT_EQ(damage.frame_damage_rects, expected_rects);
+  EXPECT_EQ(damage.buffer_damage_rects, expected_rects);
+  // The single rectangles are the bounds of the lists.
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(0, 0, 1000, 1000));
+  EXPECT_EQ(damage.buffer_damage, DlIRect::MakeLTRB(0, 0, 1000, 1000));
+
+  // The buffer damage also covers the damage of the previous frames.
+  damage = DiffLayerTree(t1, MockLayerTree(),
+                         DlIRect::MakeLTRB(500, 500, 520, 520), 0, 0, true,
+                         false, {.max_rect_count = 4});
+  EXPECT_EQ(damage.frame_damage_rects, expected_rects);
+  ASSERT_EQ(damage.buffer_damage_rects.size(), 3u);
+  EXPECT_EQ(damage.buffer_damage_rects[1],
+            DlIRect::MakeLTRB(500, 500, 520, 520));
+}
+
+TEST_F(DiffContextTest, SeparateAdditionalDamageRects) {
+  auto display_list = CreateDisplayList(DlRect::MakeLTRB(0, 0, 50, 50));
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(display_list));
+  DiffLayerTree(t1, MockLayerTree());
+
+  MockLayerTree t2;
+  t2.root()->Add(CreateDisplayListLayer(display_list));
+
+  std::vector<DlIRect> additional_damage = {
+      DlIRect::MakeLTRB(0, 0, 50, 50),
+      DlIRect::MakeLTRB(950, 950, 1000, 1000),
+  };
+
+  // Each of the rectangles is merged into the buffer damage on its own,
+  // instead of the bounds spanning both corners.
+  DiffContext dc(t2.size(), t2.paint_region_map(), t1.paint_region_map(),
+                 true, false);
+  dc.PushCullRect(DlRect::MakeSize(t2.size()));
+  t2.root()->Diff(&dc, t1.root());
+  auto damage =
+      dc.ComputeDamage(additional_damage, 0, 0, {.max_rect_count = 4});
+  EXPECT_TRUE(damage.frame_damage_rects.empty());
+  EXPECT_EQ(damage.buffer_damage_rects, additional_damage);
+
+  // With a single rectangle, the damage is their bounds.
+  damage = dc.ComputeDamage(additional_damage, 0, 0);
+  EXPECT_EQ(damage.buffer_damage, DlIRect::MakeLTRB(0, 0, 1000, 1000));
+}
+
+TEST_F(DiffContextTest, MergeDamageRects) {
+  std::vector<DlIRect> far_rects = {
+      DlIRect::MakeLTRB(0, 0, 10, 10),
+      DlIRect::MakeLTRB(20, 0, 30, 10),
+      DlIRect::MakeLTRB(500, 500, 510, 510),
+  };
+  // With a single rectangle the damage is the bounds.
+  EXPECT_EQ(DiffContext::MergeDamageRects(far_rects, {.max_rect_count = 1}),
+            std::vector<DlIRect>{DlIRect::MakeLTRB(0, 0, 510, 510)});
+  EXPECT_EQ(DiffContext::MergeDamageRects(far_rects, {.max_rect_count = 3}),
+            far_rects);
+  // The two rectangles whose bounds add the least area are merged first.
+  std::vector<DlIRect> expected_rects = {
+      DlIRect::MakeLTRB(0, 0, 30, 10),
+      DlIRect::MakeLTRB(500, 500, 510, 510),
+  };
+  EXPECT_EQ(DiffContext::MergeDamageRects(far_rects, {.max_rect_count = 2}),
+            expected_rects);
+
+  // Rectangles that are close enough are merged even below the maximum.
+  std::vector<DlIRect> near_rects = {
+      DlIRect::MakeLTRB(0, 0, 10, 10),
+      DlIRect::MakeLTRB(12, 0, 22, 10),
+  };
+  EXPECT_EQ(DiffContext::MergeDamageRects(near_rects, {.max_rect_count = 4}),
+            std::vector<DlIRect>{DlIRect::MakeLTRB(0, 0, 22, 10)});
+  EXPECT_EQ(DiffContext::MergeDamageRects(
+                near_rects, {.max_rect_count = 4, .merge_area_ratio = 0.0}),
+            near_rects);
+
+  // Overlapping and contained rectangles do not overlap after merging.
+  std::vector<DlIRect> overlapping_rects = {
+      DlIRect::MakeLTRB(0, 0, 100, 100),
+      DlIRect::MakeLTRB(10, 10, 20, 20),
+  };
+  EXPECT_EQ(
+      DiffContext::MergeDamageRects(overlapping_rects, {.max_rect_count = 4}),
+      std::vector<DlIRect>{DlIRect::MakeLTRB(0, 0, 100, 100)});
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -397,6 +397,9 @@ class DisplayListEmbedderViewSlice : public EmbedderViewSlice {
   bool is_empty();
   bool recording_ended();
 
+  // The recorded DisplayList, or nullptr if the recording has not ended.
+  const sk_sp<DisplayList>& display_list() const { return display_list_; }
+
  private:
   std::unique_ptr<DisplayListBuilder> builder_;
   sk_sp<DisplayList> display_list_;
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histograms.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint64_t kSubBucketCount = uint64_t{1}
+                                     << DurationHistogram::kSubBucketBits;
+
+size_t GetBucketIndex(uint64_t micros) {
+  if (micros < kSubBucketCount) {
+    return micros;
+  }
+  // The durations of the same power of 2 share the same group of buckets.
+  int shift = std::bit_width(micros) - 1 - DurationHistogram::kSubBucketBits;
+  uint64_t sub_bucket = (micros >> shift) - kSubBucketCount;
+  return ((shift + 1) << DurationHistogram::kSubBucketBits) + sub_bucket;
+}
+
+// The longest duration that is counted in the bucket at |index|.
+int64_t GetBucketMaxMicros(size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  int shift = (index >> DurationHistogram::kSubBucketBits) - 1;
+  uint64_t sub_bucket = index & (kSubBucketCount - 1);
+  return (((kSubBucketCount + sub_bucket) << shift) + (uint64_t{1} << shift)) -
+         1;
+}
+
+}  // namespace
+
+DurationHistogram::DurationHistogram() {
+  Reset();
+}
+
+DurationHistogram::~DurationHistogram() = default;
+
+void DurationHistogram::Record(fml::TimeDelta duration) {
+  int64_t micros = std::clamp<int64_t>(duration.ToMicroseconds(), 0,
+                                       kMaxDuration.ToMicroseconds());
+  counts_[GetBucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+  total_count_.fetch_add(1, std::memory_order_relaxed);
+  int64_t max_micros = max_micros_.load(std::memory_order_relaxed);
+  while (micros > max_micros &&
+         !max_micros_.compare_exchange_weak(max_micros, micros,
+                                            std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t DurationHistogram::GetCount() const {
+  return total_count_.load(std::memory_order_relaxed);
+}
+
+fml::TimeDelta DurationHistogram::GetMax() const {
+  return fml::TimeDelta::FromMicroseconds(
+      max_micros_.load(std::memory_order_relaxed));
+}
+
+fml::TimeDelta DurationHistogram::GetPercentile(double percentile) const {
+  // The counts of the buckets are summed instead of using |total_count_|,
+  // which may not match them while durations are being recorded.
+  std::array<uint64_t, kBucketCount> counts;
+  uint64_t total_count = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    counts[i] = counts_[i].load(std::memory_order_relaxed);
+    total_count += counts[i];
+  }
+  if (total_count == 0) {
+    return fml::TimeDelta::Zero();
+  }
+
+  uint64_t rank = static_cast<uint64_t>(
+      std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * total_count));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen_count = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen_count += counts[i];
+    if (seen_count >= rank) {
+      // No recorded duration is longer than the maximum.
+      return std::min(fml::TimeDelta::FromMicroseconds(GetBucketMaxMicros(i)),
+                      GetMax());
+    }
+  }
+  FML_UNREACHABLE();
+}
+
+void DurationHistogram::Reset() {
+  for (std::atomic<uint64_t>& count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  total_count_.store(0, std::memory_order_relaxed);
+  max_micros_.store(0, std::memory_order_relaxed);
+}
+
+FrameTimingHistograms::FrameTimingHistograms() = default;
+
+FrameTimingHistograms::~FrameTimingHistograms() = default;
+
+const char* FrameTimingHistograms::GetMetricName(Metric metric) {
+  switch (metric) {
+    case kBuild:
+      return "build";
+    case kRaster:
+      return "raster";
+    case kVsyncOverhead:
+      return "vsyncOverhead";
+    case kTotal:
+      return "total";
+    case kCount:
+      break;
+  }
+  FML_UNREACHABLE();
+}
+
+void FrameTimingHistograms::Record(const FrameTiming& timing) {
+  histograms_[kBuild].Record(timing.Get(FrameTiming::kBuildFinish) -
+                             timing.Get(FrameTiming::kBuildStart));
+  histograms_[kRaster].Record(timing.Get(FrameTiming::kRasterFinish) -
+                              timing.Get(FrameTiming::kRasterStart));
+  histograms_[kVsyncOverhead].Record(timing.Get(FrameTiming::kBuildStart) -
+                                     timing.Get(FrameTiming::kVsyncStart));
+  histograms_[kTotal].Record(timing.Get(FrameTiming::kRasterFinish) -
+                             timing.Get(FrameTiming::kVsyncStart));
+}
+
+void FrameTimingHistograms::Reset() {
+  for (DurationHistogram& histogram : histograms_) {
+    histogram.Reset();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
+#define FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// A histogram of durations with a fixed memory footprint and a bounded
+/// relative error, in the style of HdrHistogram.
+///
+/// Durations are counted in microseconds, in buckets that are linear for
+/// durations shorter than 32us and split every power of 2 into 32 linear
+/// buckets above that, so that each duration is counted in a bucket that is
+/// at most 1/32 (about 3%) wider than the duration itself. Durations longer
+/// than |kMaxDuration| are counted as |kMaxDuration|.
+///
+/// Recording and reading are lock free and may happen on any thread. A
+/// read that races with recording may miss some of the durations that are
+/// being recorded at the same time.
+class DurationHistogram {
+ public:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr int kMaxMicrosBits = 27;
+  static constexpr fml::TimeDelta kMaxDuration =
+      fml::TimeDelta::FromMicroseconds((int64_t{1} << kMaxMicrosBits) - 1);
+  static constexpr size_t kBucketCount = (kMaxMicrosBits - kSubBucketBits + 1)
+                                         << kSubBucketBits;
+
+  DurationHistogram();
+
+  ~DurationHistogram();
+
+  void Record(fml::TimeDelta duration);
+
+  /// The number of recorded durations.
+  uint64_t GetCount() const;
+
+  /// The longest recorded duration, or zero if there is none.
+  fml::TimeDelta GetMax() const;
+
+  /// Returns the smallest duration that is at least as long as the given
+  /// |percentile| (between 0 and 100) of the recorded durations, rounded
+  /// up to the end of its bucket, or zero if there are no durations.
+  fml::TimeDelta GetPercentile(double percentile) const;
+
+  void Reset();
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketCount> counts_;
+  std::atomic<uint64_t> total_count_ = 0;
+  std::atomic<int64_t> max_micros_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DurationHistogram);
+};
+
+/// The |DurationHistogram|s of the phases of the frames that were
+/// rasterized, which describe the tail latency of the rendering without the
+/// overhead of timeline tracing.
+class FrameTimingHistograms {
+ public:
+  enum Metric {
+    /// From the start to the finish of the build of a frame on the UI
+    /// thread.
+    kBuild,
+    /// From the start to the finish of the rasterization of a frame.
+    kRaster,
+    /// From the vsync to the start of the build of a frame.
+    kVsyncOverhead,
+    /// From the vsync to the finish of the rasterization of a frame.
+    kTotal,
+    kCount
+  };
+
+  static constexpr Metric kMetrics[kCount] = {kBuild, kRaster, kVsyncOverhead,
+                                              kTotal};
+
+  /// The percentiles that are reported for each of the metrics.
+  static constexpr double kReportedPercentiles[] = {50, 90, 99, 99.9};
+
+  FrameTimingHistograms();
+
+  ~FrameTimingHistograms();
+
+  static const char* GetMetricName(Metric metric);
+
+  void Record(const FrameTiming& timing);
+
+  const DurationHistogram& Get(Metric metric) const {
+    return histograms_[metric];
+  }
+
+  void Reset();
+
+ private:
+  std::array<DurationHistogram, kCount> histograms_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingHistograms);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
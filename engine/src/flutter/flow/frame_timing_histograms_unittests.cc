@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histograms.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+fml::TimeDelta Micros(int64_t micros) {
+  return fml::TimeDelta::FromMicroseconds(micros);
+}
+
+}  // namespace
+
+TEST(DurationHistogram, EmptyHistogramReportsZero) {
+  DurationHistogram histogram;
+  EXPECT_EQ(histogram.GetCount(), 0u);
+  EXPECT_EQ(histogram.GetMax(), fml::TimeDelta::Zero());
+  EXPECT_EQ(histogram.GetPercentile(50), fml::TimeDelta::Zero());
+}
+
+TEST(DurationHistogram, ShortDurationsAreExact) {
+  DurationHistogram histogram;
+  for (int64_t i = 1; i <= 20; i++) {
+    histogram.Record(Micros(i));
+  }
+  EXPECT_EQ(histogram.GetCount(), 20u);
+  EXPECT_EQ(histogram.GetPercentile(50), Micros(10));
+  EXPECT_EQ(histogram.GetPercentile(90), Micros(18));
+  EXPECT_EQ(histogram.GetPercentile(100), Micros(20));
+  EXPECT_EQ(histogram.GetPercentile(0), Micros(1));
+  EXPECT_EQ(histogram.GetMax(), Micros(20));
+}
+
+TEST(DurationHistogram, LongDurationsAreWithinRelativeError) {
+  DurationHistogram histogram;
+  for (int64_t i = 1; i <= 1000; i++) {
+    histogram.Record(Micros(i * 100));
+  }
+  struct Expectation {
+    double percentile;
+    int64_t micros;
+  };
+  for (const Expectation& expected : std::vector<Expectation>{
+           {50, 50000}, {90, 90000}, {99, 99000}, {99.9, 99900}}) {
+    int64_t actual = histogram.GetPercentile(expected.percentile)
+                         .ToMicroseconds();
+    EXPECT_GE(actual, expected.micros) << expected.percentile;
+    EXPECT_LE(actual, expected.micros + expected.micros / 32)
+        << expected.percentile;
+  }
+  EXPECT_EQ(histogram.GetPercentile(100), Micros(100000));
+}
+
+TEST(DurationHistogram, ClampsOutOfRangeDurations) {
+  DurationHistogram histogram;
+  histogram.Record(Micros(-5));
+  histogram.Record(fml::TimeDelta::FromSeconds(1000));
+  EXPECT_EQ(histogram.GetCount(), 2u);
+  EXPECT_EQ(histogram.GetPercentile(50), fml::TimeDelta::Zero());
+  EXPECT_EQ(histogram.GetMax(), DurationHistogram::kMaxDuration);
+  EXPECT_EQ(histogram.GetPercentile(100), DurationHistogram::kMaxDuration);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.GetCount(), 0u);
+  EXPECT_EQ(histogram.GetMax(), fml::TimeDelta::Zero());
+}
+
+TEST(DurationHistogram, RecordsFromSeveralThreads) {
+  DurationHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < 4; i++) {
+    threads.emplace_back([&histogram, i]() {
+      for (int j = 0; j < 1000; j++) {
+        histogram.Record(Micros(1000 * (i + 1)));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(histogram.GetCount(), 4000u);
+  EXPECT_EQ(histogram.GetMax(), Micros(4000));
+}
+
+TEST(FrameTimingHistograms, RecordsPhasesOfFrames) {
+  fml::TimePoint vsync = fml::TimePoint::FromEpochDelta(Micros(1000));
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync);
+  timing.Set(FrameTiming::kBuildStart, vsync + Micros(2));
+  timing.Set(FrameTiming::kBuildFinish, vsync + Micros(12));
+  timing.Set(FrameTiming::kRasterStart, vsync + Micros(15));
+  timing.Set(FrameTiming::kRasterFinish, vsync + Micros(30));
+
+  FrameTimingHistograms histograms;
+  histograms.Record(timing);
+  using Metric = FrameTimingHistograms::Metric;
+  EXPECT_EQ(histograms.Get(Metric::kBuild).GetMax(), Micros(10));
+  EXPECT_EQ(histograms.Get(Metric::kRaster).GetMax(), Micros(15));
+  EXPECT_EQ(histograms.Get(Metric::kVsyncOverhead).GetMax(), Micros(2));
+  EXPECT_EQ(histograms.Get(Metric::kTotal).GetMax(), Micros(30));
+
+  histograms.Reset();
+  for (Metric metric : FrameTimingHistograms::kMetrics) {
+    EXPECT_EQ(histograms.Get(metric).GetCount(), 0u);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -126,6 +126,16 @@ size_t FrameTimingsRecorder::GetPictureCacheBytes() const {
   return picture_cache_bytes_;
 }
 
+size_t FrameTimingsRecorder::GetQueuedFramesAtBuildFinish() const {
+  std::scoped_lock state_lock(state_mutex_);
+  return queued_frames_at_build_finish_;
+}
+
+size_t FrameTimingsRecorder::GetQueuedFramesAtRasterStart() const {
+  std::scoped_lock state_lock(state_mutex_);
+  return queued_frames_at_raster_start_;
+}
+
 void FrameTimingsRecorder::RecordVsync(fml::TimePoint vsync_start,
                                        fml::TimePoint vsync_target) {
   fml::Status status = RecordVsyncImpl(vsync_start, vsync_target);
@@ -151,6 +161,18 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   (void)status;
 }
 
+void FrameTimingsRecorder::RecordQueuedFramesAtBuildFinish(
+    size_t queued_frames) {
+  std::scoped_lock state_lock(state_mutex_);
+  queued_frames_at_build_finish_ = queued_frames;
+}
+
+void FrameTimingsRecorder::RecordQueuedFramesAtRasterStart(
+    size_t queued_frames) {
+  std::scoped_lock state_lock(state_mutex_);
+  queued_frames_at_raster_start_ = queued_frames;
+}
+
 fml::Status FrameTimingsRecorder::RecordVsyncImpl(fml::TimePoint vsync_start,
                                                   fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -227,6 +249,8 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetQueueDepths(queued_frames_at_build_finish_,
+                         queued_frames_at_raster_start_);
   return timing_;
 }
 
@@ -243,6 +267,8 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
       std::make_unique<FrameTimingsRecorder>(frame_number_);
   FML_DCHECK(state_ >= state);
   recorder->state_ = state;
+  recorder->queued_frames_at_build_finish_ = queued_frames_at_build_finish_;
+  recorder->queued_frames_at_raster_start_ = queued_frames_at_raster_start_;
 
   if (state >= State::kVsync) {
     recorder->vsync_start_ = vsync_start_;
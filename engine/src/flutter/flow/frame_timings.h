@@ -87,6 +87,14 @@ class FrameTimingsRecorder {
   /// Total Bytes in all picture cache entries
   size_t GetPictureCacheBytes() const;
 
+  /// The number of frames that were waiting to be rasterized when the build
+  /// of this frame finished, not counting this frame.
+  size_t GetQueuedFramesAtBuildFinish() const;
+
+  /// The number of frames that were waiting to be rasterized when the
+  /// rasterization of this frame started.
+  size_t GetQueuedFramesAtRasterStart() const;
+
   /// Records a vsync event.
   void RecordVsync(fml::TimePoint vsync_start, fml::TimePoint vsync_target);
 
@@ -99,6 +107,14 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records the number of frames that were waiting to be rasterized when
+  /// the build of this frame finished.
+  void RecordQueuedFramesAtBuildFinish(size_t queued_frames);
+
+  /// Records the number of frames that were waiting to be rasterized when
+  /// the rasterization of this frame started.
+  void RecordQueuedFramesAtRasterStart(size_t queued_frames);
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -158,6 +174,9 @@ class FrameTimingsRecorder {
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
 
+  size_t queued_frames_at_build_finish_ = 0;
+  size_t queued_frames_at_raster_start_ = 0;
+
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
 
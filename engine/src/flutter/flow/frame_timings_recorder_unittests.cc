@@ -287,6 +287,28 @@ TEST(FrameTimingsRecorderTest, ClonedHasSameRasterEndWithCache) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), cloned->GetPictureCacheBytes());
 }
 
+TEST(FrameTimingsRecorderTest, RecordQueuedFrames) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordQueuedFramesAtBuildFinish(2);
+  recorder->RecordQueuedFramesAtRasterStart(1);
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  const auto timing = recorder->RecordRasterEnd();
+
+  ASSERT_EQ(recorder->GetQueuedFramesAtBuildFinish(), 2u);
+  ASSERT_EQ(recorder->GetQueuedFramesAtRasterStart(), 1u);
+  ASSERT_EQ(timing.GetQueuedFramesAtBuildFinish(), 2u);
+  ASSERT_EQ(timing.GetQueuedFramesAtRasterStart(), 1u);
+
+  auto cloned = recorder->CloneUntil(FrameTimingsRecorder::State::kRasterEnd);
+  ASSERT_EQ(cloned->GetQueuedFramesAtBuildFinish(), 2u);
+  ASSERT_EQ(cloned->GetQueuedFramesAtRasterStart(), 1u);
+}
+
 TEST(FrameTimingsRecorderTest, FrameNumberTraceArgIsValid) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -46,6 +46,7 @@ void BackdropFilterLayer::Preroll(PrerollContext* context) {
   if (filter_ && context->view_embedder != nullptr) {
     context->view_embedder->PushFilterToVisitedPlatformViews(
         filter_, context->state_stack.device_cull_rect());
+    context->pushed_platform_view_filter_count++;
   }
   DlRect child_paint_bounds;
   PrerollChildren(context, &child_paint_bounds);
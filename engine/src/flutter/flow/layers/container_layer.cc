@@ -64,8 +64,25 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     --old_children_bottom;
   }
 
+  // If the same number of layers was replaced, mismatched layers at the same
+  // position may still be able to diff against the layer they are updating
+  std::vector<const Layer*> updated_layers;
+  if (new_children_bottom - new_children_top ==
+      old_children_bottom - old_children_top) {
+    for (int i = new_children_top; i <= new_children_bottom; ++i) {
+      auto prev_layer =
+          prev_layers[old_children_top + (i - new_children_top)].get();
+      updated_layers.push_back(
+          layers_[i]->IsUpdating(context, prev_layer) ? prev_layer : nullptr);
+    }
+  }
+
   // old layers that don't match
   for (int i = old_children_top; i <= old_children_bottom; ++i) {
+    if (!updated_layers.empty() &&
+        updated_layers[i - old_children_top] != nullptr) {
+      continue;
+    }
     auto layer = prev_layers[i];
     context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
   }
@@ -92,8 +109,11 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
       } else {
-        layer->Diff(context, prev_layer.get());
+        layer->DiffReplacing(context, prev_layer.get());
       }
+    } else if (!updated_layers.empty() &&
+               updated_layers[i - new_children_top] != nullptr) {
+      layers_[i]->Diff(context, updated_layers[i - new_children_top]);
     } else {
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
@@ -141,7 +161,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    layer->PrerollOrReuse(context);
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (child_paint_bounds->IntersectsWithRect(layer->paint_bounds())) {
@@ -4,10 +4,13 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/platform_view_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_embedder.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
@@ -549,6 +552,121 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+TEST_F(ContainerLayerTest, RetainedSubtreeReusesPreroll) {
+  DlPath child_path = DlPath::MakeRectLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = MockLayer::MakeOpacityCompatible(child_path);
+  auto retained_layer = std::make_shared<ContainerLayer>();
+  retained_layer->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained_layer);
+
+  preroll_context()->reuse_retained_preroll = true;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_EQ(layer->paint_bounds(), child_path.GetBounds());
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+
+  // The subtree is not visited again under the same inputs, and its
+  // results are still reported to the parent.
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_EQ(layer->paint_bounds(), child_path.GetBounds());
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+
+  {
+    auto mutator = preroll_context()->state_stack.save();
+    mutator.translate(10.0f, 10.0f);
+    layer->Preroll(preroll_context());
+    EXPECT_EQ(mock_layer->preroll_count(), 2);
+    EXPECT_EQ(mock_layer->parent_matrix(), DlMatrix::MakeTranslation({10, 10}));
+  }
+
+  preroll_context()->reuse_retained_preroll = false;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+  preroll_context()->reuse_retained_preroll = true;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 4);
+}
+
+TEST_F(ContainerLayerTest, SubtreeWithExternalEffectsIsAlwaysPrerolled) {
+  DlPath child_path = DlPath::MakeRectLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto platform_view_layer = MockLayer::Make(child_path);
+  platform_view_layer->set_fake_has_platform_view(true);
+  auto texture_layer = MockLayer::Make(child_path);
+  texture_layer->set_fake_has_texture_layer(true);
+  auto platform_view_container = std::make_shared<ContainerLayer>();
+  platform_view_container->Add(platform_view_layer);
+  auto texture_container = std::make_shared<ContainerLayer>();
+  texture_container->Add(texture_layer);
+  auto cacheable_layer = MockCacheableContainerLayer::CacheLayerOnly();
+  cacheable_layer->Add(MockLayer::Make(child_path));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(platform_view_container);
+  layer->Add(texture_container);
+  layer->Add(cacheable_layer);
+
+  use_mock_raster_cache();
+  preroll_context()->reuse_retained_preroll = true;
+  for (int i = 0; i < 2; i++) {
+    preroll_context()->raster_cached_entries->clear();
+    layer->Preroll(preroll_context());
+    EXPECT_EQ(preroll_context()->raster_cached_entries->size(), 1u);
+  }
+  EXPECT_EQ(platform_view_layer->preroll_count(), 2);
+  EXPECT_EQ(texture_layer->preroll_count(), 2);
+  EXPECT_TRUE(layer->subtree_has_platform_view());
+}
+
+TEST_F(ContainerLayerTest, BackdropFilterSubtreeIsAlwaysPrerolled) {
+  DlPath child_path = DlPath::MakeRectLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto filter = DlImageFilter::MakeBlur(5, 5, DlTileMode::kClamp);
+  auto platform_view_layer = std::make_shared<PlatformViewLayer>(
+      DlPoint(0.0f, 0.0f), DlSize(8.0f, 8.0f), 0);
+  auto first_backdrop_layer =
+      std::make_shared<BackdropFilterLayer>(filter, DlBlendMode::kSrcOver);
+  first_backdrop_layer->Add(MockLayer::Make(child_path));
+  auto mock_layer = MockLayer::Make(child_path);
+  auto second_backdrop_layer =
+      std::make_shared<BackdropFilterLayer>(filter, DlBlendMode::kSrcOver);
+  second_backdrop_layer->Add(mock_layer);
+  auto retained_layer = std::make_shared<ContainerLayer>();
+  retained_layer->Add(second_backdrop_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(platform_view_layer);
+  layer->Add(first_backdrop_layer);
+  layer->Add(retained_layer);
+
+  MockViewEmbedder embedder;
+  preroll_context()->view_embedder = &embedder;
+  preroll_context()->reuse_retained_preroll = true;
+  for (int i = 1; i <= 2; i++) {
+    // The first backdrop already requires a readback when the retained
+    // subtree is prerolled, so only the pushed filters tell that the second
+    // backdrop has effects outside of the subtree.
+    preroll_context()->surface_needs_readback = false;
+    layer->Preroll(preroll_context());
+    EXPECT_EQ(mock_layer->preroll_count(), i);
+    EXPECT_EQ(embedder.pushed_filter_count(), 2 * i);
+  }
+
+  // Removing the view embedder changes the inputs of the Preroll.
+  preroll_context()->view_embedder = nullptr;
+  preroll_context()->surface_needs_readback = false;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+  preroll_context()->surface_needs_readback = false;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+  preroll_context()->view_embedder = &embedder;
+  preroll_context()->surface_needs_readback = false;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 4);
+  EXPECT_EQ(embedder.pushed_filter_count(), 6);
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
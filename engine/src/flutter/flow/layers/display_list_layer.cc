@@ -4,9 +4,11 @@
 
 #include "flutter/flow/layers/display_list_layer.h"
 
+#include <optional>
 #include <utility>
 
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_delta.h"
 #include "flutter/flow/layers/cacheable_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/flow/raster_cache.h"
@@ -38,22 +40,55 @@ bool DisplayListLayer::IsReplacing(DiffContext* context,
          Compare(context->statistics(), this, old_layer);
 }
 
+bool DisplayListLayer::IsUpdating(DiffContext* context,
+                                  const Layer* layer) const {
+  // Display lists with an RTree can compute the damage caused by the
+  // records that changed since the display list of the old layer; See
+  // DisplayListDelta.
+  auto old_layer = layer->as_display_list_layer();
+  return old_layer != nullptr && offset_ == old_layer->offset_ &&
+         display_list_->has_rtree() && old_layer->display_list_->has_rtree();
+}
+
 void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
+  Diff(context, old_layer, /*compare_display_lists=*/true);
+}
+
+void DisplayListLayer::DiffReplacing(DiffContext* context,
+                                     const Layer* old_layer) {
+  Diff(context, old_layer, /*compare_display_lists=*/false);
+}
+
+void DisplayListLayer::Diff(DiffContext* context,
+                            const Layer* old_layer,
+                            bool compare_display_lists) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  std::optional<DlRect> damage;
   if (!context->IsSubtreeDirty()) {
-#ifndef NDEBUG
     FML_DCHECK(old_layer);
     auto prev = old_layer->as_display_list_layer();
-    DiffContext::Statistics dummy_statistics;
-    // IsReplacing has already determined that the display list is same
-    FML_DCHECK(prev->offset_ == offset_ &&
-               Compare(dummy_statistics, this, prev));
-#endif
+    FML_DCHECK(prev && prev->offset_ == offset_);
+    // The old layer is either replaced by an identical display list (see
+    // IsReplacing) or updated by a different one (see IsUpdating). Replaced
+    // layers were already compared as equal, so they add no damage.
+    if (compare_display_lists && prev->display_list_ != display_list_) {
+      auto delta =
+          DisplayListDelta::Compute(*prev->display_list_, *display_list_);
+      if (!delta.is_bounded()) {
+        context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
+      } else if (!delta.is_equal()) {
+        context->statistics().AddPartiallyChangedPicture();
+        damage = delta.damage();
+      }
+    }
   }
   context->PushTransform(DlMatrix::MakeTranslation(offset_));
   if (context->has_raster_cache()) {
     context->WillPaintWithIntegralTransform();
   }
+  if (damage.has_value()) {
+    context->AddLayerDamage(damage.value());
+  }
   context->AddLayerBounds(display_list()->GetBounds());
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
@@ -28,8 +28,12 @@ class DisplayListLayer : public Layer {
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
 
+  bool IsUpdating(DiffContext* context, const Layer* layer) const override;
+
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  void DiffReplacing(DiffContext* context, const Layer* old_layer) override;
+
   const DisplayListLayer* as_display_list_layer() const override {
     return this;
   }
@@ -58,6 +62,13 @@ class DisplayListLayer : public Layer {
 
   sk_sp<DisplayList> display_list_;
 
+  // Diffs with the old layer. The display lists are only compared when
+  // |compare_display_lists| is set, since IsReplacing already found them to
+  // be equal otherwise.
+  void Diff(DiffContext* context,
+            const Layer* old_layer,
+            bool compare_display_lists);
+
   static bool Compare(DiffContext::Statistics& statistics,
                       const DisplayListLayer* l1,
                       const DisplayListLayer* l2);
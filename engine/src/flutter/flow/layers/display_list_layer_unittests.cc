@@ -427,6 +427,81 @@ TEST_F(DisplayListLayerDiffTest, DisplayListCompare) {
   EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+TEST_F(DisplayListLayerDiffTest, DisplayListUpdate) {
+  auto make_display_list = [](const DlRect& second_rect,
+                              DlColor second_color) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 30, 30),
+                     DlPaint().setColor(DlColor::kGreen()));
+    builder.DrawRect(second_rect, DlPaint().setColor(second_color));
+    return builder.Build();
+  };
+
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(
+      make_display_list(DlRect::MakeLTRB(50, 50, 70, 70), DlColor::kBlue())));
+
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(10, 10, 70, 70));
+
+  MockLayerTree tree2;
+  // only the color of the second rect changed
+  tree2.root()->Add(CreateDisplayListLayer(
+      make_display_list(DlRect::MakeLTRB(50, 50, 70, 70), DlColor::kRed())));
+
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(50, 50, 70, 70));
+
+  MockLayerTree tree3;
+  // only the position of the second rect changed
+  tree3.root()->Add(CreateDisplayListLayer(
+      make_display_list(DlRect::MakeLTRB(60, 60, 80, 80), DlColor::kRed())));
+
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(50, 50, 80, 80));
+
+  MockLayerTree tree4;
+  // different offset
+  tree4.root()->Add(CreateDisplayListLayer(
+      make_display_list(DlRect::MakeLTRB(60, 60, 80, 80), DlColor::kRed()),
+      DlPoint(10, 10)));
+
+  damage = DiffLayerTree(tree4, tree3);
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(10, 10, 90, 90));
+}
+
+TEST_F(DisplayListLayerDiffTest, EqualDisplayListsWithRTree) {
+  auto make_display_list = [] {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 30, 30),
+                     DlPaint().setColor(DlColor::kGreen()));
+    builder.DrawRect(DlRect::MakeLTRB(50, 50, 70, 70),
+                     DlPaint().setColor(DlColor::kBlue()));
+    return builder.Build();
+  };
+
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(make_display_list()));
+
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(10, 10, 70, 70));
+
+  // An equal display list replaces the old layer, which adds no damage even
+  // though both display lists could be diffed record by record.
+  MockLayerTree tree2;
+  tree2.root()->Add(CreateDisplayListLayer(make_display_list()));
+
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, DlIRect());
+
+  // The paint region of the replacing layer is still recorded, so removing
+  // the layer damages the area it painted.
+  MockLayerTree tree3;
+
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(10, 10, 70, 70));
+}
+
 TEST_F(DisplayListLayerTest, DisplayListAccessCountDependsOnVisibility) {
   const DlPoint layer_offset = DlPoint(1.5f, -0.5f);
   const DlRect picture_bounds = DlRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
@@ -11,6 +11,11 @@
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/display_list/effects/color_sources/dl_image_color_source.h"
+#include "flutter/display_list/effects/image_filters/dl_compose_image_filter.h"
+#include "flutter/display_list/effects/image_filters/dl_local_matrix_image_filter.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_item.h"
@@ -21,11 +26,121 @@
 
 namespace flutter {
 
+namespace {
+
+// Finds the content of a DisplayList that cannot be drawn into a raster
+// surface on a background thread: images that live in a GPU context, and
+// runtime effects, whose samplers may be such images.
+class BackgroundRasterizationChecker : public IgnoreAttributeDispatchHelper,
+                                       public IgnoreClipDispatchHelper,
+                                       public IgnoreTransformDispatchHelper,
+                                       public IgnoreDrawDispatchHelper {
+ public:
+  bool can_rasterize_in_background() const { return supported_; }
+
+  void setColorSource(const DlColorSource* source) override {
+    if (source && (source->asRuntimeEffect() ||
+                   (source->asImage() &&
+                    !IsSupported(source->asImage()->image().get())))) {
+      supported_ = false;
+    }
+  }
+
+  void setImageFilter(const DlImageFilter* filter) override {
+    if (!IsSupported(filter)) {
+      supported_ = false;
+    }
+  }
+
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    setImageFilter(backdrop);
+  }
+
+  void drawImage(const sk_sp<DlImage> image,
+                 const DlPoint& point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    CheckImage(image.get());
+  }
+
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const DlRect& src,
+                     const DlRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     DlSrcRectConstraint constraint) override {
+    CheckImage(image.get());
+  }
+
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const DlIRect& center,
+                     const DlRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    CheckImage(image.get());
+  }
+
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const DlRSTransform xform[],
+                 const DlRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const DlRect* cull_rect,
+                 bool render_with_attributes) override {
+    CheckImage(atlas.get());
+  }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    if (supported_) {
+      display_list->Dispatch(*this);
+    }
+  }
+
+ private:
+  bool supported_ = true;
+
+  static bool IsSupported(const DlImage* image) {
+    return !image || !image->isTextureBacked();
+  }
+
+  static bool IsSupported(const DlImageFilter* filter) {
+    if (!filter) {
+      return true;
+    }
+    if (filter->asRuntimeEffectFilter()) {
+      return false;
+    }
+    if (auto compose = filter->asCompose()) {
+      return IsSupported(compose->outer().get()) &&
+             IsSupported(compose->inner().get());
+    }
+    if (auto local_matrix = filter->asLocalMatrix()) {
+      return IsSupported(local_matrix->image_filter().get());
+    }
+    return true;
+  }
+
+  void CheckImage(const DlImage* image) {
+    if (!IsSupported(image)) {
+      supported_ = false;
+    }
+  }
+};
+
+}  // namespace
+
 static bool IsDisplayListWorthRasterizing(
     const DisplayList* display_list,
     bool will_change,
     bool is_complex,
-    DisplayListComplexityCalculator* complexity_calculator) {
+    DisplayListComplexityCalculator* complexity_calculator,
+    unsigned int* complexity_score) {
   if (will_change) {
     // If the display list is going to change in the future, there is no point
     // in doing to extra work to rasterize.
@@ -45,8 +160,8 @@ static bool IsDisplayListWorthRasterizing(
     return true;
   }
 
-  unsigned int complexity_score = complexity_calculator->Compute(display_list);
-  return complexity_calculator->ShouldBeCached(complexity_score);
+  *complexity_score = complexity_calculator->Compute(display_list);
+  return complexity_calculator->ShouldBeCached(*complexity_score);
 }
 
 DisplayListRasterCacheItem::DisplayListRasterCacheItem(
@@ -74,13 +189,15 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const DlMatrix& matrix) {
   cache_state_ = CacheState::kNone;
+  complexity_score_ = 0;
   DisplayListComplexityCalculator* complexity_calculator =
       context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
                                 context->gr_context->backend())
                           : DisplayListComplexityCalculator::GetForSoftware();
 
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
-                                     complexity_calculator)) {
+                                     complexity_calculator,
+                                     &complexity_score_)) {
     // We only deal with display lists that are worthy of rasterization.
     return;
   }
@@ -115,6 +232,7 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
       cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
   } else {
+    has_cached_image_ = cache_info.has_image;
     if (cache_info.has_image) {
       context->renderable_state_flags |=
           LayerStateStack::kCallerCanApplyOpacity;
@@ -161,6 +279,20 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
   }
   SkRect bounds =
       ToSkRect(display_list_->GetBounds()).makeOffset(offset_.x(), offset_.y());
+  // Only look for content that prevents background rasterization when the
+  // entry still needs an image.
+  bool can_rasterize_in_background = false;
+  if (context.raster_cache->rasterizes_in_background() && !has_cached_image_) {
+    BackgroundRasterizationChecker checker;
+    display_list_->Dispatch(checker);
+    can_rasterize_in_background = checker.can_rasterize_in_background();
+  }
+  // Only hash the content when the entry may be in the disk store.
+  if (context.raster_cache->has_disk_store() && !has_cached_image_ &&
+      !content_hash_computed_) {
+    content_hash_ = DisplayListSerialization::ContentHash(*display_list_);
+    content_hash_computed_ = true;
+  }
   RasterCache::Context r_context = {
       // clang-format off
       .gr_context         = context.gr_context,
@@ -168,6 +300,9 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .matrix             = transformation_matrix_,
       .logical_rect       = bounds,
       .flow_type          = flow_type,
+      .raster_cost        = complexity_score_,
+      .can_rasterize_in_background = can_rasterize_in_background,
+      .content_hash       = content_hash_,
       // clang-format on
   };
   return context.raster_cache->UpdateCacheEntry(
@@ -57,6 +57,15 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // The complexity score of |display_list_|, or 0 if it was not computed.
+  unsigned int complexity_score_ = 0;
+  // Whether the raster cache had an image for |display_list_| at the end of
+  // the preroll.
+  bool has_cached_image_ = false;
+  // The |DisplayListSerialization::ContentHash| of |display_list_|, once
+  // it was needed for the disk store of the raster cache.
+  mutable bool content_hash_computed_ = false;
+  mutable std::optional<uint64_t> content_hash_;
 };
 
 }  // namespace flutter
@@ -12,6 +12,57 @@ Layer::Layer() : unique_id_(NextUniqueID()), original_layer_id_(unique_id_) {}
 
 Layer::~Layer() = default;
 
+void Layer::PrerollOrReuse(PrerollContext* context) {
+  if (!context->reuse_retained_preroll || !as_container_layer()) {
+    last_preroll_.reset();
+    Preroll(context);
+    return;
+  }
+
+  DlMatrix matrix = context->state_stack.matrix();
+  DlRect device_cull_rect = context->state_stack.device_cull_rect();
+  bool has_raster_cache = false;
+#if !SLIMPELLER
+  has_raster_cache = context->raster_cache != nullptr;
+#endif  //  !SLIMPELLER
+  bool has_view_embedder = context->view_embedder != nullptr;
+  bool surface_needed_readback = context->surface_needs_readback;
+  if (last_preroll_.has_value() && last_preroll_->matrix == matrix &&
+      last_preroll_->device_cull_rect == device_cull_rect &&
+      last_preroll_->has_raster_cache == has_raster_cache &&
+      last_preroll_->has_view_embedder == has_view_embedder &&
+      last_preroll_->surface_needed_readback == surface_needed_readback) {
+    context->renderable_state_flags = last_preroll_->renderable_state_flags;
+    context->surface_needs_readback = last_preroll_->surface_needs_readback;
+    return;
+  }
+
+  size_t cache_entry_count = context->raster_cached_entries
+                                 ? context->raster_cached_entries->size()
+                                 : 0u;
+  size_t filter_count = context->pushed_platform_view_filter_count;
+  Preroll(context);
+
+  bool has_external_effects =
+      context->has_platform_view || context->has_texture_layer ||
+      (context->raster_cached_entries &&
+       context->raster_cached_entries->size() != cache_entry_count) ||
+      context->pushed_platform_view_filter_count != filter_count;
+  if (has_external_effects) {
+    last_preroll_.reset();
+    return;
+  }
+  last_preroll_ = {
+      .matrix = matrix,
+      .device_cull_rect = device_cull_rect,
+      .has_raster_cache = has_raster_cache,
+      .has_view_embedder = has_view_embedder,
+      .surface_needed_readback = surface_needed_readback,
+      .renderable_state_flags = context->renderable_state_flags,
+      .surface_needs_readback = context->surface_needs_readback,
+  };
+}
+
 uint64_t Layer::NextUniqueID() {
   static std::atomic<uint64_t> next_id(1);
   uint64_t id;
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -73,6 +74,15 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // The number of filters that were pushed to the visited platform views of
+  // the |view_embedder| during this Preroll.
+  size_t pushed_platform_view_filter_count = 0;
+
+  // Whether retained container layers may reuse the results of their
+  // previous Preroll instead of prerolling their subtree again.
+  // See |Layer::PrerollOrReuse|.
+  bool reuse_retained_preroll = false;
 };
 
 struct PaintContext {
@@ -140,9 +150,25 @@ class Layer {
     return original_layer_id_ == old_layer->original_layer_id_;
   }
 
+  // Used to establish link between old layer and new layer that does not
+  // replace it (IsReplacing returned false), but occupies the same position
+  // in the tree. If this method returns true, the layer is diffed with the
+  // old layer without marking its subtree dirty and is expected to add the
+  // damage caused by the changes to its content itself.
+  virtual bool IsUpdating(DiffContext* context, const Layer* old_layer) const {
+    return false;
+  }
+
   // Performs diff with given layer
   virtual void Diff(DiffContext* context, const Layer* old_layer) {}
 
+  // Performs diff with the old layer that this layer replaces (IsReplacing
+  // returned true for it). Layers whose IsReplacing already compared their
+  // content with the old layer can skip comparing it again.
+  virtual void DiffReplacing(DiffContext* context, const Layer* old_layer) {
+    Diff(context, old_layer);
+  }
+
   // Used when diffing retained layer; In case the layer is identical, it
   // doesn't need to be diffed, but the paint region needs to be stored in diff
   // context so that it can be used in next frame
@@ -154,6 +180,18 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Calls |Preroll|, unless this is a container layer whose previous Preroll
+  // ran with the same transform, cull rect and readback state, in which case
+  // the results of that Preroll are reused without visiting the subtree.
+  //
+  // Layers do not change once they are built, so a retained subtree, i.e. the
+  // same layer instance that was used in the previous frame, computes the
+  // same paint bounds under the same inputs. Subtrees whose Preroll has
+  // effects outside of the subtree, i.e. that contain platform views or
+  // textures, register raster cache entries or push filters to the view
+  // embedder, are always prerolled.
+  void PrerollOrReuse(PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -257,6 +295,23 @@ class Layer {
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
 
+  // The inputs and the results of the last Preroll that can be reused by
+  // |PrerollOrReuse|.
+  struct PrerollResult {
+    // The inputs of the Preroll.
+    DlMatrix matrix;
+    DlRect device_cull_rect;
+    bool has_raster_cache;
+    bool has_view_embedder;
+    bool surface_needed_readback;
+
+    // The outputs of the Preroll, other than the state of the layers in the
+    // subtree.
+    int renderable_state_flags;
+    bool surface_needs_readback;
+  };
+  std::optional<PrerollResult> last_preroll_;
+
   static uint64_t NextUniqueID();
 
   FML_DISALLOW_COPY_AND_ASSIGN(Layer);
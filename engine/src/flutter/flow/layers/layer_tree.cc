@@ -56,6 +56,7 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time = frame.context().ui_time(),
       .texture_registry = frame.context().texture_registry(),
       .raster_cached_entries = &raster_cache_items_,
+      .reuse_retained_preroll = true,
   };
 
   root_layer_->Preroll(&context);
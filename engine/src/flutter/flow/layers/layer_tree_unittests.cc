@@ -237,6 +237,8 @@ TEST_F(LayerTreeTest, PrerollContextInitialization) {
 
     EXPECT_EQ(context.renderable_state_flags, 0);
     EXPECT_EQ(context.raster_cached_entries, nullptr);
+    EXPECT_EQ(context.pushed_platform_view_filter_count, 0u);
+    EXPECT_FALSE(context.reuse_retained_preroll);
   };
 
   // These 4 initializers are required because they are handled by reference
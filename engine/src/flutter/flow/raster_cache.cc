@@ -6,7 +6,11 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -16,11 +20,16 @@
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/ganesh/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
 namespace flutter {
@@ -70,18 +79,85 @@ void RasterCacheResult::draw(DlCanvas& canvas,
   }
 }
 
-RasterCache::RasterCache(size_t access_threshold,
-                         size_t display_list_cache_limit_per_frame)
-    : access_threshold_(access_threshold),
-      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame) {}
+/// The images rendered by background tasks, waiting to be adopted by the
+/// next frame. The tasks hold a reference to this, so they can outlive the
+/// |RasterCache|.
+struct RasterCache::BackgroundResults {
+  struct Result {
+    RasterCacheKey key;
+    std::unique_ptr<RasterCacheResult> image;
+    // Whether the image was loaded from the disk store.
+    bool from_disk;
+    // Whether the disk store had no usable image for the entry.
+    bool disk_miss;
+  };
+
+  std::mutex mutex;
+  std::vector<Result> results;
+
+  void Add(Result result) {
+    std::scoped_lock lock(mutex);
+    results.push_back(std::move(result));
+  }
+};
+
+namespace {
+
+struct DiskStoreReadback {
+  std::shared_ptr<RasterCacheDiskStore> disk_store;
+  uint64_t key;
+  SkImageInfo info;
+};
+
+void StoreReadbackResult(
+    SkImage::ReadPixelsContext context,
+    std::unique_ptr<const SkImage::AsyncReadResult> result) {
+  std::unique_ptr<DiskStoreReadback> readback(
+      static_cast<DiskStoreReadback*>(context));
+  if (!result || result->count() != 1) {
+    return;
+  }
+  // The pixels of the result are only valid during the callback.
+  size_t row_bytes = result->rowBytes(0);
+  sk_sp<SkData> pixels = SkData::MakeWithCopy(
+      result->data(0), row_bytes * readback->info.height());
+  readback->disk_store->Store(
+      readback->key,
+      SkImages::RasterFromData(readback->info, std::move(pixels), row_bytes));
+}
 
-/// @note Procedure doesn't copy all closures.
-std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+// Stores |image| in |disk_store|. Images rendered on the GPU are read back
+// asynchronously, so the frame does not wait for the GPU to finish them. The
+// read back pixels are stored when a later flush of |gr_context| finds them
+// ready.
+void StoreInDiskStore(const std::shared_ptr<RasterCacheDiskStore>& disk_store,
+                      uint64_t key,
+                      sk_sp<SkImage> image,
+                      GrDirectContext* gr_context) {
+  if (!image) {
+    return;
+  }
+  if (!image->isTextureBacked()) {
+    disk_store->Store(key, std::move(image));
+    return;
+  }
+  if (!gr_context) {
+    return;
+  }
+  SkImageInfo info =
+      SkImageInfo::MakeN32Premul(image->dimensions(), image->refColorSpace());
+  auto readback = std::make_unique<DiskStoreReadback>(
+      DiskStoreReadback{disk_store, key, info});
+  gr_context->asyncRescaleAndReadPixels(
+      image.get(), info, image->bounds(), SkImage::RescaleGamma::kSrc,
+      SkImage::RescaleMode::kNearest, StoreReadbackResult, readback.release());
+}
+
+sk_sp<SkImage> RasterizeToImage(
     const RasterCache::Context& context,
-    sk_sp<const DlRTree> rtree,
     const std::function<void(DlCanvas*)>& draw_function,
-    const std::function<void(DlCanvas*, const DlRect& rect)>& draw_checkerboard)
-    const {
+    const std::function<void(DlCanvas*, const DlRect& rect)>&
+        draw_checkerboard) {
   auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
   SkRect dest_rect =
       RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
@@ -106,13 +182,185 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   canvas.Transform(ToDlMatrix(matrix));
   draw_function(&canvas);
 
-  if (checkerboard_images_) {
+  if (draw_checkerboard) {
     draw_checkerboard(&canvas, ToDlRect(context.logical_rect));
   }
 
-  auto image = DlImage::Make(surface->makeImageSnapshot());
-  return std::make_unique<RasterCacheResult>(
-      image, context.logical_rect, context.flow_type, std::move(rtree));
+  return surface->makeImageSnapshot();
+}
+
+}  // namespace
+
+RasterCache::RasterCache(size_t access_threshold,
+                         size_t display_list_cache_limit_per_frame,
+                         const RasterCachePolicy& policy)
+    : access_threshold_(access_threshold),
+      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
+      policy_(policy) {}
+
+/// @note Procedure doesn't copy all closures.
+std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+    const RasterCache::Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const DlRect& rect)>& draw_checkerboard)
+    const {
+  sk_sp<SkImage> image = RasterizeToImage(
+      context, draw_function,
+      checkerboard_images_ ? draw_checkerboard : nullptr);
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(DlImage::Make(std::move(image)),
+                                             context.logical_rect,
+                                             context.flow_type,
+                                             std::move(rtree));
+}
+
+void RasterCache::SetBackgroundRasterizer(
+    std::shared_ptr<fml::BasicTaskRunner> worker_task_runner,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    ResourceContextGetter resource_context_getter) {
+  worker_task_runner_ = std::move(worker_task_runner);
+  io_task_runner_ = std::move(io_task_runner);
+  resource_context_getter_ = std::move(resource_context_getter);
+  if (worker_task_runner_ && !background_results_) {
+    background_results_ = std::make_shared<BackgroundResults>();
+  }
+}
+
+void RasterCache::RasterizeInBackground(
+    const RasterCacheKey& key,
+    const Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& render_function,
+    std::optional<uint64_t> disk_key,
+    bool load_from_disk) const {
+  // The context refers to the state of the frame, so everything the task
+  // needs is copied. The render function is only copied for entries that
+  // may be rasterized in the background, as it may otherwise refer to
+  // resources of the raster thread.
+  worker_task_runner_->PostTask(
+      [key, dst_color_space = context.dst_color_space,
+       matrix = context.matrix, logical_rect = context.logical_rect,
+       flow_type = context.flow_type, rtree = std::move(rtree),
+       render_function = context.can_rasterize_in_background
+                             ? render_function
+                             : std::function<void(DlCanvas*)>(),
+       checkerboard = checkerboard_images_, io_task_runner = io_task_runner_,
+       resource_context_getter = resource_context_getter_,
+       results = background_results_, disk_store = disk_store_, disk_key,
+       load_from_disk]() mutable {
+        TRACE_EVENT0("flutter", "RasterCache::RasterizeInBackground");
+        sk_sp<SkImage> image;
+        bool from_disk = false;
+        if (load_from_disk) {
+          image = disk_store->Load(disk_key.value(), dst_color_space);
+          SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+              logical_rect, RasterCacheUtil::GetIntegralTransCTM(matrix));
+          // The size of the image only differs if the key collided.
+          from_disk = image && image->width() == dest_rect.width() &&
+                      image->height() == dest_rect.height();
+          if (!from_disk) {
+            image = nullptr;
+          }
+        }
+        bool disk_miss = load_from_disk && !from_disk;
+        if (!from_disk && render_function) {
+          Context background_context = {
+              // clang-format off
+              .gr_context         = nullptr,
+              .dst_color_space    = dst_color_space,
+              .matrix             = matrix,
+              .logical_rect       = logical_rect,
+              .flow_type          = flow_type,
+              // clang-format on
+          };
+          image = RasterizeToImage(background_context, render_function,
+                                   checkerboard ? DrawCheckerboard : nullptr);
+          if (image && disk_key.has_value()) {
+            disk_store->Store(disk_key.value(), image);
+          }
+        }
+        auto add_result = [key, logical_rect, flow_type, rtree, results,
+                           from_disk,
+                           disk_miss](sk_sp<SkImage> result_image) {
+          results->Add({
+              .key = key,
+              .image = result_image
+                           ? std::make_unique<RasterCacheResult>(
+                                 DlImage::Make(std::move(result_image)),
+                                 logical_rect, flow_type, rtree)
+                           : nullptr,
+              .from_disk = from_disk,
+              .disk_miss = disk_miss,
+          });
+        };
+        if (!image || !io_task_runner || !resource_context_getter) {
+          add_result(std::move(image));
+          return;
+        }
+        io_task_runner->PostTask(fml::MakeCopyable(
+            [image = std::move(image), add_result,
+             resource_context_getter]() mutable {
+              TRACE_EVENT0("flutter", "RasterCache::UploadBackgroundImage");
+              fml::WeakPtr<GrDirectContext> resource_context =
+                  resource_context_getter();
+              SkPixmap pixmap;
+              if (resource_context && image->peekPixels(&pixmap)) {
+                sk_sp<SkImage> texture =
+                    SkImages::CrossContextTextureFromPixmap(
+                        resource_context.get(), pixmap, /*buildMips=*/false);
+                // Without a texture, the raster image is uploaded when it is
+                // first drawn.
+                if (texture) {
+                  image = std::move(texture);
+                }
+              }
+              add_result(std::move(image));
+            }));
+      });
+}
+
+void RasterCache::AdoptBackgroundResults() {
+  if (!background_results_) {
+    return;
+  }
+  std::vector<BackgroundResults::Result> results;
+  {
+    std::scoped_lock lock(background_results_->mutex);
+    results.swap(background_results_->results);
+  }
+  for (auto& result : results) {
+    auto it = cache_.find(result.key);
+    // The entry may have been evicted or cleared while it was rasterized.
+    if (it == cache_.end() || !it->second.background_raster_pending) {
+      continue;
+    }
+    Entry& entry = it->second;
+    entry.background_raster_pending = false;
+    entry.pending_bytes = 0;
+    if (result.from_disk) {
+      GetMetricsForKind(result.key.kind()).disk_hit_count++;
+    }
+    // An entry whose image could not be loaded is rasterized when it is
+    // next prepared, instead of waiting for the disk store again.
+    entry.disk_load_failed |= result.disk_miss;
+    // A failed rasterization is attempted again when the entry is next
+    // prepared, as it would be without the background rasterizer.
+    entry.image = std::move(result.image);
+  }
+}
+
+std::optional<uint64_t> RasterCache::GetDiskKey(
+    const Context& context) const {
+  if (!disk_store_ || !context.content_hash.has_value() ||
+      checkerboard_images_) {
+    return std::nullopt;
+  }
+  return RasterCacheDiskStore::ComputeKey(
+      context.content_hash.value(), context.matrix, context.logical_rect,
+      context.dst_color_space.get());
 }
 
 bool RasterCache::UpdateCacheEntry(
@@ -122,11 +370,67 @@ bool RasterCache::UpdateCacheEntry(
     sk_sp<const DlRTree> rtree) const {
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
+  entry.raster_cost = raster_cache_context.raster_cost;
   if (!entry.image) {
+    if (entry.background_raster_pending) {
+      return false;
+    }
+    auto matrix =
+        RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix);
+    SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+        raster_cache_context.logical_rect, matrix);
+    // N32 images use 4 bytes per pixel.
+    size_t estimated_bytes = static_cast<size_t>(dest_rect.width()) *
+                             static_cast<size_t>(dest_rect.height()) * 4;
+    if (!MakeRoomInBudget(estimated_bytes)) {
+      GetMetricsForKind(key.kind()).budget_rejection_count++;
+      return false;
+    }
+    std::optional<uint64_t> disk_key = GetDiskKey(raster_cache_context);
+    bool load_from_disk = disk_key.has_value() && !entry.disk_load_failed &&
+                          disk_store_->Contains(disk_key.value());
+    // Decoding an image from the disk store is not much cheaper than
+    // rasterizing it, so the images of all entries are loaded in the
+    // background, including those that may only be rasterized by the frame.
+    if (worker_task_runner_ &&
+        (load_from_disk || raster_cache_context.can_rasterize_in_background)) {
+      RasterizeInBackground(key, raster_cache_context, std::move(rtree),
+                            render_function, disk_key, load_from_disk);
+      entry.background_raster_pending = true;
+      entry.pending_bytes = estimated_bytes;
+      if (id.type() == RasterCacheKeyType::kDisplayList) {
+        display_list_cached_this_frame_++;
+      }
+      // The frame draws the entry without the cache until the image is
+      // adopted by a later frame.
+      return false;
+    }
+    if (load_from_disk) {
+      sk_sp<SkImage> disk_image = disk_store_->Load(
+          disk_key.value(), raster_cache_context.dst_color_space);
+      // The size of the image only differs if the key collided.
+      if (disk_image && disk_image->width() == dest_rect.width() &&
+          disk_image->height() == dest_rect.height()) {
+        entry.image = std::make_unique<RasterCacheResult>(
+            DlImage::Make(std::move(disk_image)),
+            raster_cache_context.logical_rect, raster_cache_context.flow_type,
+            std::move(rtree));
+        GetMetricsForKind(key.kind()).disk_hit_count++;
+        if (id.type() == RasterCacheKeyType::kDisplayList) {
+          display_list_cached_this_frame_++;
+        }
+        return true;
+      }
+    }
     void (*func)(DlCanvas*, const DlRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
     if (entry.image != nullptr) {
+      const sk_sp<DlImage>& dl_image = entry.image->image();
+      if (disk_key.has_value() && dl_image) {
+        StoreInDiskStore(disk_store_, disk_key.value(), dl_image->skia_image(),
+                         raster_cache_context.gr_context);
+      }
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -177,35 +481,43 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
                        DlCanvas& canvas,
                        const DlPaint* paint,
                        bool preserve_rtree) const {
-  auto it = cache_.find(RasterCacheKey(id, ToSkMatrix(canvas.GetMatrix())));
-  if (it == cache_.end()) {
+  RasterCacheKey key(id, ToSkMatrix(canvas.GetMatrix()));
+  RasterCacheMetrics& metrics = GetMetricsForKind(key.kind());
+  auto it = cache_.find(key);
+  if (it == cache_.end() || !it->second.image) {
+    metrics.miss_count++;
     return false;
   }
 
-  Entry& entry = it->second;
-
-  if (entry.image) {
-    entry.image->draw(canvas, paint, preserve_rtree);
-    return true;
-  }
-
-  return false;
+  it->second.image->draw(canvas, paint, preserve_rtree);
+  metrics.hit_count++;
+  return true;
 }
 
 void RasterCache::BeginFrame() {
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
+  // Adopting the images before the preroll of the frame keeps the state of
+  // each entry constant between the preroll and the paint that rely on it.
+  AdoptBackgroundResults();
 }
 
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
+    FML_DCHECK(entry.encountered_this_frame ||
+               entry.frames_since_encountered <=
+                   policy_.eviction_grace_frames);
     if (entry.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.in_use_count++;
-      metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.encountered_this_frame) {
+        metrics.in_use_count++;
+        metrics.in_use_bytes += entry.image->image_bytes();
+      } else {
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+      }
     }
     entry.encountered_this_frame = false;
   }
@@ -216,7 +528,10 @@ void RasterCache::EvictUnusedCacheEntries() {
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    if (entry.encountered_this_frame) {
+      entry.frames_since_encountered = 0;
+    } else if (++entry.frames_since_encountered >
+               policy_.eviction_grace_frames) {
       dead.push_back(it);
     }
   }
@@ -226,9 +541,73 @@ void RasterCache::EvictUnusedCacheEntries() {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.eviction_count++;
       metrics.eviction_bytes += it->second.image->image_bytes();
+      metrics.unused_eviction_count++;
     }
     cache_.erase(it);
   }
+
+  // The budget may be exceeded by images that turned out to be larger than
+  // estimated.
+  MakeRoomInBudget(0);
+}
+
+size_t RasterCache::GetCachedImageBytes() const {
+  size_t bytes = 0;
+  for (const auto& item : cache_) {
+    if (item.second.image) {
+      bytes += item.second.image->image_bytes();
+    }
+    bytes += item.second.pending_bytes;
+  }
+  return bytes;
+}
+
+bool RasterCache::MakeRoomInBudget(size_t bytes) const {
+  if (policy_.byte_budget == 0) {
+    return true;
+  }
+  if (bytes > policy_.byte_budget) {
+    return false;
+  }
+  size_t cached_bytes = GetCachedImageBytes();
+  while (cached_bytes + bytes > policy_.byte_budget) {
+    // Entries that are used in this frame may already have told their
+    // layers that they will be drawn from the cache, so only the entries
+    // that are waiting out their grace period can be evicted. Of those,
+    // evict the one with the lowest cost of rasterizing it again per byte,
+    // and of equally valuable ones the one unused for the longest time.
+    auto victim = cache_.end();
+    double victim_density = 0.0;
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+      const Entry& entry = it->second;
+      if (entry.encountered_this_frame || !entry.image) {
+        continue;
+      }
+      int64_t image_bytes = entry.image->image_bytes();
+      double density = entry.raster_cost == 0 || image_bytes <= 0
+                           ? std::numeric_limits<double>::infinity()
+                           : static_cast<double>(entry.raster_cost) /
+                                 static_cast<double>(image_bytes);
+      if (victim == cache_.end() || density < victim_density ||
+          (density == victim_density &&
+           entry.frames_since_encountered >
+               victim->second.frames_since_encountered)) {
+        victim = it;
+        victim_density = density;
+      }
+    }
+    if (victim == cache_.end()) {
+      return false;
+    }
+    size_t victim_bytes = victim->second.image->image_bytes();
+    RasterCacheMetrics& metrics = GetMetricsForKind(victim->first.kind());
+    metrics.eviction_count++;
+    metrics.eviction_bytes += victim_bytes;
+    metrics.budget_eviction_count++;
+    cache_.erase(victim);
+    cached_bytes -= std::min(cached_bytes, victim_bytes);
+  }
+  return true;
 }
 
 void RasterCache::EndFrame() {
@@ -276,6 +655,26 @@ void RasterCache::TraceStatsToTimeline() const {
       "PictureCount", picture_metrics_.total_count(),                      //
       "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
 
+  RasterCacheMetrics total;
+  for (const RasterCacheMetrics* metrics :
+       {&layer_metrics_, &picture_metrics_}) {
+    total.hit_count += metrics->hit_count;
+    total.miss_count += metrics->miss_count;
+    total.unused_eviction_count += metrics->unused_eviction_count;
+    total.budget_eviction_count += metrics->budget_eviction_count;
+    total.budget_rejection_count += metrics->budget_rejection_count;
+    total.disk_hit_count += metrics->disk_hit_count;
+  }
+  FML_TRACE_COUNTER(
+      "flutter",                                                //
+      "RasterCacheEvictions", reinterpret_cast<int64_t>(this),  //
+      "Hits", total.hit_count,                                  //
+      "Misses", total.miss_count,                               //
+      "UnusedEvictions", total.unused_eviction_count,           //
+      "BudgetEvictions", total.budget_eviction_count,           //
+      "BudgetRejections", total.budget_rejection_count,         //
+      "DiskHits", total.disk_hit_count);
+
 #endif  // !FLUTTER_RELEASE
 }
 
@@ -301,7 +700,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
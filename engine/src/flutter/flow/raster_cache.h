@@ -7,15 +7,19 @@
 
 #if !SLIMPELLER
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/display_list/geometry/dl_geometry_conversions.h"
+#include "flutter/flow/raster_cache_disk_store.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -48,6 +52,8 @@ class RasterCacheResult {
     return image_ ? image_->GetApproximateByteSize() : 0;
   };
 
+  const sk_sp<DlImage>& image() const { return image_; }
+
  private:
   sk_sp<DlImage> image_;
   SkRect logical_rect_;
@@ -81,15 +87,86 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images that were not used in this frame
+   * but are kept for the eviction grace period of the |RasterCachePolicy|.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images retained in this frame.
+   */
+  size_t retained_bytes = 0;
+
+  /**
+   * The number of times an entry was drawn from its cached image in this
+   * frame.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * The number of times an entry was asked to draw in this frame but had no
+   * cached image.
+   */
+  size_t miss_count = 0;
+
+  /**
+   * The number of cache entries with images evicted in this frame because
+   * they were not used for longer than the eviction grace period.
+   */
+  size_t unused_eviction_count = 0;
+
+  /**
+   * The number of cache entries with images evicted in this frame to make
+   * room for other entries within the byte budget.
+   */
+  size_t budget_eviction_count = 0;
+
+  /**
+   * The number of new images that were not cached in this frame because
+   * they did not fit in the byte budget.
+   */
+  size_t budget_rejection_count = 0;
+
+  /**
+   * The number of new images that were loaded from the disk store instead
+   * of being rasterized in this frame.
+   */
+  size_t disk_hit_count = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
-  size_t total_count() const { return in_use_count; }
+  size_t total_count() const { return in_use_count + retained_count; }
 
   /**
    * The size of all of the cached images during this frame.
    */
-  size_t total_bytes() const { return in_use_bytes; }
+  size_t total_bytes() const { return in_use_bytes + retained_bytes; }
+};
+
+/**
+ * Limits on the memory held by a |RasterCache| and on how long it keeps
+ * entries that are no longer used.
+ *
+ * When the images of the cache would exceed the byte budget, the cache
+ * evicts the entries that were not used in the current frame, starting
+ * with the entries that are cheapest to rasterize again for the memory
+ * they hold, as estimated by their |RasterCache::Context::raster_cost|. If
+ * that does not free enough memory, the new image is not cached.
+ */
+struct RasterCachePolicy {
+  /**
+   * The maximum size of all of the cached images, or 0 for no limit.
+   */
+  size_t byte_budget = 0;
+
+  /**
+   * The number of frames that an entry is kept after the last frame that
+   * used it. With 0, an entry is evicted by the first frame that does not
+   * use it.
+   */
+  size_t eviction_grace_frames = 0;
 };
 
 /**
@@ -124,6 +201,18 @@ class RasterCache {
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // The estimated cost of rasterizing the entry again, in the units of the
+    // |DisplayListComplexityCalculator|, or 0 if the cost is not known.
+    // Entries with an unknown cost are evicted last.
+    unsigned int raster_cost = 0;
+    // Whether the render function can be called on another thread to draw
+    // into a raster surface, which requires that it only refers to immutable
+    // content without texture backed images.
+    bool can_rasterize_in_background = false;
+    // A hash of the content that is the same in every run of the app, see
+    // |DisplayListSerialization::ContentHash|. Only entries with such a hash
+    // are kept in the disk store.
+    std::optional<uint64_t> content_hash = std::nullopt;
   };
   struct CacheInfo {
     const size_t accesses_since_visible;
@@ -140,7 +229,8 @@ class RasterCache {
   explicit RasterCache(
       size_t access_threshold = 3,
       size_t picture_and_display_list_cache_limit_per_frame =
-          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
+          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      const RasterCachePolicy& policy = {});
 
   virtual ~RasterCache() = default;
 
@@ -216,6 +306,64 @@ class RasterCache {
    */
   size_t access_threshold() const { return access_threshold_; }
 
+  const RasterCachePolicy& policy() const { return policy_; }
+
+  /**
+   * @brief Replaces the policy of the cache. A smaller byte budget or grace
+   * period takes effect when the unused entries are next evicted.
+   */
+  void SetPolicy(const RasterCachePolicy& policy) { policy_ = policy; }
+
+  using ResourceContextGetter = std::function<fml::WeakPtr<GrDirectContext>()>;
+
+  /**
+   * @brief Render the images of new entries that allow it on
+   * |worker_task_runner| instead of in the frame that first needs them.
+   *
+   * Until the image of such an entry is ready, |UpdateCacheEntry| returns
+   * false and the frames draw the entry without the cache. Ready images are
+   * adopted by |BeginFrame|, before the preroll that decides which entries
+   * are drawn from the cache.
+   *
+   * The images are rendered into raster surfaces. If |io_task_runner| is
+   * set, they are then uploaded on it to the context returned by
+   * |resource_context_getter|, which is called on that task runner.
+   * Otherwise, they are uploaded when they are first drawn.
+   *
+   * Passing a null |worker_task_runner| renders all new images in the frame
+   * again.
+   */
+  void SetBackgroundRasterizer(
+      std::shared_ptr<fml::BasicTaskRunner> worker_task_runner,
+      fml::RefPtr<fml::TaskRunner> io_task_runner = nullptr,
+      ResourceContextGetter resource_context_getter = nullptr);
+
+  bool rasterizes_in_background() const {
+    return worker_task_runner_ != nullptr;
+  }
+
+  /**
+   * @brief Keep the images of entries with a |Context::content_hash| in
+   * |disk_store|, so that later runs of the app can load them instead of
+   * rasterizing them again.
+   *
+   * When a new entry needs an image, the image is loaded from the disk store
+   * if it is there, and stored in it after it is rasterized otherwise. The
+   * images of entries are not stored while checkerboarding is enabled.
+   *
+   * With a background rasterizer, the images are loaded on its worker task
+   * runner and adopted by |BeginFrame| like the images it renders. Images
+   * rendered by the frame on the GPU are read back asynchronously before
+   * they are stored.
+   *
+   * Passing a null |disk_store| disables the disk store.
+   */
+  void SetDiskStore(std::shared_ptr<RasterCacheDiskStore> disk_store) {
+    disk_store_ = std::move(disk_store);
+  }
+
+  bool has_disk_store() const { return disk_store_ != nullptr; }
+
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
     return access_threshold_ != 0 && display_list_cached_this_frame_ <
@@ -252,20 +400,59 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    size_t frames_since_encountered = 0;
+    unsigned int raster_cost = 0;
+    // Whether the image is being rendered by the background rasterizer, and
+    // the estimated size that is reserved for it in the byte budget.
+    bool background_raster_pending = false;
+    size_t pending_bytes = 0;
+    // Whether the disk store had no usable image when it was last loaded in
+    // the background.
+    bool disk_load_failed = false;
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  struct BackgroundResults;
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
+
+  size_t GetCachedImageBytes() const;
+
+  // Evicts the images of entries that were not used in this frame until
+  // |bytes| more bytes fit in the byte budget, and returns whether they fit.
+  bool MakeRoomInBudget(size_t bytes) const;
+
+  // Loads the image of the entry from the disk store if |load_from_disk|,
+  // and rasterizes it otherwise if the entry allows it.
+  void RasterizeInBackground(
+      const RasterCacheKey& key,
+      const Context& context,
+      sk_sp<const DlRTree> rtree,
+      const std::function<void(DlCanvas*)>& render_function,
+      std::optional<uint64_t> disk_key,
+      bool load_from_disk) const;
+
+  // Returns the key of the image of the entry in the disk store, or
+  // std::nullopt if it is not kept in the disk store.
+  std::optional<uint64_t> GetDiskKey(const Context& context) const;
+
+  void AdoptBackgroundResults();
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
+  RasterCachePolicy policy_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_ = false;
+  std::shared_ptr<fml::BasicTaskRunner> worker_task_runner_;
+  fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  ResourceContextGetter resource_context_getter_;
+  std::shared_ptr<BackgroundResults> background_results_;
+  std::shared_ptr<RasterCacheDiskStore> disk_store_;
 
   void TraceStatsToTimeline() const;
 
@@ -0,0 +1,306 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !SLIMPELLER
+
+#include "flutter/flow/raster_cache_disk_store.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/codec/SkPngDecoder.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr char kIndexFileName[] = "index";
+
+// 64-bit FNV-1a, which unlike |std::hash| has the same result in every
+// run of the engine.
+void HashBytes(uint64_t& hash, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3u;
+  }
+}
+
+std::string GetFileName(uint64_t key) {
+  char name[32];
+  snprintf(name, sizeof(name), "%016" PRIx64 ".png", key);
+  return name;
+}
+
+}  // namespace
+
+struct RasterCacheDiskStore::State {
+  struct Record {
+    uint64_t key;
+    size_t bytes;
+  };
+
+  State(fml::UniqueFD p_directory, size_t p_max_bytes)
+      : directory(std::move(p_directory)), max_bytes(p_max_bytes) {
+    ReadIndex();
+  }
+
+  ~State() {
+    if (index_dirty) {
+      WriteIndex();
+    }
+  }
+
+  std::mutex mutex;
+  const fml::UniqueFD directory;
+  const size_t max_bytes;
+  // Ordered from the least to the most recently used.
+  std::list<Record> records;
+  std::unordered_map<uint64_t, std::list<Record>::iterator> records_by_key;
+  // The keys of the images that are being encoded and written.
+  std::unordered_set<uint64_t> pending_keys;
+  size_t total_bytes = 0;
+  bool index_dirty = false;
+
+  // Reads the index left by a previous run and deletes the files that it
+  // does not list, such as files whose writes were interrupted.
+  void ReadIndex() {
+    std::unique_ptr<fml::FileMapping> index =
+        fml::FileMapping::CreateReadOnly(directory, kIndexFileName);
+    if (index && index->GetMapping()) {
+      std::istringstream lines(
+          std::string(reinterpret_cast<const char*>(index->GetMapping()),
+                      index->GetSize()));
+      std::string key_string;
+      size_t bytes;
+      while (lines >> key_string >> bytes) {
+        uint64_t key = std::strtoull(key_string.c_str(), nullptr, 16);
+        if (records_by_key.count(key) ||
+            !fml::FileExists(directory, GetFileName(key).c_str())) {
+          continue;
+        }
+        records.push_back({key, bytes});
+        records_by_key[key] = std::prev(records.end());
+        total_bytes += bytes;
+      }
+    }
+
+    std::unordered_set<std::string> known_files = {kIndexFileName};
+    for (const Record& record : records) {
+      known_files.insert(GetFileName(record.key));
+    }
+    std::vector<std::string> unknown_files;
+    fml::VisitFiles(directory, [&known_files, &unknown_files](
+                                   const fml::UniqueFD& visited_directory,
+                                   const std::string& filename) {
+      if (!known_files.count(filename)) {
+        unknown_files.push_back(filename);
+      }
+      return true;
+    });
+    for (const std::string& filename : unknown_files) {
+      fml::UnlinkFile(directory, filename.c_str());
+    }
+
+    // The size limit may be lower than in the previous run.
+    if (EvictUntilFits(0)) {
+      WriteIndex();
+    }
+  }
+
+  void WriteIndex() {
+    std::ostringstream index;
+    for (const Record& record : records) {
+      index << std::hex << record.key << " " << std::dec << record.bytes
+            << "\n";
+    }
+    std::string contents = index.str();
+    fml::DataMapping mapping(
+        std::vector<uint8_t>(contents.begin(), contents.end()));
+    if (!fml::WriteAtomically(directory, kIndexFileName, mapping)) {
+      FML_LOG(ERROR) << "Could not write the raster cache disk index.";
+    }
+    index_dirty = false;
+  }
+
+  // Deletes the least recently used files until |bytes| more bytes fit in
+  // the size limit, and returns whether any files were deleted.
+  bool EvictUntilFits(size_t bytes) {
+    bool evicted = false;
+    while (!records.empty() && total_bytes + bytes > max_bytes) {
+      const Record& victim = records.front();
+      fml::UnlinkFile(directory, GetFileName(victim.key).c_str());
+      total_bytes -= victim.bytes;
+      records_by_key.erase(victim.key);
+      records.pop_front();
+      evicted = true;
+    }
+    return evicted;
+  }
+
+  void Remove(uint64_t key) {
+    auto it = records_by_key.find(key);
+    if (it == records_by_key.end()) {
+      return;
+    }
+    fml::UnlinkFile(directory, GetFileName(key).c_str());
+    total_bytes -= it->second->bytes;
+    records.erase(it->second);
+    records_by_key.erase(it);
+    WriteIndex();
+  }
+
+  void Write(uint64_t key, const sk_sp<SkImage>& image) {
+    TRACE_EVENT0("flutter", "RasterCacheDiskStore::Write");
+    sk_sp<SkData> png = SkPngEncoder::Encode(nullptr, image.get(), {});
+    bool written = false;
+    if (png && png->size() <= max_bytes) {
+      fml::NonOwnedMapping mapping(png->bytes(), png->size());
+      written = fml::WriteAtomically(directory, GetFileName(key).c_str(),
+                                     mapping);
+    }
+
+    std::scoped_lock lock(mutex);
+    pending_keys.erase(key);
+    if (!written) {
+      return;
+    }
+    EvictUntilFits(png->size());
+    records.push_back({key, png->size()});
+    records_by_key[key] = std::prev(records.end());
+    total_bytes += png->size();
+    WriteIndex();
+  }
+};
+
+RasterCacheDiskStore::RasterCacheDiskStore(
+    fml::UniqueFD directory,
+    size_t max_bytes,
+    std::shared_ptr<fml::BasicTaskRunner> task_runner)
+    : max_bytes_(max_bytes),
+      task_runner_(std::move(task_runner)),
+      state_(std::make_shared<State>(std::move(directory), max_bytes)) {}
+
+RasterCacheDiskStore::~RasterCacheDiskStore() = default;
+
+uint64_t RasterCacheDiskStore::ComputeKey(uint64_t content_hash,
+                                          const SkMatrix& matrix,
+                                          const SkRect& logical_rect,
+                                          const SkColorSpace* color_space) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  HashBytes(hash, &content_hash, sizeof(content_hash));
+  // As with |RasterCacheKey|, the image does not depend on the translation.
+  SkScalar matrix_values[9];
+  matrix.get9(matrix_values);
+  matrix_values[SkMatrix::kMTransX] = 0;
+  matrix_values[SkMatrix::kMTransY] = 0;
+  HashBytes(hash, matrix_values, sizeof(matrix_values));
+  SkScalar rect_values[4] = {logical_rect.fLeft, logical_rect.fTop,
+                             logical_rect.fRight, logical_rect.fBottom};
+  HashBytes(hash, rect_values, sizeof(rect_values));
+  uint32_t color_space_values[2] = {
+      color_space ? color_space->toXYZD50Hash() : 0u,
+      color_space ? color_space->transferFnHash() : 0u};
+  HashBytes(hash, color_space_values, sizeof(color_space_values));
+  return hash;
+}
+
+sk_sp<SkImage> RasterCacheDiskStore::Load(
+    uint64_t key,
+    sk_sp<SkColorSpace> color_space) const {
+  std::shared_ptr<fml::FileMapping> file;
+  {
+    std::scoped_lock lock(state_->mutex);
+    auto it = state_->records_by_key.find(key);
+    if (it == state_->records_by_key.end()) {
+      return nullptr;
+    }
+    // The mapping stays readable if the file is evicted while it is
+    // decoded.
+    file = fml::FileMapping::CreateReadOnly(state_->directory,
+                                            GetFileName(key));
+    if (!file || !file->GetMapping()) {
+      state_->Remove(key);
+      return nullptr;
+    }
+    state_->records.splice(state_->records.end(), state_->records,
+                           it->second);
+    state_->index_dirty = true;
+  }
+
+  TRACE_EVENT0("flutter", "RasterCacheDiskStore::Load");
+  sk_sp<SkData> data =
+      SkData::MakeWithoutCopy(file->GetMapping(), file->GetSize());
+  std::unique_ptr<SkCodec> codec = SkPngDecoder::Decode(data, nullptr);
+  SkBitmap bitmap;
+  if (!codec ||
+      !bitmap.tryAllocPixels(SkImageInfo::MakeN32Premul(
+          codec->dimensions(), std::move(color_space))) ||
+      codec->getPixels(bitmap.pixmap()) != SkCodec::kSuccess) {
+    FML_LOG(ERROR) << "Could not decode the raster cache image "
+                   << GetFileName(key);
+    std::scoped_lock lock(state_->mutex);
+    state_->Remove(key);
+    return nullptr;
+  }
+  bitmap.setImmutable();
+  return SkImages::RasterFromBitmap(bitmap);
+}
+
+void RasterCacheDiskStore::Store(uint64_t key, sk_sp<SkImage> image) {
+  if (!image || image->isTextureBacked()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(state_->mutex);
+    if (state_->records_by_key.count(key) ||
+        !state_->pending_keys.insert(key).second) {
+      return;
+    }
+  }
+  if (!task_runner_) {
+    state_->Write(key, image);
+    return;
+  }
+  task_runner_->PostTask([state = state_, key, image = std::move(image)]() {
+    state->Write(key, image);
+  });
+}
+
+bool RasterCacheDiskStore::Contains(uint64_t key) const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->records_by_key.count(key) > 0;
+}
+
+size_t RasterCacheDiskStore::entry_count() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->records.size() + state_->pending_keys.size();
+}
+
+size_t RasterCacheDiskStore::byte_size() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->total_bytes;
+}
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
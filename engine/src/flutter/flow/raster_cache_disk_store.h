@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
+#define FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
+
+#if !SLIMPELLER
+
+#include <cstdint>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+class SkColorSpace;
+
+namespace flutter {
+
+/**
+ * A size limited store of rasterized images in a directory, used by the
+ * |RasterCache| to keep the images of static content across runs of the
+ * app.
+ *
+ * Images are stored as PNG files named after their key. The store keeps an
+ * index of the files in the order in which they were last used, and evicts
+ * the least recently used files when the total size of the files would
+ * exceed the size limit. The index is written to the directory whenever
+ * files are added or removed and when the store is destroyed, and files
+ * that are not in the index when the store is created are deleted.
+ *
+ * PNG files hold unpremultiplied colors, so the colors of translucent
+ * pixels that are loaded may differ slightly from the rendered ones.
+ *
+ * All methods may be called from any thread.
+ */
+class RasterCacheDiskStore {
+ public:
+  /**
+   * Creates a store of at most |max_bytes| of files in |directory|. If
+   * |task_runner| is set, images are encoded and written on it, otherwise
+   * they are written by |Store| itself.
+   */
+  RasterCacheDiskStore(
+      fml::UniqueFD directory,
+      size_t max_bytes,
+      std::shared_ptr<fml::BasicTaskRunner> task_runner = nullptr);
+
+  ~RasterCacheDiskStore();
+
+  /**
+   * Returns the key of the image of content with the given
+   * |content_hash|, rendered with |matrix| into |color_space|. The
+   * translation of |matrix| is ignored.
+   */
+  static uint64_t ComputeKey(uint64_t content_hash,
+                             const SkMatrix& matrix,
+                             const SkRect& logical_rect,
+                             const SkColorSpace* color_space);
+
+  /**
+   * Returns the image stored with |key| as a raster image in
+   * |color_space|, or nullptr if there is no such image or it could not be
+   * read. A successful load marks the image as the most recently used.
+   */
+  sk_sp<SkImage> Load(uint64_t key, sk_sp<SkColorSpace> color_space) const;
+
+  /**
+   * Stores |image|, which must be a raster image, with |key|, unless an
+   * image with that key is already stored or being stored.
+   */
+  void Store(uint64_t key, sk_sp<SkImage> image);
+
+  bool Contains(uint64_t key) const;
+
+  /**
+   * The number of stored images, including the ones that are being
+   * written.
+   */
+  size_t entry_count() const;
+
+  /**
+   * The size of the files of the stored images.
+   */
+  size_t byte_size() const;
+
+  size_t max_bytes() const { return max_bytes_; }
+
+ private:
+  struct State;
+
+  const size_t max_bytes_;
+  std::shared_ptr<fml::BasicTaskRunner> task_runner_;
+  std::shared_ptr<State> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheDiskStore);
+};
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
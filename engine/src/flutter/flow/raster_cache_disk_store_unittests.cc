@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_disk_store.h"
+
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<SkImage> MakeTestImage(SkColor color) {
+  sk_sp<SkSurface> surface =
+      SkSurfaces::Raster(SkImageInfo::MakeN32Premul(40, 30));
+  surface->getCanvas()->clear(color);
+  return surface->makeImageSnapshot();
+}
+
+fml::UniqueFD OpenDirectory(const fml::ScopedTemporaryDirectory& dir) {
+  return fml::OpenDirectory(dir.path().c_str(), false,
+                            fml::FilePermission::kReadWrite);
+}
+
+// Runs the posted tasks only when asked to.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t RunPendingTasks() {
+    std::vector<fml::closure> tasks;
+    tasks.swap(tasks_);
+    for (const fml::closure& task : tasks) {
+      task();
+    }
+    return tasks.size();
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+}  // namespace
+
+TEST(RasterCacheDiskStore, ImagesAreKeptAcrossInstances) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  {
+    RasterCacheDiskStore store(OpenDirectory(temp_dir), 1 << 20);
+    store.Store(1u, MakeTestImage(SK_ColorRED));
+    EXPECT_TRUE(store.Contains(1u));
+    EXPECT_FALSE(store.Contains(2u));
+    EXPECT_EQ(store.entry_count(), 1u);
+    EXPECT_GT(store.byte_size(), 0u);
+  }
+
+  RasterCacheDiskStore store(OpenDirectory(temp_dir), 1 << 20);
+  ASSERT_TRUE(store.Contains(1u));
+  sk_sp<SkImage> image = store.Load(1u, nullptr);
+  ASSERT_NE(image, nullptr);
+  EXPECT_FALSE(image->isTextureBacked());
+  EXPECT_EQ(image->width(), 40);
+  EXPECT_EQ(image->height(), 30);
+  SkPixmap pixmap;
+  ASSERT_TRUE(image->peekPixels(&pixmap));
+  EXPECT_EQ(pixmap.getColor(20, 15), SK_ColorRED);
+
+  EXPECT_EQ(store.Load(2u, nullptr), nullptr);
+}
+
+TEST(RasterCacheDiskStore, EvictsLeastRecentlyUsedImages) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  size_t image_bytes;
+  {
+    fml::ScopedTemporaryDirectory measure_dir;
+    RasterCacheDiskStore store(OpenDirectory(measure_dir), 1 << 20);
+    store.Store(1u, MakeTestImage(SK_ColorRED));
+    image_bytes = store.byte_size();
+    ASSERT_GT(image_bytes, 0u);
+  }
+
+  // The limit holds 2 images of the same size.
+  RasterCacheDiskStore store(OpenDirectory(temp_dir), image_bytes * 5 / 2);
+  store.Store(1u, MakeTestImage(SK_ColorRED));
+  store.Store(2u, MakeTestImage(SK_ColorRED));
+  ASSERT_NE(store.Load(1u, nullptr), nullptr);
+  store.Store(3u, MakeTestImage(SK_ColorRED));
+
+  EXPECT_TRUE(store.Contains(1u));
+  EXPECT_FALSE(store.Contains(2u));
+  EXPECT_TRUE(store.Contains(3u));
+  EXPECT_EQ(store.byte_size(), image_bytes * 2);
+  EXPECT_FALSE(fml::FileExists(temp_dir.fd(), "0000000000000002.png"));
+
+  // A lower limit in a later run evicts the images that no longer fit.
+  RasterCacheDiskStore smaller_store(OpenDirectory(temp_dir), image_bytes);
+  EXPECT_FALSE(smaller_store.Contains(1u));
+  EXPECT_TRUE(smaller_store.Contains(3u));
+}
+
+TEST(RasterCacheDiskStore, DeletesFilesThatAreNotInTheIndex) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  fml::DataMapping stray_data(std::vector<uint8_t>{1, 2, 3});
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "0000000000000007.png",
+                                   stray_data));
+
+  RasterCacheDiskStore store(OpenDirectory(temp_dir), 1 << 20);
+  EXPECT_FALSE(store.Contains(7u));
+  EXPECT_EQ(store.entry_count(), 0u);
+  EXPECT_FALSE(fml::FileExists(temp_dir.fd(), "0000000000000007.png"));
+}
+
+TEST(RasterCacheDiskStore, WritesImagesOnTaskRunner) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  RasterCacheDiskStore store(OpenDirectory(temp_dir), 1 << 20, task_runner);
+
+  store.Store(1u, MakeTestImage(SK_ColorBLUE));
+  // Storing an image that is being written again does nothing.
+  store.Store(1u, MakeTestImage(SK_ColorBLUE));
+  EXPECT_EQ(store.entry_count(), 1u);
+  EXPECT_FALSE(store.Contains(1u));
+  EXPECT_EQ(store.Load(1u, nullptr), nullptr);
+
+  EXPECT_EQ(task_runner->RunPendingTasks(), 1u);
+  EXPECT_TRUE(store.Contains(1u));
+  EXPECT_NE(store.Load(1u, nullptr), nullptr);
+}
+
+TEST(RasterCacheDiskStore, KeyDependsOnMatrixAndColorSpace) {
+  SkRect rect = SkRect::MakeWH(100, 100);
+  uint64_t key =
+      RasterCacheDiskStore::ComputeKey(1u, SkMatrix::I(), rect, nullptr);
+  EXPECT_EQ(key,
+            RasterCacheDiskStore::ComputeKey(1u, SkMatrix::I(), rect, nullptr));
+  EXPECT_NE(key,
+            RasterCacheDiskStore::ComputeKey(2u, SkMatrix::I(), rect, nullptr));
+  EXPECT_NE(key, RasterCacheDiskStore::ComputeKey(
+                     1u, SkMatrix::Scale(2, 2), rect, nullptr));
+  EXPECT_EQ(key, RasterCacheDiskStore::ComputeKey(
+                     1u, SkMatrix::Translate(12.5, -40), rect, nullptr));
+  EXPECT_NE(key, RasterCacheDiskStore::ComputeKey(
+                     1u, SkMatrix::I(), rect,
+                     SkColorSpace::MakeSRGB().get()));
+}
+
+}  // namespace testing
+}  // namespace flutter
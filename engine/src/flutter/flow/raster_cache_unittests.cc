@@ -12,9 +12,11 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/flow/raster_cache_disk_store.h"
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/file.h"
 #include "flutter/testing/assertions_skia.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -320,6 +322,415 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+namespace {
+
+// Marks the indicated display list ids as seen and caches them directly,
+// as the raster cache items would do during a frame.
+struct BudgetTestEntry {
+  uint64_t id;
+  unsigned int raster_cost;
+};
+
+void RunBudgetTestFrame(RasterCache& cache,
+                        const std::vector<BudgetTestEntry>& entries,
+                        std::vector<bool>* cached = nullptr) {
+  SkMatrix matrix = SkMatrix::I();
+  SkRect logical_rect = SkRect::MakeWH(80, 80);
+  cache.BeginFrame();
+  for (const BudgetTestEntry& entry : entries) {
+    cache.MarkSeen(
+        RasterCacheKeyID(entry.id, RasterCacheKeyType::kDisplayList), matrix,
+        true);
+  }
+  cache.EvictUnusedCacheEntries();
+  for (const BudgetTestEntry& entry : entries) {
+    RasterCache::Context context = {
+        // clang-format off
+        .gr_context         = nullptr,
+        .dst_color_space    = nullptr,
+        .matrix             = matrix,
+        .logical_rect       = logical_rect,
+        .flow_type          = "RasterCacheFlow::DisplayList",
+        .raster_cost        = entry.raster_cost,
+        // clang-format on
+    };
+    bool result = cache.UpdateCacheEntry(
+        RasterCacheKeyID(entry.id, RasterCacheKeyType::kDisplayList), context,
+        [](DlCanvas* canvas) {
+          canvas->DrawRect(DlRect::MakeWH(80, 80), DlPaint());
+        });
+    if (cached) {
+      cached->push_back(result);
+    }
+  }
+  cache.EndFrame();
+}
+
+bool HasImage(RasterCache& cache, uint64_t id) {
+  DisplayListBuilder canvas;
+  DlPaint paint;
+  return cache.Draw(RasterCacheKeyID(id, RasterCacheKeyType::kDisplayList),
+                    canvas, &paint);
+}
+
+}  // namespace
+
+TEST(RasterCache, EvictionGracePeriodRetainsUnusedEntries) {
+  RasterCache cache(1, 3, {.eviction_grace_frames = 2});
+
+  RunBudgetTestFrame(cache, {{1, 100}, {2, 100}});
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 2u);
+
+  // The second entry is kept for 2 frames after it was last used.
+  RunBudgetTestFrame(cache, {{1, 100}});
+  EXPECT_EQ(cache.picture_metrics().in_use_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().retained_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().total_count(), 2u);
+  RunBudgetTestFrame(cache, {{1, 100}});
+  EXPECT_EQ(cache.picture_metrics().retained_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().eviction_count, 0u);
+
+  RunBudgetTestFrame(cache, {{1, 100}});
+  EXPECT_EQ(cache.picture_metrics().retained_count, 0u);
+  EXPECT_EQ(cache.picture_metrics().eviction_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().unused_eviction_count, 1u);
+  EXPECT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, HitAndMissCountersAreReported) {
+  RasterCache cache(1, 3, {.eviction_grace_frames = 2});
+
+  RunBudgetTestFrame(cache, {{1, 100}});
+  // Entries in their grace period can still be drawn.
+  RunBudgetTestFrame(cache, {});
+  cache.BeginFrame();
+  EXPECT_TRUE(HasImage(cache, 1));
+  EXPECT_EQ(cache.picture_metrics().hit_count, 1u);
+  EXPECT_FALSE(HasImage(cache, 2));
+  EXPECT_EQ(cache.picture_metrics().miss_count, 1u);
+  cache.EndFrame();
+}
+
+TEST(RasterCache, ByteBudgetEvictsCheapestUnusedEntryFirst) {
+  // Each 80x80 image uses a little more than 25600 bytes, so the budget
+  // holds 2 of them.
+  RasterCache cache(1, 3, {.byte_budget = 60000, .eviction_grace_frames = 10});
+
+  RunBudgetTestFrame(cache, {{1, 1000}, {2, 10}});
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 2u);
+
+  // Entry 2 is cheaper to rasterize again, so it makes room for entry 3.
+  std::vector<bool> cached;
+  RunBudgetTestFrame(cache, {{3, 500}}, &cached);
+  ASSERT_EQ(cached.size(), 1u);
+  EXPECT_TRUE(cached[0]);
+  EXPECT_EQ(cache.picture_metrics().budget_eviction_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().eviction_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().total_count(), 2u);
+  EXPECT_LE(cache.EstimatePictureCacheByteSize(), 60000u);
+
+  cache.BeginFrame();
+  EXPECT_TRUE(HasImage(cache, 1));
+  EXPECT_FALSE(HasImage(cache, 2));
+  EXPECT_TRUE(HasImage(cache, 3));
+  cache.EndFrame();
+}
+
+TEST(RasterCache, ByteBudgetNeverEvictsEntriesUsedInTheFrame) {
+  RasterCache cache(1, 3, {.byte_budget = 30000, .eviction_grace_frames = 10});
+
+  std::vector<bool> cached;
+  RunBudgetTestFrame(cache, {{1, 10}, {2, 1000}}, &cached);
+  ASSERT_EQ(cached.size(), 2u);
+  EXPECT_TRUE(cached[0]);
+  EXPECT_FALSE(cached[1]);
+  EXPECT_EQ(cache.picture_metrics().budget_rejection_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().budget_eviction_count, 0u);
+  EXPECT_EQ(cache.picture_metrics().in_use_count, 1u);
+}
+
+TEST(RasterCache, ByteBudgetRejectsImagesLargerThanBudget) {
+  RasterCache cache(1, 3, {.byte_budget = 1000});
+
+  std::vector<bool> cached;
+  RunBudgetTestFrame(cache, {{1, 1000}}, &cached);
+  ASSERT_EQ(cached.size(), 1u);
+  EXPECT_FALSE(cached[0]);
+  EXPECT_EQ(cache.picture_metrics().budget_rejection_count, 1u);
+  EXPECT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
+namespace {
+
+// Runs the posted tasks only when asked to, so that a test can control
+// when the background work completes.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t RunPendingTasks() {
+    std::vector<fml::closure> tasks;
+    tasks.swap(tasks_);
+    for (const fml::closure& task : tasks) {
+      task();
+    }
+    return tasks.size();
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+}  // namespace
+
+TEST(RasterCache, BackgroundRasterizerDrawsUncachedUntilImageIsReady) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto worker = std::make_shared<ManualTaskRunner>();
+  cache.SetBackgroundRasterizer(worker);
+  ASSERT_TRUE(cache.rasterizes_in_background());
+
+  DlMatrix matrix;
+
+  auto display_list = GetSampleDisplayList();
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  // 1st access.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+  ASSERT_EQ(worker->RunPendingTasks(), 0u);
+
+  // The entry is now worth caching, but the frame does not wait for it.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().total_count(), 0u);
+
+  // No more work is posted while the image is pending.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+  ASSERT_EQ(worker->RunPendingTasks(), 1u);
+
+  // The next frame adopts the image before its preroll.
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
+  ASSERT_EQ(worker->RunPendingTasks(), 0u);
+}
+
+TEST(RasterCache, BackgroundImageOfEvictedEntryIsDropped) {
+  flutter::RasterCache cache(1);
+  auto worker = std::make_shared<ManualTaskRunner>();
+  cache.SetBackgroundRasterizer(worker);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkRect logical_rect = SkRect::MakeWH(80, 80);
+  RasterCacheKeyID id(1, RasterCacheKeyType::kDisplayList);
+  RasterCache::Context context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      .can_rasterize_in_background = true,
+      // clang-format on
+  };
+
+  cache.BeginFrame();
+  cache.MarkSeen(id, matrix, true);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(cache.UpdateCacheEntry(id, context, [](DlCanvas* canvas) {
+    canvas->DrawRect(DlRect::MakeWH(80, 80), DlPaint());
+  }));
+  cache.EndFrame();
+
+  // The entry is not used by the next frame, so it is evicted before its
+  // image is ready.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+
+  ASSERT_EQ(worker->RunPendingTasks(), 1u);
+  cache.BeginFrame();
+  cache.EndFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 0u);
+}
+
+TEST(RasterCache, DiskStoreImagesAreUsedByLaterRuns) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto open_disk_store = [&temp_dir]() {
+    return std::make_shared<RasterCacheDiskStore>(
+        fml::OpenDirectory(temp_dir.path().c_str(), false,
+                           fml::FilePermission::kReadWrite),
+        1 << 20);
+  };
+
+  SkMatrix matrix = SkMatrix::I();
+  SkRect logical_rect = SkRect::MakeWH(80, 80);
+  RasterCacheKeyID id(1, RasterCacheKeyType::kDisplayList);
+  RasterCache::Context context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      .content_hash       = 1234u,
+      // clang-format on
+  };
+  int render_count = 0;
+  auto render = [&render_count](DlCanvas* canvas) {
+    render_count++;
+    canvas->DrawRect(DlRect::MakeWH(80, 80), DlPaint());
+  };
+  auto run_frame = [&](RasterCache& cache) {
+    cache.BeginFrame();
+    cache.MarkSeen(id, matrix, true);
+    cache.EvictUnusedCacheEntries();
+    bool cached = cache.UpdateCacheEntry(id, context, render);
+    cache.EndFrame();
+    return cached;
+  };
+
+  {
+    RasterCache cache(1);
+    cache.SetDiskStore(open_disk_store());
+    ASSERT_TRUE(cache.has_disk_store());
+    ASSERT_TRUE(run_frame(cache));
+    EXPECT_EQ(render_count, 1);
+    EXPECT_EQ(cache.picture_metrics().disk_hit_count, 0u);
+  }
+
+  RasterCache cache(1);
+  cache.SetDiskStore(open_disk_store());
+  ASSERT_TRUE(run_frame(cache));
+  EXPECT_EQ(render_count, 1);
+  EXPECT_EQ(cache.picture_metrics().disk_hit_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().in_use_count, 1u);
+  cache.BeginFrame();
+  EXPECT_TRUE(HasImage(cache, 1));
+  cache.EndFrame();
+
+  // The same content at another scroll offset is loaded from disk as well.
+  RasterCache translated_cache(1);
+  translated_cache.SetDiskStore(open_disk_store());
+  // |context| refers to |matrix|.
+  matrix = SkMatrix::Translate(30, 250);
+  ASSERT_TRUE(run_frame(translated_cache));
+  EXPECT_EQ(render_count, 1);
+  EXPECT_EQ(translated_cache.picture_metrics().disk_hit_count, 1u);
+
+  // Entries without a content hash are not kept on disk.
+  RasterCache other_cache(1);
+  other_cache.SetDiskStore(open_disk_store());
+  context.content_hash = std::nullopt;
+  ASSERT_TRUE(run_frame(other_cache));
+  EXPECT_EQ(render_count, 2);
+}
+
+TEST(RasterCache, DiskStoreImagesAreLoadedInBackground) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto open_disk_store = [&temp_dir]() {
+    return std::make_shared<RasterCacheDiskStore>(
+        fml::OpenDirectory(temp_dir.path().c_str(), false,
+                           fml::FilePermission::kReadWrite),
+        1 << 20);
+  };
+
+  SkMatrix matrix = SkMatrix::I();
+  SkRect logical_rect = SkRect::MakeWH(80, 80);
+  RasterCacheKeyID id(1, RasterCacheKeyType::kDisplayList);
+  // The entry may not be rasterized in the background, but its image is
+  // still loaded there.
+  RasterCache::Context context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      .content_hash       = 1234u,
+      // clang-format on
+  };
+  int render_count = 0;
+  auto render = [&render_count](DlCanvas* canvas) {
+    render_count++;
+    canvas->DrawRect(DlRect::MakeWH(80, 80), DlPaint());
+  };
+  auto run_frame = [&](RasterCache& cache) {
+    cache.BeginFrame();
+    cache.MarkSeen(id, matrix, true);
+    cache.EvictUnusedCacheEntries();
+    bool cached = cache.UpdateCacheEntry(id, context, render);
+    cache.EndFrame();
+    return cached;
+  };
+
+  {
+    RasterCache cache(1);
+    cache.SetDiskStore(open_disk_store());
+    ASSERT_TRUE(run_frame(cache));
+    EXPECT_EQ(render_count, 1);
+  }
+
+  RasterCache cache(1);
+  auto worker = std::make_shared<ManualTaskRunner>();
+  cache.SetBackgroundRasterizer(worker);
+  cache.SetDiskStore(open_disk_store());
+  ASSERT_FALSE(run_frame(cache));
+  EXPECT_EQ(cache.picture_metrics().disk_hit_count, 0u);
+  ASSERT_EQ(worker->RunPendingTasks(), 1u);
+
+  // The next frame adopts the loaded image before its preroll.
+  ASSERT_TRUE(run_frame(cache));
+  EXPECT_EQ(render_count, 1);
+  EXPECT_EQ(cache.picture_metrics().disk_hit_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(worker->RunPendingTasks(), 0u);
+
+  // Without an image in the disk store, the entry is rasterized by the
+  // frame.
+  RasterCache other_cache(1);
+  other_cache.SetBackgroundRasterizer(worker);
+  other_cache.SetDiskStore(open_disk_store());
+  context.content_hash = 5678u;
+  ASSERT_TRUE(run_frame(other_cache));
+  EXPECT_EQ(render_count, 2);
+  ASSERT_EQ(worker->RunPendingTasks(), 0u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -20,6 +20,28 @@ struct RasterCacheUtil {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDisplayListCacheLimitPerFrame = 3;
 
+  // The default byte budget and eviction grace period of the raster cache
+  // used by the compositor. Keeping entries for a short while after they go
+  // offscreen avoids rasterizing them again when content is scrolled back
+  // and forth, and the budget bounds the memory held by those entries.
+  //
+  // The byte budget is |kDefaultByteBudgetScreenCount| full screen RGBA
+  // images of the view, which is also the size of the resource cache. Until
+  // the size of the view is known, it is |kDefaultByteBudget|.
+  static constexpr size_t kDefaultByteBudget = 256 * 1024 * 1024;
+  static constexpr size_t kDefaultByteBudgetScreenCount = 12;
+  static constexpr size_t kDefaultEvictionGraceFrames = 30;
+
+  static size_t GetDefaultByteBudget(int64_t physical_width,
+                                     int64_t physical_height) {
+    if (physical_width <= 0 || physical_height <= 0) {
+      return kDefaultByteBudget;
+    }
+    return static_cast<size_t>(physical_width) *
+           static_cast<size_t>(physical_height) * 4 *
+           kDefaultByteBudgetScreenCount;
+  }
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/display_list/dl_builder.h"
@@ -58,6 +59,15 @@ class SurfaceFrame {
     // rasterized (no partial redraw). To signal that there is no existing
     // damage use an empty DlIRect.
     std::optional<DlIRect> existing_damage = std::nullopt;
+
+    // The individual rectangles that make up existing_damage. When empty, the
+    // existing damage is the single existing_damage rectangle.
+    std::vector<DlIRect> existing_damage_rects;
+
+    // The maximum number of rectangles that the target can use to describe
+    // the damage of a frame. With 1, the damage is a single rectangle that
+    // bounds all of the changes.
+    size_t max_damage_rect_count = 1;
   };
 
   SurfaceFrame(sk_sp<SkSurface> surface,
@@ -66,7 +76,8 @@ class SurfaceFrame {
                const SubmitCallback& submit_callback,
                DlISize frame_size,
                std::unique_ptr<GLContextResult> context_result = nullptr,
-               bool display_list_fallback = false);
+               bool display_list_fallback = false,
+               bool display_list_rtree = false);
 
   struct SubmitInfo {
     // The frame damage for frame n is the difference between frame n and
@@ -82,6 +93,11 @@ class SurfaceFrame {
     // Corresponds to EGL_KHR_partial_update
     std::optional<DlIRect> buffer_damage;
 
+    // The rectangles that make up frame_damage and buffer_damage, when the
+    // framebuffer allows more than one damage rectangle.
+    std::vector<DlIRect> frame_damage_rects;
+    std::vector<DlIRect> buffer_damage_rects;
+
     // Time at which this frame is scheduled to be presented. This is a hint
     // that can be passed to the platform to drop queued frames.
     std::optional<fml::TimePoint> presentation_time;
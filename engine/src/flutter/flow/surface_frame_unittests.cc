@@ -62,4 +62,21 @@ TEST(FlowTest, SurfaceFrameDoesNotPrepareRtree) {
   EXPECT_FALSE(surface_frame->BuildDisplayList()->has_rtree());
 }
 
+TEST(FlowTest, SurfaceFrameCanPrepareRtree) {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto callback = [](const SurfaceFrame&, DlCanvas*) { return true; };
+  auto submit_callback = [](const SurfaceFrame&) { return true; };
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr,
+      /*framebuffer_info=*/framebuffer_info,
+      /*encode_callback=*/callback,
+      /*submit_callback=*/submit_callback,
+      /*frame_size=*/DlISize(800, 600),
+      /*context_result=*/nullptr,
+      /*display_list_fallback=*/true,
+      /*display_list_rtree=*/true);
+  surface_frame->Canvas()->DrawRect(DlRect::MakeWH(100, 100), DlPaint());
+  EXPECT_TRUE(surface_frame->BuildDisplayList()->has_rtree());
+}
+
 }  // namespace flutter
@@ -12,13 +12,15 @@ namespace testing {
 
 DiffContextTest::DiffContextTest() {}
 
-Damage DiffContextTest::DiffLayerTree(MockLayerTree& layer_tree,
-                                      const MockLayerTree& old_layer_tree,
-                                      const DlIRect& additional_damage,
-                                      int horizontal_clip_alignment,
-                                      int vertical_clip_alignment,
-                                      bool use_raster_cache,
-                                      bool impeller_enabled) {
+Damage DiffContextTest::DiffLayerTree(
+    MockLayerTree& layer_tree,
+    const MockLayerTree& old_layer_tree,
+    const DlIRect& additional_damage,
+    int horizontal_clip_alignment,
+    int vertical_clip_alignment,
+    bool use_raster_cache,
+    bool impeller_enabled,
+    const DamageRectPolicy& damage_rect_policy) {
   FML_CHECK(layer_tree.size() == old_layer_tree.size());
 
   DiffContext dc(layer_tree.size(), layer_tree.paint_region_map(),
@@ -27,7 +29,7 @@ Damage DiffContextTest::DiffLayerTree(MockLayerTree& layer_tree,
   dc.PushCullRect(DlRect::MakeSize(layer_tree.size()));
   layer_tree.root()->Diff(&dc, old_layer_tree.root());
   return dc.ComputeDamage(additional_damage, horizontal_clip_alignment,
-                          vertical_clip_alignment);
+                          vertical_clip_alignment, damage_rect_policy);
 }
 
 sk_sp<DisplayList> DiffContextTest::CreateDisplayList(const DlRect& bounds,
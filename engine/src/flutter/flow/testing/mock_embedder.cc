@@ -47,5 +47,12 @@ DlCanvas* MockViewEmbedder::CompositeEmbeddedView(int64_t view_id) {
   return canvas;
 }
 
+// |ExternalViewEmbedder|
+void MockViewEmbedder::PushFilterToVisitedPlatformViews(
+    const std::shared_ptr<DlImageFilter>& filter,
+    const DlRect& filter_rect) {
+  pushed_filter_count_++;
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -44,6 +44,7 @@ class MockLayer : public Layer {
   const MutatorsStack& parent_mutators() { return parent_mutators_; }
   const DlMatrix& parent_matrix() { return parent_matrix_; }
   const DlRect& parent_cull_rect() { return parent_cull_rect_; }
+  int preroll_count() const { return preroll_count_; }
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
   void Diff(DiffContext* context, const Layer* old_layer) override;
@@ -114,6 +115,7 @@ class MockLayer : public Layer {
   DlPath fake_paint_path_;
   DlPaint fake_paint_;
   std::optional<DlMatrix> expected_paint_matrix_;
+  int preroll_count_ = 0;
 
   static constexpr int kParentHasPlatformView = 1 << 0;
   static constexpr int kParentHasTextureLayer = 1 << 1;
@@ -9,6 +9,9 @@ namespace impeller {
 struct Flags {
   /// When turned on DrawLine will use the experimental antialiased path.
   bool antialiased_lines = false;
+  /// When turned on DrawPath will fill paths with solid colors using analytic
+  /// coverage instead of the stencil buffer.
+  bool analytic_path_fills = false;
 };
 }  // namespace impeller
 
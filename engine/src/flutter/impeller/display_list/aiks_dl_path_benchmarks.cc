@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_color.h"
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/display_list/geometry/dl_path_builder.h"
+#include "flutter/fml/logging.h"
+#include "impeller/display_list/aiks_context.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/geometry/constants.h"
+#include "impeller/playground/backend/vulkan/swiftshader_utilities.h"
+#include "impeller/playground/playground_impl.h"
+#include "impeller/playground/switches.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+
+#define GLFW_INCLUDE_NONE
+#include "third_party/glfw/include/GLFW/glfw3.h"
+
+// These benchmarks render whole frames of filled paths with Impeller on
+// SwiftShader, once with analytic path fills and once with the stencil then
+// cover fills, and wait for the GPU to finish each frame. Unlike
+// BM_AnalyticCoverage and BM_FillPath in geometry_benchmarks, they include
+// the uploads, the render passes and the rasterization on the GPU.
+
+namespace impeller {
+namespace {
+
+constexpr ISize kFrameSize(1024, 768);
+
+std::unique_ptr<PlaygroundImpl> MakeVulkanPlayground(bool analytic_fills) {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    FML_CHECK(::glfwInit() == GLFW_TRUE);
+    SetupSwiftshaderOnce(/*use_swiftshader=*/true);
+  });
+  PlaygroundSwitches switches;
+  switches.use_swiftshader = true;
+  switches.flags.analytic_path_fills = analytic_fills;
+  return PlaygroundImpl::Create(PlaygroundBackend::kVulkan, switches);
+}
+
+/// A non-convex shape made of every kind of curve that fits into a square of
+/// |size| at |origin|, so that the stencil fills cannot take the convex path.
+flutter::DlPath CreateShape(flutter::DlPoint origin, flutter::DlScalar size) {
+  flutter::DlScalar x = origin.x;
+  flutter::DlScalar y = origin.y;
+  flutter::DlScalar s = size / 20.0f;
+  flutter::DlPathBuilder builder;
+  builder  //
+      .MoveTo({x, y + 10 * s})
+      .CubicCurveTo({x, y + 2 * s}, {x + 8 * s, y}, {x + 12 * s, y})
+      .QuadraticCurveTo({x + 20 * s, y}, {x + 20 * s, y + 10 * s})
+      .LineTo({x + 10 * s, y + 10 * s})
+      .ConicCurveTo({x + 20 * s, y + 20 * s}, {x + 10 * s, y + 20 * s},
+                    kSqrt2Over2)
+      .CubicCurveTo({x + 4 * s, y + 20 * s}, {x - 2 * s, y + 16 * s},
+                    {x, y + 10 * s})
+      .Close();
+  return builder.TakePath();
+}
+
+/// A frame with a grid of |count| by |count| shapes of a size that fills the
+/// frame, each drawn as a fill of its own.
+sk_sp<flutter::DisplayList> CreateFillsDisplayList(int count) {
+  flutter::DisplayListBuilder builder;
+  flutter::DlScalar size =
+      std::min(kFrameSize.width, kFrameSize.height) / static_cast<float>(count);
+  for (int row = 0; row < count; row++) {
+    for (int column = 0; column < count; column++) {
+      flutter::DlPaint paint;
+      paint.setColor(flutter::DlColor::RGBA(row / static_cast<float>(count),
+                                            column / static_cast<float>(count),
+                                            0.5f, 1.0f));
+      builder.DrawPath(
+          CreateShape(flutter::DlPoint(column * size, row * size), size),
+          paint);
+    }
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+static void BM_RenderFills(benchmark::State& state,
+                           bool analytic_fills,
+                           int count) {
+  std::unique_ptr<PlaygroundImpl> playground =
+      MakeVulkanPlayground(analytic_fills);
+  if (!playground || !playground->GetContext()) {
+    state.SkipWithError("Could not create a Vulkan context.");
+    return;
+  }
+  std::shared_ptr<Context> context = playground->GetContext();
+  AiksContext aiks_context(context, TypographerContextSkia::Make());
+  sk_sp<flutter::DisplayList> display_list = CreateFillsDisplayList(count);
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<Texture> texture =
+        DisplayListToTexture(display_list, kFrameSize, aiks_context);
+    if (!texture) {
+      state.SkipWithError("Could not render the frame.");
+      break;
+    }
+    context->GetIdleWaiter()->WaitIdle();
+  }
+  state.counters["FillCount"] = count * count;
+
+  context->Shutdown();
+}
+
+BENCHMARK_CAPTURE(BM_RenderFills, stencil_Large, false, 4)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RenderFills, analytic_Large, true, 4)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RenderFills, stencil_Icons, false, 24)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RenderFills, analytic_Icons, true, 24)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace impeller
@@ -1093,5 +1093,79 @@ TEST_P(AiksTest, BlurredCircleWithStrokeWidth) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+namespace {
+
+// Fills paths with curves, both fill types, translucent colors and
+// transforms that are not aligned with the pixel grid, so that the stencil
+// fills and the analytic fills of the same paths can be compared.
+sk_sp<DisplayList> MakeFilledPathsDisplayList(Point content_scale) {
+  DisplayListBuilder builder;
+  builder.Scale(content_scale.x, content_scale.y);
+  builder.DrawPaint(DlPaint(DlColor(0xff111111)));
+
+  DlPathBuilder star_builder;
+  for (int i = 0; i < 5; i++) {
+    Scalar angle = kPi * (0.5f + i * 0.8f);
+    DlPoint point(100 + 80 * std::cos(angle), 100 - 80 * std::sin(angle));
+    if (i == 0) {
+      star_builder.MoveTo(point);
+    } else {
+      star_builder.LineTo(point);
+    }
+  }
+  star_builder.Close();
+
+  DlPaint paint;
+  paint.setColor(DlColor::kGreenYellow());
+  builder.DrawPath(star_builder.CopyPath(), paint);
+  builder.Save();
+  builder.Translate(200, 0);
+  star_builder.SetFillType(DlPathFillType::kOdd);
+  builder.DrawPath(star_builder.TakePath(), paint);
+  builder.Restore();
+
+  DlPathBuilder blob_builder;
+  blob_builder.MoveTo(DlPoint(40, 250));
+  blob_builder.CubicCurveTo(DlPoint(80, 180), DlPoint(200, 320),
+                            DlPoint(240, 240));
+  blob_builder.QuadraticCurveTo(DlPoint(300, 380), DlPoint(120, 360));
+  blob_builder.ConicCurveTo(DlPoint(20, 360), DlPoint(40, 250), 0.6f);
+  blob_builder.Close();
+  DlPath blob = blob_builder.TakePath();
+  paint.setColor(DlColor::kCornflowerBlue().withAlphaF(0.7f));
+  builder.DrawPath(blob, paint);
+
+  builder.Save();
+  builder.Translate(420.3f, 180.6f);
+  builder.Rotate(17.0f);
+  builder.Scale(0.6f, 1.3f);
+  paint.setColor(DlColor::kMaroon());
+  builder.DrawPath(blob, paint);
+  builder.Restore();
+
+  // Small paths, whose edges are all anti-aliased.
+  paint.setColor(DlColor::kWhite());
+  for (int i = 0; i < 8; i++) {
+    builder.Save();
+    builder.Translate(40.0f + i * 30.25f, 400.0f + i * 0.125f);
+    builder.Scale(0.05f + i * 0.02f, 0.05f + i * 0.02f);
+    builder.DrawPath(blob, paint);
+    builder.Restore();
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST_P(AiksTest, CanRenderFilledPaths) {
+  ASSERT_TRUE(
+      OpenPlaygroundHere(MakeFilledPathsDisplayList(GetContentScale())));
+}
+
+TEST_P(AiksTest, FilledPathsExperimentAnalyticPathFills) {
+  ASSERT_TRUE(
+      OpenPlaygroundHere(MakeFilledPathsDisplayList(GetContentScale())));
+}
+
 }  // namespace testing
 }  // namespace impeller
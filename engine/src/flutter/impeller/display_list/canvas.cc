@@ -24,6 +24,7 @@
 #include "impeller/display_list/dl_vertices_geometry.h"
 #include "impeller/display_list/image_filter.h"
 #include "impeller/display_list/skia_conversions.h"
+#include "impeller/entity/contents/analytic_path_contents.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/circle_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
@@ -422,6 +423,14 @@ void Canvas::DrawPath(const flutter::DlPath& path, const Paint& paint) {
   entity.SetBlendMode(paint.blend_mode);
 
   if (paint.style == Paint::Style::kFill) {
+    if (renderer_.GetContext()->GetFlags().analytic_path_fills &&
+        !paint.HasColorFilter() && !paint.invert_colors &&
+        !paint.image_filter && !paint.mask_blur_descriptor.has_value() &&
+        !paint.color_source) {
+      entity.SetContents(AnalyticPathContents::Make(path, paint.color));
+      AddRenderEntityToCurrentPass(entity);
+      return;
+    }
     FillPathGeometry geom(path);
     AddRenderEntityWithFiltersToCurrentPass(entity, &geom, paint);
   } else {
@@ -1145,6 +1145,32 @@ void FirstPassDispatcher::drawDisplayList(
   FML_DCHECK(stack_depth == stack_.size());
 }
 
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawPath(const DlPath& path) {
+  TessellationPrepass& prepass = renderer_.GetTessellationPrepass();
+  if (!prepass.IsEnabled() || matrix_.HasPerspective()) {
+    return;
+  }
+
+  // Skip the paths that |SimplifyOrDrawPath| draws as simpler shapes.
+  DlRect rect;
+  bool closed;
+  DlRoundRect rrect;
+  DlPoint start;
+  DlPoint end;
+  if ((path.IsRect(&rect, &closed) && closed) ||
+      (path.IsRoundRect(&rrect) && rrect.GetRadii().AreAllCornersSame()) ||
+      path.IsOval(&rect) || path.IsLine(&start, &end)) {
+    return;
+  }
+
+  if (paint_.style == Paint::Style::kFill) {
+    prepass.AddFill(path, matrix_);
+  } else {
+    prepass.AddStroke(path, paint_.stroke, matrix_);
+  }
+}
+
 // |flutter::DlOpReceiver|
 void FirstPassDispatcher::setDrawStyle(flutter::DlDrawStyle style) {
   paint_.style = ToStyle(style);
@@ -1284,14 +1310,18 @@ std::shared_ptr<Texture> DisplayListToTexture(
   context.GetContentContext().GetTextShadowCache().MarkFrameStart();
   fml::ScopedCleanupClosure cleanup([&] {
     if (reset_host_buffer) {
-      context.GetContentContext().GetTransientsDataBuffer().Reset();
-      context.GetContentContext().GetTransientsIndexesBuffer().Reset();
+      context.GetContentContext().ResetTransientsBuffers();
     }
     context.GetContentContext().GetTextShadowCache().MarkFrameEnd();
+    context.GetContentContext().GetTessellationCache().MarkFrameEnd();
+    context.GetContentContext().GetTessellationPrepass().MarkFrameEnd();
     context.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
     context.GetContext()->DisposeThreadLocalCachedResources();
   });
 
+  context.GetContentContext().GetTessellationPrepass().Tessellate(
+      *context.GetContext(),
+      context.GetContentContext().GetTessellationCache());
   display_list->Dispatch(impeller_dispatcher, cull_rect);
   impeller_dispatcher.FinishRecording();
 
@@ -1323,8 +1353,12 @@ bool RenderToTarget(ContentContext& context,
       context.ResetTransientsBuffers();
     }
     context.GetTextShadowCache().MarkFrameEnd();
+    context.GetTessellationCache().MarkFrameEnd();
+    context.GetTessellationPrepass().MarkFrameEnd();
   });
 
+  context.GetTessellationPrepass().Tessellate(*context.GetContext(),
+                                              context.GetTessellationCache());
   display_list->Dispatch(impeller_dispatcher, cull_rect);
   impeller_dispatcher.FinishRecording();
   context.GetLazyGlyphAtlas()->ResetTextFrames();
@@ -274,6 +274,9 @@ class CanvasDlDispatcher : public DlDispatcherBase {
   void SetBackdropData(std::unordered_map<int64_t, BackdropData> backdrop,
                        size_t backdrop_count);
 
+  // |flutter::DlOpReceiver|
+  bool IsRenderingReceiver() const override { return true; }
+
   // |flutter::DlOpReceiver|
   void save() override {
     // This dispatcher should never be used with the save() variant
@@ -359,6 +362,9 @@ class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
   void drawDisplayList(const sk_sp<flutter::DisplayList> display_list,
                        DlScalar opacity) override;
 
+  // |flutter::DlOpReceiver|
+  void drawPath(const DlPath& path) override;
+
   // |flutter::DlOpReceiver|
   void setDrawStyle(flutter::DlDrawStyle style) override;
 
@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/analytic_path_contents.h"
+
+#include <array>
+#include <optional>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/formats.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/coverage_mask_atlas.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/fill_path_geometry.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/tessellator/coverage_rasterizer.h"
+#include "impeller/tessellator/path_tessellator.h"
+
+namespace impeller {
+
+using VS = GlyphAtlasPipeline::VertexShader;
+using FS = GlyphAtlasPipeline::FragmentShader;
+
+std::unique_ptr<AnalyticPathContents> AnalyticPathContents::Make(
+    flutter::DlPath path,
+    Color color) {
+  return std::unique_ptr<AnalyticPathContents>(
+      new AnalyticPathContents(std::move(path), color));
+}
+
+AnalyticPathContents::AnalyticPathContents(flutter::DlPath path, Color color)
+    : path_(std::move(path)), color_(color) {}
+
+AnalyticPathContents::~AnalyticPathContents() = default;
+
+std::optional<Rect> AnalyticPathContents::GetCoverage(
+    const Entity& entity) const {
+  return FillPathGeometry(path_).GetCoverage(entity.GetTransform());
+}
+
+bool AnalyticPathContents::Render(const ContentContext& renderer,
+                                  const Entity& entity,
+                                  RenderPass& pass) const {
+  if (color_.IsTransparent()) {
+    return true;
+  }
+
+  // The coverage is written with the format and into the color channel that
+  // the glyph atlas pipeline reads.
+  PixelFormat mask_format =
+      renderer.GetContext()->GetCapabilities()->GetDefaultGlyphAtlasFormat();
+  const Matrix& transform = entity.GetTransform();
+  if (BytesPerPixelForPixelFormat(mask_format) != 1u ||
+      transform.HasPerspective()) {
+    return RenderWithStencil(renderer, entity, pass);
+  }
+
+  std::optional<Rect> coverage = GetCoverage(entity);
+  if (!coverage.has_value()) {
+    return true;
+  }
+  IRect mask_bounds =
+      IRect::RoundOut(coverage.value())
+          .IntersectionOrEmpty(IRect::MakeSize(pass.GetRenderTargetSize()));
+  if (mask_bounds.IsEmpty()) {
+    return true;
+  }
+  // Rows that are a multiple of 4 bytes long can be uploaded without any
+  // unpacking alignment.
+  ISize mask_size((mask_bounds.GetWidth() + 3) & ~int64_t{3},
+                  mask_bounds.GetHeight());
+  if (mask_size.Area() > kMaxMaskArea) {
+    return RenderWithStencil(renderer, entity, pass);
+  }
+
+  // The coverage is resolved straight into the transient data buffer, from
+  // which it is copied into a region of a page of the coverage mask atlas.
+  HostBuffer& data_host_buffer = renderer.GetTransientsDataBuffer();
+  std::optional<CoverageMaskAtlas::Mask> mask =
+      renderer.GetCoverageMaskAtlas().AddMask(
+          *renderer.GetContext(), data_host_buffer, mask_format, mask_size,
+          [&](uint8_t* data) {
+            TRACE_EVENT0("impeller",
+                         "AnalyticPathContents::RasterizeCoverage");
+            CoverageRasterizer rasterizer(mask_size,
+                                          Point(mask_bounds.GetOrigin()));
+            PathTessellator::PathToTransformedFilledVertices(
+                path_, rasterizer, transform);
+            rasterizer.Resolve(path_.GetFillType(), data, mask_size.width);
+          });
+  if (!mask.has_value()) {
+    return false;
+  }
+
+  pass.SetCommandLabel("AnalyticPath");
+  ContentContextOptions options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+  pass.SetPipeline(renderer.GetGlyphAtlasPipeline(options));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp =
+      Entity::GetShaderTransform(entity.GetShaderClipDepth(), pass, Matrix());
+  VS::BindFrameInfo(pass, data_host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.is_color_glyph = 0.0;
+  frag_info.use_text_color = 0.0;
+  frag_info.text_color = ToVector(color_.Premultiply());
+  FS::BindFragInfo(pass, data_host_buffer.EmplaceUniform(frag_info));
+
+  // The quad covers whole pixels, so every pixel samples its own coverage.
+  SamplerDescriptor sampler_desc;
+  sampler_desc.min_filter = MinMagFilter::kNearest;
+  sampler_desc.mag_filter = MinMagFilter::kNearest;
+  sampler_desc.mip_filter = MipFilter::kBase;
+  FS::BindGlyphAtlasSampler(
+      pass, mask->texture,
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc));
+
+  Rect quad = Rect::MakeOriginSize(Point(mask_bounds.GetOrigin()),
+                                   Size(mask_size));
+  Size page_size(mask->texture->GetSize());
+  Rect uv_bounds = Rect::MakeOriginSize(
+      Point(mask->bounds.GetOrigin()) / page_size, Size(mask_size) / page_size);
+  constexpr std::array<Point, 4> kUnitPoints = {
+      Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1)};
+  std::array<VS::PerVertexData, 4> vertices;
+  for (size_t i = 0; i < kUnitPoints.size(); i++) {
+    vertices[i].uv =
+        uv_bounds.GetOrigin() + kUnitPoints[i] * uv_bounds.GetSize();
+    vertices[i].position = quad.GetOrigin() + kUnitPoints[i] * quad.GetSize();
+  }
+  pass.SetVertexBuffer(CreateVertexBuffer(vertices, data_host_buffer));
+
+  return pass.Draw().ok();
+}
+
+bool AnalyticPathContents::RenderWithStencil(const ContentContext& renderer,
+                                             const Entity& entity,
+                                             RenderPass& pass) const {
+  FillPathGeometry geometry(path_);
+  SolidColorContents contents;
+  contents.SetGeometry(&geometry);
+  contents.SetColor(color_);
+  return contents.Render(renderer, entity, pass);
+}
+
+}  // namespace impeller
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_ANALYTIC_PATH_CONTENTS_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_ANALYTIC_PATH_CONTENTS_H_
+
+#include <memory>
+
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/impeller/entity/contents/contents.h"
+#include "impeller/geometry/color.h"
+
+namespace impeller {
+
+/// @brief Fills a path with a solid color and exact, analytic anti-aliasing.
+///
+/// The coverage of every pixel under the device space bounds of the path is
+/// computed on the CPU by a |CoverageRasterizer| and uploaded into a region
+/// of the single channel |CoverageMaskAtlas| of the frame, which is then
+/// drawn as a quad with the glyph atlas pipeline. This needs neither a stencil attachment nor MSAA. Paths whose
+/// bounds cover too many pixels are filled with a |FillPathGeometry| instead.
+///
+/// This is used for fills when |Flags::analytic_path_fills| is turned on.
+class AnalyticPathContents : public Contents {
+ public:
+  /// The largest number of pixels of a coverage mask.
+  static constexpr int64_t kMaxMaskArea = 1024 * 1024;
+
+  static std::unique_ptr<AnalyticPathContents> Make(flutter::DlPath path,
+                                                    Color color);
+
+  ~AnalyticPathContents() override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+ private:
+  AnalyticPathContents(flutter::DlPath path, Color color);
+
+  bool RenderWithStencil(const ContentContext& renderer,
+                         const Entity& entity,
+                         RenderPass& pass) const;
+
+  const flutter::DlPath path_;
+  const Color color_;
+
+  AnalyticPathContents(const AnalyticPathContents&) = delete;
+
+  AnalyticPathContents& operator=(const AnalyticPathContents&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_ANALYTIC_PATH_CONTENTS_H_
@@ -564,7 +564,11 @@ ContentContext::ContentContext(
           context_->GetResourceAllocator(),
           context_->GetIdleWaiter(),
           context_->GetCapabilities()->GetMinimumUniformAlignment())),
-      text_shadow_cache_(std::make_unique<TextShadowCache>()) {
+      text_shadow_cache_(std::make_unique<TextShadowCache>()),
+      coverage_mask_atlas_(std::make_unique<CoverageMaskAtlas>()),
+      tessellation_cache_(std::make_unique<TessellationCache>()),
+      tessellation_prepass_(std::make_unique<TessellationPrepass>(
+          context_->GetConcurrentWorkerTaskRunner())) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -1010,6 +1014,8 @@ void ContentContext::ResetTransientsBuffers() {
   if (data_host_buffer_ != indexes_host_buffer_) {
     indexes_host_buffer_->Reset();
   }
+  tessellation_prepass_->ResetHostBuffers();
+  coverage_mask_atlas_->Reset();
 }
 
 void ContentContext::InitializeCommonlyUsedShadersIfNeeded() const {
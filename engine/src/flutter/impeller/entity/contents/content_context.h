@@ -16,7 +16,10 @@
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/entity/contents/coverage_mask_atlas.h"
 #include "impeller/entity/contents/text_shadow_cache.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#include "impeller/entity/geometry/tessellation_prepass.h"
 #include "impeller/geometry/color.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/command_buffer.h"
@@ -298,11 +301,25 @@ class ContentContext {
   /// allocate their own device buffers.
   HostBuffer& GetTransientsDataBuffer() const { return *data_host_buffer_; }
 
-  /// @brief Resets the transients buffers held onto by the content context.
+  /// @brief Resets the transients buffers held onto by the content context,
+  ///        including the ones of the |TessellationPrepass|, and moves the
+  ///        |CoverageMaskAtlas| on to the next frame.
   void ResetTransientsBuffers();
 
   TextShadowCache& GetTextShadowCache() const { return *text_shadow_cache_; }
 
+  CoverageMaskAtlas& GetCoverageMaskAtlas() const {
+    return *coverage_mask_atlas_;
+  }
+
+  TessellationCache& GetTessellationCache() const {
+    return *tessellation_cache_;
+  }
+
+  TessellationPrepass& GetTessellationPrepass() const {
+    return *tessellation_prepass_;
+  }
+
  protected:
   // Visible for testing.
   void SetTransientsIndexesBuffer(std::shared_ptr<HostBuffer> host_buffer) {
@@ -362,6 +379,9 @@ class ContentContext {
   std::shared_ptr<HostBuffer> indexes_host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
   std::unique_ptr<TextShadowCache> text_shadow_cache_;
+  std::unique_ptr<CoverageMaskAtlas> coverage_mask_atlas_;
+  std::unique_ptr<TessellationCache> tessellation_cache_;
+  std::unique_ptr<TessellationPrepass> tessellation_prepass_;
 
   ContentContext(const ContentContext&) = delete;
 
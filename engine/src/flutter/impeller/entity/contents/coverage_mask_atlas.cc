@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/coverage_mask_atlas.h"
+
+#include <utility>
+
+#include "impeller/base/validation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/texture_descriptor.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller {
+
+CoverageMaskAtlas::CoverageMaskAtlas() = default;
+
+CoverageMaskAtlas::~CoverageMaskAtlas() = default;
+
+std::optional<CoverageMaskAtlas::Mask> CoverageMaskAtlas::AddMask(
+    Context& context,
+    HostBuffer& data_host_buffer,
+    PixelFormat format,
+    ISize size,
+    const HostBuffer::EmplaceProc& write) {
+  if (size.IsEmpty()) {
+    return std::nullopt;
+  }
+  std::optional<Mask> mask = Allocate(context, format, size);
+  if (!mask.has_value()) {
+    return std::nullopt;
+  }
+
+  BufferView buffer_view = data_host_buffer.Emplace(
+      size.Area() * BytesPerPixelForPixelFormat(format),
+      data_host_buffer.GetMinimumUniformAlignment(), write);
+
+  std::shared_ptr<CommandBuffer> cmd_buffer = context.CreateCommandBuffer();
+  std::shared_ptr<BlitPass> blit_pass = cmd_buffer->CreateBlitPass();
+  if (!blit_pass->AddCopy(std::move(buffer_view), mask->texture,
+                          mask->bounds) ||
+      !blit_pass->EncodeCommands() ||
+      !context.EnqueueCommandBuffer(std::move(cmd_buffer))) {
+    VALIDATION_LOG << "Failed to upload a coverage mask.";
+    return std::nullopt;
+  }
+  return mask;
+}
+
+std::optional<CoverageMaskAtlas::Mask> CoverageMaskAtlas::Allocate(
+    const Context& context,
+    PixelFormat format,
+    ISize size) {
+  Frame& frame = frames_[frame_index_];
+  IPoint16 location;
+  for (size_t i = 0; i < frame.used_page_count; i++) {
+    Page& page = frame.pages[i];
+    if (page.texture->GetTextureDescriptor().format == format &&
+        page.packer->AddRect(size.width, size.height, &location)) {
+      return Mask{page.texture, IRect::MakeXYWH(location.x(), location.y(),
+                                                size.width, size.height)};
+    }
+  }
+
+  // Masks that are larger than a page are given a page of exactly their
+  // size, which nothing else will fit into.
+  ISize page_size(kPageSize, kPageSize);
+  if (size.width > kPageSize || size.height > kPageSize) {
+    page_size = size;
+  }
+
+  // Pages that this frame used the last time around are reused if they are
+  // compatible, and replaced otherwise.
+  if (frame.used_page_count == frame.pages.size()) {
+    frame.pages.emplace_back();
+  }
+  Page& page = frame.pages[frame.used_page_count];
+  if (!page.texture ||
+      page.texture->GetTextureDescriptor().format != format ||
+      page.texture->GetSize() != page_size) {
+    TextureDescriptor descriptor;
+    descriptor.format = format;
+    descriptor.size = page_size;
+    descriptor.storage_mode = StorageMode::kDevicePrivate;
+    descriptor.usage = TextureUsage::kShaderRead;
+    std::shared_ptr<Texture> texture =
+        context.GetResourceAllocator()->CreateTexture(descriptor);
+    if (!texture) {
+      return std::nullopt;
+    }
+    texture->SetLabel("CoverageMaskAtlas");
+    page.texture = std::move(texture);
+    page.packer = RectanglePacker::Factory(page_size.width, page_size.height);
+  } else {
+    page.packer->Reset();
+  }
+  frame.used_page_count++;
+
+  if (!page.packer->AddRect(size.width, size.height, &location)) {
+    return std::nullopt;
+  }
+  return Mask{page.texture, IRect::MakeXYWH(location.x(), location.y(),
+                                            size.width, size.height)};
+}
+
+void CoverageMaskAtlas::Reset() {
+  frame_index_ = (frame_index_ + 1) % frames_.size();
+  Frame& frame = frames_[frame_index_];
+  frame.pages.resize(frame.used_page_count);
+  frame.used_page_count = 0u;
+}
+
+size_t CoverageMaskAtlas::GetPageCount() const {
+  return frames_[frame_index_].used_page_count;
+}
+
+}  // namespace impeller
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_COVERAGE_MASK_ATLAS_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_COVERAGE_MASK_ATLAS_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "impeller/core/formats.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/geometry/size.h"
+#include "impeller/renderer/context.h"
+#include "impeller/typographer/rectangle_packer.h"
+
+namespace impeller {
+
+/// @brief Sub-allocates the single channel coverage masks of a frame from a
+///        few large textures.
+///
+/// Each mask is written straight into the transient data host buffer and
+/// copied into a free region of one of the pages of the atlas, so drawing a
+/// mask allocates neither a texture nor a device buffer of its own.
+///
+/// Like the arenas of a |HostBuffer|, the pages are kept in a ring of
+/// |kHostBufferArenaSize| frames, so that a frame never writes into a page
+/// that a frame which may still be in flight samples from. |Reset| must be
+/// called whenever the transient host buffers of the |ContentContext| are
+/// reset.
+///
+/// This object must only be used on the raster thread.
+class CoverageMaskAtlas {
+ public:
+  /// The width and height of a page. Masks that do not fit into a page of
+  /// this size get a page of their own.
+  static constexpr int64_t kPageSize = 2048;
+
+  /// A region of a page that holds one mask.
+  struct Mask {
+    std::shared_ptr<Texture> texture;
+    IRect bounds;
+  };
+
+  CoverageMaskAtlas();
+
+  ~CoverageMaskAtlas();
+
+  /// @brief Reserves a region of |size| pixels of |format| in one of the
+  ///        pages of the frame and records the copy of the contents that
+  ///        |write| writes into |data_host_buffer| into that region.
+  ///
+  /// |write| is passed rows of |size.width| bytes per pixel that follow
+  /// each other without any padding.
+  ///
+  /// @return The mask, or std::nullopt if no page could be allocated or the
+  ///         copy could not be submitted.
+  std::optional<Mask> AddMask(Context& context,
+                              HostBuffer& data_host_buffer,
+                              PixelFormat format,
+                              ISize size,
+                              const HostBuffer::EmplaceProc& write);
+
+  /// @brief Moves on to the pages of the next frame of the ring, and
+  ///        releases the ones that the frame did not use the last time
+  ///        around.
+  void Reset();
+
+  /// @brief The number of pages that the current frame has used so far.
+  size_t GetPageCount() const;
+
+ private:
+  struct Page {
+    std::shared_ptr<Texture> texture;
+    std::shared_ptr<RectanglePacker> packer;
+  };
+
+  struct Frame {
+    std::vector<Page> pages;
+    size_t used_page_count = 0u;
+  };
+
+  CoverageMaskAtlas(const CoverageMaskAtlas&) = delete;
+
+  CoverageMaskAtlas& operator=(const CoverageMaskAtlas&) = delete;
+
+  std::optional<Mask> Allocate(const Context& context,
+                               PixelFormat format,
+                               ISize size);
+
+  std::array<Frame, kHostBufferArenaSize> frames_;
+  size_t frame_index_ = 0u;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_COVERAGE_MASK_ATLAS_H_
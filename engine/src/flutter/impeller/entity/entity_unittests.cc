@@ -21,6 +21,7 @@
 #include "impeller/entity/contents/conical_gradient_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/contents.h"
+#include "impeller/entity/contents/coverage_mask_atlas.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
@@ -2960,6 +2961,51 @@ TEST_P(EntityTest, RoundSuperellipseGetPositionBufferFlushes) {
   EXPECT_TRUE(device_buffer->flush_called());
 }
 
+TEST_P(EntityTest, CoverageMasksAreSubAllocatedFromAtlasPages) {
+  auto content_context = GetContentContext();
+  HostBuffer& data_host_buffer = content_context->GetTransientsDataBuffer();
+  PixelFormat format =
+      GetContext()->GetCapabilities()->GetDefaultGlyphAtlasFormat();
+  CoverageMaskAtlas atlas;
+  auto add_mask = [&](ISize size) {
+    return atlas.AddMask(
+        *GetContext(), data_host_buffer, format, size,
+        [size](uint8_t* data) { std::memset(data, 0xFF, size.Area()); });
+  };
+
+  std::optional<CoverageMaskAtlas::Mask> first = add_mask(ISize(64, 32));
+  std::optional<CoverageMaskAtlas::Mask> second = add_mask(ISize(32, 64));
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first->texture, second->texture);
+  EXPECT_FALSE(first->bounds.IntersectsWithRect(second->bounds));
+  EXPECT_EQ(atlas.GetPageCount(), 1u);
+
+  // Masks that do not fit into a page get a page of their own.
+  std::optional<CoverageMaskAtlas::Mask> wide =
+      add_mask(ISize(CoverageMaskAtlas::kPageSize + 64, 4));
+  ASSERT_TRUE(wide.has_value());
+  EXPECT_NE(wide->texture, first->texture);
+  EXPECT_EQ(wide->texture->GetSize(), wide->bounds.GetSize());
+  EXPECT_EQ(atlas.GetPageCount(), 2u);
+
+  // The frames that may still be in flight keep their pages.
+  atlas.Reset();
+  EXPECT_EQ(atlas.GetPageCount(), 0u);
+  std::optional<CoverageMaskAtlas::Mask> next = add_mask(ISize(64, 32));
+  ASSERT_TRUE(next.has_value());
+  EXPECT_NE(next->texture, first->texture);
+
+  // Once the ring comes around, the pages of the first frame are reused.
+  for (size_t i = 1; i < kHostBufferArenaSize; i++) {
+    atlas.Reset();
+  }
+  std::optional<CoverageMaskAtlas::Mask> again = add_mask(ISize(64, 32));
+  ASSERT_TRUE(again.has_value());
+  EXPECT_EQ(again->texture, first->texture);
+  EXPECT_EQ(again->bounds, first->bounds);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
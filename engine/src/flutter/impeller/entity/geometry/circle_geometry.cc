@@ -3,11 +3,14 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "flutter/impeller/entity/geometry/circle_geometry.h"
 
 #include "flutter/impeller/entity/geometry/line_geometry.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/pipelines.h"
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
@@ -58,12 +61,34 @@ GeometryResult CircleGeometry::GetPositionBuffer(const ContentContext& renderer,
                                         : LineGeometry::ComputePixelHalfWidth(
                                               transform, stroke_width_);
 
-  // We call the StrokedCircle method which will simplify to a
-  // FilledCircleGenerator if the inner_radius is <= 0.
-  auto generator = renderer.GetTessellator().StrokedCircle(transform, center_,
-                                                           radius_, half_width);
-
-  return ComputePositionGeometry(renderer, generator, entity, pass);
+  // The retained vertices are those of the StrokedCircle method, which will
+  // simplify to a FilledCircleGenerator if the inner_radius is <= 0, around
+  // the origin so that circles of the same size share them.
+  std::shared_ptr<const std::vector<Point>> circle_vertices =
+      renderer.GetTessellator().GetCircleVertices(transform, radius_,
+                                                  half_width);
+
+  using VT = SolidFillVertexShader::PerVertexData;
+  size_t count = circle_vertices->size();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer =
+          {
+              .vertex_buffer = renderer.GetTransientsDataBuffer().Emplace(
+                  count * sizeof(VT), alignof(VT),
+                  [&circle_vertices, center = center_](uint8_t* buffer) {
+                    auto vertices = reinterpret_cast<VT*>(buffer);
+                    for (const Point& vertex : *circle_vertices) {
+                      *vertices++ = {
+                          .position = center + vertex,
+                      };
+                    }
+                  }),
+              .vertex_count = count,
+              .index_type = IndexType::kNone,
+          },
+      .transform = entity.GetShaderTransform(pass),
+  };
 }
 
 std::optional<Rect> CircleGeometry::GetCoverage(const Matrix& transform) const {
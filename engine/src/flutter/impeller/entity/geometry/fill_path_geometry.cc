@@ -9,6 +9,7 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 
 namespace impeller {
 
@@ -43,11 +44,39 @@ GeometryResult FillPathSourceGeometry::GetPositionBuffer(
   bool supports_triangle_fan =
       renderer.GetDeviceCapabilities().SupportsTriangleFan() &&
       supports_primitive_restart;
-  VertexBuffer vertex_buffer = renderer.GetTessellator().TessellateConvex(
-      GetSource(), data_host_buffer, indexes_host_buffer,
-      entity.GetTransform().GetMaxBasisLengthXY(),
-      /*supports_primitive_restart=*/supports_primitive_restart,
-      /*supports_triangle_fan=*/supports_triangle_fan);
+  Scalar scale = entity.GetTransform().GetMaxBasisLengthXY();
+  const flutter::DlPath* cacheable_path = GetCacheablePath();
+  std::optional<TessellationCache::Key> cache_key;
+  std::optional<VertexBuffer> cached_vertex_buffer;
+  if (cacheable_path) {
+    scale = TessellationCache::QuantizeScale(scale);
+    cache_key = TessellationCache::MakeFillKey(*cacheable_path, scale);
+    cached_vertex_buffer = renderer.GetTessellationCache().Lookup(*cache_key);
+  }
+
+  VertexBuffer vertex_buffer;
+  if (cached_vertex_buffer.has_value()) {
+    vertex_buffer = std::move(cached_vertex_buffer.value());
+  } else {
+    std::optional<VertexBuffer> prepared_vertex_buffer;
+    if (cache_key.has_value()) {
+      prepared_vertex_buffer =
+          renderer.GetTessellationPrepass().Find(*cache_key);
+    }
+    if (prepared_vertex_buffer.has_value()) {
+      vertex_buffer = std::move(prepared_vertex_buffer.value());
+    } else {
+      vertex_buffer = renderer.GetTessellator().TessellateConvex(
+          GetSource(), data_host_buffer, indexes_host_buffer, scale,
+          /*supports_primitive_restart=*/supports_primitive_restart,
+          /*supports_triangle_fan=*/supports_triangle_fan);
+    }
+    if (cache_key.has_value()) {
+      renderer.GetTessellationCache().Store(
+          *cache_key, vertex_buffer,
+          *renderer.GetContext()->GetResourceAllocator());
+    }
+  }
 
   return GeometryResult{
       .type = supports_triangle_fan ? PrimitiveType::kTriangleFan
@@ -92,6 +121,10 @@ bool FillPathSourceGeometry::CoversArea(const Matrix& transform,
   return coverage.Contains(rect);
 }
 
+const flutter::DlPath* FillPathSourceGeometry::GetCacheablePath() const {
+  return nullptr;
+}
+
 FillPathFromSourceGeometry::FillPathFromSourceGeometry(const PathSource& source)
     : FillPathSourceGeometry(std::nullopt), source_(source) {}
 
@@ -107,6 +140,10 @@ const PathSource& FillPathGeometry::GetSource() const {
   return path_;
 }
 
+const flutter::DlPath* FillPathGeometry::GetCacheablePath() const {
+  return &path_;
+}
+
 FillDiffRoundRectGeometry::FillDiffRoundRectGeometry(const RoundRect& outer,
                                                      const RoundRect& inner)
     : FillPathSourceGeometry(std::nullopt), source_(outer, inner) {}
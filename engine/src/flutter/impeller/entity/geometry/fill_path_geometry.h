@@ -30,6 +30,10 @@ class FillPathSourceGeometry : public Geometry {
   /// vertices.
   virtual const PathSource& GetSource() const = 0;
 
+  /// The |DlPath| that is the source of the vertices, if any, so that the
+  /// vertices can be retained in the |TessellationCache|.
+  virtual const flutter::DlPath* GetCacheablePath() const;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -73,6 +77,8 @@ class FillPathGeometry final : public FillPathSourceGeometry {
  protected:
   const PathSource& GetSource() const override;
 
+  const flutter::DlPath* GetCacheablePath() const override;
+
  private:
   const flutter::DlPath path_;
 };
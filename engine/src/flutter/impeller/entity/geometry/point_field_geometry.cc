@@ -4,6 +4,9 @@
 
 #include "impeller/entity/geometry/point_field_geometry.h"
 
+#include <memory>
+#include <vector>
+
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/vertex_buffer.h"
@@ -44,17 +47,11 @@ GeometryResult PointFieldGeometry::GetPositionBuffer(
 
   if (round_) {
     // Get triangulation relative to {0, 0} so we can translate it to each
-    // point in turn.
-    Tessellator::EllipticalVertexGenerator generator =
-        renderer.GetTessellator().FilledCircle(transform, {}, radius);
-    FML_DCHECK(generator.GetTriangleType() == PrimitiveType::kTriangleStrip);
-
-    std::vector<Point> circle_vertices;
-    circle_vertices.reserve(generator.GetVertexCount());
-    generator.GenerateVertices([&circle_vertices](const Point& p) {  //
-      circle_vertices.push_back(p);
-    });
-    FML_DCHECK(circle_vertices.size() == generator.GetVertexCount());
+    // point in turn. The vertices are retained across frames for dots of
+    // the same size.
+    std::shared_ptr<const std::vector<Point>> retained_vertices =
+        renderer.GetTessellator().GetCircleVertices(transform, radius, 0.0f);
+    const std::vector<Point>& circle_vertices = *retained_vertices;
 
     vertex_count = (circle_vertices.size() + 2) * point_count_ - 2;
     buffer_view = data_host_buffer.Emplace(
@@ -10,6 +10,7 @@
 #include "impeller/core/host_buffer.h"
 #include "impeller/entity/contents/pipelines.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/separated_vector.h"
 #include "impeller/geometry/wangs_formula.h"
@@ -226,13 +227,26 @@ class StrokePathSegmentReceiver : public PathAndArcSegmentReceiver {
       Point prev = curve.p1;
       SeparatedVector2 prev_perpendicular = start_perpendicular;
 
-      // Handle all intermediate curve points up to but not including the end.
-      for (int i = 1; i < count; i++) {
-        Point cur = curve.Solve(i / count);
-        SeparatedVector2 cur_perpendicular = PerpendicularFromPoints(prev, cur);
-        RecordCurveSegment(prev_perpendicular, cur, cur_perpendicular);
-        prev = cur;
-        prev_perpendicular = cur_perpendicular;
+      // Handle all intermediate curve points up to but not including the end,
+      // solving them and their perpendiculars a batch at a time. Only the
+      // segments themselves have to be recorded one after the other, since
+      // each of them depends on the direction of the previous one.
+      Point points[PathTessellator::kCurveBatchSize];
+      SeparatedVector2 perpendiculars[PathTessellator::kCurveBatchSize];
+      for (size_t i = 1; i < count;) {
+        size_t batch_count = std::min(PathTessellator::kCurveBatchSize,
+                                      static_cast<size_t>(count - i));
+        PathTessellator::SolveBatch(curve, i, batch_count, count, points);
+        perpendiculars[0] = PerpendicularFromPoints(prev, points[0]);
+        for (size_t j = 1; j < batch_count; j++) {
+          perpendiculars[j] = PerpendicularFromPoints(points[j - 1], points[j]);
+        }
+        for (size_t j = 0; j < batch_count; j++) {
+          RecordCurveSegment(prev_perpendicular, points[j], perpendiculars[j]);
+          prev_perpendicular = perpendiculars[j];
+        }
+        prev = points[batch_count - 1];
+        i += batch_count;
       }
 
       RecordCurveSegment(prev_perpendicular, curve.p2, end_perpendicular);
@@ -737,6 +751,59 @@ Scalar StrokeSegmentsGeometry::ComputeAlphaCoverage(
   return Geometry::ComputeStrokeAlphaCoverage(transform, stroke_.width);
 }
 
+StrokeParameters StrokeSegmentsGeometry::AdjustStrokeForScale(
+    const StrokeParameters& stroke,
+    Scalar max_basis) {
+  Scalar min_size = kMinStrokeSize / max_basis;
+  StrokeParameters adjusted_stroke = stroke;
+  adjusted_stroke.width = std::max(stroke.width, min_size);
+  return adjusted_stroke;
+}
+
+VertexBuffer StrokeSegmentsGeometry::TessellateStroke(
+    Tessellator& tessellator,
+    HostBuffer& data_host_buffer,
+    const StrokeParameters& adjusted_stroke,
+    Scalar scale) const {
+  PositionWriter position_writer(tessellator.GetStrokePointCache());
+  StrokePathSegmentReceiver receiver(tessellator, position_writer,
+                                     adjusted_stroke, scale);
+  Dispatch(receiver, tessellator, scale);
+
+  const auto [arena_length, oversized_length] = position_writer.GetUsedSize();
+  BufferView buffer_view;
+  if (!position_writer.HasOversizedBuffer()) {
+    buffer_view =
+        data_host_buffer.Emplace(tessellator.GetStrokePointCache().data(),
+                                 arena_length * sizeof(Point), alignof(Point));
+  } else {
+    const std::vector<Point>& oversized_data =
+        position_writer.GetOversizedBuffer();
+    buffer_view = data_host_buffer.Emplace(
+        /*buffer=*/nullptr,                                 //
+        (arena_length + oversized_length) * sizeof(Point),  //
+        alignof(Point)                                      //
+    );
+    memcpy(buffer_view.GetBuffer()->OnGetContents() +
+               buffer_view.GetRange().offset,         //
+           tessellator.GetStrokePointCache().data(),  //
+           arena_length * sizeof(Point)               //
+    );
+    memcpy(buffer_view.GetBuffer()->OnGetContents() +
+               buffer_view.GetRange().offset + arena_length * sizeof(Point),  //
+           oversized_data.data(),                                             //
+           oversized_data.size() * sizeof(Point)                              //
+    );
+    buffer_view.GetBuffer()->Flush(buffer_view.GetRange());
+  }
+
+  return VertexBuffer{
+      .vertex_buffer = std::move(buffer_view),
+      .vertex_count = arena_length + oversized_length,
+      .index_type = IndexType::kNone,
+  };
+}
+
 GeometryResult StrokeSegmentsGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
@@ -749,65 +816,50 @@ GeometryResult StrokeSegmentsGeometry::GetPositionBuffer(
     return {};
   }
 
-  Scalar min_size = kMinStrokeSize / max_basis;
-  StrokeParameters adjusted_stroke = stroke_;
-  adjusted_stroke.width = std::max(stroke_.width, min_size);
-
-  auto& data_host_buffer = renderer.GetTransientsDataBuffer();
-  auto scale = entity.GetTransform().GetMaxBasisLengthXY();
-  auto& tessellator = renderer.GetTessellator();
-
-  PositionWriter position_writer(tessellator.GetStrokePointCache());
-  StrokePathSegmentReceiver receiver(tessellator, position_writer,
-                                     adjusted_stroke, scale);
-  Dispatch(receiver, tessellator, scale);
-
-  const auto [arena_length, oversized_length] = position_writer.GetUsedSize();
-  if (!position_writer.HasOversizedBuffer()) {
-    BufferView buffer_view =
-        data_host_buffer.Emplace(tessellator.GetStrokePointCache().data(),
-                                 arena_length * sizeof(Point), alignof(Point));
+  StrokeParameters adjusted_stroke = AdjustStrokeForScale(stroke_, max_basis);
+  Scalar scale = max_basis;
+
+  const flutter::DlPath* cacheable_path = GetCacheablePath();
+  std::optional<TessellationCache::Key> cache_key;
+  std::optional<VertexBuffer> vertex_buffer;
+  if (cacheable_path) {
+    scale = TessellationCache::QuantizeScale(scale);
+    cache_key = TessellationCache::MakeStrokeKey(*cacheable_path,
+                                                 adjusted_stroke, scale);
+    std::optional<VertexBuffer> cached_vertex_buffer =
+        renderer.GetTessellationCache().Lookup(*cache_key);
+    if (cached_vertex_buffer.has_value()) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangleStrip,
+          .vertex_buffer = std::move(cached_vertex_buffer.value()),
+          .transform = entity.GetShaderTransform(pass),
+          .mode = GeometryResult::Mode::kPreventOverdraw};
+    }
+    vertex_buffer = renderer.GetTessellationPrepass().Find(*cache_key);
+  }
 
-    return GeometryResult{.type = PrimitiveType::kTriangleStrip,
-                          .vertex_buffer =
-                              {
-                                  .vertex_buffer = buffer_view,
-                                  .vertex_count = arena_length,
-                                  .index_type = IndexType::kNone,
-                              },
-                          .transform = entity.GetShaderTransform(pass),
-                          .mode = GeometryResult::Mode::kPreventOverdraw};
-  }
-  const std::vector<Point>& oversized_data =
-      position_writer.GetOversizedBuffer();
-  BufferView buffer_view = data_host_buffer.Emplace(
-      /*buffer=*/nullptr,                                 //
-      (arena_length + oversized_length) * sizeof(Point),  //
-      alignof(Point)                                      //
-  );
-  memcpy(buffer_view.GetBuffer()->OnGetContents() +
-             buffer_view.GetRange().offset,         //
-         tessellator.GetStrokePointCache().data(),  //
-         arena_length * sizeof(Point)               //
-  );
-  memcpy(buffer_view.GetBuffer()->OnGetContents() +
-             buffer_view.GetRange().offset + arena_length * sizeof(Point),  //
-         oversized_data.data(),                                             //
-         oversized_data.size() * sizeof(Point)                              //
-  );
-  buffer_view.GetBuffer()->Flush(buffer_view.GetRange());
+  if (!vertex_buffer.has_value()) {
+    vertex_buffer =
+        TessellateStroke(renderer.GetTessellator(),
+                         renderer.GetTransientsDataBuffer(), adjusted_stroke,
+                         scale);
+  }
+  if (cache_key.has_value()) {
+    renderer.GetTessellationCache().Store(
+        *cache_key, vertex_buffer.value(),
+        *renderer.GetContext()->GetResourceAllocator());
+  }
 
   return GeometryResult{.type = PrimitiveType::kTriangleStrip,
-                        .vertex_buffer =
-                            {
-                                .vertex_buffer = buffer_view,
-                                .vertex_count = arena_length + oversized_length,
-                                .index_type = IndexType::kNone,
-                            },
+                        .vertex_buffer = std::move(vertex_buffer.value()),
                         .transform = entity.GetShaderTransform(pass),
                         .mode = GeometryResult::Mode::kPreventOverdraw};
 }
 
+const flutter::DlPath* StrokeSegmentsGeometry::GetCacheablePath() const {
+  return nullptr;
+}
+
 GeometryResult::Mode StrokeSegmentsGeometry::GetResultMode() const {
   return GeometryResult::Mode::kPreventOverdraw;
 }
@@ -859,6 +911,10 @@ const PathSource& StrokePathGeometry::GetSource() const {
   return path_;
 }
 
+const flutter::DlPath* StrokePathGeometry::GetCacheablePath() const {
+  return &path_;
+}
+
 ArcStrokeGeometry::ArcStrokeGeometry(const Arc& arc,
                                      const StrokeParameters& parameters)
     : StrokeSegmentsGeometry(parameters), arc_(arc) {}
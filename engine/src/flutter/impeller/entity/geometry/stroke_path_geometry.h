@@ -46,6 +46,25 @@ class StrokeSegmentsGeometry : public Geometry {
 
   Scalar ComputeAlphaCoverage(const Matrix& transform) const override;
 
+  /// @brief Returns the stroke parameters that are used to stroke the
+  ///        segments under a transform with the given maximum basis length,
+  ///        which widen the stroke to at least |kMinStrokeSize| pixels.
+  static StrokeParameters AdjustStrokeForScale(const StrokeParameters& stroke,
+                                               Scalar max_basis);
+
+  /// @brief Strokes the segments into a triangle strip in |data_host_buffer|.
+  ///
+  /// This only uses the tessellator and the host buffer that it is given, so
+  /// it can run on any thread that owns both of them.
+  ///
+  /// @param adjusted_stroke The stroke parameters returned by
+  ///                        |AdjustStrokeForScale|.
+  /// @param scale           The scale at which to flatten the curves.
+  VertexBuffer TessellateStroke(Tessellator& tessellator,
+                                HostBuffer& data_host_buffer,
+                                const StrokeParameters& adjusted_stroke,
+                                Scalar scale) const;
+
  protected:
   explicit StrokeSegmentsGeometry(const StrokeParameters& parameters);
 
@@ -55,6 +74,10 @@ class StrokeSegmentsGeometry : public Geometry {
                         Tessellator& tessellator,
                         Scalar scale) const = 0;
 
+  /// The |DlPath| that is the source of the segments, if any, so that the
+  /// vertices can be retained in the |TessellationCache|.
+  virtual const flutter::DlPath* GetCacheablePath() const;
+
   /// Provide the stroke-padded bounds for the provided bounds of the
   /// segments themselves.
   std::optional<Rect> GetStrokeCoverage(const Matrix& transform,
@@ -121,6 +144,9 @@ class StrokePathGeometry final : public StrokePathSourceGeometry {
   // |StrokePathSourceGeometry|
   const PathSource& GetSource() const override;
 
+  // |StrokeSegmentsGeometry|
+  const flutter::DlPath* GetCacheablePath() const override;
+
  private:
   const flutter::DlPath path_;
 };
@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+// Bounds the memory used to track the paths that are not retained yet.
+constexpr size_t kMaxCandidates = 1024u;
+
+// Copies the contents of a transient buffer view into a new device buffer
+// that is owned by the returned view.
+BufferView RetainBufferView(const BufferView& view, Allocator& allocator) {
+  if (!view) {
+    return {};
+  }
+  const uint8_t* contents =
+      view.GetBuffer()->OnGetContents() + view.GetRange().offset;
+  std::shared_ptr<DeviceBuffer> buffer =
+      allocator.CreateBufferWithCopy(contents, view.GetRange().length);
+  if (!buffer) {
+    return {};
+  }
+  return BufferView(std::move(buffer), Range{0, view.GetRange().length});
+}
+
+}  // namespace
+
+TessellationCache::TessellationCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+Scalar TessellationCache::QuantizeScale(Scalar scale) {
+  if (!(scale > 0.0f) || !std::isfinite(scale)) {
+    return scale;
+  }
+  return std::exp2(std::ceil(std::log2(scale) * kScaleStepsPerOctave) /
+                   kScaleStepsPerOctave);
+}
+
+TessellationCache::Key TessellationCache::MakeFillKey(
+    const flutter::DlPath& path,
+    Scalar quantized_scale) {
+  return Key{
+      .path_hash = path.GetContentHash(),
+      .fill_type = path.GetFillType(),
+      .stroke = std::nullopt,
+      .quantized_scale = quantized_scale,
+  };
+}
+
+TessellationCache::Key TessellationCache::MakeStrokeKey(
+    const flutter::DlPath& path,
+    const StrokeParameters& stroke,
+    Scalar quantized_scale) {
+  return Key{
+      .path_hash = path.GetContentHash(),
+      .fill_type = path.GetFillType(),
+      .stroke = stroke,
+      .quantized_scale = quantized_scale,
+  };
+}
+
+std::optional<VertexBuffer> TessellationCache::Lookup(const Key& key) {
+  auto it = entries_by_key_.find(key);
+  if (it == entries_by_key_.end()) {
+    miss_count_++;
+    frame_miss_count_++;
+    return std::nullopt;
+  }
+  hit_count_++;
+  frame_hit_count_++;
+  entries_.splice(entries_.end(), entries_, it->second);
+  return it->second->vertices;
+}
+
+bool TessellationCache::Contains(const Key& key) const {
+  return entries_by_key_.contains(key);
+}
+
+void TessellationCache::Store(const Key& key,
+                              const VertexBuffer& vertices,
+                              Allocator& allocator) {
+  if (!vertices || vertices.vertex_count == 0u ||
+      entries_by_key_.contains(key)) {
+    return;
+  }
+  if (!previous_candidates_.contains(key) && !candidates_.contains(key)) {
+    if (candidates_.size() < kMaxCandidates) {
+      candidates_.insert(key);
+    }
+    return;
+  }
+
+  size_t bytes = vertices.vertex_buffer.GetRange().length +
+                 vertices.index_buffer.GetRange().length;
+  if (bytes > max_bytes_) {
+    return;
+  }
+  VertexBuffer retained = vertices;
+  retained.vertex_buffer = RetainBufferView(vertices.vertex_buffer, allocator);
+  retained.index_buffer = RetainBufferView(vertices.index_buffer, allocator);
+  if (!retained) {
+    return;
+  }
+
+  candidates_.erase(key);
+  previous_candidates_.erase(key);
+  while (!entries_.empty() && byte_size_ + bytes > max_bytes_) {
+    byte_size_ -= entries_.front().bytes;
+    entries_by_key_.erase(entries_.front().key);
+    entries_.pop_front();
+  }
+  entries_.push_back(Entry{
+      .key = key,
+      .vertices = std::move(retained),
+      .bytes = bytes,
+  });
+  entries_by_key_[key] = std::prev(entries_.end());
+  byte_size_ += bytes;
+}
+
+void TessellationCache::MarkFrameEnd() {
+  FML_TRACE_COUNTER("impeller", "TessellationCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Hits", static_cast<int64_t>(frame_hit_count_),
+                    "Misses", static_cast<int64_t>(frame_miss_count_),
+                    "Bytes", static_cast<int64_t>(byte_size_));
+  frame_hit_count_ = 0u;
+  frame_miss_count_ = 0u;
+  previous_candidates_ = std::move(candidates_);
+  candidates_.clear();
+}
+
+TessellationCache::Stats TessellationCache::GetStats() const {
+  return Stats{
+      .hit_count = hit_count_,
+      .miss_count = miss_count_,
+      .entry_count = entries_.size(),
+      .byte_size = byte_size_,
+  };
+}
+
+}  // namespace impeller
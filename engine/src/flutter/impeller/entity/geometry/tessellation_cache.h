@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <optional>
+
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/fml/hash_combine.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path_source.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/stroke_parameters.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_set.h"
+
+namespace impeller {
+
+/// @brief A cache for the vertices of tessellated paths that re-uses them
+///        across frames.
+///
+/// Paths are identified by a hash of their verbs, points and fill type, so
+/// that a path which is rebuilt with the same contents every frame still
+/// finds its vertices, along with their stroke parameters and the scale of
+/// their transform. The scale is rounded up to one of |kScaleStepsPerOctave|
+/// steps per power of 2 so that a path that is scaled slightly can still
+/// re-use its vertices, at the cost of a somewhat finer tessellation.
+///
+/// The vertices of a path are only retained once the path has been
+/// tessellated twice in the same or in consecutive frames, so that animated
+/// paths, which change every frame, do not churn the cache. The retained
+/// vertices live in their own host visible device buffers and the least
+/// recently used ones are evicted once the cache exceeds its byte budget.
+///
+/// This object is not thread safe.
+class TessellationCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 4u * 1024u * 1024u;
+
+  static constexpr int kScaleStepsPerOctave = 8;
+
+  /// @brief A key to look up the cached vertices of a path.
+  struct Key {
+    uint64_t path_hash = 0u;
+    FillType fill_type = FillType::kNonZero;
+    // The stroke parameters, or std::nullopt for a fill.
+    std::optional<StrokeParameters> stroke;
+    Scalar quantized_scale = 1.0f;
+
+    bool operator==(const Key& other) const = default;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        StrokeParameters stroke = key.stroke.value_or(StrokeParameters{
+            .width = -1.0f,
+        });
+        return fml::HashCombine(key.path_hash, key.fill_type, stroke.width,
+                                stroke.cap, stroke.join, stroke.miter_limit,
+                                key.quantized_scale);
+      }
+    };
+  };
+
+  /// @brief The cumulative statistics of the cache since its creation.
+  struct Stats {
+    size_t hit_count = 0u;
+    size_t miss_count = 0u;
+    size_t entry_count = 0u;
+    size_t byte_size = 0u;
+  };
+
+  explicit TessellationCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  /// @brief Returns the scale at which a path is tessellated when its
+  ///        vertices may be cached, given the scale of its transform.
+  static Scalar QuantizeScale(Scalar scale);
+
+  static Key MakeFillKey(const flutter::DlPath& path, Scalar quantized_scale);
+
+  static Key MakeStrokeKey(const flutter::DlPath& path,
+                           const StrokeParameters& stroke,
+                           Scalar quantized_scale);
+
+  /// @brief Returns the retained vertices for the key, or std::nullopt if
+  ///        the caller needs to tessellate the path.
+  std::optional<VertexBuffer> Lookup(const Key& key);
+
+  /// @brief Whether vertices are retained for the key, without counting a
+  ///        hit or a miss or refreshing their use.
+  bool Contains(const Key& key) const;
+
+  /// @brief Retains a copy of the vertices that the caller tessellated for
+  ///        the key after a failed |Lookup|, if the path was tessellated
+  ///        recently enough to be worth caching.
+  void Store(const Key& key,
+             const VertexBuffer& vertices,
+             Allocator& allocator);
+
+  /// @brief Reports the hits and misses of the frame to the timeline and
+  ///        forgets the paths that were only tessellated in the previous
+  ///        frame.
+  void MarkFrameEnd();
+
+  Stats GetStats() const;
+
+ private:
+  TessellationCache(const TessellationCache&) = delete;
+
+  TessellationCache& operator=(const TessellationCache&) = delete;
+
+  using KeySet = absl::flat_hash_set<Key, Key::Hash>;
+
+  struct Entry {
+    Key key;
+    VertexBuffer vertices;
+    size_t bytes = 0u;
+  };
+
+  const size_t max_bytes_;
+  // Ordered from the least to the most recently used.
+  std::list<Entry> entries_;
+  absl::flat_hash_map<Key, std::list<Entry>::iterator, Key::Hash>
+      entries_by_key_;
+  size_t byte_size_ = 0u;
+  // The keys of the paths that were tessellated without being retained, in
+  // this frame and in the previous one.
+  KeySet candidates_;
+  KeySet previous_candidates_;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+  size_t frame_hit_count_ = 0u;
+  size_t frame_miss_count_ = 0u;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+
+#include "flutter/display_list/geometry/dl_path_builder.h"
+#include "flutter/testing/testing.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+namespace testing {
+
+using TessellationCacheTest = EntityPlayground;
+INSTANTIATE_PLAYGROUND_SUITE(TessellationCacheTest);
+
+namespace {
+
+flutter::DlPath MakeTestPath() {
+  flutter::DlPathBuilder builder;
+  builder.MoveTo({10, 10});
+  builder.QuadraticCurveTo({50, 0}, {90, 10});
+  builder.LineTo({50, 90});
+  builder.Close();
+  return builder.TakePath();
+}
+
+}  // namespace
+
+TEST(TessellationCache, QuantizedScaleIsNeverSmaller) {
+  for (Scalar scale : {0.3f, 1.0f, 1.05f, 2.0f, 3.7f, 100.0f}) {
+    Scalar quantized = TessellationCache::QuantizeScale(scale);
+    EXPECT_GE(quantized, scale);
+    EXPECT_LT(quantized, scale * 1.1f);
+  }
+  EXPECT_EQ(TessellationCache::QuantizeScale(1.0f), 1.0f);
+  EXPECT_EQ(TessellationCache::QuantizeScale(1.01f),
+            TessellationCache::QuantizeScale(1.02f));
+  EXPECT_EQ(TessellationCache::QuantizeScale(0.0f), 0.0f);
+}
+
+TEST(TessellationCache, KeysIdentifyPathsAndParameters) {
+  flutter::DlPath path = MakeTestPath();
+  flutter::DlPath copy = path;
+  flutter::DlPath rebuilt = MakeTestPath();
+  flutter::DlPath other = path.WithOffset({1, 0});
+
+  TessellationCache::Key key = TessellationCache::MakeFillKey(path, 1.0f);
+  EXPECT_EQ(key, TessellationCache::MakeFillKey(copy, 1.0f));
+  EXPECT_EQ(key, TessellationCache::MakeFillKey(rebuilt, 1.0f));
+  EXPECT_NE(key, TessellationCache::MakeFillKey(other, 1.0f));
+  EXPECT_NE(key, TessellationCache::MakeFillKey(path, 2.0f));
+  EXPECT_NE(key, TessellationCache::MakeFillKey(
+                     path.WithFillType(FillType::kOdd), 1.0f));
+  EXPECT_NE(key, TessellationCache::MakeStrokeKey(path, {.width = 1.0f},
+                                                  1.0f));
+  EXPECT_NE(TessellationCache::MakeStrokeKey(path, {.width = 1.0f}, 1.0f),
+            TessellationCache::MakeStrokeKey(path, {.width = 2.0f}, 1.0f));
+}
+
+TEST_P(TessellationCacheTest, RetainsPathsTessellatedInConsecutiveFrames) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  auto host_buffer =
+      HostBuffer::Create(allocator, GetContext()->GetIdleWaiter(), 256);
+  Tessellator tessellator;
+  flutter::DlPath path = MakeTestPath();
+  TessellationCache cache;
+  TessellationCache::Key key = TessellationCache::MakeFillKey(path, 1.0f);
+
+  // The first frame only remembers the path.
+  EXPECT_FALSE(cache.Lookup(key).has_value());
+  VertexBuffer vertices = tessellator.TessellateConvex(
+      path, *host_buffer, *host_buffer, 1.0f);
+  cache.Store(key, vertices, *allocator);
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+  cache.MarkFrameEnd();
+
+  // The second frame retains the vertices.
+  EXPECT_FALSE(cache.Lookup(key).has_value());
+  cache.Store(key, vertices, *allocator);
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+  cache.MarkFrameEnd();
+  host_buffer->Reset();
+
+  std::optional<VertexBuffer> cached = cache.Lookup(key);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->vertex_count, vertices.vertex_count);
+  EXPECT_EQ(cached->index_type, vertices.index_type);
+  EXPECT_NE(cached->vertex_buffer.GetBuffer(),
+            vertices.vertex_buffer.GetBuffer());
+
+  TessellationCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.hit_count, 1u);
+  EXPECT_EQ(stats.miss_count, 2u);
+  EXPECT_EQ(stats.byte_size, vertices.vertex_buffer.GetRange().length +
+                                 vertices.index_buffer.GetRange().length);
+}
+
+TEST_P(TessellationCacheTest, EvictsLeastRecentlyUsedPaths) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  auto host_buffer =
+      HostBuffer::Create(allocator, GetContext()->GetIdleWaiter(), 256);
+  Tessellator tessellator;
+  flutter::DlPath path = MakeTestPath();
+  VertexBuffer vertices = tessellator.TessellateConvex(
+      path, *host_buffer, *host_buffer, 1.0f);
+  size_t bytes = vertices.vertex_buffer.GetRange().length +
+                 vertices.index_buffer.GetRange().length;
+
+  // The budget holds the vertices of 2 paths.
+  TessellationCache cache(bytes * 5 / 2);
+  TessellationCache::Key keys[] = {
+      TessellationCache::MakeFillKey(path, 1.0f),
+      TessellationCache::MakeFillKey(path, 2.0f),
+      TessellationCache::MakeFillKey(path, 4.0f),
+  };
+  for (const TessellationCache::Key& key : keys) {
+    cache.Store(key, vertices, *allocator);
+  }
+  cache.MarkFrameEnd();
+  cache.Store(keys[0], vertices, *allocator);
+  cache.Store(keys[1], vertices, *allocator);
+  ASSERT_TRUE(cache.Lookup(keys[0]).has_value());
+  cache.Store(keys[2], vertices, *allocator);
+
+  EXPECT_TRUE(cache.Lookup(keys[0]).has_value());
+  EXPECT_FALSE(cache.Lookup(keys[1]).has_value());
+  EXPECT_TRUE(cache.Lookup(keys[2]).has_value());
+  EXPECT_EQ(cache.GetStats().entry_count, 2u);
+  EXPECT_EQ(cache.GetStats().byte_size, bytes * 2);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,182 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_prepass.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+TessellationPrepass::TessellationPrepass(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : worker_task_runner_(std::move(worker_task_runner)) {}
+
+TessellationPrepass::~TessellationPrepass() = default;
+
+bool TessellationPrepass::IsEnabled() const {
+  return worker_task_runner_ != nullptr;
+}
+
+void TessellationPrepass::AddFill(const flutter::DlPath& path,
+                                  const Matrix& transform) {
+  // Paths with empty bounds are not tessellated by |FillPathGeometry|.
+  if (!IsEnabled() || path.GetBounds().IsEmpty()) {
+    return;
+  }
+  Scalar scale =
+      TessellationCache::QuantizeScale(transform.GetMaxBasisLengthXY());
+  AddJob(TessellationCache::MakeFillKey(path, scale), path);
+}
+
+void TessellationPrepass::AddStroke(const flutter::DlPath& path,
+                                    const StrokeParameters& stroke,
+                                    const Matrix& transform) {
+  Scalar max_basis = transform.GetMaxBasisLengthXY();
+  // These strokes are not tessellated by |StrokePathGeometry|.
+  if (!IsEnabled() || stroke.width < 0.0f || max_basis == 0.0f) {
+    return;
+  }
+  StrokeParameters adjusted_stroke =
+      StrokeSegmentsGeometry::AdjustStrokeForScale(stroke, max_basis);
+  Scalar scale = TessellationCache::QuantizeScale(max_basis);
+  AddJob(TessellationCache::MakeStrokeKey(path, adjusted_stroke, scale), path);
+}
+
+void TessellationPrepass::AddJob(const TessellationCache::Key& key,
+                                 const flutter::DlPath& path) {
+  if (job_indices_.try_emplace(key, jobs_.size()).second) {
+    jobs_.push_back(Job{.key = key, .path = path});
+  }
+}
+
+void TessellationPrepass::Tessellate(const Context& context,
+                                     const TessellationCache& cache) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  std::vector<Job*> pending_jobs;
+  for (Job& job : jobs_) {
+    if (!job.vertices.has_value() && !cache.Contains(job.key)) {
+      pending_jobs.push_back(&job);
+    }
+  }
+  size_t thread_count = std::min<size_t>(
+      {kMaxThreadCount, pending_jobs.size() / kMinPathsPerThread,
+       std::thread::hardware_concurrency()});
+  if (thread_count < 2u) {
+    return;
+  }
+
+  TRACE_EVENT0("impeller", "TessellationPrepass::Tessellate");
+  const std::shared_ptr<const Capabilities>& capabilities =
+      context.GetCapabilities();
+  while (slices_.size() < thread_count) {
+    std::shared_ptr<HostBuffer> data_host_buffer = HostBuffer::Create(
+        context.GetResourceAllocator(), context.GetIdleWaiter(),
+        capabilities->GetMinimumUniformAlignment());
+    std::shared_ptr<HostBuffer> indexes_host_buffer =
+        capabilities->NeedsPartitionedHostBuffer()
+            ? HostBuffer::Create(context.GetResourceAllocator(),
+                                 context.GetIdleWaiter(),
+                                 capabilities->GetMinimumUniformAlignment())
+            : data_host_buffer;
+    slices_.push_back(Slice{
+        .tessellator = std::make_unique<Tessellator>(
+            capabilities->Supports32BitPrimitiveIndices()),
+        .data_host_buffer = std::move(data_host_buffer),
+        .indexes_host_buffer = std::move(indexes_host_buffer),
+    });
+  }
+
+  // Each thread claims a slice and then claims jobs until there are none
+  // left. The raster thread takes part as well, so the jobs are all done even
+  // if the workers are busy with other tasks. The workers that only start
+  // once the jobs are all claimed return without touching anything but the
+  // shared state.
+  struct SharedState {
+    explicit SharedState(size_t job_count)
+        : job_count(job_count), latch(job_count) {}
+
+    const size_t job_count;
+    std::atomic<size_t> next_slice = 0u;
+    std::atomic<size_t> next_job = 0u;
+    fml::CountDownLatch latch;
+  };
+  auto state = std::make_shared<SharedState>(pending_jobs.size());
+  auto run = [state, &context, &pending_jobs, this]() {
+    size_t job_index = state->next_job.fetch_add(1u);
+    if (job_index >= state->job_count) {
+      return;
+    }
+    // The slices and jobs outlive this task from here on because the raster
+    // thread waits for every claimed job.
+    Slice& slice = slices_[state->next_slice.fetch_add(1u)];
+    do {
+      TessellateJob(context, slice, *pending_jobs[job_index]);
+      state->latch.CountDown();
+      job_index = state->next_job.fetch_add(1u);
+    } while (job_index < state->job_count);
+  };
+  for (size_t i = 1u; i < thread_count; i++) {
+    worker_task_runner_->PostTask(run);
+  }
+  run();
+  state->latch.Wait();
+}
+
+void TessellationPrepass::TessellateJob(const Context& context,
+                                        Slice& slice,
+                                        Job& job) {
+  if (job.key.stroke.has_value()) {
+    StrokePathGeometry geometry(job.path, job.key.stroke.value());
+    job.vertices = geometry.TessellateStroke(
+        *slice.tessellator, *slice.data_host_buffer, job.key.stroke.value(),
+        job.key.quantized_scale);
+    return;
+  }
+
+  const Capabilities& capabilities = *context.GetCapabilities();
+  bool supports_primitive_restart = capabilities.SupportsPrimitiveRestart();
+  bool supports_triangle_fan =
+      capabilities.SupportsTriangleFan() && supports_primitive_restart;
+  job.vertices = slice.tessellator->TessellateConvex(
+      job.path, *slice.data_host_buffer, *slice.indexes_host_buffer,
+      job.key.quantized_scale,
+      /*supports_primitive_restart=*/supports_primitive_restart,
+      /*supports_triangle_fan=*/supports_triangle_fan);
+}
+
+std::optional<VertexBuffer> TessellationPrepass::Find(
+    const TessellationCache::Key& key) const {
+  auto it = job_indices_.find(key);
+  if (it == job_indices_.end()) {
+    return std::nullopt;
+  }
+  return jobs_[it->second].vertices;
+}
+
+void TessellationPrepass::MarkFrameEnd() {
+  jobs_.clear();
+  job_indices_.clear();
+}
+
+void TessellationPrepass::ResetHostBuffers() {
+  for (Slice& slice : slices_) {
+    slice.data_host_buffer->Reset();
+    if (slice.indexes_host_buffer != slice.data_host_buffer) {
+      slice.indexes_host_buffer->Reset();
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_PREPASS_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_PREPASS_H_
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/stroke_parameters.h"
+#include "impeller/renderer/context.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+
+namespace impeller {
+
+class Tessellator;
+
+/// @brief Tessellates the paths of a frame on several threads before the
+///        frame is dispatched to the |Canvas|.
+///
+/// The first pass over a display list adds the fills and strokes of the paths
+/// that will be drawn with a |FillPathGeometry| or a |StrokePathGeometry|,
+/// along with their transforms. |Tessellate| then shares them among the
+/// raster thread and tasks posted to the worker task runner, each of which
+/// tessellates its share with its own |Tessellator| into its own host
+/// buffers. When the paths are drawn, the geometries find their vertices
+/// under the same keys as in the |TessellationCache|, and tessellate any
+/// path that was not prepared as before.
+///
+/// The vertices can be found until |MarkFrameEnd|. The host buffers that
+/// hold them must be cycled with |ResetHostBuffers| whenever the transient
+/// host buffers of the |ContentContext| are.
+///
+/// Apart from the tasks posted by |Tessellate|, this object must only be
+/// used on the raster thread.
+class TessellationPrepass {
+ public:
+  /// The maximum number of threads, including the raster thread, that
+  /// tessellate the paths of a frame.
+  static constexpr size_t kMaxThreadCount = 4u;
+
+  /// The minimum number of paths that are worth tessellating on each thread.
+  static constexpr size_t kMinPathsPerThread = 4u;
+
+  /// @brief Creates a prepass that tessellates on |worker_task_runner|, or
+  ///        that does nothing if it is nullptr.
+  explicit TessellationPrepass(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  ~TessellationPrepass();
+
+  /// @brief Whether the added paths are tessellated concurrently at all.
+  bool IsEnabled() const;
+
+  /// @brief Adds a path that will be filled under |transform|.
+  void AddFill(const flutter::DlPath& path, const Matrix& transform);
+
+  /// @brief Adds a path that will be stroked under |transform|.
+  void AddStroke(const flutter::DlPath& path,
+                 const StrokeParameters& stroke,
+                 const Matrix& transform);
+
+  /// @brief Tessellates the added paths whose vertices are not retained in
+  ///        |cache| and waits until all of them are done.
+  ///
+  /// The paths are only shared out if there are enough of them to keep at
+  /// least 2 threads busy. Otherwise they are tessellated when they are
+  /// drawn.
+  void Tessellate(const Context& context, const TessellationCache& cache);
+
+  /// @brief Returns the vertices that were prepared for the key, or
+  ///        std::nullopt if the caller needs to tessellate the path.
+  std::optional<VertexBuffer> Find(const TessellationCache::Key& key) const;
+
+  /// @brief Forgets the paths and the vertices of the frame.
+  void MarkFrameEnd();
+
+  /// @brief Resets the host buffers that hold the prepared vertices.
+  ///
+  /// @see HostBuffer::Reset
+  void ResetHostBuffers();
+
+ private:
+  struct Job {
+    TessellationCache::Key key;
+    flutter::DlPath path;
+    std::optional<VertexBuffer> vertices;
+  };
+
+  // The state that is owned by one of the threads that tessellate the paths.
+  struct Slice {
+    std::unique_ptr<Tessellator> tessellator;
+    std::shared_ptr<HostBuffer> data_host_buffer;
+    std::shared_ptr<HostBuffer> indexes_host_buffer;
+  };
+
+  TessellationPrepass(const TessellationPrepass&) = delete;
+
+  TessellationPrepass& operator=(const TessellationPrepass&) = delete;
+
+  void AddJob(const TessellationCache::Key& key, const flutter::DlPath& path);
+
+  static void TessellateJob(const Context& context, Slice& slice, Job& job);
+
+  const std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  std::vector<Job> jobs_;
+  absl::flat_hash_map<TessellationCache::Key,
+                      size_t,
+                      TessellationCache::Key::Hash>
+      job_indices_;
+  std::vector<Slice> slices_;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_PREPASS_H_
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_prepass.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/display_list/geometry/dl_path_builder.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/testing/testing.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+namespace testing {
+
+using TessellationPrepassTest = EntityPlayground;
+INSTANTIATE_PLAYGROUND_SUITE(TessellationPrepassTest);
+
+namespace {
+
+flutter::DlPath MakeTestPath(Scalar offset) {
+  flutter::DlPathBuilder builder;
+  builder.MoveTo({offset, 10});
+  builder.CubicCurveTo({offset + 20, -20}, {offset + 60, 40},
+                       {offset + 90, 10});
+  builder.QuadraticCurveTo({offset + 50, 120}, {offset + 10, 90});
+  builder.Close();
+  return builder.TakePath();
+}
+
+}  // namespace
+
+TEST(TessellationPrepass, DoesNothingWithoutWorkers) {
+  TessellationPrepass prepass(nullptr);
+  TessellationCache cache;
+  std::vector<flutter::DlPath> paths;
+  for (int i = 0; i < 16; i++) {
+    paths.push_back(MakeTestPath(i * 100));
+    prepass.AddFill(paths.back(), Matrix());
+  }
+
+  EXPECT_FALSE(prepass.IsEnabled());
+  for (const flutter::DlPath& path : paths) {
+    EXPECT_FALSE(
+        prepass.Find(TessellationCache::MakeFillKey(path, 1.0f)).has_value());
+  }
+}
+
+TEST_P(TessellationPrepassTest, TessellatesPathsOnWorkers) {
+  if (std::thread::hardware_concurrency() < 2u) {
+    GTEST_SKIP() << "The paths are only shared out with several cores.";
+  }
+  auto loop = fml::ConcurrentMessageLoop::Create(3u);
+  TessellationPrepass prepass(loop->GetTaskRunner());
+  TessellationCache cache;
+  StrokeParameters stroke{.width = 4.0f, .join = Join::kRound};
+
+  std::vector<flutter::DlPath> paths;
+  for (int i = 0; i < 16; i++) {
+    paths.push_back(MakeTestPath(i * 100));
+    prepass.AddFill(paths.back(), Matrix());
+    prepass.AddStroke(paths.back(), stroke, Matrix());
+  }
+  prepass.Tessellate(*GetContext(), cache);
+
+  auto host_buffer =
+      HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                         GetContext()->GetIdleWaiter(), 256);
+  const Capabilities& capabilities = *GetContext()->GetCapabilities();
+  bool supports_primitive_restart = capabilities.SupportsPrimitiveRestart();
+  bool supports_triangle_fan =
+      capabilities.SupportsTriangleFan() && supports_primitive_restart;
+  Tessellator tessellator(capabilities.Supports32BitPrimitiveIndices());
+  for (const flutter::DlPath& path : paths) {
+    std::optional<VertexBuffer> fill =
+        prepass.Find(TessellationCache::MakeFillKey(path, 1.0f));
+    ASSERT_TRUE(fill.has_value());
+    VertexBuffer expected_fill = tessellator.TessellateConvex(
+        path, *host_buffer, *host_buffer, 1.0f, supports_primitive_restart,
+        supports_triangle_fan);
+    EXPECT_EQ(fill->vertex_count, expected_fill.vertex_count);
+    EXPECT_EQ(fill->index_type, expected_fill.index_type);
+
+    std::optional<VertexBuffer> stroked =
+        prepass.Find(TessellationCache::MakeStrokeKey(path, stroke, 1.0f));
+    ASSERT_TRUE(stroked.has_value());
+    VertexBuffer expected_stroke =
+        StrokePathGeometry(path, stroke)
+            .TessellateStroke(tessellator, *host_buffer, stroke, 1.0f);
+    EXPECT_EQ(stroked->vertex_count, expected_stroke.vertex_count);
+  }
+
+  prepass.MarkFrameEnd();
+  prepass.ResetHostBuffers();
+  EXPECT_FALSE(prepass.Find(TessellationCache::MakeFillKey(paths[0], 1.0f))
+                   .has_value());
+}
+
+TEST_P(TessellationPrepassTest, LeavesFewPathsToTheRasterThread) {
+  auto loop = fml::ConcurrentMessageLoop::Create(3u);
+  TessellationPrepass prepass(loop->GetTaskRunner());
+  TessellationCache cache;
+
+  flutter::DlPath path = MakeTestPath(0);
+  prepass.AddFill(path, Matrix());
+  prepass.Tessellate(*GetContext(), cache);
+
+  EXPECT_TRUE(prepass.IsEnabled());
+  EXPECT_FALSE(
+      prepass.Find(TessellationCache::MakeFillKey(path, 1.0f)).has_value());
+}
+
+}  // namespace testing
+}  // namespace impeller
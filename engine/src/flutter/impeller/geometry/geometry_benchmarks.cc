@@ -8,6 +8,9 @@
 #include "flutter/display_list/geometry/dl_path_builder.h"
 #include "impeller/entity/geometry/shadow_path_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/tessellator/coverage_rasterizer.h"
+#include "impeller/tessellator/path_tessellator.h"
+#include "impeller/tessellator/tessellator.h"
 #include "impeller/tessellator/tessellator_libtess.h"
 
 namespace impeller {
@@ -34,6 +37,9 @@ flutter::DlPath CreateQuadratic(bool closed);
 flutter::DlPath CreateRRect();
 /// Create a rounded superellipse.
 flutter::DlPath CreateRSuperellipse();
+/// A path with a grid of many small closed contours made of every kind of
+/// curve, similar to the icons or glyphs of a dense SVG illustration.
+flutter::DlPath CreateDenseShapes();
 /// Create a clockwise triangle path.
 flutter::DlPath CreateClockwiseTriangle();
 /// Create a counter-clockwise triangle path.
@@ -50,10 +56,79 @@ flutter::DlPath CreateCounterClockwiseMultiRadiiRoundRect();
 flutter::DlPath CreateClockwisePolygon();
 /// Create a counter-clockwise polygonal path.
 flutter::DlPath CreateCounterClockwisePolygon();
+
+/// A vertex writer that stores the points of a filled path into a
+/// preallocated buffer.
+class PointBufferWriter : public PathTessellator::VertexWriter {
+ public:
+  explicit PointBufferWriter(Point* points) : points_(points) {}
+
+  size_t GetPointCount() const { return count_; }
+
+  // |VertexWriter|
+  void Write(Point point) override { points_[count_++] = point; }
+
+  // |VertexWriter|
+  void WriteBatch(const Point* points, size_t count) override {
+    std::copy(points, points + count, points_ + count_);
+    count_ += count;
+  }
+
+  // |VertexWriter|
+  void EndContour() override {}
+
+ private:
+  Point* points_;
+  size_t count_ = 0u;
+};
+
 }  // namespace
 
 static TessellatorLibtess tess;
 
+template <class... Args>
+static void BM_FillPath(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<flutter::DlPath>(args_tuple);
+
+  const Scalar scale = 1.0f;
+
+  auto [storage_count, contour_count] =
+      PathTessellator::CountFillStorage(path, scale);
+  std::vector<Point> points(storage_count);
+
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    PointBufferWriter writer(points.data());
+    PathTessellator::PathToFilledVertices(path, writer, scale);
+    single_point_count = writer.GetPointCount();
+    point_count += single_point_count;
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+}
+
+/// Computes the analytic coverage of a path over its bounds, which replaces
+/// the fill tessellation and the stencil pass of |BM_FillPath| when analytic
+/// path fills are turned on.
+template <class... Args>
+static void BM_AnalyticCoverage(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<flutter::DlPath>(args_tuple);
+
+  IRect bounds = IRect::RoundOut(path.GetBounds());
+  std::vector<uint8_t> coverage(bounds.GetSize().Area());
+
+  while (state.KeepRunning()) {
+    CoverageRasterizer rasterizer(bounds.GetSize(), Point(bounds.GetOrigin()));
+    PathTessellator::PathToTransformedFilledVertices(path, rasterizer,
+                                                     Matrix());
+    rasterizer.Resolve(path.GetFillType(), coverage.data(), bounds.GetWidth());
+  }
+  state.counters["PixelCount"] = bounds.GetSize().Area();
+}
+
 template <class... Args>
 static void BM_StrokePath(benchmark::State& state, Args&&... args) {
   auto args_tuple = std::make_tuple(std::move(args)...);
@@ -81,6 +156,41 @@ static void BM_StrokePath(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+/// Measures the vertices of a frame of many circles of the same size, which
+/// are either generated for each circle by |Tessellator::StrokedCircle| or
+/// offset from the ones retained by |Tessellator::GetCircleVertices|.
+template <class... Args>
+static void BM_CircleVertices(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto radius = std::get<0>(args_tuple);
+  auto half_width = std::get<1>(args_tuple);
+  auto retained = std::get<2>(args_tuple);
+
+  constexpr size_t kCircleCount = 1000u;
+  Tessellator tessellator;
+  std::vector<Point> vertices;
+  while (state.KeepRunning()) {
+    vertices.clear();
+    for (size_t i = 0; i < kCircleCount; i++) {
+      Point center(i % 40 * 25.0f, i / 40 * 25.0f);
+      if (retained) {
+        auto circle_vertices =
+            tessellator.GetCircleVertices({}, radius, half_width);
+        for (const Point& vertex : *circle_vertices) {
+          vertices.push_back(center + vertex);
+        }
+      } else {
+        auto generator =
+            tessellator.StrokedCircle({}, center, radius, half_width);
+        generator.GenerateVertices([&vertices](const Point& p) {  //
+          vertices.push_back(p);
+        });
+      }
+    }
+  }
+  state.counters["TotalPointCount"] = vertices.size();
+}
+
 template <class... Args>
 static void BM_Convex(benchmark::State& state, Args&&... args) {
   auto args_tuple = std::make_tuple(std::move(args)...);
@@ -151,6 +261,23 @@ MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Cubic, false);
 
 MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Quadratic, false);
 
+BENCHMARK_CAPTURE(BM_FillPath, fill_Cubic, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_FillPath, fill_Quadratic, CreateQuadratic(true));
+BENCHMARK_CAPTURE(BM_FillPath, fill_DenseShapes, CreateDenseShapes());
+BENCHMARK_CAPTURE(BM_AnalyticCoverage, coverage_Cubic, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_AnalyticCoverage,
+                  coverage_Quadratic,
+                  CreateQuadratic(true));
+BENCHMARK_CAPTURE(BM_AnalyticCoverage,
+                  coverage_DenseShapes,
+                  CreateDenseShapes());
+BENCHMARK_CAPTURE(BM_CircleVertices, dots_generated, 10.0f, 0.0f, false);
+BENCHMARK_CAPTURE(BM_CircleVertices, dots_retained, 10.0f, 0.0f, true);
+BENCHMARK_CAPTURE(BM_CircleVertices, rings_generated, 10.0f, 2.0f, false);
+BENCHMARK_CAPTURE(BM_CircleVertices, rings_retained, 10.0f, 2.0f, true);
+MAKE_STROKE_PATH_BENCHMARK_CAPTURE(DenseShapes, Butt, Bevel, );
+MAKE_STROKE_PATH_BENCHMARK_CAPTURE(DenseShapes, Round, Round, );
+
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
 // A round rect has no ends so we don't need to try it with all cap values
 // but it does have joins and even though they should all be almost
@@ -321,6 +448,24 @@ flutter::DlPath CreateRSuperellipse() {
       .TakePath();
 }
 
+flutter::DlPath CreateDenseShapes() {
+  flutter::DlPathBuilder builder;
+  for (int row = 0; row < 16; row++) {
+    for (int column = 0; column < 16; column++) {
+      Scalar x = column * 25.0f;
+      Scalar y = row * 25.0f;
+      builder  //
+          .MoveTo({x, y + 10})
+          .CubicCurveTo({x, y + 2}, {x + 8, y}, {x + 12, y})
+          .QuadraticCurveTo({x + 20, y}, {x + 20, y + 10})
+          .ConicCurveTo({x + 20, y + 20}, {x + 10, y + 20}, kSqrt2Over2)
+          .CubicCurveTo({x + 4, y + 20}, {x - 2, y + 16}, {x, y + 10})
+          .Close();
+    }
+  }
+  return builder.TakePath();
+}
+
 flutter::DlPath CreateCubic(bool closed) {
   auto builder = flutter::DlPathBuilder{};
   builder  //
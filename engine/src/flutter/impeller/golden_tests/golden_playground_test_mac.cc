@@ -26,10 +26,12 @@
 namespace impeller {
 
 namespace {
-std::unique_ptr<PlaygroundImpl> MakeVulkanPlayground(bool enable_validations) {
+std::unique_ptr<PlaygroundImpl> MakeVulkanPlayground(bool enable_validations,
+                                                     const Flags& flags = {}) {
   FML_CHECK(::glfwInit() == GLFW_TRUE);
   PlaygroundSwitches playground_switches;
   playground_switches.enable_vulkan_validation = enable_validations;
+  playground_switches.flags = flags;
   return PlaygroundImpl::Create(PlaygroundBackend::kVulkan,
                                 playground_switches);
 }
@@ -165,6 +167,8 @@ void GoldenPlaygroundTest::SetUp() {
       test_name.find("WideGamut_") != std::string::npos;
   switches.flags.antialiased_lines =
       test_name.find("ExperimentAntialiasLines_") != std::string::npos;
+  switches.flags.analytic_path_fills =
+      test_name.find("ExperimentAnalyticPathFills_") != std::string::npos;
   switch (GetParam()) {
     case PlaygroundBackend::kMetal:
       if (!DoesSupportWideGamutTests()) {
@@ -182,6 +186,15 @@ void GoldenPlaygroundTest::SetUp() {
         GTEST_SKIP()
             << "Vulkan doesn't support antialiased lines golden tests.";
       }
+      if (switches.flags.analytic_path_fills) {
+        // The shared playground is created without any flags, so tests of
+        // flagged features get a context of their own.
+        pimpl_->test_vulkan_playground =
+            MakeVulkanPlayground(/*enable_validations=*/true, switches.flags);
+        pimpl_->screenshotter = std::make_unique<testing::VulkanScreenshotter>(
+            pimpl_->test_vulkan_playground);
+        break;
+      }
       const std::unique_ptr<PlaygroundImpl>& playground =
           GetSharedVulkanPlayground(/*enable_validations=*/true);
       pimpl_->screenshotter =
@@ -199,6 +212,7 @@ void GoldenPlaygroundTest::SetUp() {
       FML_CHECK(::glfwInit() == GLFW_TRUE);
       PlaygroundSwitches playground_switches;
       playground_switches.use_angle = true;
+      playground_switches.flags = switches.flags;
       pimpl_->test_opengl_playground = PlaygroundImpl::Create(
           PlaygroundBackend::kOpenGLES, playground_switches);
       pimpl_->screenshotter = std::make_unique<testing::VulkanScreenshotter>(
@@ -67,6 +67,8 @@ void PlaygroundTest::SetUp() {
 
   switches.flags.antialiased_lines =
       test_name.find("ExperimentAntialiasLines/") != std::string::npos;
+  switches.flags.analytic_path_fills =
+      test_name.find("ExperimentAnalyticPathFills/") != std::string::npos;
 
   SetupContext(GetParam(), switches);
   SetupWindow();
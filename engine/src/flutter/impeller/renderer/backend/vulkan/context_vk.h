@@ -198,8 +198,9 @@ class ContextVK final : public Context,
 
   const std::unique_ptr<DriverInfoVK>& GetDriverInfo() const;
 
-  const std::shared_ptr<fml::ConcurrentTaskRunner>
-  GetConcurrentWorkerTaskRunner() const;
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
+      const override;
 
   std::shared_ptr<SurfaceContextVK> CreateSurfaceContext();
 
@@ -63,6 +63,11 @@ std::shared_ptr<const IdleWaiter> SurfaceContextVK::GetIdleWaiter() const {
   return parent_->GetIdleWaiter();
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+SurfaceContextVK::GetConcurrentWorkerTaskRunner() const {
+  return parent_->GetConcurrentWorkerTaskRunner();
+}
+
 void SurfaceContextVK::Shutdown() {
   parent_->Shutdown();
 }
@@ -70,6 +70,10 @@ class SurfaceContextVK : public Context,
   // |Context|
   std::shared_ptr<const IdleWaiter> GetIdleWaiter() const override;
 
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
+      const override;
+
   // |Context|
   RuntimeStageBackend GetRuntimeStageBackend() const override;
 
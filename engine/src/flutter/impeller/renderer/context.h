@@ -10,6 +10,7 @@
 #include <string>
 
 #include "fml/closure.h"
+#include "fml/concurrent_message_loop.h"
 #include "impeller/base/flags.h"
 #include "impeller/base/thread_safety.h"
 #include "impeller/core/allocator.h"
@@ -245,6 +246,11 @@ class Context {
 
   virtual std::shared_ptr<const IdleWaiter> GetIdleWaiter() const;
 
+  /// @brief Returns a task runner for CPU work that may run concurrently with
+  ///        the raster thread, or nullptr if the backend does not have one.
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner>
+  GetConcurrentWorkerTaskRunner() const;
+
   //----------------------------------------------------------------------------
   /// Resets any thread local state that may interfere with embedders.
   ///
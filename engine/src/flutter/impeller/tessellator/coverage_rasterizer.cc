@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/impeller/tessellator/coverage_rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace impeller {
+
+CoverageRasterizer::CoverageRasterizer(ISize size, Point origin)
+    : size_(size.IsEmpty() ? ISize() : size),
+      origin_(origin),
+      stride_(static_cast<size_t>(size_.width) + 2u),
+      areas_(stride_ * static_cast<size_t>(size_.height), 0.0f) {}
+
+CoverageRasterizer::~CoverageRasterizer() = default;
+
+void CoverageRasterizer::Write(Point point) {
+  point -= origin_;
+  if (contour_start_.has_value()) {
+    AddEdge(last_point_, point);
+  } else {
+    contour_start_ = point;
+  }
+  last_point_ = point;
+}
+
+void CoverageRasterizer::EndContour() {
+  if (contour_start_.has_value()) {
+    AddEdge(last_point_, contour_start_.value());
+    contour_start_.reset();
+  }
+}
+
+void CoverageRasterizer::AddEdge(Point p0, Point p1) {
+  if (size_.IsEmpty() || p0.y == p1.y) {
+    return;
+  }
+
+  // Split the edge where it crosses the left and right sides of the grid.
+  // The parts beyond them are moved onto the sides, which leaves the winding
+  // of the pixels inside the grid unchanged.
+  Scalar width = static_cast<Scalar>(size_.width);
+  Point points[4] = {p0};
+  size_t point_count = 1u;
+  for (Scalar side : {0.0f, width}) {
+    if ((p0.x < side) != (p1.x < side)) {
+      Scalar t = (side - p0.x) / (p1.x - p0.x);
+      points[point_count++] = {side, p0.y + t * (p1.y - p0.y)};
+    }
+  }
+  if (point_count == 3u &&
+      std::abs(points[2].x - p0.x) < std::abs(points[1].x - p0.x)) {
+    std::swap(points[1], points[2]);
+  }
+  points[point_count++] = p1;
+
+  for (size_t i = 1u; i < point_count; i++) {
+    Point from = points[i - 1];
+    Point to = points[i];
+    from.x = std::clamp(from.x, 0.0f, width);
+    to.x = std::clamp(to.x, 0.0f, width);
+    AccumulateEdge(from, to);
+  }
+}
+
+void CoverageRasterizer::AccumulateEdge(Point p0, Point p1) {
+  if (p0.y == p1.y) {
+    return;
+  }
+  // Edges that go down add to the winding of the pixels to their right and
+  // edges that go up subtract from it.
+  Scalar direction = 1.0f;
+  if (p0.y > p1.y) {
+    std::swap(p0, p1);
+    direction = -1.0f;
+  }
+  Scalar height = static_cast<Scalar>(size_.height);
+  if (p1.y <= 0.0f || p0.y >= height) {
+    return;
+  }
+
+  // The positions along the rows are clamped to the grid to keep rounding
+  // errors from reaching outside of it.
+  Scalar width = static_cast<Scalar>(size_.width);
+  Scalar dxdy = (p1.x - p0.x) / (p1.y - p0.y);
+  Scalar x = p0.x;
+  if (p0.y < 0.0f) {
+    x = std::clamp(x - p0.y * dxdy, 0.0f, width);
+  }
+  int64_t first_row = static_cast<int64_t>(std::max(p0.y, 0.0f));
+  int64_t end_row =
+      std::min(size_.height, static_cast<int64_t>(std::ceil(p1.y)));
+  for (int64_t row = first_row; row < end_row; row++) {
+    Scalar* areas = areas_.data() + row * stride_;
+    Scalar top = std::max(static_cast<Scalar>(row), p0.y);
+    Scalar bottom = std::min(static_cast<Scalar>(row + 1), p1.y);
+    Scalar dy = bottom - top;
+    Scalar next_x = std::clamp(x + dxdy * dy, 0.0f, width);
+    Scalar delta = dy * direction;
+
+    Scalar x0 = std::min(x, next_x);
+    Scalar x1 = std::max(x, next_x);
+    Scalar x0_floor = std::floor(x0);
+    Scalar x1_ceil = std::ceil(x1);
+    size_t x0i = static_cast<size_t>(x0_floor);
+    size_t x1i = static_cast<size_t>(x1_ceil);
+    if (x1i <= x0i + 1u) {
+      // The edge stays within a single pixel of the row, so the pixel gets
+      // the part of the area to the right of the midpoint of the edge.
+      Scalar mid = 0.5f * (x + next_x) - x0_floor;
+      areas[x0i] += delta - delta * mid;
+      areas[x0i + 1u] += delta * mid;
+    } else {
+      // The edge crosses several pixels, so the area is split between the
+      // triangles in the first and last pixels and the slices in between.
+      Scalar inverse_width = 1.0f / (x1 - x0);
+      Scalar x0_fraction = x0 - x0_floor;
+      Scalar first_area =
+          0.5f * inverse_width * (1.0f - x0_fraction) * (1.0f - x0_fraction);
+      Scalar x1_fraction = x1 - x1_ceil + 1.0f;
+      Scalar last_area = 0.5f * inverse_width * x1_fraction * x1_fraction;
+      areas[x0i] += delta * first_area;
+      if (x1i == x0i + 2u) {
+        areas[x0i + 1u] += delta * (1.0f - first_area - last_area);
+      } else {
+        Scalar second_area = inverse_width * (1.5f - x0_fraction);
+        areas[x0i + 1u] += delta * (second_area - first_area);
+        for (size_t i = x0i + 2u; i < x1i - 1u; i++) {
+          areas[i] += delta * inverse_width;
+        }
+        Scalar before_last_area =
+            second_area + static_cast<Scalar>(x1i - x0i - 3u) * inverse_width;
+        areas[x1i - 1u] += delta * (1.0f - before_last_area - last_area);
+      }
+      areas[x1i] += delta * last_area;
+    }
+    x = next_x;
+  }
+}
+
+void CoverageRasterizer::Resolve(FillType fill_type,
+                                 uint8_t* coverage,
+                                 size_t row_bytes) const {
+  for (int64_t row = 0; row < size_.height; row++) {
+    const Scalar* areas = areas_.data() + row * stride_;
+    uint8_t* row_coverage = coverage + row * row_bytes;
+    Scalar winding = 0.0f;
+    for (int64_t i = 0; i < size_.width; i++) {
+      winding += areas[i];
+      Scalar value = std::abs(winding);
+      if (fill_type == FillType::kOdd) {
+        value = std::fmod(value, 2.0f);
+        value = value > 1.0f ? 2.0f - value : value;
+      } else {
+        value = std::min(value, 1.0f);
+      }
+      row_coverage[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TESSELLATOR_COVERAGE_RASTERIZER_H_
+#define FLUTTER_IMPELLER_TESSELLATOR_COVERAGE_RASTERIZER_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "flutter/impeller/geometry/path_source.h"
+#include "flutter/impeller/geometry/point.h"
+#include "flutter/impeller/geometry/size.h"
+#include "flutter/impeller/tessellator/path_tessellator.h"
+
+namespace impeller {
+
+/// @brief Computes the exact fraction of each pixel of a grid that is covered
+///        by a filled path, which is used to draw paths with analytic
+///        anti-aliasing instead of a stencil and MSAA.
+///
+/// The contours of the path are written as polylines, such as the ones
+/// produced by |PathTessellator::PathToTransformedFilledVertices|, in the
+/// coordinates of the grid offset by the origin. Every edge adds the signed
+/// area that it covers to the pixels of the rows that it crosses, and
+/// |Resolve| sums up these areas along each row to get the winding of every
+/// pixel, weighted by coverage. Edges that leave the grid are clipped to it,
+/// so the grid can be any part of the bounds of the path.
+class CoverageRasterizer : public PathTessellator::VertexWriter {
+ public:
+  /// @brief Creates a rasterizer for a grid of |size| pixels whose top left
+  ///        pixel starts at |origin|.
+  explicit CoverageRasterizer(ISize size, Point origin = {});
+
+  ~CoverageRasterizer();
+
+  const ISize& GetSize() const { return size_; }
+
+  /// @brief Adds the coverage of a single edge of a contour.
+  void AddEdge(Point p0, Point p1);
+
+  // |VertexWriter|
+  void Write(Point point) override;
+
+  // |VertexWriter|
+  void EndContour() override;
+
+  /// @brief Writes the coverage of every pixel of the grid as a single byte
+  ///        into rows of |coverage| that start |row_bytes| apart.
+  void Resolve(FillType fill_type, uint8_t* coverage, size_t row_bytes) const;
+
+ private:
+  // Adds the area of an edge that lies between the left and right sides of
+  // the grid.
+  void AccumulateEdge(Point p0, Point p1);
+
+  const ISize size_;
+  const Point origin_;
+  // Each row has room for the areas that edges on the right side of the grid
+  // add past its last pixel.
+  const size_t stride_;
+  std::vector<Scalar> areas_;
+  std::optional<Point> contour_start_;
+  Point last_point_;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TESSELLATOR_COVERAGE_RASTERIZER_H_
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+
+#include "flutter/impeller/tessellator/coverage_rasterizer.h"
+
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/display_list/geometry/dl_path_builder.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+std::vector<uint8_t> RasterizeCoverage(const flutter::DlPath& path,
+                                       ISize size,
+                                       Point origin = {}) {
+  CoverageRasterizer rasterizer(size, origin);
+  PathTessellator::PathToTransformedFilledVertices(path, rasterizer, Matrix());
+  std::vector<uint8_t> coverage(size.Area());
+  rasterizer.Resolve(path.GetFillType(), coverage.data(), size.width);
+  return coverage;
+}
+
+}  // namespace
+
+TEST(CoverageRasterizerTest, RectCoversWholePixels) {
+  flutter::DlPath path = flutter::DlPath::MakeRect(Rect::MakeLTRB(1, 1, 3, 3));
+  std::vector<uint8_t> coverage = RasterizeCoverage(path, ISize(4, 4));
+
+  std::vector<uint8_t> expected = {
+      0, 0,   0,   0,  //
+      0, 255, 255, 0,  //
+      0, 255, 255, 0,  //
+      0, 0,   0,   0,  //
+  };
+  EXPECT_EQ(coverage, expected);
+}
+
+TEST(CoverageRasterizerTest, DiagonalEdgeCoversHalfOfItsPixels) {
+  flutter::DlPathBuilder builder;
+  builder.MoveTo({0, 0});
+  builder.LineTo({2, 0});
+  builder.LineTo({0, 2});
+  builder.Close();
+  std::vector<uint8_t> coverage =
+      RasterizeCoverage(builder.TakePath(), ISize(3, 3));
+
+  std::vector<uint8_t> expected = {
+      255, 128, 0,  //
+      128, 0,   0,  //
+      0,   0,   0,  //
+  };
+  EXPECT_EQ(coverage, expected);
+}
+
+TEST(CoverageRasterizerTest, CoverageAddsUpToTheAreaOfTheShape) {
+  flutter::DlPathBuilder builder;
+  builder.MoveTo({-3, -1});
+  builder.LineTo({12, 7.3});
+  builder.LineTo({1, 9});
+  builder.Close();
+  std::vector<uint8_t> coverage =
+      RasterizeCoverage(builder.TakePath(), ISize(8, 8));
+
+  Scalar area = 0.0f;
+  for (uint8_t value : coverage) {
+    area += value / 255.0f;
+  }
+  // The area of the part of the triangle that lies inside of the grid.
+  EXPECT_NEAR(area, 40.5417f, 0.1f);
+}
+
+TEST(CoverageRasterizerTest, FillTypeDecidesCoverageOfOverlaps) {
+  flutter::DlPathBuilder builder;
+  builder.AddRect(Rect::MakeLTRB(0, 0, 2, 1));
+  builder.AddRect(Rect::MakeLTRB(1, 0, 3, 1));
+
+  builder.SetFillType(FillType::kNonZero);
+  EXPECT_EQ(RasterizeCoverage(builder.CopyPath(), ISize(3, 1)),
+            std::vector<uint8_t>({255, 255, 255}));
+
+  builder.SetFillType(FillType::kOdd);
+  EXPECT_EQ(RasterizeCoverage(builder.CopyPath(), ISize(3, 1)),
+            std::vector<uint8_t>({255, 0, 255}));
+}
+
+TEST(CoverageRasterizerTest, EdgesOutsideTheGridAreClipped) {
+  flutter::DlPath path =
+      flutter::DlPath::MakeRect(Rect::MakeLTRB(-10, -10, 3.5, 20));
+  std::vector<uint8_t> coverage =
+      RasterizeCoverage(path, ISize(4, 2), Point(1, 1));
+
+  std::vector<uint8_t> expected = {
+      255, 255, 128, 0,  //
+      255, 255, 128, 0,  //
+  };
+  EXPECT_EQ(coverage, expected);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -14,6 +14,7 @@ using Scalar = impeller::Scalar;
 
 using SegmentReceiver = impeller::PathTessellator::SegmentReceiver;
 using VertexWriter = impeller::PathTessellator::VertexWriter;
+using PathTessellator = impeller::PathTessellator;
 using Quad = impeller::PathTessellator::Quad;
 using Conic = impeller::PathTessellator::Conic;
 using Cubic = impeller::PathTessellator::Cubic;
@@ -240,32 +241,15 @@ class PathFillWriter : public SegmentReceiver {
   void RecordLine(Point p1, Point p2) override { writer_.Write(p2); }
 
   void RecordQuad(Point p1, Point cp, Point p2) override {
-    Quad quad{p1, cp, p2};
-    Scalar count = std::ceilf(ComputeQuadradicSubdivisions(scale_, p1, cp, p2));
-    for (size_t i = 1; i < count; i++) {
-      writer_.Write(quad.Solve(i / count));
-    }
-    writer_.Write(p2);
+    RecordCurve(Quad{p1, cp, p2});
   }
 
   void RecordConic(Point p1, Point cp, Point p2, Scalar weight) override {
-    Conic conic{p1, cp, p2, weight};
-    Scalar count =
-        std::ceilf(ComputeConicSubdivisions(scale_, p1, cp, p2, weight));
-    for (size_t i = 1; i < count; i++) {
-      writer_.Write(conic.Solve(i / count));
-    }
-    writer_.Write(p2);
+    RecordCurve(Conic{p1, cp, p2, weight});
   }
 
   void RecordCubic(Point p1, Point cp1, Point cp2, Point p2) override {
-    Cubic cubic{p1, cp1, cp2, p2};
-    Scalar count =
-        std::ceilf(ComputeCubicSubdivisions(scale_, p1, cp1, cp2, p2));
-    for (size_t i = 1; i < count; i++) {
-      writer_.Write(cubic.Solve(i / count));
-    }
-    writer_.Write(p2);
+    RecordCurve(Cubic{p1, cp1, cp2, p2});
   }
 
   void EndContour(Point origin, bool with_close) override {
@@ -275,6 +259,22 @@ class PathFillWriter : public SegmentReceiver {
  private:
   VertexWriter& writer_;
   Scalar scale_;
+
+  // Writes the intermediate points of the curve a batch at a time, followed
+  // by its end point.
+  template <typename Curve>
+  void RecordCurve(const Curve& curve) {
+    Scalar count = std::ceilf(curve.SubdivisionCount(scale_));
+    Point points[PathTessellator::kCurveBatchSize];
+    for (size_t i = 1; i < count;) {
+      size_t batch_count = std::min(PathTessellator::kCurveBatchSize,
+                                    static_cast<size_t>(count - i));
+      PathTessellator::SolveBatch(curve, i, batch_count, count, points);
+      writer_.WriteBatch(points, batch_count);
+      i += batch_count;
+    }
+    writer_.Write(curve.Last());
+  }
 };
 
 }  // namespace
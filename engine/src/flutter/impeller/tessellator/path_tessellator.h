@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_TESSELLATOR_PATH_TESSELLATOR_H_
 #define FLUTTER_IMPELLER_TESSELLATOR_PATH_TESSELLATOR_H_
 
+#include <cstddef>
 #include <memory>
 #include <tuple>
 
@@ -22,6 +23,15 @@ class PathTessellator {
    public:
     virtual void Write(Point point) = 0;
     virtual void EndContour() = 0;
+
+    /// Writes |count| consecutive points of the current contour. Writers
+    /// that store the points contiguously should override this to copy
+    /// all of them at once.
+    virtual void WriteBatch(const Point* points, size_t count) {
+      for (size_t i = 0; i < count; i++) {
+        Write(points[i]);
+      }
+    }
   };
 
   /// An interface for receiving pruned path segments.
@@ -58,17 +68,53 @@ class PathTessellator {
     virtual void EndContour(Point origin, bool with_close) = 0;
   };
 
+  /// The maximum number of curve points that are solved by a single call to
+  /// |SolveBatch| when a curve is flattened.
+  static constexpr size_t kCurveBatchSize = 16u;
+
+  /// @brief Solves |curve| at the parameters (first + i) / divisions for
+  ///        every i in [0, count) and stores the points in |points|.
+  ///
+  /// The terms of the Bernstein form that do not depend on the parameter
+  /// are computed once for the whole batch. The points are identical to the
+  /// ones returned by |Curve::Solve|, but they are solved independently of
+  /// each other in a single branch-free loop so that the compiler can solve
+  /// several of them at once with vector instructions.
+  template <typename Curve>
+  static void SolveBatch(const Curve& curve,
+                         size_t first,
+                         size_t count,
+                         Scalar divisions,
+                         Point* points) {
+    const typename Curve::Evaluator evaluator = curve.GetEvaluator();
+    for (size_t i = 0; i < count; i++) {
+      points[i] = evaluator.Solve((first + i) / divisions);
+    }
+  }
+
   struct Quad {
     const Point p1;
     const Point cp;
     const Point p2;
 
+    /// The Bernstein form of the curve with its constant factors applied
+    /// to the control point.
+    struct Evaluator {
+      Point p1;
+      Point cp2;  // 2 * cp
+      Point p2;
+
+      Point Solve(Scalar t) const {
+        Scalar u = 1.0f - t;
+        return p1 * u * u + cp2 * u * t + p2 * t * t;
+      }
+    };
+
     Point Last() const { return p2; }
 
-    Point Solve(Scalar t) const {
-      Scalar u = 1.0f - t;
-      return p1 * u * u + 2 * cp * u * t + p2 * t * t;
-    }
+    Evaluator GetEvaluator() const { return {p1, 2 * cp, p2}; }
+
+    Point Solve(Scalar t) const { return GetEvaluator().Solve(t); }
 
     Scalar SubdivisionCount(Scalar scale) const {
       return ComputeQuadradicSubdivisions(scale, p1, cp, p2);
@@ -101,17 +147,30 @@ class PathTessellator {
     const Point p2;
     const Scalar weight;
 
+    /// The rational Bernstein form of the curve. None of its terms can be
+    /// factored out of the parameter without changing the result.
+    struct Evaluator {
+      Point p1;
+      Point cp;
+      Point p2;
+      Scalar weight;
+
+      Point Solve(Scalar t) const {
+        Scalar u = 1.0f - t;
+        Scalar coeff_1 = u * u;
+        Scalar coeff_c = 2 * u * t * weight;
+        Scalar coeff_2 = t * t;
+
+        return (p1 * coeff_1 + cp * coeff_c + p2 * coeff_2) /
+               (coeff_1 + coeff_c + coeff_2);
+      }
+    };
+
     Point Last() const { return p2; }
 
-    Point Solve(Scalar t) const {
-      Scalar u = 1.0f - t;
-      Scalar coeff_1 = u * u;
-      Scalar coeff_c = 2 * u * t * weight;
-      Scalar coeff_2 = t * t;
+    Evaluator GetEvaluator() const { return {p1, cp, p2, weight}; }
 
-      return (p1 * coeff_1 + cp * coeff_c + p2 * coeff_2) /
-             (coeff_1 + coeff_c + coeff_2);
-    }
+    Point Solve(Scalar t) const { return GetEvaluator().Solve(t); }
 
     Scalar SubdivisionCount(Scalar scale) const {
       return ComputeConicSubdivisions(scale, p1, cp, p2, weight);
@@ -144,15 +203,28 @@ class PathTessellator {
     const Point cp2;
     const Point p2;
 
+    /// The Bernstein form of the curve with its constant factors applied
+    /// to the control points.
+    struct Evaluator {
+      Point p1;
+      Point cp1_3;  // 3 * cp1
+      Point cp2_3;  // 3 * cp2
+      Point p2;
+
+      Point Solve(Scalar t) const {
+        Scalar u = 1.0f - t;
+        return p1 * u * u * u +     //
+               cp1_3 * u * u * t +  //
+               cp2_3 * u * t * t +  //
+               p2 * t * t * t;
+      }
+    };
+
     Point Last() const { return p2; }
 
-    Point Solve(Scalar t) const {
-      Scalar u = 1.0f - t;
-      return p1 * u * u * u +       //
-             3 * cp1 * u * u * t +  //
-             3 * cp2 * u * t * t +  //
-             p2 * t * t * t;
-    }
+    Evaluator GetEvaluator() const { return {p1, 3 * cp1, 3 * cp2, p2}; }
+
+    Point Solve(Scalar t) const { return GetEvaluator().Solve(t); }
 
     Scalar SubdivisionCount(Scalar scale) const {
       return ComputeCubicSubdivisions(scale, p1, cp1, cp2, p2);
@@ -580,5 +580,101 @@ TEST(PathTessellatorTest, LinearCubicToPointCount) {
   EXPECT_EQ(contours, 1u);
 }
 
+TEST(PathTessellatorTest, SolveBatchMatchesSolve) {
+  PathTessellator::Quad quad{{10, 10}, {50, 90}, {90, 10}};
+  PathTessellator::Conic conic{{10, 10}, {50, 90}, {90, 10}, 0.7f};
+  PathTessellator::Cubic cubic{{10, 10}, {30, 90}, {70, -70}, {90, 10}};
+  Scalar divisions = 37.0f;
+  Point points[40];
+
+  PathTessellator::SolveBatch(quad, 1, 36, divisions, points);
+  for (size_t i = 1; i < 37; i++) {
+    EXPECT_EQ(points[i - 1], quad.Solve(i / divisions)) << i;
+  }
+  PathTessellator::SolveBatch(conic, 1, 36, divisions, points);
+  for (size_t i = 1; i < 37; i++) {
+    EXPECT_EQ(points[i - 1], conic.Solve(i / divisions)) << i;
+  }
+  PathTessellator::SolveBatch(cubic, 1, 36, divisions, points);
+  for (size_t i = 1; i < 37; i++) {
+    EXPECT_EQ(points[i - 1], cubic.Solve(i / divisions)) << i;
+  }
+}
+
+TEST(PathTessellatorTest, SolveMatchesBernsteinFormAtLargeCoordinates) {
+  for (Scalar offset : {0.0f, 1.0e5f, 1.0e7f}) {
+    Point o(offset, -offset);
+    PathTessellator::Quad quad{o + Point(10, 10), o + Point(50, 90),
+                               o + Point(90, 10)};
+    PathTessellator::Conic conic{o + Point(10, 10), o + Point(50, 90),
+                                 o + Point(90, 10), 0.7f};
+    PathTessellator::Cubic cubic{o + Point(10, 10), o + Point(30, 90),
+                                 o + Point(70, -70), o + Point(90, 10)};
+
+    for (int i = 0; i <= 16; i++) {
+      Scalar t = i / 16.0f;
+      Scalar u = 1.0f - t;
+
+      Point quad_point =
+          quad.p1 * u * u + 2 * quad.cp * u * t + quad.p2 * t * t;
+      EXPECT_FLOAT_EQ(quad.Solve(t).x, quad_point.x) << offset << ", " << t;
+      EXPECT_FLOAT_EQ(quad.Solve(t).y, quad_point.y) << offset << ", " << t;
+
+      Scalar weight = 2 * u * t * conic.weight;
+      Point conic_point =
+          (conic.p1 * u * u + conic.cp * weight + conic.p2 * t * t) /
+          (u * u + weight + t * t);
+      EXPECT_FLOAT_EQ(conic.Solve(t).x, conic_point.x) << offset << ", " << t;
+      EXPECT_FLOAT_EQ(conic.Solve(t).y, conic_point.y) << offset << ", " << t;
+
+      Point cubic_point = cubic.p1 * u * u * u + 3 * cubic.cp1 * u * u * t +
+                          3 * cubic.cp2 * u * t * t + cubic.p2 * t * t * t;
+      EXPECT_FLOAT_EQ(cubic.Solve(t).x, cubic_point.x) << offset << ", " << t;
+      EXPECT_FLOAT_EQ(cubic.Solve(t).y, cubic_point.y) << offset << ", " << t;
+    }
+  }
+}
+
+TEST(PathTessellatorTest, LongCurveIsWrittenInBatches) {
+  class BatchVertexWriter : public PathTessellator::VertexWriter {
+   public:
+    void Write(Point point) override { points.push_back(point); }
+    void EndContour() override {}
+    void WriteBatch(const Point* batch, size_t count) override {
+      EXPECT_LE(count, PathTessellator::kCurveBatchSize);
+      batch_count++;
+      points.insert(points.end(), batch, batch + count);
+    }
+
+    std::vector<Point> points;
+    size_t batch_count = 0u;
+  };
+
+  PathTessellator::Cubic cubic{{0, 0}, {0, 1000}, {1000, -1000}, {1000, 0}};
+  flutter::DlPathBuilder builder;
+  builder.MoveTo(cubic.p1);
+  builder.CubicCurveTo(cubic.cp1, cubic.cp2, cubic.p2);
+  flutter::DlPath path = builder.TakePath();
+
+  BatchVertexWriter writer;
+  PathTessellator::PathToFilledVertices(path, writer, 1.0f);
+
+  Scalar divisions = std::ceilf(cubic.SubdivisionCount(1.0f));
+  size_t count = static_cast<size_t>(divisions);
+  ASSERT_GT(count, 2u * PathTessellator::kCurveBatchSize);
+  auto [point_count, contour_count] =
+      PathTessellator::CountFillStorage(path, 1.0f);
+  // The origin, the intermediate points, the end point and the point that
+  // closes the contour.
+  ASSERT_EQ(writer.points.size(), point_count);
+  EXPECT_EQ(writer.points.size(), count + 2u);
+  EXPECT_GE(writer.batch_count, 3u);
+  EXPECT_EQ(writer.points[0], cubic.p1);
+  for (size_t i = 1; i < count; i++) {
+    EXPECT_EQ(writer.points[i], cubic.Solve(i / divisions)) << i;
+  }
+  EXPECT_EQ(writer.points[count], cubic.p2);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -3,9 +3,15 @@
 // found in the LICENSE file.
 
 #include "impeller/tessellator/tessellator.h"
+#include <array>
 #include <cstdint>
 #include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 
+#include "flutter/fml/hash_combine.h"
+#include "flutter/impeller/base/thread.h"
 #include "flutter/impeller/core/device_buffer.h"
 #include "flutter/impeller/tessellator/path_tessellator.h"
 
@@ -174,6 +180,15 @@ class FanPathVertexWriter : public impeller::PathTessellator::VertexWriter {
     point_buffer_[count_++] = point;
   }
 
+  void WriteBatch(const impeller::Point* points, size_t count) override {
+    for (size_t i = 0; i < count; i++) {
+      index_buffer_[index_count_ + i] = count_ + i;
+    }
+    std::memcpy(point_buffer_ + count_, points, count * sizeof(points[0]));
+    index_count_ += count;
+    count_ += count;
+  }
+
  private:
   size_t count_ = 0;
   size_t index_count_ = 0;
@@ -226,6 +241,11 @@ class StripPathVertexWriter : public impeller::PathTessellator::VertexWriter {
     point_buffer_[count_++] = point;
   }
 
+  void WriteBatch(const impeller::Point* points, size_t count) override {
+    std::memcpy(point_buffer_ + count_, points, count * sizeof(points[0]));
+    count_ += count;
+  }
+
  private:
   size_t count_ = 0;
   size_t index_count_ = 0;
@@ -296,6 +316,10 @@ class GLESPathVertexWriter : public impeller::PathTessellator::VertexWriter {
 
   void Write(impeller::Point point) override { points_.push_back(point); }
 
+  void WriteBatch(const impeller::Point* points, size_t count) override {
+    points_.insert(points_.end(), points, points + count);
+  }
+
  private:
   bool previous_contour_odd_points_ = false;
   size_t contour_start_ = 0u;
@@ -447,29 +471,140 @@ void Tessellator::TessellateConvexInternal(const PathSource& path,
 Tessellator::Trigs::Trigs(Scalar pixel_radius)
     : Tessellator::Trigs(ComputeQuadrantDivisions(pixel_radius)) {}
 
-void Tessellator::Trigs::init(size_t divisions) {
-  if (!trigs_.empty()) {
-    return;
-  }
-
-  // Either not cached yet, or we are using the temp storage...
-  trigs_.reserve(divisions + 1);
+void Tessellator::Trigs::init(std::vector<Trig>& trigs, size_t divisions) {
+  FML_DCHECK(trigs.empty());
+  trigs.reserve(divisions + 1);
 
   double angle_scale = kPiOver2 / divisions;
 
-  trigs_.emplace_back(1.0, 0.0);
+  trigs.emplace_back(1.0, 0.0);
   for (size_t i = 1; i < divisions; i++) {
-    trigs_.emplace_back(Radians(i * angle_scale));
+    trigs.emplace_back(Radians(i * angle_scale));
   }
-  trigs_.emplace_back(0.0, 1.0);
+  trigs.emplace_back(0.0, 1.0);
+}
+
+const std::vector<Trig>& Tessellator::GetCachedTrigs(size_t divisions) {
+  FML_DCHECK(divisions >= 1 && divisions < kCachedTrigCount);
+  // Each vector is filled exactly once, by whichever thread needs it first,
+  // and is only read from then on.
+  struct CachedTrigs {
+    std::array<std::once_flag, kCachedTrigCount> once_flags;
+    std::array<std::vector<Trig>, kCachedTrigCount> trigs;
+  };
+  static CachedTrigs* cached_trigs = new CachedTrigs();
+
+  std::call_once(cached_trigs->once_flags[divisions], [divisions]() {
+    Trigs::init(cached_trigs->trigs[divisions], divisions);
+  });
+  return cached_trigs->trigs[divisions];
 }
 
 Tessellator::Trigs Tessellator::GetTrigsForDivisions(size_t divisions) {
   return divisions < Tessellator::kCachedTrigCount
-             ? Trigs(precomputed_trigs_[divisions], divisions)
+             ? Trigs(GetCachedTrigs(divisions))
              : Trigs(divisions);
 }
 
+namespace {
+
+// The vertices of the circles and rings around the origin that were most
+// recently requested from |Tessellator::GetCircleVertices|, shared by all of
+// the threads in the process.
+class CircleVertexCache {
+ public:
+  struct Key {
+    size_t divisions = 0u;
+    Scalar radius = 0.0f;
+    Scalar half_width = 0.0f;
+
+    bool operator==(const Key& other) const = default;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        return fml::HashCombine(key.divisions, key.radius, key.half_width);
+      }
+    };
+  };
+
+  using Vertices = std::shared_ptr<const std::vector<Point>>;
+
+  Vertices Find(const Key& key) {
+    Lock lock(mutex_);
+    auto it = entries_by_key_.find(key);
+    if (it == entries_by_key_.end()) {
+      return nullptr;
+    }
+    entries_.splice(entries_.end(), entries_, it->second);
+    return it->second->vertices;
+  }
+
+  // Returns the vertices that are retained for the key, which are the given
+  // ones unless another thread stored the same circle in the meantime.
+  Vertices Store(const Key& key, Vertices vertices) {
+    Lock lock(mutex_);
+    auto it = entries_by_key_.find(key);
+    if (it != entries_by_key_.end()) {
+      return it->second->vertices;
+    }
+    if (entries_.size() >= Tessellator::kMaxCachedCircleCount) {
+      entries_by_key_.erase(entries_.front().key);
+      entries_.pop_front();
+    }
+    entries_.push_back(Entry{.key = key, .vertices = vertices});
+    entries_by_key_[key] = std::prev(entries_.end());
+    return vertices;
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    Vertices vertices;
+  };
+
+  Mutex mutex_;
+  // Ordered from the least to the most recently used.
+  std::list<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash>
+      entries_by_key_ IPLR_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+std::shared_ptr<const std::vector<Point>> Tessellator::GetCircleVertices(
+    const Matrix& view_transform,
+    Scalar radius,
+    Scalar half_width) {
+  // The generator is cheap to create, since it shares the cached trigs, and
+  // it knows how many divisions the circle needs.
+  EllipticalVertexGenerator generator =
+      StrokedCircle(view_transform, {}, radius, half_width);
+  auto generate_vertices = [&generator]() {
+    auto vertices = std::make_shared<std::vector<Point>>();
+    vertices->reserve(generator.GetVertexCount());
+    generator.GenerateVertices([&vertices](const Point& p) {  //
+      vertices->push_back(p);
+    });
+    return vertices;
+  };
+
+  size_t divisions = generator.trigs_.GetSteps();
+  if (divisions >= kCachedTrigCount) {
+    return generate_vertices();
+  }
+
+  static CircleVertexCache* cache = new CircleVertexCache();
+  CircleVertexCache::Key key{
+      .divisions = divisions,
+      .radius = radius,
+      .half_width = half_width > 0 ? half_width : -1.0f,
+  };
+  if (CircleVertexCache::Vertices vertices = cache->Find(key)) {
+    return vertices;
+  }
+  return cache->Store(key, generate_vertices());
+}
+
 using TessellatedVertexProc = Tessellator::TessellatedVertexProc;
 using EllipticalVertexGenerator = Tessellator::EllipticalVertexGenerator;
 using ArcVertexGenerator = Tessellator::ArcVertexGenerator;
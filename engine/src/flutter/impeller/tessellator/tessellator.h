@@ -38,8 +38,9 @@ class Tessellator {
  public:
   /// Essentially just a vector of Trig objects, but supports storing a
   /// reference to either a cached vector or a locally generated vector.
-  /// The constructor will fill the vector with quarter circular samples
-  /// for the indicated number of equal divisions if the vector is new.
+  /// The cached vectors are shared by all of the tessellators in the process
+  /// and are never modified once they are filled with quarter circular
+  /// samples for their number of equal divisions.
   ///
   /// A given instance of Trigs will always contain at least 2 entries
   /// which is the minimum number of samples to traverse a quarter circle
@@ -51,8 +52,12 @@ class Tessellator {
 
     // Utility forwards of the indicated vector methods.
     size_t inline size() const { return trigs_.size(); }
-    std::vector<Trig>::iterator inline begin() const { return trigs_.begin(); }
-    std::vector<Trig>::iterator inline end() const { return trigs_.end(); }
+    std::vector<Trig>::const_iterator inline begin() const {
+      return trigs_.begin();
+    }
+    std::vector<Trig>::const_iterator inline end() const {
+      return trigs_.end();
+    }
     const inline Trig& operator[](size_t index) const { return trigs_[index]; }
 
     size_t inline GetSteps() const { return trigs_.size() - 1u; }
@@ -60,17 +65,15 @@ class Tessellator {
    private:
     friend class Tessellator;
 
-    explicit Trigs(std::vector<Trig>& trigs, size_t divisions) : trigs_(trigs) {
-      FML_DCHECK(divisions >= 1);
-      init(divisions);
-      FML_DCHECK(trigs_.size() == divisions + 1);
+    explicit Trigs(const std::vector<Trig>& trigs) : trigs_(trigs) {
+      FML_DCHECK(trigs_.size() >= 2u);
     }
 
     explicit Trigs(size_t divisions)
         : local_storage_(std::make_unique<std::vector<Trig>>()),
           trigs_(*local_storage_) {
       FML_DCHECK(divisions >= 1);
-      init(divisions);
+      init(*local_storage_, divisions);
       FML_DCHECK(trigs_.size() == divisions + 1);
     }
 
@@ -79,11 +82,11 @@ class Tessellator {
 
     // Whether or not a cached vector or the local storage is used, this
     // this reference will always be valid
-    std::vector<Trig>& trigs_;
+    const std::vector<Trig>& trigs_;
 
-    // Fill the vector with the indicated number of equal divisions of
-    // trigonometric values if it is empty.
-    void init(size_t divisions);
+    // Fill the empty vector with the indicated number of equal divisions of
+    // trigonometric values.
+    static void init(std::vector<Trig>& trigs, size_t divisions);
   };
 
   enum class Result {
@@ -384,6 +387,26 @@ class Tessellator {
                                             const Rect& bounds,
                                             const Size& radii);
 
+  /// @brief   Return the vertices of the circle or ring that |StrokedCircle|
+  ///          generates for the given radius and half_width around the
+  ///          origin, which only need to be offset by the center of a circle.
+  ///
+  ///          The vertices are retained in a cache that is shared by all of
+  ///          the tessellators in the process and can be used from any
+  ///          thread, so that the many dots and rings of the same size that
+  ///          are drawn in a frame, or in consecutive frames, are only
+  ///          generated once. The least recently used vertices are dropped
+  ///          once |kMaxCachedCircleCount| circles are retained, and circles
+  ///          that need too many divisions are generated on every call.
+  std::shared_ptr<const std::vector<Point>> GetCircleVertices(
+      const Matrix& view_transform,
+      Scalar radius,
+      Scalar half_width);
+
+  /// The maximum number of circles whose vertices are retained by
+  /// |GetCircleVertices|.
+  static constexpr size_t kMaxCachedCircleCount = 256u;
+
   /// Retrieve a pre-allocated arena of kPointArenaSize points.
   std::vector<Point>& GetStrokePointCache();
 
@@ -411,13 +434,15 @@ class Tessellator {
   /// Used for stroke path generation.
   std::vector<Point> stroke_points_;
 
-  // Data for various Circle/EllipseGenerator classes, cached per
-  // Tessellator instance which is usually the foreground life of an app
-  // if not longer.
+  // Data for various Circle/EllipseGenerator classes, cached for the life
+  // of the process and shared by all Tessellator instances.
   static constexpr size_t kCachedTrigCount = 300;
-  std::vector<Trig> precomputed_trigs_[kCachedTrigCount];
 
-  Trigs GetTrigsForDivisions(size_t divisions);
+  // Returns the shared trigs for a division count below |kCachedTrigCount|,
+  // computing them if this is the first time that they are needed.
+  static const std::vector<Trig>& GetCachedTrigs(size_t divisions);
+
+  static Trigs GetTrigsForDivisions(size_t divisions);
 
   static void GenerateFilledCircle(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
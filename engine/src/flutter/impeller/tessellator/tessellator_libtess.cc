@@ -67,6 +67,10 @@ class Polyline : public impeller::PathTessellator::VertexWriter {
 
   void Write(Point point) override { points.emplace_back(point); }
 
+  void WriteBatch(const Point* batch, size_t count) override {
+    points.insert(points.end(), batch, batch + count);
+  }
+
   void EndContour() override {
     size_t contour_end = points.size();
     contours.push_back({contour_start_, contour_end});
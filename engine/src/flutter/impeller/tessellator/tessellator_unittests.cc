@@ -5,6 +5,8 @@
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 
+#include <thread>
+
 #include "flutter/display_list/geometry/dl_path_builder.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/geometry_asserts.h"
@@ -303,6 +305,80 @@ TEST(TessellatorTest, StrokedCircleTessellationVertices) {
   test(Matrix::MakeScale({0.002, 0.002, 0.0}), {}, 1000.0, 10.0);
 }
 
+TEST(TessellatorTest, TrigsAreSharedByAllTessellators) {
+  Tessellator tessellator1;
+  Tessellator tessellator2;
+
+  auto trigs1 = tessellator1.GetTrigsForDeviceRadius(100);
+  auto trigs2 = tessellator2.GetTrigsForDeviceRadius(100);
+  ASSERT_EQ(trigs1.size(), trigs2.size());
+  EXPECT_EQ(&trigs1[0], &trigs2[0]);
+}
+
+TEST(TessellatorTest, CircleVerticesMatchGeneratedVertices) {
+  Tessellator tessellator;
+
+  auto test = [&tessellator](const Matrix& transform, Scalar radius,
+                             Scalar half_width) {
+    auto generator =
+        tessellator.StrokedCircle(transform, {}, radius, half_width);
+    auto expected = std::vector<Point>();
+    generator.GenerateVertices([&expected](const Point& p) {  //
+      expected.push_back(p);
+    });
+
+    auto vertices =
+        tessellator.GetCircleVertices(transform, radius, half_width);
+    ASSERT_NE(vertices, nullptr);
+    EXPECT_EQ(*vertices, expected)
+        << "radius = " << radius << ", half_width = " << half_width;
+  };
+
+  test({}, 2.0, 0.0);
+  test({}, 2.0, 1.0);
+  test({}, 2.0, 3.0);
+  test(Matrix::MakeScale({500.0, 500.0, 0.0}), 2.0, 1.0);
+  test(Matrix::MakeScale({0.002, 0.002, 0.0}), 1000.0, 10.0);
+  // Too many divisions to be retained.
+  test(Matrix::MakeScale({1000.0, 1000.0, 0.0}), 1000.0, 0.0);
+}
+
+TEST(TessellatorTest, CircleVerticesAreRetainedAcrossTessellators) {
+  Tessellator tessellator1;
+  Tessellator tessellator2;
+
+  auto filled = tessellator1.GetCircleVertices({}, 7.0, 0.0);
+  EXPECT_EQ(tessellator2.GetCircleVertices({}, 7.0, 0.0), filled);
+  EXPECT_EQ(tessellator2.GetCircleVertices({}, 7.0, -1.0), filled);
+
+  auto stroked = tessellator1.GetCircleVertices({}, 7.0, 1.0);
+  EXPECT_NE(stroked, filled);
+  EXPECT_EQ(tessellator2.GetCircleVertices({}, 7.0, 1.0), stroked);
+
+  EXPECT_NE(tessellator2.GetCircleVertices({}, 7.5, 0.0), filled);
+}
+
+TEST(TessellatorTest, CircleVerticesCanBeRequestedFromManyThreads) {
+  auto expected = Tessellator().GetCircleVertices({}, 20.0, 2.0);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&expected]() {
+      Tessellator tessellator;
+      for (int j = 0; j < 1000; j++) {
+        Scalar radius = 1.0f + (j % 100);
+        auto vertices = tessellator.GetCircleVertices({}, radius, 2.0);
+        ASSERT_NE(vertices, nullptr);
+        EXPECT_FALSE(vertices->empty());
+      }
+      EXPECT_EQ(*tessellator.GetCircleVertices({}, 20.0, 2.0), *expected);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
 TEST(TessellatorTest, FilledArcStripTessellationVertices) {
   Tessellator tessellator;
 
@@ -2123,6 +2123,14 @@ enum _FrameTimingInfo {
 
   /// The frame number of the frame.
   frameNumber,
+
+  /// The number of frames waiting to be rasterized when the build of the
+  /// frame finished, not counting the frame itself.
+  queuedFramesAtBuildFinish,
+
+  /// The number of frames waiting to be rasterized when the rasterization of
+  /// the frame started.
+  queuedFramesAtRasterStart,
 }
 
 /// Time-related performance metrics of a frame.
@@ -2157,6 +2165,8 @@ class FrameTiming {
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
     int frameNumber = -1,
+    int queuedFramesAtBuildFinish = 0,
+    int queuedFramesAtRasterStart = 0,
   }) {
     return FrameTiming._(<int>[
       vsyncStart,
@@ -2170,6 +2180,8 @@ class FrameTiming {
       pictureCacheCount,
       pictureCacheBytes,
       frameNumber,
+      queuedFramesAtBuildFinish,
+      queuedFramesAtRasterStart,
     ]);
   }
 
@@ -2264,7 +2276,22 @@ class FrameTiming {
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
   /// The frame key associated with this frame measurement.
-  int get frameNumber => _data.last;
+  int get frameNumber => _rawInfo(_FrameTimingInfo.frameNumber);
+
+  /// The number of frames that were waiting to be rasterized when the build
+  /// of this frame finished, not counting this frame.
+  ///
+  /// This is only above zero when the engine is configured to let the UI
+  /// thread run more than one frame ahead of the raster thread.
+  ///
+  /// See also [queuedFramesAtRasterStart].
+  int get queuedFramesAtBuildFinish => _rawInfo(_FrameTimingInfo.queuedFramesAtBuildFinish);
+
+  /// The number of frames that were waiting to be rasterized when the
+  /// rasterization of this frame started.
+  ///
+  /// See also [queuedFramesAtBuildFinish].
+  int get queuedFramesAtRasterStart => _rawInfo(_FrameTimingInfo.queuedFramesAtRasterStart);
 
   final List<int> _data; // some elements in microseconds, some in bytes, some are counts
 
@@ -2280,7 +2307,9 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
-        'frameNumber: ${_data.last})';
+        'frameNumber: $frameNumber, '
+        'queuedFramesAtBuildFinish: $queuedFramesAtBuildFinish, '
+        'queuedFramesAtRasterStart: $queuedFramesAtRasterStart)';
   }
 }
 
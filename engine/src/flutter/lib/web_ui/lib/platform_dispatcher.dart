@@ -230,6 +230,8 @@ enum _FrameTimingInfo {
   pictureCacheCount,
   pictureCacheBytes,
   frameNumber,
+  queuedFramesAtBuildFinish,
+  queuedFramesAtRasterStart,
 }
 
 class FrameTiming {
@@ -245,6 +247,8 @@ class FrameTiming {
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
     int frameNumber = 1,
+    int queuedFramesAtBuildFinish = 0,
+    int queuedFramesAtRasterStart = 0,
   }) {
     return FrameTiming._(<int>[
       vsyncStart,
@@ -258,6 +262,8 @@ class FrameTiming {
       pictureCacheCount,
       pictureCacheBytes,
       frameNumber,
+      queuedFramesAtBuildFinish,
+      queuedFramesAtRasterStart,
     ]);
   }
 
@@ -295,7 +301,11 @@ class FrameTiming {
 
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
-  int get frameNumber => _data.last;
+  int get frameNumber => _rawInfo(_FrameTimingInfo.frameNumber);
+
+  int get queuedFramesAtBuildFinish => _rawInfo(_FrameTimingInfo.queuedFramesAtBuildFinish);
+
+  int get queuedFramesAtRasterStart => _rawInfo(_FrameTimingInfo.queuedFramesAtRasterStart);
 
   final List<int> _data; // some elements in microseconds, some in bytes, some are counts
 
@@ -311,7 +321,9 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
-        'frameNumber: ${_data.last})';
+        'frameNumber: $frameNumber, '
+        'queuedFramesAtBuildFinish: $queuedFramesAtBuildFinish, '
+        'queuedFramesAtRasterStart: $queuedFramesAtRasterStart)';
   }
 }
 
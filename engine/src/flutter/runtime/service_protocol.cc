@@ -41,6 +41,11 @@ const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
 const std::string_view ServiceProtocol::kGetPipelineUsageExtensionName =
     "_flutter.getPipelineUsage";
+const std::string_view
+    ServiceProtocol::kGetFrameTimingStatisticsExtensionName =
+        "_flutter.getFrameTimingStatistics";
+const std::string_view ServiceProtocol::kProfileDisplayListOpsExtensionName =
+    "_flutter.profileDisplayListOps";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -62,6 +67,8 @@ ServiceProtocol::ServiceProtocol()
           kEstimateRasterCacheMemoryExtensionName,
           kReloadAssetFonts,
           kGetPipelineUsageExtensionName,
+          kGetFrameTimingStatisticsExtensionName,
+          kProfileDisplayListOpsExtensionName,
       }) {}
 
 ServiceProtocol::~ServiceProtocol() {
@@ -30,6 +30,8 @@ class ServiceProtocol {
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kReloadAssetFonts;
   static const std::string_view kGetPipelineUsageExtensionName;
+  static const std::string_view kGetFrameTimingStatisticsExtensionName;
+  static const std::string_view kProfileDisplayListOpsExtensionName;
 
   class Handler {
    public:
@@ -20,28 +20,52 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// The interval between the synthesized vsyncs of frames that do not wait for
+// vsync.
+constexpr fml::TimeDelta kThroughputFrameInterval =
+    fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+
+size_t GetDefaultPipelineDepth(const TaskRunners& task_runners) {
+#if SHELL_ENABLE_METAL
+  return 2;
+#else   // SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and set the pipeline depth
+  // back to 2 in this case. See
+  // https://github.com/flutter/engine/pull/9132 for discussion.
+  return task_runners.GetPlatformTaskRunner() ==
+                 task_runners.GetRasterTaskRunner()
+             ? 1
+             : 2;
+#endif  // SHELL_ENABLE_METAL
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   size_t pipeline_depth,
+                   bool throughput_pacing)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
-#if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<FramePipeline>(2)),
-#else   // SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
       layer_tree_pipeline_(std::make_shared<FramePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
-#endif  // SHELL_ENABLE_METAL
+          pipeline_depth > 0 ? pipeline_depth
+                             : GetDefaultPipelineDepth(task_runners))),
       pending_frame_semaphore_(1),
+      throughput_pacing_(throughput_pacing),
       weak_factory_(this) {
+  if (throughput_pacing_) {
+    layer_tree_pipeline_->SetConsumedCallback(
+        [ui_task_runner = task_runners_.GetUITaskRunner(),
+         self = weak_factory_.GetWeakPtr()]() {
+          ui_task_runner->PostTask([self]() {
+            if (self) {
+              self->OnPipelineConsumed();
+            }
+          });
+        });
+  }
 }
 
 Animator::~Animator() = default;
@@ -103,6 +127,12 @@ void Animator::BeginFrame(
       // full because the consumer is being too slow. Try again at the next
       // frame interval.
       TRACE_EVENT0("flutter", "PipelineFull");
+      if (throughput_pacing_) {
+        // Without vsync, the next frame interval begins right away, so wait
+        // for the consumer to make room instead.
+        waiting_for_pipeline_ = true;
+        return;
+      }
       RequestFrame();
       return;
     }
@@ -113,6 +143,9 @@ void Animator::BeginFrame(
   FML_DCHECK(producer_continuation_);
   const fml::TimePoint frame_target_time =
       frame_timings_recorder_->GetVsyncTargetTime();
+  if (throughput_pacing_) {
+    throughput_frame_time_ = frame_target_time;
+  }
   dart_frame_deadline_ = frame_target_time.ToEpochDelta();
   uint64_t frame_number = frame_timings_recorder_->GetFrameNumber();
   delegate_.OnAnimatorBeginFrame(frame_target_time, frame_number);
@@ -139,6 +172,8 @@ void Animator::EndFrame() {
       layer_tree_task_list.push_back(std::move(layer_tree_task));
     }
     layer_trees_tasks_.clear();
+    frame_timings_recorder_->RecordQueuedFramesAtBuildFinish(
+        layer_tree_pipeline_->GetQueueDepth());
     PipelineProduceResult result = producer_continuation_.Complete(
         std::make_unique<FrameItem>(std::move(layer_tree_task_list),
                                     std::move(frame_timings_recorder_)));
@@ -233,6 +268,9 @@ void Animator::DrawLastLayerTrees(
   const auto now = fml::TimePoint::Now();
   frame_timings_recorder->RecordBuildStart(now);
   frame_timings_recorder->RecordBuildEnd(now);
+  if (throughput_pacing_) {
+    throughput_frame_time_ = frame_timings_recorder->GetVsyncTargetTime();
+  }
   delegate_.OnAnimatorDrawLastLayerTrees(std::move(frame_timings_recorder));
 }
 
@@ -271,23 +309,53 @@ void Animator::RequestFrame(bool regenerate_layer_trees) {
 }
 
 void Animator::AwaitVSync() {
-  waiter_->AsyncWaitForVsync(
-      [self = weak_factory_.GetWeakPtr()](
-          std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
-        if (self) {
-          if (self->CanReuseLastLayerTrees()) {
-            self->DrawLastLayerTrees(std::move(frame_timings_recorder));
-          } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
-            self->EndFrame();
+  auto callback = [self = weak_factory_.GetWeakPtr()](
+                      std::unique_ptr<FrameTimingsRecorder>
+                          frame_timings_recorder) {
+    if (self) {
+      if (self->CanReuseLastLayerTrees()) {
+        self->DrawLastLayerTrees(std::move(frame_timings_recorder));
+      } else {
+        self->BeginFrame(std::move(frame_timings_recorder));
+        self->EndFrame();
+      }
+    }
+  };
+  if (throughput_pacing_) {
+    // Begin the frame right away, with a synthesized vsync. The vsyncs follow
+    // a clock of their own, so that the frames are timed as if they were
+    // shown at a steady frame rate however fast they are produced.
+    task_runners_.GetUITaskRunner()->PostTask(
+        [callback, self = weak_factory_.GetWeakPtr()]() {
+          if (!self) {
+            return;
           }
-        }
-      });
+          TRACE_EVENT0("flutter", "Animator::ThroughputVSync");
+          if (self->throughput_frame_time_ == fml::TimePoint()) {
+            self->throughput_frame_time_ = fml::TimePoint::Now();
+          }
+          const fml::TimePoint vsync_start = self->throughput_frame_time_;
+          auto frame_timings_recorder =
+              std::make_unique<FrameTimingsRecorder>();
+          frame_timings_recorder->RecordVsync(
+              vsync_start, vsync_start + kThroughputFrameInterval);
+          callback(std::move(frame_timings_recorder));
+        });
+  } else {
+    waiter_->AsyncWaitForVsync(callback);
+  }
   if (has_rendered_) {
     delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
   }
 }
 
+void Animator::OnPipelineConsumed() {
+  if (waiting_for_pipeline_) {
+    waiting_for_pipeline_ = false;
+    RequestFrame();
+  }
+}
+
 void Animator::OnAllViewsRendered() {
   if (!layer_trees_tasks_.empty()) {
     EndFrame();
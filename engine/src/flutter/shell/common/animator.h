@@ -45,9 +45,25 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief    Creates an animator that produces at most |pipeline_depth|
+  ///           frames ahead of the rasterizer, or a platform dependent
+  ///           number of frames if |pipeline_depth| is 0.
+  ///
+  ///           If |throughput_pacing| is true, the animator does not wait
+  ///           for vsync and begins a new frame as soon as the pipeline has
+  ///           room for it, which renders frames as fast as the UI and
+  ///           raster threads can produce them. This is meant for rendering
+  ///           that is not shown on a display, such as rendering a video.
+  ///           The vsync of each frame is then synthesized one 60hz frame
+  ///           interval after the vsync of the previous frame, whatever the
+  ///           time it takes to produce it.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           size_t pipeline_depth = 0,
+           bool throughput_pacing = false);
 
   ~Animator();
 
@@ -128,6 +144,10 @@ class Animator final {
 
   void AwaitVSync();
 
+  // Called on the UI thread after the rasterizer consumed a frame, in the
+  // throughput pacing mode.
+  void OnPipelineConsumed();
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
@@ -147,6 +167,13 @@ class Animator final {
   bool frame_scheduled_ = false;
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  const bool throughput_pacing_;
+  // Whether a frame could not begin because the pipeline was full, and
+  // should begin once the rasterizer consumes a frame.
+  bool waiting_for_pipeline_ = false;
+  // The start time of the next synthesized vsync in the throughput pacing
+  // mode, which advances by one frame interval with each produced frame.
+  fml::TimePoint throughput_frame_time_;
 
   fml::TaskRunnerAffineWeakPtrFactory<Animator> weak_factory_;
 
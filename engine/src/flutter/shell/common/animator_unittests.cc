@@ -6,9 +6,12 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -261,6 +264,63 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+TEST_F(ShellTest, AnimatorThroughputPacingAdvancesByFrameInterval) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  auto clock = std::make_shared<ShellTestVsyncClock>();
+  std::shared_ptr<Animator> animator;
+
+  // Create the animator on the UI task runner. The pipeline has room for all
+  // the frames, as nothing consumes them.
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<ShellTestVsyncWaiter>(task_runners, clock));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter),
+                                          /*pipeline_depth=*/3,
+                                          /*throughput_pacing=*/true);
+  });
+
+  EXPECT_CALL(delegate, OnAnimatorUpdateLatestFrameTargetTime)
+      .Times(::testing::AnyNumber());
+  EXPECT_CALL(delegate, OnAnimatorDraw).Times(::testing::AnyNumber());
+
+  std::vector<fml::TimePoint> target_times;
+  fml::AutoResetWaitableEvent begin_frame_latch;
+  for (int i = 0; i < 3; i++) {
+    task_runners.GetUITaskRunner()->PostTask([&] {
+      EXPECT_CALL(delegate, OnAnimatorBeginFrame)
+          .WillOnce([&](fml::TimePoint frame_target_time,
+                        uint64_t frame_number) {
+            target_times.push_back(frame_target_time);
+            auto layer_tree =
+                std::make_unique<LayerTree>(nullptr, DlISize(600, 800));
+            animator->Render(kImplicitViewId, std::move(layer_tree), 1.0);
+            begin_frame_latch.Signal();
+          });
+      animator->RequestFrame();
+    });
+    begin_frame_latch.Wait();
+    // The time it takes to produce a frame does not affect the next one.
+    std::this_thread::sleep_for(std::chrono::milliseconds(i * 5));
+  }
+
+  ASSERT_EQ(target_times.size(), 3u);
+  const fml::TimeDelta frame_interval =
+      fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+  EXPECT_EQ(target_times[1] - target_times[0], frame_interval);
+  EXPECT_EQ(target_times[2] - target_times[1], frame_interval);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 
@@ -135,6 +136,21 @@ class Pipeline {
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// The number of resources that were produced and are waiting to be
+  /// consumed.
+  size_t GetQueueDepth() {
+    std::scoped_lock lock(queue_mutex_);
+    return queue_.size();
+  }
+
+  /// Sets a callback that the consumer thread calls after every resource
+  /// that it consumes, when there is room to produce another resource.
+  ///
+  /// This must be set before any resource is consumed.
+  void SetConsumedCallback(std::function<void()> callback) {
+    consumed_callback_ = std::move(callback);
+  }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
@@ -208,6 +224,10 @@ class Pipeline {
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
     TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
 
+    if (consumed_callback_) {
+      consumed_callback_();
+    }
+
     return items_count > 0 ? PipelineConsumeResult::MoreAvailable
                            : PipelineConsumeResult::Done;
   }
@@ -218,6 +238,7 @@ class Pipeline {
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
+  std::function<void()> consumed_callback_;
 
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
@@ -107,6 +107,32 @@ TEST(PipelineTest, PushingMultiProcessesInOrder) {
   ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ReportsQueueDepthAndConsumedResources) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  int consumed_count = 0;
+  pipeline->SetConsumedCallback([&consumed_count]() { consumed_count++; });
+
+  for (int i = 0; i < depth; i++) {
+    Continuation continuation = pipeline->Produce();
+    ASSERT_EQ(pipeline->GetQueueDepth(), static_cast<size_t>(i));
+    ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i)).success);
+  }
+  ASSERT_EQ(pipeline->GetQueueDepth(), 3u);
+  ASSERT_FALSE(pipeline->Produce());
+
+  size_t depth_while_consuming = 0;
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([&](std::unique_ptr<int> v) {
+        depth_while_consuming = pipeline->GetQueueDepth();
+      });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(depth_while_consuming, 2u);
+  ASSERT_EQ(consumed_count, 1);
+  // The consumed resource made room for another one.
+  ASSERT_TRUE(pipeline->Produce());
+}
+
 TEST(PipelineTest, ProduceIfEmptyDoesNotConsumeWhenQueueIsNotEmpty) {
   const int depth = 2;
   std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
@@ -51,6 +51,23 @@ namespace flutter {
 [[maybe_unused]] static constexpr std::chrono::milliseconds
     kSkiaCleanupExpiration(15000);
 
+#if !SLIMPELLER
+static RasterCachePolicy MakeRasterCachePolicy(const Settings& settings) {
+  RasterCachePolicy policy = {
+      .byte_budget = RasterCacheUtil::kDefaultByteBudget,
+      .eviction_grace_frames = RasterCacheUtil::kDefaultEvictionGraceFrames,
+  };
+  if (settings.raster_cache_max_bytes >= 0) {
+    policy.byte_budget = static_cast<size_t>(settings.raster_cache_max_bytes);
+  }
+  if (settings.raster_cache_eviction_grace_frames >= 0) {
+    policy.eviction_grace_frames =
+        static_cast<size_t>(settings.raster_cache_eviction_grace_frames);
+  }
+  return policy;
+}
+#endif  //  !SLIMPELLER
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -60,6 +77,10 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+#if !SLIMPELLER
+  compositor_context_->raster_cache().SetPolicy(
+      MakeRasterCachePolicy(delegate.GetSettings()));
+#endif  //  !SLIMPELLER
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -255,8 +276,10 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
                  ->RunsTasksOnCurrentThread());
 
   DoDrawResult draw_result;
-  FramePipeline::Consumer consumer = [&draw_result,
+  FramePipeline::Consumer consumer = [&draw_result, &pipeline,
                                       this](std::unique_ptr<FrameItem> item) {
+    item->frame_timings_recorder->RecordQueuedFramesAtRasterStart(
+        pipeline->GetQueueDepth());
     draw_result = DoDraw(std::move(item->frame_timings_recorder),
                          std::move(item->layer_tree_tasks));
   };
@@ -771,10 +794,19 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
       auto existing_damage = frame->framebuffer_info().existing_damage;
       if (existing_damage.has_value() && !force_full_repaint) {
         damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
-        damage->AddAdditionalDamage(existing_damage.value());
+        const auto& existing_damage_rects =
+            frame->framebuffer_info().existing_damage_rects;
+        if (existing_damage_rects.empty()) {
+          damage->AddAdditionalDamage(existing_damage.value());
+        } else {
+          damage->AddAdditionalDamage(existing_damage_rects);
+        }
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
             frame->framebuffer_info().vertical_clip_alignment);
+        damage->SetDamageRectPolicy({
+            .max_rect_count = frame->framebuffer_info().max_damage_rect_count,
+        });
       }
     }
 
@@ -797,6 +829,10 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     if (damage) {
       submit_info.frame_damage = damage->GetFrameDamage();
       submit_info.buffer_damage = damage->GetBufferDamage();
+      if (frame->framebuffer_info().max_damage_rect_count > 1) {
+        submit_info.frame_damage_rects = damage->GetFrameDamageRects();
+        submit_info.buffer_damage_rects = damage->GetBufferDamageRects();
+      }
     }
 
     frame->set_submit_info(submit_info);
@@ -1149,6 +1185,19 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
 #endif  //  !SLIMPELLER
 }
 
+void Rasterizer::SetRasterCacheDefaultMaxBytes(size_t max_bytes) {
+#if !SLIMPELLER
+  if (delegate_.GetSettings().raster_cache_max_bytes >= 0) {
+    // The budget from the settings takes precedence over the default.
+    return;
+  }
+  RasterCache& raster_cache = compositor_context_->raster_cache();
+  RasterCachePolicy policy = raster_cache.policy();
+  policy.byte_budget = max_bytes;
+  raster_cache.SetPolicy(policy);
+#endif  //  !SLIMPELLER
+}
+
 std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
 #if SLIMPELLER
   return std::nullopt;
@@ -550,6 +550,16 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   void SetResourceCacheMaxBytes(size_t max_bytes, bool from_user);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the byte budget of the `RasterCache` for when the
+  ///             settings do not specify one with `raster_cache_max_bytes`.
+  ///             The shell derives this budget from the size of the view.
+  ///
+  /// @param[in]  max_bytes  The maximum byte size of the images held by the
+  ///                        raster cache.
+  ///
+  void SetRasterCacheDefaultMaxBytes(size_t max_bytes);
+
   //----------------------------------------------------------------------------
   /// @brief      The current value of Skia's resource cache size, if a surface
   ///             is present.
@@ -11,6 +11,7 @@
 #include <optional>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -135,6 +136,42 @@ TEST(RasterizerTest, create) {
   EXPECT_TRUE(rasterizer != nullptr);
 }
 
+#if !SLIMPELLER
+TEST(RasterizerTest, RasterCachePolicyDefaultsToViewSizedBudget) {
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  const RasterCachePolicy& policy =
+      rasterizer->compositor_context()->raster_cache().policy();
+  EXPECT_EQ(policy.byte_budget, RasterCacheUtil::kDefaultByteBudget);
+  EXPECT_EQ(policy.eviction_grace_frames,
+            RasterCacheUtil::kDefaultEvictionGraceFrames);
+
+  rasterizer->SetRasterCacheDefaultMaxBytes(
+      RasterCacheUtil::GetDefaultByteBudget(1080, 2400));
+  EXPECT_EQ(policy.byte_budget, 1080u * 2400u * 4u * 12u);
+}
+
+TEST(RasterizerTest, RasterCachePolicyUsesSettings) {
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.raster_cache_max_bytes = 1000000;
+  settings.raster_cache_eviction_grace_frames = 5;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  const RasterCachePolicy& policy =
+      rasterizer->compositor_context()->raster_cache().policy();
+  EXPECT_EQ(policy.byte_budget, 1000000u);
+  EXPECT_EQ(policy.eviction_grace_frames, 5u);
+
+  // The budget of the settings is not replaced by the size of the view.
+  rasterizer->SetRasterCacheDefaultMaxBytes(
+      RasterCacheUtil::GetDefaultByteBudget(1080, 2400));
+  EXPECT_EQ(policy.byte_budget, 1000000u);
+}
+#endif  //  !SLIMPELLER
+
 TEST(RasterizerTest, isAiksContextInitialized) {
   NiceMock<MockDelegate> delegate;
   Settings settings;
@@ -17,12 +17,17 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/dl_storage_pool.h"
+#include "flutter/display_list/utils/dl_op_profiler.h"
+#include "flutter/flow/raster_cache_disk_store.h"
+#include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -200,6 +205,66 @@ bool ValidateViewportMetrics(const ViewportMetrics& metrics) {
   return true;
 }
 
+// How often the frame timing statistics are written to the
+// |Settings::frame_timing_statistics_path| while frames are rasterized.
+constexpr fml::TimeDelta kFrameTimingStatisticsWriteInterval =
+    fml::TimeDelta::FromSeconds(10);
+
+// Adds the frame count and the percentiles of each of the metrics of the
+// |histograms|, in microseconds, to the |object|.
+void AddFrameTimingStatistics(const FrameTimingHistograms& histograms,
+                              rapidjson::Value& object,
+                              rapidjson::Document::AllocatorType& allocator) {
+  object.AddMember<uint64_t>(
+      "frameCount", histograms.Get(FrameTimingHistograms::kTotal).GetCount(),
+      allocator);
+  for (FrameTimingHistograms::Metric metric : FrameTimingHistograms::kMetrics) {
+    const DurationHistogram& histogram = histograms.Get(metric);
+    rapidjson::Value metric_json(rapidjson::kObjectType);
+    for (double percentile : FrameTimingHistograms::kReportedPercentiles) {
+      std::ostringstream name;
+      name << "p" << percentile;
+      rapidjson::Value name_json(name.str().c_str(), allocator);
+      metric_json.AddMember<int64_t>(
+          name_json, histogram.GetPercentile(percentile).ToMicroseconds(),
+          allocator);
+    }
+    metric_json.AddMember<int64_t>("max", histogram.GetMax().ToMicroseconds(),
+                                   allocator);
+    object.AddMember(rapidjson::StringRef(
+                         FrameTimingHistograms::GetMetricName(metric)),
+                     metric_json, allocator);
+  }
+}
+
+// Replaces the file at |path| with the statistics of the |histograms|. The
+// file is written atomically, so that a reader never sees a truncated file.
+void WriteFrameTimingStatisticsFile(const FrameTimingHistograms& histograms,
+                                    const std::string& path) {
+  TRACE_EVENT0("flutter", "Shell::WriteFrameTimingStatistics");
+  rapidjson::Document document;
+  document.SetObject();
+  AddFrameTimingStatistics(histograms, document, document.GetAllocator());
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+
+  std::string directory_path = fml::paths::GetDirectoryName(path);
+  std::string file_name = path.substr(directory_path.size());
+  if (!file_name.empty() && (file_name[0] == '/' || file_name[0] == '\\')) {
+    file_name.erase(0, 1);
+  }
+  fml::UniqueFD directory = fml::OpenDirectory(
+      directory_path.empty() ? "." : directory_path.c_str(), false,
+      fml::FilePermission::kReadWrite);
+  fml::DataMapping mapping(std::string(buffer.GetString(), buffer.GetSize()));
+  if (!directory.is_valid() ||
+      !fml::WriteAtomically(directory, file_name.c_str(), mapping)) {
+    FML_LOG(ERROR) << "Could not write the frame timing statistics to "
+                   << path;
+  }
+}
+
 }  // namespace
 
 std::pair<DartVMRef, fml::RefPtr<const DartSnapshot>>
@@ -413,10 +478,20 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
         const auto& task_runners = shell->GetTaskRunners();
 
+        // DisplayLists recorded on the UI thread reuse the storage of the
+        // DisplayLists of earlier frames once those are released. Shells
+        // that share a UI thread also share its pool.
+        if (!DisplayListStoragePool::GetForCurrentThread()) {
+          DisplayListStoragePool::SetForCurrentThread(
+              DisplayListStoragePool::Create());
+        }
+
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().frame_pipeline_depth,
+            shell->GetSettings().enable_throughput_frame_pacing);
 
         engine_promise.set_value(
             on_create_engine(*shell,                               //
@@ -600,6 +675,16 @@ Shell::Shell(DartVMRef vm,
       {task_runners_.GetIOTaskRunner(),
        std::bind(&Shell::OnServiceProtocolGetPipelineUsage, this,
                  std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingStatisticsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kProfileDisplayListOpsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolProfileDisplayListOps, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -639,6 +724,20 @@ Shell::~Shell() {
           }));
   gpu_latch.Wait();
 
+  // The rasterizer is gone, so the statistics are final. Write them now,
+  // since the last periodic write may be up to
+  // |kFrameTimingStatisticsWriteInterval| old.
+  if (!settings_.frame_timing_statistics_path.empty()) {
+    WriteFrameTimingStatisticsFile(*frame_timing_histograms_,
+                                   settings_.frame_timing_statistics_path);
+  }
+
+  // Spawned shells share the settings, and the profile of the process, so
+  // every shell rewrites the file with everything recorded so far.
+  if (!settings_.display_list_op_profile_path.empty()) {
+    DlOpProfiler::WriteToFile(settings_.display_list_op_profile_path);
+  }
+
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetIOTaskRunner(),
       fml::MakeCopyable([io_manager = std::move(io_manager_),
@@ -747,6 +846,12 @@ void Shell::NotifyLowMemoryWarning() const {
   // running.
   ::Dart_NotifyLowMemory();
 
+  task_runners_.GetUITaskRunner()->PostTask([]() {
+    if (const auto& pool = DisplayListStoragePool::GetForCurrentThread()) {
+      pool->Clear();
+    }
+  });
+
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
         if (rasterizer) {
@@ -913,8 +1018,56 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   if (settings_.purge_persistent_cache) {
     PersistentCache::GetCacheForProcess()->Purge();
   }
+
+  if (settings_.enable_background_raster_cache) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         worker_task_runner = GetConcurrentWorkerTaskRunner(),
+         io_task_runner = task_runners_.GetIOTaskRunner(),
+         io_manager = io_manager_->GetWeakPtr()]() {
+          if (!rasterizer) {
+            return;
+          }
+          // The resource context can be replaced, so it is looked up on the
+          // IO thread for every image.
+          rasterizer->compositor_context()
+              ->raster_cache()
+              .SetBackgroundRasterizer(
+                  worker_task_runner, io_task_runner, [io_manager]() {
+                    return io_manager ? io_manager->GetResourceContext()
+                                      : fml::WeakPtr<GrDirectContext>();
+                  });
+        });
+  }
+
+  if (settings_.raster_cache_disk_size_mb > 0) {
+    fml::UniqueFD directory =
+        PersistentCache::GetCacheForProcess()->OpenRasterCacheDirectory();
+    if (directory.is_valid()) {
+      // The index of the disk store is read here instead of on the raster
+      // thread.
+      auto disk_store = std::make_shared<RasterCacheDiskStore>(
+          std::move(directory),
+          static_cast<size_t>(settings_.raster_cache_disk_size_mb *
+                              kMegaByteSizeInBytes),
+          GetConcurrentWorkerTaskRunner());
+      fml::TaskRunner::RunNowOrPostTask(
+          task_runners_.GetRasterTaskRunner(),
+          [rasterizer = weak_rasterizer_, disk_store]() {
+            if (rasterizer) {
+              rasterizer->compositor_context()->raster_cache().SetDiskStore(
+                  disk_store);
+            }
+          });
+    }
+  }
 #endif  //  !SLIMPELLER
 
+  if (!settings_.display_list_op_profile_path.empty()) {
+    DlOpProfiler::Start();
+  }
+
   return true;
 }
 
@@ -1144,10 +1297,15 @@ void Shell::OnPlatformViewSetViewportMetrics(int64_t view_id,
       metrics.physical_width * metrics.physical_height * 12 * 4;
   size_t resource_cache_max_bytes =
       resource_cache_limit_calculator_->GetResourceCacheMaxBytes();
+  size_t raster_cache_max_bytes = RasterCacheUtil::GetDefaultByteBudget(
+      static_cast<int64_t>(metrics.physical_width),
+      static_cast<int64_t>(metrics.physical_height));
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), resource_cache_max_bytes] {
+      [rasterizer = rasterizer_->GetWeakPtr(), resource_cache_max_bytes,
+       raster_cache_max_bytes] {
         if (rasterizer) {
           rasterizer->SetResourceCacheMaxBytes(resource_cache_max_bytes, false);
+          rasterizer->SetRasterCacheDefaultMaxBytes(raster_cache_max_bytes);
         }
       });
 
@@ -1737,6 +1895,16 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
 
+  frame_timing_histograms_->Record(timing);
+  if (!settings_.frame_timing_statistics_path.empty()) {
+    fml::TimePoint now = fml::TimePoint::Now();
+    if (now - frame_timing_statistics_write_time_ >=
+        kFrameTimingStatisticsWriteInterval) {
+      frame_timing_statistics_write_time_ = now;
+      WriteFrameTimingStatistics();
+    }
+  }
+
   // The C++ callback defined in settings.h and set by Flutter runner. This is
   // independent of the timings report to the Dart side.
   if (settings_.frame_rasterized_callback) {
@@ -1758,6 +1926,8 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
   unreported_timings_.push_back(timing.GetFrameNumber());
+  unreported_timings_.push_back(timing.GetQueuedFramesAtBuildFinish());
+  unreported_timings_.push_back(timing.GetQueuedFramesAtRasterStart());
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
 
@@ -2205,6 +2375,80 @@ bool Shell::OnServiceProtocolGetPipelineUsage(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFrameTimingStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  response->SetObject();
+  response->AddMember("type", "FrameTimingStatistics",
+                      response->GetAllocator());
+  AddFrameTimingStatistics(*frame_timing_histograms_, *response,
+                           response->GetAllocator());
+
+  auto reset = params.find("reset");
+  if (reset != params.end() && reset->second == "true") {
+    frame_timing_histograms_->Reset();
+  }
+  return true;
+}
+
+bool Shell::OnServiceProtocolProfileDisplayListOps(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  auto enable = params.find("enable");
+  if (enable != params.end()) {
+    if (enable->second == "true") {
+      DlOpProfiler::Start();
+    } else if (enable->second == "false") {
+      DlOpProfiler::Stop();
+    } else {
+      ServiceProtocolParameterError(
+          response, "'enable' must be either 'true' or 'false'.");
+      return false;
+    }
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "DisplayListOpProfile", allocator);
+  response->AddMember("enabled", DlOpProfiler::IsEnabled(), allocator);
+  rapidjson::Value op_types(rapidjson::kArrayType);
+  for (const DlOpProfiler::OpTypeStats& stats :
+       DlOpProfiler::GetOpTypeStats()) {
+    rapidjson::Value op_type(rapidjson::kObjectType);
+    op_type.AddMember(
+        "name", rapidjson::StringRef(DlOpProfiler::GetOpTypeName(stats.type)),
+        allocator);
+    op_type.AddMember("count", stats.count, allocator);
+    op_type.AddMember("selfMicros", stats.self_ns / 1000u, allocator);
+    op_types.PushBack(op_type, allocator);
+  }
+  response->AddMember("opTypes", op_types, allocator);
+  std::ostringstream folded_stacks;
+  DlOpProfiler::WriteFoldedStacks(folded_stacks);
+  std::string folded_stacks_string = folded_stacks.str();
+  rapidjson::Value folded_stacks_json(folded_stacks_string.c_str(),
+                                      folded_stacks_string.size(), allocator);
+  response->AddMember("foldedStacks", folded_stacks_json, allocator);
+
+  auto reset = params.find("reset");
+  if (reset != params.end() && reset->second == "true") {
+    DlOpProfiler::Reset();
+  }
+  return true;
+}
+
+void Shell::WriteFrameTimingStatistics() {
+  GetConcurrentWorkerTaskRunner()->PostTask(
+      [histograms = frame_timing_histograms_,
+       path = settings_.frame_timing_statistics_path]() {
+        WriteFrameTimingStatisticsFile(*histograms, path);
+      });
+}
+
 void Shell::SendFontChangeNotification() {
   // After system fonts are reloaded, we send a system channel message
   // to notify flutter framework.
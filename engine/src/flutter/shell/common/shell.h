@@ -14,6 +14,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_timing_histograms.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -508,6 +509,16 @@ class Shell final : public PlatformView::Delegate,
   // stored here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The durations of the phases of all of the rasterized frames. Recorded on
+  // the raster thread, and shared with the tasks that write them to the
+  // |Settings::frame_timing_statistics_path|.
+  std::shared_ptr<FrameTimingHistograms> frame_timing_histograms_ =
+      std::make_shared<FrameTimingHistograms>();
+
+  // When the frame timing statistics were last written to a file. Only
+  // accessed on the raster thread.
+  fml::TimePoint frame_timing_statistics_write_time_;
+
   /// Manages the displays. This class is thread safe, can be accessed from
   /// any of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -803,6 +814,29 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Returns the percentiles of the durations of the phases of the frames
+  // rasterized so far, in microseconds. The recorded durations are cleared
+  // if the "reset" parameter is "true".
+  bool OnServiceProtocolGetFrameTimingStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Starts the DisplayList op profiler if the "enable" parameter is "true"
+  // and stops it if it is "false", then returns the time spent in each op
+  // type and the folded stacks of the profile. The profile is cleared if the
+  // "reset" parameter is "true".
+  bool OnServiceProtocolProfileDisplayListOps(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Writes the frame timing statistics to the
+  // |Settings::frame_timing_statistics_path| on a worker thread.
+  void WriteFrameTimingStatistics();
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
@@ -4,12 +4,26 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/geometry/dl_region.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/flow/diff_context.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
@@ -122,4 +136,233 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+#if !SLIMPELLER
+
+// A scrolling view shows a part of a tall list, which is rasterized whole
+// into the raster cache.
+static constexpr DlScalar kViewportSize = 512;
+static constexpr DlScalar kListHeight = 4 * kViewportSize;
+static constexpr int kRasterCacheFrameCount = 30;
+
+static sk_sp<DisplayList> MakeScrollingListDisplayList() {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint paint;
+  for (DlScalar y = 0; y < kListHeight; y += 8) {
+    for (DlScalar x = 0; x < kViewportSize; x += 8) {
+      uint32_t rgb = static_cast<uint32_t>(x * 7 + y) & 0xFFFFFF;
+      paint.setColor(DlColor(0xFF000000 | rgb));
+      builder.DrawCircle(DlPoint(x + 4, y + 4), 3.5, paint);
+    }
+  }
+  return builder.Build();
+}
+
+// Renders frames of a view whose content becomes worth caching after the
+// access threshold, and reports the distribution of the frame times. When
+// the cache populates its entries in the frame that first needs them, that
+// frame rasterizes the whole list instead of the visible part. With the
+// background rasterizer, the frames keep drawing the visible part until the
+// image is ready.
+static void BM_RasterCachePopulationFrameTimes(benchmark::State& state,
+                                               bool background) {
+  sk_sp<DisplayList> display_list = MakeScrollingListDisplayList();
+  sk_sp<SkSurface> surface = SkSurfaces::Raster(
+      SkImageInfo::MakeN32Premul(kViewportSize, kViewportSize));
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop =
+      fml::ConcurrentMessageLoop::Create(1);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkRect logical_rect = ToSkRect(display_list->GetBounds());
+  RasterCacheKeyID id(display_list->unique_id(),
+                      RasterCacheKeyType::kDisplayList);
+  RasterCache::Context context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      .can_rasterize_in_background = true,
+      // clang-format on
+  };
+
+  double max_frame_ms = 0;
+  double frame_ms_variance = 0;
+  size_t sequences = 0;
+  while (state.KeepRunning()) {
+    RasterCache cache;
+    if (background) {
+      cache.SetBackgroundRasterizer(loop->GetTaskRunner());
+    }
+    std::vector<double> frame_ms;
+    for (int frame = 0; frame < kRasterCacheFrameCount; frame++) {
+      fml::TimePoint start = fml::TimePoint::Now();
+      DlSkCanvasAdapter canvas(surface->getCanvas());
+      canvas.Clear(DlColor::kWhite());
+      cache.BeginFrame();
+      RasterCache::CacheInfo info = cache.MarkSeen(id, matrix, true);
+      cache.EvictUnusedCacheEntries();
+      bool cached = info.accesses_since_visible > cache.access_threshold() &&
+                    cache.UpdateCacheEntry(
+                        id, context, [display_list](DlCanvas* canvas) {
+                          canvas->DrawDisplayList(display_list);
+                        });
+      if (!cached || !cache.Draw(id, canvas, nullptr)) {
+        canvas.DrawDisplayList(display_list);
+      }
+      cache.EndFrame();
+      frame_ms.push_back((fml::TimePoint::Now() - start).ToMillisecondsF());
+    }
+
+    double mean = 0;
+    for (double ms : frame_ms) {
+      mean += ms;
+    }
+    mean /= frame_ms.size();
+    double variance = 0;
+    for (double ms : frame_ms) {
+      variance += (ms - mean) * (ms - mean);
+      max_frame_ms = std::max(max_frame_ms, ms);
+    }
+    frame_ms_variance += variance / frame_ms.size();
+    sequences++;
+  }
+
+  state.counters["MaxFrameMs"] = max_frame_ms;
+  state.counters["FrameStdDevMs"] =
+      sequences ? std::sqrt(frame_ms_variance / sequences) : 0;
+  loop->Terminate();
+}
+
+static void BM_RasterCachePopulationInFrame(benchmark::State& state) {
+  BM_RasterCachePopulationFrameTimes(state, false);
+}
+
+BENCHMARK(BM_RasterCachePopulationInFrame)->Unit(benchmark::kMillisecond);
+
+static void BM_RasterCachePopulationInBackground(benchmark::State& state) {
+  BM_RasterCachePopulationFrameTimes(state, true);
+}
+
+BENCHMARK(BM_RasterCachePopulationInBackground)
+    ->Unit(benchmark::kMillisecond);
+
+#endif  //  !SLIMPELLER
+
+// The damage of a 1080x1920 frame in which a few small regions change, e.g.
+// a progress spinner and a clock in opposite corners, or badges that update
+// across a list.
+static std::vector<DlIRect> MakeDamageScenario(int64_t scenario) {
+  if (scenario == 0) {
+    return {
+        DlIRect::MakeXYWH(40, 120, 48, 48),
+        DlIRect::MakeXYWH(900, 1820, 140, 40),
+    };
+  }
+  std::vector<DlIRect> rects;
+  for (int i = 0; i < 16; i++) {
+    int x = (i * 389) % 1000;
+    int y = (i * 761) % 1860;
+    rects.push_back(DlIRect::MakeXYWH(x, y, 24 + (i % 3) * 16, 24));
+  }
+  return rects;
+}
+
+static int64_t DamagedPixels(const std::vector<DlIRect>& rects) {
+  int64_t pixels = 0;
+  for (const DlIRect& rect : DlRegion(rects).getRects(false)) {
+    pixels += rect.Area();
+  }
+  return pixels;
+}
+
+// Measures the cost of merging the damage into a few rectangles, and reports
+// how many pixels have to be repainted with the bounds of the damage and with
+// the rectangles.
+static void BM_DamageRectMerging(benchmark::State& state) {
+  std::vector<DlIRect> damage = MakeDamageScenario(state.range(0));
+  DamageRectPolicy policy{.max_rect_count = 4};
+  std::vector<DlIRect> rects;
+  for (auto _ : state) {
+    rects = DiffContext::MergeDamageRects(damage, policy);
+    benchmark::DoNotOptimize(rects);
+  }
+
+  int64_t bounds_pixels =
+      DiffContext::MergeDamageRects(damage, {.max_rect_count = 1})[0].Area();
+  int64_t rect_pixels = DamagedPixels(rects);
+  state.counters["Rects"] = rects.size();
+  state.counters["BoundsPixels"] = bounds_pixels;
+  state.counters["RectPixels"] = rect_pixels;
+  state.counters["PixelsSavedPct"] =
+      100.0 * (bounds_pixels - rect_pixels) / bounds_pixels;
+}
+
+BENCHMARK(BM_DamageRectMerging)->Arg(0)->Arg(1);
+
+// Builds a tree of transform layers with |depth| levels and 3 children per
+// layer, and a small picture in each leaf.
+static std::shared_ptr<ContainerLayer> MakeDeepLayerTree(int depth) {
+  if (depth == 0) {
+    DisplayListBuilder builder;
+    builder.DrawRect(DlRect::MakeWH(8, 8), DlPaint());
+    auto container = std::make_shared<ContainerLayer>();
+    container->Add(std::make_shared<DisplayListLayer>(
+        DlPoint(), builder.Build(), false, false));
+    return container;
+  }
+  auto layer =
+      std::make_shared<TransformLayer>(DlMatrix::MakeTranslation({8, 8}));
+  for (int i = 0; i < 3; i++) {
+    layer->Add(MakeDeepLayerTree(depth - 1));
+  }
+  return layer;
+}
+
+// Prerolls the same retained tree in every iteration, as when the framework
+// adds an unchanged subtree with addRetained, with and without reusing the
+// results of the previous Preroll.
+static void BM_PrerollRetainedLayerTree(benchmark::State& state,
+                                        bool reuse_retained_preroll) {
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(MakeDeepLayerTree(state.range(0)));
+  const FixedRefreshRateStopwatch unused_stopwatch;
+  LayerStateStack state_stack;
+  state_stack.set_preroll_delegate(DlRect::MakeWH(1000, 1000));
+  std::vector<RasterCacheItem*> raster_cache_items;
+  PrerollContext context = {
+      // clang-format off
+#if !SLIMPELLER
+      .raster_cache                  = nullptr,
+#endif  //  !SLIMPELLER
+      .gr_context                    = nullptr,
+      .view_embedder                 = nullptr,
+      .state_stack                   = state_stack,
+      .dst_color_space               = nullptr,
+      .surface_needs_readback        = false,
+      .raster_time                   = unused_stopwatch,
+      .ui_time                       = unused_stopwatch,
+      .texture_registry              = nullptr,
+      .raster_cached_entries         = &raster_cache_items,
+      .reuse_retained_preroll        = reuse_retained_preroll,
+      // clang-format on
+  };
+  for (auto _ : state) {
+    root->Preroll(&context);
+  }
+  state.counters["Leaves"] = std::pow(3, state.range(0));
+}
+
+static void BM_PrerollDeepLayerTree(benchmark::State& state) {
+  BM_PrerollRetainedLayerTree(state, false);
+}
+
+BENCHMARK(BM_PrerollDeepLayerTree)->Arg(4)->Arg(6)->Arg(8);
+
+static void BM_PrerollDeepLayerTreeReusingRetained(benchmark::State& state) {
+  BM_PrerollRetainedLayerTree(state, true);
+}
+
+BENCHMARK(BM_PrerollDeepLayerTreeReusingRetained)->Arg(4)->Arg(6)->Arg(8);
+
 }  // namespace flutter
@@ -335,6 +335,12 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kRunInView:
             shell->OnServiceProtocolRunInView(params, response);
             break;
+          case ServiceProtocolEnum::kGetFrameTimingStatistics:
+            shell->OnServiceProtocolGetFrameTimingStatistics(params, response);
+            break;
+          case ServiceProtocolEnum::kProfileDisplayListOps:
+            shell->OnServiceProtocolProfileDisplayListOps(params, response);
+            break;
         }
         finished.set_value(true);
       });
@@ -142,6 +142,8 @@ class ShellTest : public FixtureTest {
     kEstimateRasterCacheMemory,
     kSetAssetBundlePath,
     kRunInView,
+    kGetFrameTimingStatistics,
+    kProfileDisplayListOps,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
@@ -20,6 +20,8 @@
 #include "assets/directory_asset_bundle.h"
 #include "common/graphics/persistent_cache.h"
 #include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/utils/dl_op_profiler.h"
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/layers/display_list_layer.h"
@@ -30,6 +32,7 @@
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
@@ -50,6 +53,7 @@
 #include "lib/ui/semantics/semantics_node.h"
 #include "third_party/rapidjson/include/rapidjson/writer.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
 #ifdef SHELL_ENABLE_VULKAN
@@ -2603,6 +2607,138 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetFrameTimingStatisticsWorks) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent timing_latch;
+  settings.frame_rasterized_callback =
+      [&timing_latch](const FrameTiming& timing) { timing_latch.Signal(); };
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  timing_latch.Wait();
+
+  auto get_statistics = [&shell](bool reset) {
+    ServiceProtocol::Handler::ServiceProtocolMap params;
+    if (reset) {
+      params["reset"] = "true";
+    }
+    rapidjson::Document document;
+    OnServiceProtocol(shell.get(),
+                      ServiceProtocolEnum::kGetFrameTimingStatistics,
+                      shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                      &document);
+    return document;
+  };
+
+  rapidjson::Document document = get_statistics(/*reset=*/true);
+  EXPECT_STREQ(document["type"].GetString(), "FrameTimingStatistics");
+  EXPECT_EQ(document["frameCount"].GetUint64(), 1u);
+  for (const char* metric : {"build", "raster", "vsyncOverhead", "total"}) {
+    ASSERT_TRUE(document.HasMember(metric)) << metric;
+    const rapidjson::Value& metric_json = document[metric];
+    for (const char* percentile : {"p50", "p90", "p99", "p99.9"}) {
+      ASSERT_TRUE(metric_json.HasMember(percentile)) << percentile;
+      EXPECT_LE(metric_json[percentile].GetInt64(),
+                metric_json["max"].GetInt64());
+    }
+  }
+  EXPECT_GE(document["total"]["max"].GetInt64(),
+            document["raster"]["max"].GetInt64());
+
+  // The previous request cleared the recorded frames.
+  EXPECT_EQ(get_statistics(/*reset=*/false)["frameCount"].GetUint64(), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, FrameTimingStatisticsAreWrittenOnShutdown) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto settings = CreateSettingsForFixture();
+  settings.frame_timing_statistics_path =
+      fml::paths::JoinPaths({temp_dir.path(), "frame_timing.json"});
+  fml::AutoResetWaitableEvent timing_latch;
+  settings.frame_rasterized_callback =
+      [&timing_latch](const FrameTiming& timing) { timing_latch.Signal(); };
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  timing_latch.Wait();
+
+  // The frames rasterized since the last periodic write are flushed when
+  // the shell is destroyed.
+  DestroyShell(std::move(shell));
+
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(temp_dir.fd(), "frame_timing.json");
+  ASSERT_TRUE(mapping);
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(mapping->GetMapping()),
+                 mapping->GetSize());
+  ASSERT_FALSE(document.HasParseError());
+  EXPECT_EQ(document["frameCount"].GetUint64(), 1u);
+}
+
+TEST_F(ShellTest, OnServiceProtocolProfileDisplayListOpsWorks) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  DlOpProfiler::Reset();
+
+  auto profile = [&shell](const char* enable, bool reset) {
+    ServiceProtocol::Handler::ServiceProtocolMap params;
+    if (enable) {
+      params["enable"] = enable;
+    }
+    if (reset) {
+      params["reset"] = "true";
+    }
+    rapidjson::Document document;
+    OnServiceProtocol(shell.get(), ServiceProtocolEnum::kProfileDisplayListOps,
+                      shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                      &document);
+    return document;
+  };
+
+  rapidjson::Document document = profile("true", /*reset=*/false);
+  EXPECT_STREQ(document["type"].GetString(), "DisplayListOpProfile");
+  EXPECT_TRUE(document["enabled"].GetBool());
+  EXPECT_TRUE(DlOpProfiler::IsEnabled());
+
+  // Only the ops dispatched to rendering receivers are profiled.
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeWH(10, 10), DlPaint());
+  auto display_list = builder.Build();
+  auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(10, 10));
+  DlSkCanvasAdapter(surface->getCanvas()).DrawDisplayList(display_list);
+
+  document = profile("false", /*reset=*/true);
+  EXPECT_FALSE(document["enabled"].GetBool());
+  EXPECT_FALSE(DlOpProfiler::IsEnabled());
+  ASSERT_EQ(document["opTypes"].Size(), 1u);
+  EXPECT_STREQ(document["opTypes"][0]["name"].GetString(), "DrawRect");
+  EXPECT_EQ(document["opTypes"][0]["count"].GetUint64(), 1u);
+  EXPECT_NE(std::string(document["foldedStacks"].GetString())
+                .find("DisplayList;DrawRect "),
+            std::string::npos);
+
+  // The previous request cleared the profile.
+  document = profile(nullptr, /*reset=*/false);
+  EXPECT_EQ(document["opTypes"].Size(), 0u);
+
+  document = profile("yes", /*reset=*/false);
+  EXPECT_TRUE(document.HasMember("code"));
+  EXPECT_FALSE(DlOpProfiler::IsEnabled());
+
+  DestroyShell(std::move(shell));
+}
+
 // TODO(https://github.com/flutter/flutter/issues/100273): Disabled due to
 // flakiness.
 // TODO(https://github.com/flutter/flutter/issues/100299): Fix it when
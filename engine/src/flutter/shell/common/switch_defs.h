@@ -167,6 +167,44 @@ DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
            "purposes such as reproducing the shader compilation jank.")
+DEF_SWITCH(EnableBackgroundRasterCache,
+           "enable-background-raster-cache",
+           "Render the images of new raster cache entries on a background "
+           "worker. Until an image is ready, the frames draw the content "
+           "without the cache, instead of rendering the image in the frame "
+           "that first needs it.")
+DEF_SWITCH(RasterCacheDiskSizeMB,
+           "raster-cache-disk-size-mb",
+           "Keep the raster cache images of static content in the persistent "
+           "cache directory, up to the specified number of megabytes, so that "
+           "later runs of the app can load them instead of rendering them "
+           "again. Disabled by default.")
+DEF_SWITCH(RasterCacheMaxBytes,
+           "raster-cache-max-bytes",
+           "The size limit of the images in the raster cache, or 0 for "
+           "unlimited. Defaults to 12 full screen images of the view.")
+DEF_SWITCH(RasterCacheEvictionGraceFrames,
+           "raster-cache-eviction-grace-frames",
+           "The number of frames that the raster cache keeps an image after "
+           "the last frame that used it, so that content which scrolls back "
+           "into view is not rendered again. Defaults to 30.")
+DEF_SWITCH(FramePipelineDepth,
+           "frame-pipeline-depth",
+           "The number of frames that the UI thread may build while the "
+           "raster thread has not drawn them yet. Deeper pipelines increase "
+           "throughput at the cost of latency. Defaults to a platform "
+           "dependent depth of 1 or 2.")
+DEF_SWITCH(ThroughputFramePacing,
+           "throughput-frame-pacing",
+           "Begin frames as soon as the frame pipeline has room for them "
+           "instead of waiting for vsync. This renders frames as fast as "
+           "possible and is meant for rendering that is not shown on a "
+           "display, such as headless rendering of videos.")
+DEF_SWITCH(SoftwareRasterThreads,
+           "software-raster-threads",
+           "The number of threads that rasterize frames of the software "
+           "renderer in parallel, by splitting them into tiles. Frames are "
+           "rasterized on the raster thread alone by default.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
@@ -178,6 +216,20 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(ProfileDisplayListOps,
+           "profile-display-list-ops",
+           "Time every DisplayList op that is rasterized and write the profile "
+           "to a file at the specified path when the shell is destroyed. Paths "
+           "ending in \".json\" are written as Chrome trace events that can be "
+           "loaded into Perfetto, other paths as folded stacks for flamegraph "
+           "tools. The profiler can also be started and stopped at runtime "
+           "with the _flutter.profileDisplayListOps service extension.")
+DEF_SWITCH(FrameTimingStatisticsFile,
+           "frame-timing-statistics-file",
+           "Periodically write the percentiles of the build, raster and vsync "
+           "overhead durations of the rendered frames as JSON to a file at the "
+           "specified path, and once more when the engine shuts down. Unlike "
+           "the VM service, this also works in release mode.")
 DEF_SWITCH(ProfileMicrotasks,
            "profile-microtasks",
            "Enable collection of information about each microtask. Information "
@@ -297,6 +349,10 @@ DEF_SWITCH(ImpellerLazyShaderMode,
 DEF_SWITCH(ImpellerAntialiasLines,
            "impeller-antialias-lines",
            "Experimental flag to test drawing lines with antialiasing.")
+DEF_SWITCH(ImpellerAnalyticPathFills,
+           "impeller-analytic-path-fills",
+           "Experimental flag to test filling paths with analytic "
+           "antialiasing instead of the stencil buffer.")
 DEF_SWITCHES_END
 
 }  // namespace flutter
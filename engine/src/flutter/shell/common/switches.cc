@@ -339,6 +339,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::ProfileDisplayListOps),
+                              &settings.display_list_op_profile_path);
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::FrameTimingStatisticsFile),
+                              &settings.frame_timing_statistics_path);
+
   settings.profile_microtasks =
       command_line.HasOption(FlagForSwitch(Switch::ProfileMicrotasks));
 
@@ -494,6 +500,51 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
+  settings.enable_background_raster_cache = command_line.HasOption(
+      FlagForSwitch(Switch::EnableBackgroundRasterCache));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheDiskSizeMB))) {
+    std::string raster_cache_disk_size_mb;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheDiskSizeMB),
+                                &raster_cache_disk_size_mb);
+    settings.raster_cache_disk_size_mb = std::stoul(raster_cache_disk_size_mb);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxBytes))) {
+    std::string raster_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxBytes),
+                                &raster_cache_max_bytes);
+    settings.raster_cache_max_bytes = std::stoll(raster_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheEvictionGraceFrames))) {
+    std::string raster_cache_eviction_grace_frames;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheEvictionGraceFrames),
+        &raster_cache_eviction_grace_frames);
+    settings.raster_cache_eviction_grace_frames =
+        std::stoll(raster_cache_eviction_grace_frames);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePipelineDepth))) {
+    std::string frame_pipeline_depth;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePipelineDepth),
+                                &frame_pipeline_depth);
+    settings.frame_pipeline_depth = std::stoul(frame_pipeline_depth);
+  }
+
+  settings.enable_throughput_frame_pacing =
+      command_line.HasOption(FlagForSwitch(Switch::ThroughputFramePacing));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::SoftwareRasterThreads))) {
+    std::string software_raster_threads;
+    command_line.GetOptionValue(FlagForSwitch(Switch::SoftwareRasterThreads),
+                                &software_raster_threads);
+    settings.software_raster_thread_count =
+        std::stoul(software_raster_threads);
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::OldGenHeapSize))) {
     std::string old_gen_heap_size;
     command_line.GetOptionValue(FlagForSwitch(Switch::OldGenHeapSize),
@@ -556,6 +607,8 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
       command_line.HasOption(FlagForSwitch(Switch::ImpellerLazyShaderMode));
   settings.impeller_antialiased_lines =
       command_line.HasOption(FlagForSwitch(Switch::ImpellerAntialiasLines));
+  settings.impeller_analytic_path_fills =
+      command_line.HasOption(FlagForSwitch(Switch::ImpellerAnalyticPathFills));
 
   return settings;
 }
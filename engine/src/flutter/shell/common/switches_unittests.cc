@@ -59,6 +59,22 @@ TEST(SwitchesTest, TraceToFile) {
   EXPECT_EQ(settings.trace_to_file, "trace.binpb");
 }
 
+TEST(SwitchesTest, ProfileDisplayListOps) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--profile-display-list-ops=ops.json"});
+  EXPECT_TRUE(command_line.HasOption("profile-display-list-ops"));
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.display_list_op_profile_path, "ops.json");
+}
+
+TEST(SwitchesTest, FrameTimingStatisticsFile) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--frame-timing-statistics-file=frames.json"});
+  EXPECT_TRUE(command_line.HasOption("frame-timing-statistics-file"));
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.frame_timing_statistics_path, "frames.json");
+}
+
 TEST(SwitchesTest, ProfileMicrotasks) {
   {
     fml::CommandLine command_line = fml::CommandLineFromInitializerList(
@@ -139,6 +155,91 @@ TEST(SwitchesTest, ProfileStartup) {
   }
 }
 
+TEST(SwitchesTest, EnableBackgroundRasterCache) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-background-raster-cache"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.enable_background_raster_cache);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.enable_background_raster_cache);
+  }
+}
+
+TEST(SwitchesTest, RasterCacheDiskSizeMB) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--raster-cache-disk-size-mb=64"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_disk_size_mb, 64u);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_disk_size_mb, 0u);
+  }
+}
+
+TEST(SwitchesTest, RasterCacheBudget) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--raster-cache-max-bytes=1048576",
+         "--raster-cache-eviction-grace-frames=5"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_max_bytes, 1048576);
+    EXPECT_EQ(settings.raster_cache_eviction_grace_frames, 5);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_max_bytes, -1);
+    EXPECT_EQ(settings.raster_cache_eviction_grace_frames, -1);
+  }
+}
+
+TEST(SwitchesTest, FramePacing) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--frame-pipeline-depth=4", "--throughput-frame-pacing"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.frame_pipeline_depth, 4u);
+    EXPECT_TRUE(settings.enable_throughput_frame_pacing);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.frame_pipeline_depth, 0u);
+    EXPECT_FALSE(settings.enable_throughput_frame_pacing);
+  }
+}
+
+TEST(SwitchesTest, SoftwareRasterThreads) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--software-raster-threads=4"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.software_raster_thread_count, 4u);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.software_raster_thread_count, 0u);
+  }
+}
+
 #if !FLUTTER_RELEASE
 TEST(SwitchesTest, EnableAsserts) {
   fml::CommandLine command_line = fml::CommandLineFromInitializerList(
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 
 #include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
@@ -33,6 +34,9 @@ struct GLFBOInfo {
   uint32_t fbo_id;
   // The frame buffer's existing damage (i.e. damage since it was last used).
   const std::optional<DlIRect> existing_damage;
+  // The individual rectangles that make up `existing_damage`, when the
+  // delegate tracks more than one. Empty if only the bounds are known.
+  const std::vector<DlIRect> existing_damage_rects = {};
 };
 
 // Information passed during presentation of a frame.
@@ -50,6 +54,11 @@ struct GLPresentInfo {
   // The buffer damage refers to the region that needs to be set as damaged
   // within the frame buffer.
   const std::optional<DlIRect>& buffer_damage;
+
+  // The rectangles that make up the frame and buffer damage, when the
+  // surface allows more than one damage rectangle. Empty otherwise.
+  std::vector<DlIRect> frame_damage_rects = {};
+  std::vector<DlIRect> buffer_damage_rects = {};
 };
 
 class GPUSurfaceGLDelegate {
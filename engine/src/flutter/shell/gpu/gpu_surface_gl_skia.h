@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
@@ -73,6 +74,8 @@ class GPUSurfaceGLSkia : public Surface {
   // still have an option of overriding this damage with their own in
   // `GLContextFrameBufferInfo`.
   std::optional<DlIRect> existing_damage_ = std::nullopt;
+  // The separate rectangles of `existing_damage_`, if the delegate has them.
+  std::vector<DlIRect> existing_damage_rects_;
   bool context_owner_ = false;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
   // external view embedder may want to render to the root surface. This is a
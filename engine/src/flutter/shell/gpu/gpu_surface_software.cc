@@ -5,19 +5,47 @@
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
 #include <memory>
+#include <vector>
 
 #include "flow/surface_frame.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
-GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+namespace {
+
+constexpr int32_t kTileSize = 256;
+
+// A backdrop filter reads the pixels that were rendered underneath it,
+// which may belong to other tiles that are being rendered at the same
+// time.
+bool HasBackdropFilter(const DisplayList& display_list) {
+  if (display_list.root_has_backdrop_filter()) {
+    return true;
+  }
+  for (DlIndex i : display_list) {
+    if (display_list.GetOpType(i) == DisplayListOpType::kSaveLayerBackdrop) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+GPUSurfaceSoftware::GPUSurfaceSoftware(
+    GPUSurfaceSoftwareDelegate* delegate,
+    bool render_to_surface,
+    std::shared_ptr<const DlTiledDispatcher> tiled_dispatcher)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tiled_dispatcher_(std::move(tiled_dispatcher)),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -61,6 +89,11 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  if (tiled_dispatcher_) {
+    return AcquireTiledFrame(logical_size, framebuffer_info,
+                             std::move(backing_store));
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -93,6 +126,96 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
                                         logical_size);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireTiledFrame(
+    const DlISize& logical_size,
+    const SurfaceFrame::FramebufferInfo& framebuffer_info,
+    sk_sp<SkSurface> backing_store) {
+  // The frame is recorded with an RTree so that each tile only receives the
+  // ops that intersect it.
+  SurfaceFrame::EncodeCallback encode_callback =
+      [self = weak_factory_.GetWeakPtr(), backing_store](
+          SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+    // If the surface itself went away, there is nothing more to do.
+    if (!self || !self->IsValid()) {
+      return false;
+    }
+
+    sk_sp<DisplayList> display_list = surface_frame.BuildDisplayList();
+    if (!display_list) {
+      return false;
+    }
+    self->RasterizeTiles(*display_list, *backing_store);
+    return true;
+  };
+  SurfaceFrame::SubmitCallback submit_callback =
+      [self = weak_factory_.GetWeakPtr(),
+       backing_store](const SurfaceFrame& surface_frame) {
+        // If the surface itself went away, there is nothing more to do.
+        if (!self || !self->IsValid()) {
+          return false;
+        }
+        return self->delegate_->PresentBackingStore(backing_store);
+      };
+
+  return std::make_unique<SurfaceFrame>(
+      nullptr, framebuffer_info, encode_callback, submit_callback,
+      logical_size, /*context_result=*/nullptr,
+      /*display_list_fallback=*/true, /*display_list_rtree=*/true);
+}
+
+void GPUSurfaceSoftware::RasterizeTiles(const DisplayList& display_list,
+                                        SkSurface& backing_store) const {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTiles");
+  if (HasBackdropFilter(display_list)) {
+    SkCanvas* canvas = backing_store.getCanvas();
+    canvas->resetMatrix();
+    DlSkCanvasDispatcher dispatcher(canvas);
+    display_list.Dispatch(dispatcher);
+    return;
+  }
+
+  // The pixels are written behind the back of the canvas of the backing
+  // store, which must first detach them from any snapshot of it.
+  backing_store.notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  SkPixmap pixmap;
+  if (!backing_store.peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not access the pixels of the backing store.";
+    return;
+  }
+
+  // Each tile renders directly into its own rectangle of the pixels of the
+  // backing store, so there is nothing left to composite afterwards.
+  std::vector<DlIRect> tile_bounds = DlTiledDispatcher::ComputeTileBounds(
+      DlIRect::MakeWH(pixmap.width(), pixmap.height()),
+      DlISize(kTileSize, kTileSize));
+  std::vector<sk_sp<SkSurface>> tile_surfaces;
+  std::vector<std::unique_ptr<DlSkCanvasDispatcher>> receivers;
+  std::vector<DlTiledDispatcher::Tile> tiles;
+  tile_surfaces.reserve(tile_bounds.size());
+  receivers.reserve(tile_bounds.size());
+  tiles.reserve(tile_bounds.size());
+  for (const DlIRect& bounds : tile_bounds) {
+    SkPixmap tile_pixmap;
+    if (!pixmap.extractSubset(
+            &tile_pixmap, SkIRect::MakeLTRB(bounds.GetLeft(), bounds.GetTop(),
+                                            bounds.GetRight(),
+                                            bounds.GetBottom()))) {
+      continue;
+    }
+    sk_sp<SkSurface> tile_surface = SkSurfaces::WrapPixels(
+        tile_pixmap, &backing_store.props());
+    if (!tile_surface) {
+      continue;
+    }
+    SkCanvas* tile_canvas = tile_surface->getCanvas();
+    tile_canvas->translate(-bounds.GetLeft(), -bounds.GetTop());
+    receivers.push_back(std::make_unique<DlSkCanvasDispatcher>(tile_canvas));
+    tiles.push_back({bounds, receivers.back().get()});
+    tile_surfaces.push_back(std::move(tile_surface));
+  }
+  tiled_dispatcher_->Dispatch(display_list, tiles);
+}
+
 // |Surface|
 DlMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
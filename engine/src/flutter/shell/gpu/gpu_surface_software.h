@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <memory>
+
+#include "flutter/display_list/utils/dl_tiled_dispatcher.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -14,8 +17,13 @@ namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
-  GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+  // If |tiled_dispatcher| is set, frames are recorded into a DisplayList
+  // and rasterized into the backing store in tiles, in parallel on the
+  // threads of the dispatcher.
+  GPUSurfaceSoftware(
+      GPUSurfaceSoftwareDelegate* delegate,
+      bool render_to_surface,
+      std::shared_ptr<const DlTiledDispatcher> tiled_dispatcher = nullptr);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,7 +46,17 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  const std::shared_ptr<const DlTiledDispatcher> tiled_dispatcher_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  std::unique_ptr<SurfaceFrame> AcquireTiledFrame(
+      const DlISize& logical_size,
+      const SurfaceFrame::FramebufferInfo& framebuffer_info,
+      sk_sp<SkSurface> backing_store);
+
+  void RasterizeTiles(const DisplayList& display_list,
+                      SkSurface& backing_store) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
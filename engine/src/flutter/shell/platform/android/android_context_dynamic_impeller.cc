@@ -128,6 +128,8 @@ GetActualRenderingAPIForImpeller(
               {
                   .antialiased_lines =
                       settings.impeller_flags.antialiased_lines,
+                  .analytic_path_fills =
+                      settings.impeller_flags.analytic_path_fills,
               },
       });
   if (!vulkan_backend->IsValid()) {
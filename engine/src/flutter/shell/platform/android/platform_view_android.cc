@@ -61,6 +61,8 @@ AndroidContext::ContextSettings CreateContextSettings(
   settings.enable_surface_control = p_settings.enable_surface_control;
   settings.impeller_flags.antialiased_lines =
       p_settings.impeller_antialiased_lines;
+  settings.impeller_flags.analytic_path_fills =
+      p_settings.impeller_analytic_path_fills;
   return settings;
 }
 }  // namespace
@@ -16,6 +16,7 @@ namespace {
 impeller::Flags SettingsToFlags(const Settings& settings) {
   return impeller::Flags{
       .antialiased_lines = settings.impeller_antialiased_lines,
+      .analytic_path_fills = settings.impeller_analytic_path_fills,
   };
 }
 }  // namespace
@@ -5,6 +5,7 @@
 #define FML_USED_ON_EMBEDDER
 #define RAPIDJSON_HAS_STDSTRING 1
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -20,6 +21,7 @@
 #include "flutter/fml/thread.h"
 #include "third_party/dart/runtime/bin/elf_loader.h"
 #include "third_party/dart/runtime/include/dart_native_api.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GpuTypes.h"
 #include "third_party/skia/include/gpu/ganesh/GrBackendSurface.h"
@@ -104,6 +106,10 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "third_party/skia/include/gpu/ganesh/vk/GrVkTypes.h"
 #endif  // SHELL_ENABLE_VULKAN
 
+#ifdef IMPELLER_SUPPORTS_RENDERING
+#include "impeller/base/flags.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 const int32_t kFlutterSemanticsNodeIdBatchEnd = -1;
 const int32_t kFlutterSemanticsCustomActionIdBatchEnd = -1;
 
@@ -180,6 +186,12 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
+  if (SAFE_ACCESS(software_config, acquire_buffer_callback, nullptr) !=
+      nullptr) {
+    return SAFE_ACCESS(software_config, present_buffer_callback, nullptr) !=
+           nullptr;
+  }
+
   if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
       nullptr) {
     return false;
@@ -301,6 +313,18 @@ static std::optional<SkColorType> FlutterFormatToSkColorType(uint32_t format) {
 
 #endif
 
+#ifdef IMPELLER_SUPPORTS_RENDERING
+// The experimental Impeller features that the command line switches turned
+// on, for the Impeller contexts of the embedder surfaces.
+static impeller::Flags ImpellerFlagsFromSettings(
+    const flutter::Settings& settings) {
+  return impeller::Flags{
+      .antialiased_lines = settings.impeller_antialiased_lines,
+      .analytic_path_fills = settings.impeller_analytic_path_fills,
+  };
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 static inline flutter::Shell::CreateCallback<flutter::PlatformView>
 InferOpenGLPlatformViewCreationCallback(
     const FlutterRendererConfig* config,
@@ -309,7 +333,7 @@ InferOpenGLPlatformViewCreationCallback(
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
         external_view_embedder,
-    bool enable_impeller) {
+    const flutter::Settings& settings) {
 #ifdef SHELL_ENABLE_GL
   if (config->type != kOpenGL) {
     return nullptr;
@@ -328,33 +352,37 @@ InferOpenGLPlatformViewCreationCallback(
     if (present) {
       return present(user_data);
     } else {
-      // Format the frame and buffer damages accordingly. Note that, since the
-      // current compute damage algorithm only returns one rectangle for damage
-      // we are assuming the number of rectangles provided in frame and buffer
-      // damage are always 1. Once the function that computes damage implements
-      // support for multiple damage rectangles, GLPresentInfo should also
-      // contain the number of damage rectangles.
-
-      std::optional<FlutterRect> frame_damage_rect;
-      if (gl_present_info.frame_damage) {
-        frame_damage_rect =
-            DlIRectToFlutterRect(*(gl_present_info.frame_damage));
-      }
-      std::optional<FlutterRect> buffer_damage_rect;
-      if (gl_present_info.buffer_damage) {
-        buffer_damage_rect =
-            DlIRectToFlutterRect(*(gl_present_info.buffer_damage));
-      }
+      // Format the frame and buffer damages accordingly. The damage is a
+      // single rectangle unless the embedder allowed more than one with
+      // max_damage_rect_count.
+      auto to_flutter_rects = [](const std::optional<flutter::DlIRect>& bounds,
+                                 const std::vector<flutter::DlIRect>& rects) {
+        std::vector<FlutterRect> flutter_rects;
+        if (!rects.empty()) {
+          for (const flutter::DlIRect& rect : rects) {
+            flutter_rects.push_back(DlIRectToFlutterRect(rect));
+          }
+        } else if (bounds) {
+          flutter_rects.push_back(DlIRectToFlutterRect(*bounds));
+        }
+        return flutter_rects;
+      };
+      std::vector<FlutterRect> frame_damage_rects = to_flutter_rects(
+          gl_present_info.frame_damage, gl_present_info.frame_damage_rects);
+      std::vector<FlutterRect> buffer_damage_rects = to_flutter_rects(
+          gl_present_info.buffer_damage, gl_present_info.buffer_damage_rects);
 
       FlutterDamage frame_damage{
           .struct_size = sizeof(FlutterDamage),
-          .num_rects = frame_damage_rect ? size_t{1} : size_t{0},
-          .damage = frame_damage_rect ? &frame_damage_rect.value() : nullptr,
+          .num_rects = frame_damage_rects.size(),
+          .damage = frame_damage_rects.empty() ? nullptr
+                                               : frame_damage_rects.data(),
       };
       FlutterDamage buffer_damage{
           .struct_size = sizeof(FlutterDamage),
-          .num_rects = buffer_damage_rect ? size_t{1} : size_t{0},
-          .damage = buffer_damage_rect ? &buffer_damage_rect.value() : nullptr,
+          .num_rects = buffer_damage_rects.size(),
+          .damage = buffer_damage_rects.empty() ? nullptr
+                                                : buffer_damage_rects.data(),
       };
 
       // Construct the present information concerning the frame being rendered.
@@ -401,6 +429,7 @@ InferOpenGLPlatformViewCreationCallback(
     populate_existing_damage(user_data, id, &existing_damage);
 
     std::optional<flutter::DlIRect> existing_damage_rect = std::nullopt;
+    std::vector<flutter::DlIRect> existing_damage_rects;
 
     // Verify that at least one damage rectangle was provided.
     if (existing_damage.num_rects <= 0 || existing_damage.damage == nullptr) {
@@ -408,8 +437,10 @@ InferOpenGLPlatformViewCreationCallback(
     } else {
       existing_damage_rect = flutter::DlIRect();
       for (size_t i = 0; i < existing_damage.num_rects; i++) {
-        existing_damage_rect = existing_damage_rect->Union(
+        existing_damage_rects.push_back(
             FlutterRectToDlIRect(existing_damage.damage[i]));
+        existing_damage_rect =
+            existing_damage_rect->Union(existing_damage_rects.back());
       }
     }
 
@@ -417,6 +448,7 @@ InferOpenGLPlatformViewCreationCallback(
     return flutter::GLFBOInfo{
         .fbo_id = static_cast<uint32_t>(id),
         .existing_damage = existing_damage_rect,
+        .existing_damage_rects = std::move(existing_damage_rects),
     };
   };
 
@@ -468,6 +500,10 @@ InferOpenGLPlatformViewCreationCallback(
   bool fbo_reset_after_present =
       SAFE_ACCESS(open_gl_config, fbo_reset_after_present, false);
 
+  size_t max_damage_rect_count =
+      std::max(SAFE_ACCESS(open_gl_config, max_damage_rect_count, size_t{1}),
+               size_t{1});
+
   flutter::EmbedderSurfaceGLSkia::GLDispatchTable gl_dispatch_table = {
       gl_make_current,                     // gl_make_current_callback
       gl_clear_current,                    // gl_clear_current_callback
@@ -477,11 +513,13 @@ InferOpenGLPlatformViewCreationCallback(
       gl_surface_transformation_callback,  // gl_surface_transformation_callback
       gl_proc_resolver,                    // gl_proc_resolver
       gl_populate_existing_damage,         // gl_populate_existing_damage
+      max_damage_rect_count,               // max_damage_rect_count
   };
 
   return fml::MakeCopyable(
       [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
-       enable_impeller,
+       enable_impeller = settings.enable_impeller,
+       impeller_flags = ImpellerFlagsFromSettings(settings),
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
         std::shared_ptr<flutter::EmbedderExternalViewEmbedder> view_embedder =
@@ -491,7 +529,7 @@ InferOpenGLPlatformViewCreationCallback(
               shell,                   // delegate
               shell.GetTaskRunners(),  // task runners
               std::make_unique<flutter::EmbedderSurfaceGLImpeller>(
-                  gl_dispatch_table, fbo_reset_after_present,
+                  gl_dispatch_table, fbo_reset_after_present, impeller_flags,
                   view_embedder),       // embedder_surface
               platform_dispatch_table,  // embedder platform dispatch table
               view_embedder             // external view embedder
@@ -521,7 +559,7 @@ InferMetalPlatformViewCreationCallback(
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
         external_view_embedder,
-    bool enable_impeller) {
+    const flutter::Settings& settings) {
   if (config->type != kMetal) {
     return nullptr;
   }
@@ -560,7 +598,7 @@ InferMetalPlatformViewCreationCallback(
 
   std::unique_ptr<flutter::EmbedderSurface> embedder_surface;
 
-  if (enable_impeller) {
+  if (settings.enable_impeller) {
     flutter::EmbedderSurfaceMetalImpeller::MetalDispatchTable
         metal_dispatch_table = {
             .present = metal_present,
@@ -570,7 +608,8 @@ InferMetalPlatformViewCreationCallback(
         const_cast<flutter::GPUMTLDeviceHandle>(config->metal.device),
         const_cast<flutter::GPUMTLCommandQueueHandle>(
             config->metal.present_command_queue),
-        metal_dispatch_table, view_embedder);
+        metal_dispatch_table, ImpellerFlagsFromSettings(settings),
+        view_embedder);
   } else {
 #if !SLIMPELLER
     flutter::EmbedderSurfaceMetalSkia::MetalDispatchTable metal_dispatch_table =
@@ -615,7 +654,7 @@ InferVulkanPlatformViewCreationCallback(
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
         external_view_embedder,
-    bool enable_impeller) {
+    const flutter::Settings& settings) {
   if (config->type != kVulkan) {
     return nullptr;
   }
@@ -659,7 +698,7 @@ InferVulkanPlatformViewCreationCallback(
       std::move(external_view_embedder);
 
 #if IMPELLER_SUPPORTS_RENDERING
-  if (enable_impeller) {
+  if (settings.enable_impeller) {
     flutter::EmbedderSurfaceVulkanImpeller::VulkanDispatchTable
         vulkan_dispatch_table = {
             .get_instance_proc_address =
@@ -679,7 +718,7 @@ InferVulkanPlatformViewCreationCallback(
             static_cast<VkDevice>(config->vulkan.device),
             config->vulkan.queue_family_index,
             static_cast<VkQueue>(config->vulkan.queue), vulkan_dispatch_table,
-            view_embedder);
+            ImpellerFlagsFromSettings(settings), view_embedder);
 
     return fml::MakeCopyable(
         [embedder_surface = std::move(embedder_surface),
@@ -770,6 +809,11 @@ InferVulkanPlatformViewCreationCallback(
 #endif  // SHELL_ENABLE_VULKAN
 }
 
+static sk_sp<SkSurface> MakeSkSurfaceFromBackingStore(
+    GrDirectContext* context,
+    const FlutterBackingStoreConfig& config,
+    const FlutterSoftwareBackingStore* software);
+
 static flutter::Shell::CreateCallback<flutter::PlatformView>
 InferSoftwarePlatformViewCreationCallback(
     const FlutterRendererConfig* config,
@@ -793,16 +837,93 @@ InferSoftwarePlatformViewCreationCallback(
           software_present_backing_store,  // required
       };
 
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+  if (SAFE_ACCESS(software_config, acquire_buffer_callback, nullptr) !=
+      nullptr) {
+    // The buffer that the engine renders the current frame into. Only
+    // accessed on the raster thread.
+    auto acquired_buffer = std::make_shared<FlutterSoftwareBackingStore>();
+
+    software_dispatch_table.software_acquire_buffer =
+        [ptr = software_config->acquire_buffer_callback, user_data,
+         acquired_buffer](const flutter::DlISize& size) -> sk_sp<SkSurface> {
+      FlutterFrameInfo frame_info = {};
+      frame_info.struct_size = sizeof(FlutterFrameInfo);
+      frame_info.size = {static_cast<uint32_t>(size.width),
+                         static_cast<uint32_t>(size.height)};
+
+      FlutterSoftwareBackingStore buffer = {};
+      if (!ptr(user_data, &frame_info, &buffer)) {
+        FML_LOG(ERROR) << "Could not acquire a software buffer to render into.";
+        return nullptr;
+      }
+      if (buffer.allocation == nullptr ||
+          buffer.height < static_cast<size_t>(size.height)) {
+        FML_LOG(ERROR) << "Embedder supplied an invalid software buffer.";
+        if (buffer.destruction_callback) {
+          buffer.destruction_callback(buffer.user_data);
+        }
+        return nullptr;
+      }
+      // The rows are 32-bit pixels, which must not overlap.
+      if (buffer.row_bytes < static_cast<size_t>(size.width) * 4) {
+        FML_LOG(ERROR) << "Embedder supplied a software buffer with "
+                       << buffer.row_bytes << " row bytes for a frame that is "
+                       << size.width << " pixels wide.";
+        if (buffer.destruction_callback) {
+          buffer.destruction_callback(buffer.user_data);
+        }
+        return nullptr;
+      }
+
+      FlutterBackingStoreConfig backing_store_config = {};
+      backing_store_config.struct_size = sizeof(FlutterBackingStoreConfig);
+      backing_store_config.size = {static_cast<double>(size.width),
+                                   static_cast<double>(size.height)};
+      // The surface calls the destruction callback of the buffer when the
+      // engine is done with it.
+      auto surface = MakeSkSurfaceFromBackingStore(
+          nullptr, backing_store_config, &buffer);
+      if (surface) {
+        *acquired_buffer = buffer;
+      }
+      return surface;
+    };
+
+    software_dispatch_table.software_present_buffer =
+        [ptr = SAFE_ACCESS(software_config, present_buffer_callback, nullptr),
+         user_data, acquired_buffer](const sk_sp<SkSurface>& surface) {
+          SkPixmap pixmap;
+          if (!surface->peekPixels(&pixmap) ||
+              pixmap.addr() != acquired_buffer->allocation) {
+            FML_LOG(ERROR) << "Tried to present a software buffer that was "
+                              "not acquired for the frame.";
+            return false;
+          }
+          return ptr(user_data, acquired_buffer.get());
+        };
+  }
+
   return fml::MakeCopyable(
       [software_dispatch_table, platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        // Frames are rasterized in tiles on the concurrent workers of the
+        // shell if more than one thread is requested for them.
+        std::shared_ptr<const flutter::DlTiledDispatcher> tiled_dispatcher;
+        size_t raster_thread_count =
+            shell.GetSettings().software_raster_thread_count;
+        if (raster_thread_count > 1) {
+          tiled_dispatcher = std::make_shared<flutter::DlTiledDispatcher>(
+              shell.GetConcurrentWorkerTaskRunner(), raster_thread_count);
+        }
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            std::move(tiled_dispatcher)         // tiled dispatcher
         );
       });
 }
@@ -815,7 +936,7 @@ InferPlatformViewCreationCallback(
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
         external_view_embedder,
-    bool enable_impeller) {
+    const flutter::Settings& settings) {
   if (config == nullptr) {
     return nullptr;
   }
@@ -824,7 +945,7 @@ InferPlatformViewCreationCallback(
     case kOpenGL:
       return InferOpenGLPlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder), enable_impeller);
+          std::move(external_view_embedder), settings);
     case kSoftware:
       return InferSoftwarePlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
@@ -832,11 +953,11 @@ InferPlatformViewCreationCallback(
     case kMetal:
       return InferMetalPlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder), enable_impeller);
+          std::move(external_view_embedder), settings);
     case kVulkan:
       return InferVulkanPlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder), enable_impeller);
+          std::move(external_view_embedder), settings);
     default:
       return nullptr;
   }
@@ -2143,6 +2264,37 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
 
+  if (SAFE_ACCESS(args, frame_pacing, kFlutterFramePacingVsync) ==
+      kFlutterFramePacingThroughput) {
+    settings.enable_throughput_frame_pacing = true;
+  }
+
+  if (SAFE_ACCESS(args, frame_pipeline_depth, 0) != 0) {
+    settings.frame_pipeline_depth = args->frame_pipeline_depth;
+  }
+
+  if (SAFE_ACCESS(args, frame_complete_callback, nullptr) != nullptr) {
+    FlutterFrameCompleteCallback callback = args->frame_complete_callback;
+    settings.frame_rasterized_callback =
+        [callback, user_data](const flutter::FrameTiming& timing) {
+          auto nanos = [&timing](flutter::FrameTiming::Phase phase) {
+            return static_cast<uint64_t>(
+                timing.Get(phase).ToEpochDelta().ToNanoseconds());
+          };
+          FlutterFrameTimings timings = {
+              .struct_size = sizeof(FlutterFrameTimings),
+              .frame_number = timing.GetFrameNumber(),
+              .vsync_start_nanos = nanos(flutter::FrameTiming::kVsyncStart),
+              .build_start_nanos = nanos(flutter::FrameTiming::kBuildStart),
+              .build_finish_nanos = nanos(flutter::FrameTiming::kBuildFinish),
+              .raster_start_nanos = nanos(flutter::FrameTiming::kRasterStart),
+              .raster_finish_nanos =
+                  nanos(flutter::FrameTiming::kRasterFinish),
+          };
+          callback(&timings, user_data);
+        };
+  }
+
   bool has_update_semantics_2_callback =
       SAFE_ACCESS(args, update_semantics_callback2, nullptr) != nullptr;
   bool has_update_semantics_callback =
@@ -2302,8 +2454,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   auto on_create_platform_view = InferPlatformViewCreationCallback(
       config, user_data, platform_dispatch_table,
-      std::move(external_view_embedder_result.value()),
-      settings.enable_impeller);
+      std::move(external_view_embedder_result.value()), settings);
 
   if (!on_create_platform_view) {
     return LOG_EMBEDDER_ERROR(
@@ -801,6 +801,13 @@ typedef struct {
   /// ID. Not specifying populate_existing_damage will result in full
   /// repaint (i.e. rendering all the pixels on the screen at every frame).
   FlutterFrameBufferWithDamageCallback populate_existing_damage;
+  /// The maximum number of rectangles in the frame and buffer damage that are
+  /// passed to `present_with_info`. If this is 0 or 1, the damage is a single
+  /// rectangle that bounds all of the changes in the frame. Allowing more
+  /// rectangles lets the engine repaint separate changes, such as animations
+  /// in opposite corners of the screen, without repainting the area between
+  /// them.
+  size_t max_damage_rect_count;
 } FlutterOpenGLRendererConfig;
 
 /// Alias for id<MTLDevice>.
@@ -1024,6 +1031,39 @@ typedef struct {
 
 } FlutterVulkanRendererConfig;
 
+typedef struct {
+  /// A pointer to the raw bytes of the allocation described by this software
+  /// backing store.
+  const void* allocation;
+  /// The number of bytes in a single row of the allocation.
+  size_t row_bytes;
+  /// The number of rows in the allocation.
+  size_t height;
+  /// A baton that is not interpreted by the engine in any way. It will be given
+  /// back to the embedder in the destruction callback below. Embedder resources
+  /// may be associated with this baton.
+  void* user_data;
+  /// The callback invoked by the engine when it no longer needs this backing
+  /// store.
+  VoidCallback destruction_callback;
+} FlutterSoftwareBackingStore;
+
+/// Callback for when the engine needs a buffer of the embedder to render the
+/// next frame into. The embedder fills in the buffer, which must hold at least
+/// `frame_info->size.height` rows of `frame_info->size.width` pixels, and
+/// returns true, or returns false if it has no buffer. The `row_bytes` of the
+/// buffer must be at least 4 times `frame_info->size.width`, or the engine
+/// drops the frame.
+typedef bool (*FlutterSoftwareBufferAcquireCallback)(
+    void* /* user data */,
+    const FlutterFrameInfo* /* frame info */,
+    FlutterSoftwareBackingStore* /* buffer out */);
+
+/// Callback for when a frame was rendered into a buffer of the embedder.
+typedef bool (*FlutterSoftwareBufferPresentCallback)(
+    void* /* user data */,
+    const FlutterSoftwareBackingStore* /* buffer */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
@@ -1031,7 +1071,25 @@ typedef struct {
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
+  ///
+  /// Not used if `acquire_buffer_callback` is supplied, in which case this may
+  /// be null.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The callback invoked on the raster thread when the engine needs a buffer
+  /// to render the next frame into. If supplied, the engine renders directly
+  /// into the buffers of the embedder, which avoids copying the pixels of
+  /// every frame. The embedder may reuse a buffer once the engine invokes its
+  /// `destruction_callback`, which happens after the buffer is presented, or
+  /// when the frame is dropped.
+  ///
+  /// The pixel format of the buffer is the native 32-bit RGBA format.
+  /// Not used if a FlutterCompositor is supplied in FlutterProjectArgs.
+  FlutterSoftwareBufferAcquireCallback acquire_buffer_callback;
+  /// The callback invoked on the raster thread when a frame was rendered into
+  /// a buffer returned by `acquire_buffer_callback`.
+  ///
+  /// @attention required if `acquire_buffer_callback` is supplied.
+  FlutterSoftwareBufferPresentCallback present_buffer_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1873,6 +1931,38 @@ typedef void (*FlutterViewFocusChangeRequestCallback)(
     const FlutterViewFocusChangeRequest* /* request */,
     void* /* user data */);
 
+/// The timestamps of the phases of a rasterized frame, in nanoseconds of the
+/// clock used by `FlutterEngineGetCurrentTime`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimings).
+  size_t struct_size;
+  /// The number of the frame, which increases with every frame.
+  uint64_t frame_number;
+  /// The time at which the vsync signal that began the frame arrived.
+  uint64_t vsync_start_nanos;
+  /// The time at which the UI thread began to build the frame.
+  uint64_t build_start_nanos;
+  /// The time at which the UI thread finished building the frame.
+  uint64_t build_finish_nanos;
+  /// The time at which the raster thread began to rasterize the frame.
+  uint64_t raster_start_nanos;
+  /// The time at which the raster thread finished rasterizing the frame.
+  uint64_t raster_finish_nanos;
+} FlutterFrameTimings;
+
+typedef void (*FlutterFrameCompleteCallback)(
+    const FlutterFrameTimings* /* timings */,
+    void* /* user data */);
+
+typedef enum {
+  /// Frames begin on vsync. This is the default.
+  kFlutterFramePacingVsync,
+  /// Frames begin as soon as the UI and raster threads have room for them,
+  /// without waiting for vsync. This renders frames as fast as possible, for
+  /// rendering that is not shown on a display, such as rendering a video.
+  kFlutterFramePacingThroughput,
+} FlutterFramePacing;
+
 typedef struct _FlutterTaskRunner* FlutterTaskRunner;
 
 typedef struct {
@@ -1954,23 +2044,6 @@ typedef struct {
   };
 } FlutterOpenGLBackingStore;
 
-typedef struct {
-  /// A pointer to the raw bytes of the allocation described by this software
-  /// backing store.
-  const void* allocation;
-  /// The number of bytes in a single row of the allocation.
-  size_t row_bytes;
-  /// The number of rows in the allocation.
-  size_t height;
-  /// A baton that is not interpreted by the engine in any way. It will be given
-  /// back to the embedder in the destruction callback below. Embedder resources
-  /// may be associated with this baton.
-  void* user_data;
-  /// The callback invoked by the engine when it no longer needs this backing
-  /// store.
-  VoidCallback destruction_callback;
-} FlutterSoftwareBackingStore;
-
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareBackingStore2).
   size_t struct_size;
@@ -2793,6 +2866,19 @@ typedef struct {
   /// `PlatformDispatcher.instance.engineId`. Can be used in native code to
   /// retrieve the engine instance that is running the Dart code.
   int64_t engine_id;
+
+  /// How the engine paces the frames it renders.
+  FlutterFramePacing frame_pacing;
+
+  /// The number of frames that the UI thread may build while the raster thread
+  /// has not rasterized them yet, or 0 for the default of the platform. More
+  /// frames increase the throughput of `kFlutterFramePacingThroughput` at the
+  /// cost of latency.
+  size_t frame_pipeline_depth;
+
+  /// The callback invoked on the raster thread after every frame is
+  /// rasterized, with the timings of the frame. This callback is optional.
+  FlutterFrameCompleteCallback frame_complete_callback;
 } FlutterProjectArgs;
 
 typedef struct {
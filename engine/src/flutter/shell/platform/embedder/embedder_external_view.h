@@ -107,6 +107,9 @@ class EmbedderExternalView {
 
   const DlRegion& GetDlRegion() const;
 
+  // The DisplayList of the Flutter contents of this view.
+  sk_sp<DisplayList> GetDisplayList() const;
+
  private:
   // End the recording of the slice.
   // Noop if the slice's recording has already ended.
@@ -252,14 +252,32 @@ class Layer {
     render_target_ = std::move(target);
   }
 
+  /// Returns the contents that this layer renders when it is the layer at
+  /// `index` from the bottom of the frame.
+  EmbedderRenderTargetCache::RenderedContents GetRenderedContents(
+      size_t index,
+      const DlMatrix& surface_transformation) const {
+    EmbedderRenderTargetCache::RenderedContents contents;
+    contents.layer_index = index;
+    contents.surface_transformation = surface_transformation;
+    for (auto c : flutter_contents_) {
+      contents.display_lists.push_back(c->GetDisplayList());
+    }
+    return contents;
+  }
+
   /// Renders this layer Flutter contents to the render target previously
-  /// assigned with SetRenderTarget.
+  /// assigned with SetRenderTarget, unless the render target already holds
+  /// them from a previous frame.
   void RenderFlutterContents() {
     FML_DCHECK(has_flutter_contents());
-    if (render_target_) {
+    if (render_target_ && !render_target_reused_) {
       bool clear_surface = true;
       for (auto c : flutter_contents_) {
-        c->Render(*render_target_, clear_surface);
+        if (!c->Render(*render_target_, clear_surface)) {
+          // The render target must not be reused for these contents.
+          rendered_contents_.reset();
+        }
         clear_surface = false;
       }
     }
@@ -282,6 +300,10 @@ class Layer {
   std::vector<EmbedderExternalView*> flutter_contents_;
   DlRegion flutter_contents_region_;
   std::unique_ptr<EmbedderRenderTarget> render_target_;
+  // The contents of the render target once this layer is rendered.
+  std::optional<EmbedderRenderTargetCache::RenderedContents> rendered_contents_;
+  // Whether the render target already holds the contents of this layer.
+  bool render_target_reused_ = false;
   friend class LayerBuilder;
 };
 
@@ -298,8 +320,15 @@ class LayerBuilder {
   using RenderTargetProvider =
       std::function<std::unique_ptr<EmbedderRenderTarget>(
           const DlISize& frame_size)>;
+  using RenderedContents = EmbedderRenderTargetCache::RenderedContents;
+  using ReusableRenderTargetProvider =
+      std::function<std::unique_ptr<EmbedderRenderTarget>(
+          const DlISize& frame_size,
+          const RenderedContents& contents)>;
 
-  explicit LayerBuilder(DlISize frame_size) : frame_size_(frame_size) {
+  LayerBuilder(DlISize frame_size, const DlMatrix& surface_transformation)
+      : frame_size_(frame_size),
+        surface_transformation_(surface_transformation) {
     layers_.push_back(Layer());
   }
 
@@ -319,10 +348,38 @@ class LayerBuilder {
   }
 
   /// Prepares the render targets for all layers that have Flutter contents.
-  void PrepareBackingStore(const RenderTargetProvider& target_provider) {
+  ///
+  /// A layer whose contents are unchanged since a previous frame gets the
+  /// render target that holds them from `reusable_target_provider` and is
+  /// not rendered again. The other layers get a render target from
+  /// `target_provider`.
+  void PrepareBackingStore(
+      const RenderTargetProvider& target_provider,
+      const ReusableRenderTargetProvider& reusable_target_provider) {
+    // The reusable render targets are claimed first so that none of them is
+    // handed out to a layer with different contents.
+    for (size_t i = 0; i < layers_.size(); i++) {
+      Layer& layer = layers_[i];
+      if (!layer.has_flutter_contents()) {
+        continue;
+      }
+      layer.rendered_contents_ =
+          layer.GetRenderedContents(i, surface_transformation_);
+      auto target =
+          reusable_target_provider(frame_size_, *layer.rendered_contents_);
+      if (target != nullptr) {
+        target->SetDidUpdate(false);
+        layer.SetRenderTarget(std::move(target));
+        layer.render_target_reused_ = true;
+      }
+    }
     for (auto& layer : layers_) {
-      if (layer.has_flutter_contents()) {
-        layer.SetRenderTarget(target_provider(frame_size_));
+      if (layer.has_flutter_contents() && layer.render_target() == nullptr) {
+        auto target = target_provider(frame_size_);
+        if (target != nullptr) {
+          target->SetDidUpdate(true);
+        }
+        layer.SetRenderTarget(std::move(target));
       }
     }
   }
@@ -353,13 +410,18 @@ class LayerBuilder {
     }
   }
 
-  /// Removes the render targets from layers and returns them for collection.
-  std::vector<std::unique_ptr<EmbedderRenderTarget>>
+  /// Removes the render targets from layers and returns them for collection,
+  /// along with the contents that they hold.
+  std::vector<std::pair<std::unique_ptr<EmbedderRenderTarget>,
+                        std::optional<RenderedContents>>>
   ClearAndCollectRenderTargets() {
-    std::vector<std::unique_ptr<EmbedderRenderTarget>> result;
+    std::vector<std::pair<std::unique_ptr<EmbedderRenderTarget>,
+                          std::optional<RenderedContents>>>
+        result;
     for (auto& layer : layers_) {
       if (layer.render_target() != nullptr) {
-        result.push_back(std::move(layer.render_target_));
+        result.emplace_back(std::move(layer.render_target_),
+                            std::move(layer.rendered_contents_));
       }
     }
     layers_.clear();
@@ -419,6 +481,7 @@ class LayerBuilder {
 
   std::vector<Layer> layers_;
   DlISize frame_size_;
+  DlMatrix surface_transformation_;
 };
 
 };  // namespace
@@ -435,25 +498,37 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   DlRect _rect = DlRect::MakeSize(pending_frame_size_)
                      .TransformAndClipBounds(pending_surface_transformation_);
 
-  LayerBuilder builder(DlIRect::RoundOut(_rect).GetSize());
+  LayerBuilder builder(DlIRect::RoundOut(_rect).GetSize(),
+                       pending_surface_transformation_);
 
   for (auto view_id : composition_order_) {
     auto& view = pending_views_[view_id];
     builder.AddExternalView(view.get());
   }
 
-  builder.PrepareBackingStore([&](const DlISize& frame_size) {
-    if (!avoid_backing_store_cache_) {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          render_target_cache.GetRenderTarget(
-              EmbedderExternalView::RenderTargetDescriptor(frame_size));
-      if (target != nullptr) {
-        return target;
-      }
-    }
-    auto config = MakeBackingStoreConfig(flutter_view_id, frame_size);
-    return create_render_target_callback_(context, aiks_context, config);
-  });
+  builder.PrepareBackingStore(
+      [&](const DlISize& frame_size) {
+        if (!avoid_backing_store_cache_) {
+          std::unique_ptr<EmbedderRenderTarget> target =
+              render_target_cache.GetRenderTarget(
+                  EmbedderExternalView::RenderTargetDescriptor(frame_size));
+          if (target != nullptr) {
+            return target;
+          }
+        }
+        auto config = MakeBackingStoreConfig(flutter_view_id, frame_size);
+        return create_render_target_callback_(context, aiks_context, config);
+      },
+      [&](const DlISize& frame_size,
+          const EmbedderRenderTargetCache::RenderedContents& contents)
+          -> std::unique_ptr<EmbedderRenderTarget> {
+        if (avoid_backing_store_cache_) {
+          return nullptr;
+        }
+        return render_target_cache.GetRenderTargetWithContents(
+            EmbedderExternalView::RenderTargetDescriptor(frame_size),
+            contents);
+      });
 
   // This is where unused render targets will be collected. Control may flow
   // to the embedder. Here, the embedder has the opportunity to trample on the
@@ -518,9 +593,10 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   deferred_cleanup_render_targets.clear();
 
   auto render_targets = builder.ClearAndCollectRenderTargets();
-  for (auto& render_target : render_targets) {
+  for (auto& [render_target, contents] : render_targets) {
     if (!avoid_backing_store_cache_) {
-      render_target_cache.CacheRenderTarget(std::move(render_target));
+      render_target_cache.CacheRenderTarget(std::move(render_target),
+                                            std::move(contents));
     }
   }
 
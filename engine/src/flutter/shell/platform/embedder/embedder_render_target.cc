@@ -12,8 +12,6 @@ namespace flutter {
 EmbedderRenderTarget::EmbedderRenderTarget(FlutterBackingStore backing_store,
                                            fml::closure on_release)
     : backing_store_(backing_store), on_release_(std::move(on_release)) {
-  // TODO(38468): The optimization to elide backing store updates between frames
-  // has not been implemented yet.
   backing_store_.did_update = true;
 }
 
@@ -27,4 +25,8 @@ const FlutterBackingStore* EmbedderRenderTarget::GetBackingStore() const {
   return &backing_store_;
 }
 
+void EmbedderRenderTarget::SetDidUpdate(bool did_update) {
+  backing_store_.did_update = did_update;
+}
+
 }  // namespace flutter
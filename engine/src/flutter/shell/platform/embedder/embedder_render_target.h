@@ -91,6 +91,16 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the contents of the backing store were rendered
+  ///             again since the last time it was presented, which is
+  ///             reported to the embedder in the `did_update` field of the
+  ///             backing store.
+  ///
+  /// @param[in]  did_update  Whether the backing store was updated.
+  ///
+  void SetDidUpdate(bool did_update);
+
   //----------------------------------------------------------------------------
   /// @brief      Make the render target current.
   ///
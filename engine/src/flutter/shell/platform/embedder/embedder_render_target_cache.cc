@@ -6,6 +6,24 @@
 
 namespace flutter {
 
+bool EmbedderRenderTargetCache::RenderedContents::Equals(
+    const RenderedContents& other) const {
+  if (layer_index != other.layer_index ||
+      surface_transformation != other.surface_transformation ||
+      display_lists.size() != other.display_lists.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < display_lists.size(); i++) {
+    const DisplayList* display_list = display_lists[i].get();
+    const DisplayList* other_display_list = other.display_lists[i].get();
+    if (!display_list || !other_display_list ||
+        !display_list->Equals(other_display_list)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
@@ -17,29 +35,47 @@ EmbedderRenderTargetCache::GetRenderTarget(
   if (compatible_target == cached_render_targets_.end()) {
     return nullptr;
   }
-  auto target = std::move(compatible_target->second);
+  auto target = std::move(compatible_target->second.target);
   cached_render_targets_.erase(compatible_target);
   return target;
 }
 
+std::unique_ptr<EmbedderRenderTarget>
+EmbedderRenderTargetCache::GetRenderTargetWithContents(
+    const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+    const RenderedContents& contents) {
+  auto [begin, end] = cached_render_targets_.equal_range(descriptor);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second.contents.has_value() &&
+        it->second.contents->Equals(contents)) {
+      auto target = std::move(it->second.target);
+      cached_render_targets_.erase(it);
+      return target;
+    }
+  }
+  return nullptr;
+}
+
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
   for (auto& targets : cached_render_targets_) {
-    cleared_targets.insert(std::move(targets.second));
+    cleared_targets.insert(std::move(targets.second.target));
   }
   cached_render_targets_.clear();
   return cleared_targets;
 }
 
 void EmbedderRenderTargetCache::CacheRenderTarget(
-    std::unique_ptr<EmbedderRenderTarget> target) {
+    std::unique_ptr<EmbedderRenderTarget> target,
+    std::optional<RenderedContents> contents) {
   if (target == nullptr) {
     return;
   }
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
       target->GetRenderTargetSize()};
-  cached_render_targets_.insert(std::make_pair(desc, std::move(target)));
+  cached_render_targets_.insert(std::make_pair(
+      desc, CachedRenderTarget{std::move(target), std::move(contents)}));
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
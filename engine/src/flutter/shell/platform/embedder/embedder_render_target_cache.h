@@ -5,10 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <optional>
 #include <set>
 #include <stack>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
@@ -25,6 +27,20 @@ namespace flutter {
 ///
 class EmbedderRenderTargetCache {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      The contents that were rendered into a render target: the
+  ///             Flutter contents of the layer at `layer_index` from the
+  ///             bottom of a frame, rendered in order with the surface
+  ///             transformation.
+  ///
+  struct RenderedContents {
+    size_t layer_index = 0;
+    DlMatrix surface_transformation;
+    std::vector<sk_sp<DisplayList>> display_lists;
+
+    bool Equals(const RenderedContents& other) const;
+  };
+
   EmbedderRenderTargetCache();
 
   ~EmbedderRenderTargetCache();
@@ -32,17 +48,37 @@ class EmbedderRenderTargetCache {
   std::unique_ptr<EmbedderRenderTarget> GetRenderTarget(
       const EmbedderExternalView::RenderTargetDescriptor& descriptor);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a cached render target that already holds the given
+  ///             contents, so that they do not need to be rendered again, or
+  ///             nullptr if there is none.
+  ///
+  std::unique_ptr<EmbedderRenderTarget> GetRenderTargetWithContents(
+      const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+      const RenderedContents& contents);
+
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
-  void CacheRenderTarget(std::unique_ptr<EmbedderRenderTarget> target);
+  //----------------------------------------------------------------------------
+  /// @brief      Caches the render target along with the contents that it
+  ///             holds, if they are known.
+  ///
+  void CacheRenderTarget(
+      std::unique_ptr<EmbedderRenderTarget> target,
+      std::optional<RenderedContents> contents = std::nullopt);
 
   size_t GetCachedTargetsCount() const;
 
  private:
+  struct CachedRenderTarget {
+    std::unique_ptr<EmbedderRenderTarget> target;
+    std::optional<RenderedContents> contents;
+  };
+
   using CachedRenderTargets = std::unordered_multimap<
       EmbedderExternalView::RenderTargetDescriptor,
-      std::unique_ptr<EmbedderRenderTarget>,
+      CachedRenderTarget,
       EmbedderExternalView::RenderTargetDescriptor::Hash,
       EmbedderExternalView::RenderTargetDescriptor::Equal>;
 
@@ -45,6 +45,7 @@ class ReactorWorker final : public impeller::ReactorGLES::Worker {
 EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
     EmbedderSurfaceGLSkia::GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
+    const impeller::Flags& impeller_flags,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : gl_dispatch_table_(std::move(gl_dispatch_table)),
       fbo_reset_after_present_(fbo_reset_after_present),
@@ -81,7 +82,7 @@ EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
   }
 
   impeller_context_ = impeller::ContextGLES::Create(
-      impeller::Flags{}, std::move(gl), shader_mappings,
+      impeller_flags, std::move(gl), shader_mappings,
       /*enable_gpu_tracing=*/false);
 
   if (!impeller_context_) {
@@ -90,6 +90,7 @@ SurfaceFrame::FramebufferInfo EmbedderSurfaceGLSkia::GLContextFramebufferInfo()
   info.supports_readback = true;
   info.supports_partial_repaint =
       gl_dispatch_table_.gl_populate_existing_damage != nullptr;
+  info.max_damage_rect_count = gl_dispatch_table_.max_damage_rect_count;
   return info;
 }
 
@@ -12,6 +12,7 @@
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 #include "flutter/shell/platform/embedder/embedder_surface.h"
 #include "fml/concurrent_message_loop.h"
+#include "impeller/base/flags.h"
 #include "impeller/display_list/aiks_context.h"
 
 namespace impeller {
@@ -33,6 +34,7 @@ class EmbedderSurfaceMetalImpeller final : public EmbedderSurface,
       GPUMTLDeviceHandle device,
       GPUMTLCommandQueueHandle command_queue,
       MetalDispatchTable dispatch_table,
+      const impeller::Flags& impeller_flags,
       std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
 
   ~EmbedderSurfaceMetalImpeller() override;
@@ -28,6 +28,7 @@ EmbedderSurfaceMetalImpeller::EmbedderSurfaceMetalImpeller(
     GPUMTLDeviceHandle device,
     GPUMTLCommandQueueHandle command_queue,
     MetalDispatchTable metal_dispatch_table,
+    const impeller::Flags& impeller_flags,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : GPUSurfaceMetalDelegate(MTLRenderTargetType::kMTLTexture),
       metal_dispatch_table_(std::move(metal_dispatch_table)),
@@ -41,7 +42,7 @@ EmbedderSurfaceMetalImpeller::EmbedderSurfaceMetalImpeller(
                                              impeller_framebuffer_blend_shaders_length),
   };
   context_ = impeller::ContextMTL::Create(
-      impeller::Flags{},
+      impeller_flags,
       (__bridge id<MTLDevice>)device,               // device
       (__bridge id<MTLCommandQueue>)command_queue,  // command_queue
       shader_mappings,                              // shader_libraries_data
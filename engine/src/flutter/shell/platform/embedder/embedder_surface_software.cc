@@ -17,10 +17,16 @@ namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    std::shared_ptr<const DlTiledDispatcher> tiled_dispatcher)
     : software_dispatch_table_(std::move(software_dispatch_table)),
-      external_view_embedder_(std::move(external_view_embedder)) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+      external_view_embedder_(std::move(external_view_embedder)),
+      tiled_dispatcher_(std::move(tiled_dispatcher)) {
+  if (software_dispatch_table_.software_acquire_buffer) {
+    if (!software_dispatch_table_.software_present_buffer) {
+      return;
+    }
+  } else if (!software_dispatch_table_.software_present_backing_store) {
     return;
   }
   valid_ = true;
@@ -39,7 +45,8 @@ std::unique_ptr<Surface> EmbedderSurfaceSoftware::CreateGPUSurface() {
     return nullptr;
   }
   const bool render_to_surface = !external_view_embedder_;
-  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface);
+  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface,
+                                                      tiled_dispatcher_);
 
   if (!surface->IsValid()) {
     return nullptr;
@@ -63,6 +70,12 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
+  if (software_dispatch_table_.software_acquire_buffer) {
+    // Every frame renders into a new buffer of the embedder, which the
+    // embedder may reuse once the surface is released.
+    return software_dispatch_table_.software_acquire_buffer(size);
+  }
+
   if (sk_surface_ != nullptr &&  //
       size.width == sk_surface_->width() &&
       size.height == sk_surface_->height()) {
@@ -90,6 +103,10 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
+  if (software_dispatch_table_.software_acquire_buffer) {
+    return software_dispatch_table_.software_present_buffer(backing_store);
+  }
+
   SkPixmap pixmap;
   if (!backing_store->peekPixels(&pixmap)) {
     FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
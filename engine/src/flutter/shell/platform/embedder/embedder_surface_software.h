@@ -19,12 +19,20 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  public:
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // required unless buffers are acquired
+    // Returns a surface that renders into a buffer of the embedder.
+    std::function<sk_sp<SkSurface>(const DlISize& size)>
+        software_acquire_buffer;  // optional
+    // Presents a surface returned by |software_acquire_buffer|.
+    std::function<bool(const sk_sp<SkSurface>& surface)>
+        software_present_buffer;  // required with software_acquire_buffer
   };
 
+  // If |tiled_dispatcher| is set, frames are rasterized in parallel tiles.
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<const DlTiledDispatcher> tiled_dispatcher = nullptr);
 
   ~EmbedderSurfaceSoftware() override;
 
@@ -33,6 +41,7 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  std::shared_ptr<const DlTiledDispatcher> tiled_dispatcher_;
 
   // |EmbedderSurface|
   bool IsValid() const override;
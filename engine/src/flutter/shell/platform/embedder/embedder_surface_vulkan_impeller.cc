@@ -29,6 +29,7 @@ EmbedderSurfaceVulkanImpeller::EmbedderSurfaceVulkanImpeller(
     uint32_t queue_family_index,
     VkQueue queue,
     const VulkanDispatchTable& vulkan_dispatch_table,
+    const impeller::Flags& impeller_flags,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : vk_(fml::MakeRefCounted<vulkan::VulkanProcTable>(
           vulkan_dispatch_table.get_instance_proc_address)),
@@ -51,6 +52,7 @@ EmbedderSurfaceVulkanImpeller::EmbedderSurfaceVulkanImpeller(
           impeller_framebuffer_blend_shaders_vk_length),
   };
   impeller::ContextVK::Settings settings;
+  settings.flags = impeller_flags;
   settings.shader_libraries_data = shader_mappings;
   settings.proc_address_callback =
       vulkan_dispatch_table.get_instance_proc_address;
@@ -923,6 +923,57 @@ void render_gradient() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void render_gradient_continuously() {
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    const size = Size(800.0, 600.0);
+
+    final builder = SceneBuilder();
+
+    builder.pushOffset(0.0, 0.0);
+
+    builder.addPicture(Offset.zero, createGradientBox(size)); // gradient - flutter
+
+    builder.pop();
+
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    PlatformDispatcher.instance.scheduleFrame();
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void render_gradient_three_times() {
+  const frameLimit = 3;
+  var frameCount = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    // Frames that begin before the window metrics arrive are not rendered.
+    final view = PlatformDispatcher.instance.views.first;
+    if (frameCount == frameLimit || view.physicalSize.isEmpty) {
+      return;
+    }
+    frameCount++;
+
+    const size = Size(800.0, 600.0);
+
+    final builder = SceneBuilder();
+
+    builder.pushOffset(0.0, 0.0);
+
+    builder.addPicture(Offset.zero, createGradientBox(size)); // gradient - flutter
+
+    builder.pop();
+
+    view.render(builder.build());
+    if (frameCount < frameLimit) {
+      PlatformDispatcher.instance.scheduleFrame();
+    }
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void render_texture() {
@@ -1312,6 +1363,27 @@ void render_targets_are_in_stable_order() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void reuses_unchanged_backing_stores() {
+  var frameCount = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    const size = Size(300.0, 200.0);
+    // Only the picture above the platform view changes, in the third frame.
+    final topColor = frameCount < 2 ? const Color(0xFF0000FF) : const Color(0xFF00FF00);
+    final builder = SceneBuilder();
+    builder.addPicture(Offset.zero, createColoredBox(const Color(0xFFFF0000), size));
+    builder.addPlatformView(42, width: size.width, height: size.height);
+    builder.addPicture(Offset.zero, createColoredBox(topColor, size));
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    frameCount++;
+    if (frameCount < 3) {
+      PlatformDispatcher.instance.scheduleFrame();
+    }
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:external-name', 'NativeArgumentsCallback')
 external void nativeArgumentsCallback(List<String> args);
 
@@ -1557,6 +1629,37 @@ void render_gradient_retained() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void render_separated_boxes_retained() {
+  OffsetEngineLayer? offsetLayer; // Retain the offset layer.
+  var frameCount = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    const size = Size(100.0, 100.0);
+    // The boxes change color on every frame, so that each of them damages
+    // its own 100x100 area of the 800x600 frame.
+    final color = frameCount++.isEven
+        ? const Color.fromARGB(255, 255, 0, 0)
+        : const Color.fromARGB(255, 0, 0, 255);
+
+    final builder = SceneBuilder();
+
+    offsetLayer = builder.pushOffset(0.0, 0.0, oldLayer: offsetLayer);
+
+    builder.addPicture(Offset.zero, createColoredBox(color, size));
+    builder.addPicture(const Offset(600.0, 0.0), createColoredBox(color, size));
+    builder.addPicture(
+      const Offset(600.0, 400.0),
+      createColoredBox(color, size),
+    );
+
+    builder.pop();
+
+    PlatformDispatcher.instance.views.first.render(builder.build());
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void render_impeller_test() {
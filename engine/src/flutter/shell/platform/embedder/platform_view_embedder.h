@@ -62,14 +62,16 @@ class PlatformViewEmbedder final : public PlatformView {
         view_focus_change_request_callback;  // optional
   };
 
-  // Create a platform view that sets up a software rasterizer.
+  // Create a platform view that sets up a software rasterizer. If
+  // |tiled_dispatcher| is set, frames are rasterized in parallel tiles.
   PlatformViewEmbedder(
       PlatformView::Delegate& delegate,
       const flutter::TaskRunners& task_runners,
       const EmbedderSurfaceSoftware::SoftwareDispatchTable&
           software_dispatch_table,
       PlatformDispatchTable platform_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<const DlTiledDispatcher> tiled_dispatcher = nullptr);
 
 #ifdef SHELL_ENABLE_GL
   // Creates a platform view that sets up an OpenGL rasterizer.
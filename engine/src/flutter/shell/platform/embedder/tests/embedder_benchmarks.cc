@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include <atomic>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
+#include "flutter/testing/testing.h"
+
+#ifdef SHELL_ENABLE_VULKAN
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_vulkan.h"
+#endif  // SHELL_ENABLE_VULKAN
+
+namespace flutter::testing {
+
+namespace {
+
+// Renders frames with |context| as fast as the engine can, without vsync, and
+// reports the number of frames that were rendered per second.
+void RenderFramesAtMaxThroughput(benchmark::State& state,
+                                 EmbedderTestContext& context,
+                                 bool enable_impeller) {
+  std::atomic<int64_t> frame_count = 0;
+  fml::AutoResetWaitableEvent frame_latch;
+  context.SetFrameCompleteCallback([&](const FlutterFrameTimings* timings) {
+    frame_count++;
+    frame_latch.Signal();
+  });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("render_gradient_continuously");
+  builder.SetSurface(DlISize(800, 600));
+  builder.SetupFrameCompleteCallback();
+  builder.GetProjectArgs().frame_pacing = kFlutterFramePacingThroughput;
+  if (enable_impeller) {
+    builder.AddCommandLineArgument("--enable-impeller");
+  }
+
+  auto engine = builder.LaunchEngine();
+  if (!engine.is_valid()) {
+    state.SkipWithError("Could not launch the engine.");
+    return;
+  }
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  if (FlutterEngineSendWindowMetricsEvent(engine.get(), &event) != kSuccess) {
+    state.SkipWithError("Could not send the window metrics.");
+    return;
+  }
+
+  // The first frame includes the startup of the root isolate.
+  frame_latch.Wait();
+  const int64_t start_frame_count = frame_count;
+  for (auto _ : state) {
+    frame_latch.Wait();
+  }
+  state.counters["FramesPerSecond"] = benchmark::Counter(
+      static_cast<double>(frame_count - start_frame_count),
+      benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+// Arg(0) presents buffers of the engine that the embedder copies, and Arg(1)
+// renders into a pool of buffers of the embedder.
+static void BM_EmbedderSoftwareFrameThroughput(benchmark::State& state) {
+  EmbedderTestContextSoftware context(GetFixturesPath());
+  if (state.range(0) != 0) {
+    context.SetupBufferPool();
+  }
+  RenderFramesAtMaxThroughput(state, context, /*enable_impeller=*/false);
+}
+BENCHMARK(BM_EmbedderSoftwareFrameThroughput)
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+#ifdef SHELL_ENABLE_VULKAN
+// Renders with Impeller on the Vulkan context of the tests, which is backed by
+// SwiftShader.
+static void BM_EmbedderImpellerVulkanFrameThroughput(benchmark::State& state) {
+  EmbedderTestContextVulkan context(GetFixturesPath());
+  RenderFramesAtMaxThroughput(state, context, /*enable_impeller=*/true);
+}
+BENCHMARK(BM_EmbedderImpellerVulkanFrameThroughput)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+#endif  // SHELL_ENABLE_VULKAN
+
+}  // namespace flutter::testing
@@ -185,6 +185,14 @@ void EmbedderConfigBuilder::SetupVsyncCallback() {
   };
 }
 
+void EmbedderConfigBuilder::SetupFrameCompleteCallback() {
+  project_args_.frame_complete_callback = [](const FlutterFrameTimings* timings,
+                                             void* user_data) {
+    auto context = reinterpret_cast<EmbedderTestContext*>(user_data);
+    context->RunFrameCompleteCallback(timings);
+  };
+}
+
 void EmbedderConfigBuilder::SetRenderTaskRunner(
     const FlutterTaskRunnerDescription* runner) {
   if (runner == nullptr) {
@@ -107,6 +107,10 @@ class EmbedderConfigBuilder {
   // text context vis `SetVsyncCallback`.
   void SetupVsyncCallback();
 
+  // Sets up the callback for rasterized frames, the callback needs to be
+  // specified on the test context via `SetFrameCompleteCallback`.
+  void SetupFrameCompleteCallback();
+
   void SetViewFocusChangeRequestCallback(
       const FlutterViewFocusChangeRequestCallback& callback);
 
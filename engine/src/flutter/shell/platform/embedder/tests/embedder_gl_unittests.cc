@@ -33,6 +33,7 @@
 #include "flutter/testing/assertions_skia.h"
 #include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
+#include "impeller/renderer/context.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
@@ -3930,6 +3931,293 @@ TEST_F(EmbedderTest, PresentInfoReceivesPartialDamage) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, PresentInfoReceivesSeparateDamageRects) {
+  auto& context = GetEmbedderContext<EmbedderTestContextGL>();
+  context.GetRendererConfig().open_gl.max_damage_rect_count = 4;
+  context.GetRendererConfig().open_gl.populate_existing_damage =
+      [](void* context, const intptr_t id,
+         FlutterDamage* existing_damage) -> void {
+    return reinterpret_cast<EmbedderTestContextGL*>(context)
+        ->GLPopulateExistingDamage(id, existing_damage);
+  };
+  // Return no existing damage on purpose.
+  context.SetGLPopulateExistingDamageCallback(
+      [](const intptr_t id, FlutterDamage* existing_damage_ptr) {
+        const size_t num_rects = 1;
+        // The array must be valid after the callback returns.
+        static FlutterRect existing_damage_rects[num_rects] = {
+            FlutterRect{0, 0, 0, 0}};
+        existing_damage_ptr->num_rects = num_rects;
+        existing_damage_ptr->damage = existing_damage_rects;
+      });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(800, 600));
+  builder.SetDartEntrypoint("render_separated_boxes_retained");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent latch;
+
+  // First frame should be entirely rerendered, as a single rectangle.
+  context.SetGLPresentCallback([&](FlutterPresentInfo present_info) {
+    const size_t num_rects = 1;
+    ASSERT_EQ(present_info.frame_damage.num_rects, num_rects);
+    ASSERT_EQ(present_info.frame_damage.damage->left, 0);
+    ASSERT_EQ(present_info.frame_damage.damage->top, 0);
+    ASSERT_EQ(present_info.frame_damage.damage->right, 800);
+    ASSERT_EQ(present_info.frame_damage.damage->bottom, 600);
+
+    ASSERT_EQ(present_info.buffer_damage.num_rects, num_rects);
+    ASSERT_EQ(present_info.buffer_damage.damage->left, 0);
+    ASSERT_EQ(present_info.buffer_damage.damage->top, 0);
+    ASSERT_EQ(present_info.buffer_damage.damage->right, 800);
+    ASSERT_EQ(present_info.buffer_damage.damage->bottom, 600);
+
+    latch.Signal();
+  });
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+
+  // The second frame changes the color of the three boxes, which are far
+  // enough apart to each be damaged on their own.
+  context.SetGLPresentCallback([&](FlutterPresentInfo present_info) {
+    const size_t num_rects = 3;
+    for (const FlutterDamage& damage :
+         {present_info.frame_damage, present_info.buffer_damage}) {
+      ASSERT_EQ(damage.num_rects, num_rects);
+      ASSERT_EQ(damage.damage[0].left, 0);
+      ASSERT_EQ(damage.damage[0].top, 0);
+      ASSERT_EQ(damage.damage[0].right, 100);
+      ASSERT_EQ(damage.damage[0].bottom, 100);
+
+      ASSERT_EQ(damage.damage[1].left, 600);
+      ASSERT_EQ(damage.damage[1].top, 0);
+      ASSERT_EQ(damage.damage[1].right, 700);
+      ASSERT_EQ(damage.damage[1].bottom, 100);
+
+      ASSERT_EQ(damage.damage[2].left, 600);
+      ASSERT_EQ(damage.damage[2].top, 400);
+      ASSERT_EQ(damage.damage[2].right, 700);
+      ASSERT_EQ(damage.damage[2].bottom, 500);
+    }
+
+    latch.Signal();
+  });
+
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+}
+
+TEST_F(EmbedderTest, PresentInfoReceivesMergedDamageRects) {
+  auto& context = GetEmbedderContext<EmbedderTestContextGL>();
+  context.GetRendererConfig().open_gl.max_damage_rect_count = 2;
+  context.GetRendererConfig().open_gl.populate_existing_damage =
+      [](void* context, const intptr_t id,
+         FlutterDamage* existing_damage) -> void {
+    return reinterpret_cast<EmbedderTestContextGL*>(context)
+        ->GLPopulateExistingDamage(id, existing_damage);
+  };
+  // Return no existing damage on purpose.
+  context.SetGLPopulateExistingDamageCallback(
+      [](const intptr_t id, FlutterDamage* existing_damage_ptr) {
+        const size_t num_rects = 1;
+        // The array must be valid after the callback returns.
+        static FlutterRect existing_damage_rects[num_rects] = {
+            FlutterRect{0, 0, 0, 0}};
+        existing_damage_ptr->num_rects = num_rects;
+        existing_damage_ptr->damage = existing_damage_rects;
+      });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(800, 600));
+  builder.SetDartEntrypoint("render_separated_boxes_retained");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent latch;
+
+  context.SetGLPresentCallback(
+      [&](FlutterPresentInfo present_info) { latch.Signal(); });
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+
+  // Only two of the three damaged boxes may be reported, so the two boxes on
+  // the right, whose bounds add the least area, are merged.
+  context.SetGLPresentCallback([&](FlutterPresentInfo present_info) {
+    const size_t num_rects = 2;
+    for (const FlutterDamage& damage :
+         {present_info.frame_damage, present_info.buffer_damage}) {
+      ASSERT_EQ(damage.num_rects, num_rects);
+      ASSERT_EQ(damage.damage[0].left, 0);
+      ASSERT_EQ(damage.damage[0].top, 0);
+      ASSERT_EQ(damage.damage[0].right, 100);
+      ASSERT_EQ(damage.damage[0].bottom, 100);
+
+      ASSERT_EQ(damage.damage[1].left, 600);
+      ASSERT_EQ(damage.damage[1].top, 0);
+      ASSERT_EQ(damage.damage[1].right, 700);
+      ASSERT_EQ(damage.damage[1].bottom, 500);
+    }
+
+    latch.Signal();
+  });
+
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+}
+
+TEST_F(EmbedderTest, PresentInfoReceivesSeparateExistingDamageRects) {
+  auto& context = GetEmbedderContext<EmbedderTestContextGL>();
+  context.GetRendererConfig().open_gl.max_damage_rect_count = 4;
+  context.GetRendererConfig().open_gl.populate_existing_damage =
+      [](void* context, const intptr_t id,
+         FlutterDamage* existing_damage) -> void {
+    return reinterpret_cast<EmbedderTestContextGL*>(context)
+        ->GLPopulateExistingDamage(id, existing_damage);
+  };
+  // Return existing damage in two opposite corners of the screen on purpose.
+  context.SetGLPopulateExistingDamageCallback(
+      [](const intptr_t id, FlutterDamage* existing_damage_ptr) {
+        const size_t num_rects = 2;
+        // The array must be valid after the callback returns.
+        static FlutterRect existing_damage_rects[num_rects] = {
+            FlutterRect{0, 0, 100, 100}, FlutterRect{600, 400, 700, 500}};
+        existing_damage_ptr->num_rects = num_rects;
+        existing_damage_ptr->damage = existing_damage_rects;
+      });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(800, 600));
+  builder.SetDartEntrypoint("render_gradient_retained");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent latch;
+
+  context.SetGLPresentCallback(
+      [&](FlutterPresentInfo present_info) { latch.Signal(); });
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+
+  // The second frame is the same as the first, so the frame damage is empty
+  // and the buffer damage is each of the existing damage rectangles, rather
+  // than their bounds spanning both corners.
+  context.SetGLPresentCallback([&](FlutterPresentInfo present_info) {
+    ASSERT_EQ(present_info.frame_damage.num_rects, 1u);
+    ASSERT_EQ(present_info.frame_damage.damage->left, 0);
+    ASSERT_EQ(present_info.frame_damage.damage->top, 0);
+    ASSERT_EQ(present_info.frame_damage.damage->right, 0);
+    ASSERT_EQ(present_info.frame_damage.damage->bottom, 0);
+
+    ASSERT_EQ(present_info.buffer_damage.num_rects, 2u);
+    ASSERT_EQ(present_info.buffer_damage.damage[0].left, 0);
+    ASSERT_EQ(present_info.buffer_damage.damage[0].top, 0);
+    ASSERT_EQ(present_info.buffer_damage.damage[0].right, 100);
+    ASSERT_EQ(present_info.buffer_damage.damage[0].bottom, 100);
+
+    ASSERT_EQ(present_info.buffer_damage.damage[1].left, 600);
+    ASSERT_EQ(present_info.buffer_damage.damage[1].top, 400);
+    ASSERT_EQ(present_info.buffer_damage.damage[1].right, 700);
+    ASSERT_EQ(present_info.buffer_damage.damage[1].bottom, 500);
+
+    latch.Signal();
+  });
+
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+}
+
+TEST_F(EmbedderTest, PresentInfoReceivesDamageBoundsByDefault) {
+  auto& context = GetEmbedderContext<EmbedderTestContextGL>();
+  context.GetRendererConfig().open_gl.populate_existing_damage =
+      [](void* context, const intptr_t id,
+         FlutterDamage* existing_damage) -> void {
+    return reinterpret_cast<EmbedderTestContextGL*>(context)
+        ->GLPopulateExistingDamage(id, existing_damage);
+  };
+  // Return no existing damage on purpose.
+  context.SetGLPopulateExistingDamageCallback(
+      [](const intptr_t id, FlutterDamage* existing_damage_ptr) {
+        const size_t num_rects = 1;
+        // The array must be valid after the callback returns.
+        static FlutterRect existing_damage_rects[num_rects] = {
+            FlutterRect{0, 0, 0, 0}};
+        existing_damage_ptr->num_rects = num_rects;
+        existing_damage_ptr->damage = existing_damage_rects;
+      });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(800, 600));
+  builder.SetDartEntrypoint("render_separated_boxes_retained");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent latch;
+
+  context.SetGLPresentCallback(
+      [&](FlutterPresentInfo present_info) { latch.Signal(); });
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+
+  // Without max_damage_rect_count, the damage is the bounds of the boxes.
+  context.SetGLPresentCallback([&](FlutterPresentInfo present_info) {
+    const size_t num_rects = 1;
+    ASSERT_EQ(present_info.frame_damage.num_rects, num_rects);
+    ASSERT_EQ(present_info.frame_damage.damage->left, 0);
+    ASSERT_EQ(present_info.frame_damage.damage->top, 0);
+    ASSERT_EQ(present_info.frame_damage.damage->right, 700);
+    ASSERT_EQ(present_info.frame_damage.damage->bottom, 500);
+
+    ASSERT_EQ(present_info.buffer_damage.num_rects, num_rects);
+    ASSERT_EQ(present_info.buffer_damage.damage->left, 0);
+    ASSERT_EQ(present_info.buffer_damage.damage->top, 0);
+    ASSERT_EQ(present_info.buffer_damage.damage->right, 700);
+    ASSERT_EQ(present_info.buffer_damage.damage->bottom, 500);
+
+    latch.Signal();
+  });
+
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+}
+
 TEST_F(EmbedderTest, PopulateExistingDamageReceivesValidID) {
   auto& context = GetEmbedderContext<EmbedderTestContextGL>();
   context.GetRendererConfig().open_gl.populate_existing_damage =
@@ -4856,6 +5144,32 @@ TEST_F(EmbedderTest, ImpellerOpenGLImageSnapshot) {
   ASSERT_TRUE(result);
 }
 
+TEST_F(EmbedderTest, ImpellerOpenGLContextReceivesImpellerFlags) {
+  auto& context = GetEmbedderContext<EmbedderTestContextGL>();
+  fml::AutoResetWaitableEvent latch;
+  context.AddIsolateCreateCallback([&latch]() { latch.Signal(); });
+
+  EmbedderConfigBuilder builder(context);
+  builder.AddCommandLineArgument("--enable-impeller");
+  builder.AddCommandLineArgument("--impeller-analytic-path-fills");
+  builder.SetDartEntrypoint("render_impeller_test");
+  builder.SetSurface(DlISize(800, 600));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  // Wait for the root isolate to launch.
+  latch.Wait();
+
+  flutter::Shell& shell = ToEmbedderEngine(engine.get())->GetShell();
+  std::shared_ptr<impeller::Context> impeller_context =
+      shell.GetPlatformView()->GetImpellerContext();
+  ASSERT_TRUE(impeller_context);
+  EXPECT_TRUE(impeller_context->GetFlags().analytic_path_fills);
+  EXPECT_FALSE(impeller_context->GetFlags().antialiased_lines);
+
+  engine.reset();
+}
+
 TEST_F(EmbedderTest, CompositorMustBeAbleToRenderToOpenGLSurface) {
   auto& context = GetEmbedderContext<EmbedderTestContextGL>();
 
@@ -320,5 +320,15 @@ void EmbedderTestContext::RunVsyncCallback(intptr_t baton) {
   vsync_callback_(baton);
 }
 
+void EmbedderTestContext::SetFrameCompleteCallback(
+    std::function<void(const FlutterFrameTimings*)> callback) {
+  frame_complete_callback_ = std::move(callback);
+}
+
+void EmbedderTestContext::RunFrameCompleteCallback(
+    const FlutterFrameTimings* timings) {
+  frame_complete_callback_(timings);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -117,6 +117,15 @@ class EmbedderTestContext {
   // Runs the vsync callback.
   void RunVsyncCallback(intptr_t baton);
 
+  // Sets up the callback for rasterized frames. This callback will be invoked
+  // on the raster thread for every frame. This should be used in conjunction
+  // with SetupFrameCompleteCallback on the EmbedderConfigBuilder.
+  void SetFrameCompleteCallback(
+      std::function<void(const FlutterFrameTimings*)> callback);
+
+  // Runs the frame complete callback.
+  void RunFrameCompleteCallback(const FlutterFrameTimings* timings);
+
   // TODO(gw280): encapsulate these properly for subclasses to use
  protected:
   // This allows the builder to access the hooks.
@@ -146,6 +155,8 @@ class EmbedderTestContext {
   NextSceneCallback next_scene_callback_;
   DlMatrix root_surface_transformation_;
   std::function<void(intptr_t)> vsync_callback_ = nullptr;
+  std::function<void(const FlutterFrameTimings*)> frame_complete_callback_ =
+      nullptr;
 
   static VoidCallback GetIsolateCreateCallbackHook();
 
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
@@ -14,6 +15,7 @@
 #include "flutter/testing/testing.h"
 #include "third_party/dart/runtime/bin/elf_loader.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter::testing {
@@ -64,8 +66,111 @@ size_t EmbedderTestContextSoftware::GetSurfacePresentCount() const {
 
 bool EmbedderTestContextSoftware::Present(const sk_sp<SkImage>& image) {
   software_surface_present_count_++;
+  copied_frame_count_++;
   FireRootSurfacePresentCallbackIfPresent([image] { return image; });
   return true;
 }
 
+void EmbedderTestContextSoftware::SetupBufferPool() {
+  renderer_config_.software.acquire_buffer_callback =
+      [](void* context, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBackingStore* buffer_out) {
+        return reinterpret_cast<EmbedderTestContextSoftware*>(context)
+            ->AcquireBuffer(frame_info, buffer_out);
+      };
+  renderer_config_.software.present_buffer_callback =
+      [](void* context, const FlutterSoftwareBackingStore* buffer) {
+        return reinterpret_cast<EmbedderTestContextSoftware*>(context)
+            ->PresentBuffer(buffer);
+      };
+}
+
+size_t EmbedderTestContextSoftware::GetBufferPoolSize() const {
+  std::scoped_lock lock(buffer_pool_mutex_);
+  return buffer_pool_.size();
+}
+
+size_t EmbedderTestContextSoftware::GetBufferAcquireCount() const {
+  std::scoped_lock lock(buffer_pool_mutex_);
+  return buffer_acquire_count_;
+}
+
+size_t EmbedderTestContextSoftware::GetBufferPresentCount() const {
+  std::scoped_lock lock(buffer_pool_mutex_);
+  return buffer_present_count_;
+}
+
+size_t EmbedderTestContextSoftware::GetBufferDestructionCount() const {
+  std::scoped_lock lock(buffer_pool_mutex_);
+  return buffer_destruction_count_;
+}
+
+size_t EmbedderTestContextSoftware::GetCopiedFrameCount() const {
+  return copied_frame_count_;
+}
+
+bool EmbedderTestContextSoftware::AcquireBuffer(
+    const FlutterFrameInfo* frame_info,
+    FlutterSoftwareBackingStore* buffer_out) {
+  const DlISize size(frame_info->size.width, frame_info->size.height);
+  PooledBuffer* buffer = nullptr;
+  {
+    std::scoped_lock lock(buffer_pool_mutex_);
+    buffer_acquire_count_++;
+    auto it = std::find_if(
+        free_buffers_.begin(), free_buffers_.end(),
+        [&size](const PooledBuffer* free) { return free->size == size; });
+    if (it != free_buffers_.end()) {
+      buffer = *it;
+      free_buffers_.erase(it);
+    } else {
+      auto new_buffer = std::make_unique<PooledBuffer>();
+      new_buffer->context = this;
+      new_buffer->size = size;
+      new_buffer->pixels.resize(size.width * size.height);
+      buffer = new_buffer.get();
+      buffer_pool_.push_back(std::move(new_buffer));
+    }
+  }
+
+  buffer_out->allocation = buffer->pixels.data();
+  buffer_out->row_bytes = size.width * sizeof(uint32_t);
+  buffer_out->height = size.height;
+  buffer_out->user_data = buffer;
+  buffer_out->destruction_callback = [](void* user_data) {
+    auto buffer = reinterpret_cast<PooledBuffer*>(user_data);
+    std::scoped_lock lock(buffer->context->buffer_pool_mutex_);
+    buffer->context->buffer_destruction_count_++;
+    buffer->context->free_buffers_.push_back(buffer);
+  };
+  return true;
+}
+
+bool EmbedderTestContextSoftware::PresentBuffer(
+    const FlutterSoftwareBackingStore* buffer) {
+  software_surface_present_count_++;
+  {
+    std::scoped_lock lock(buffer_pool_mutex_);
+    // Only buffers of the pool that the engine has not returned yet count,
+    // so that the count shows that the frames were rendered into them.
+    auto pooled = std::find_if(
+        buffer_pool_.begin(), buffer_pool_.end(),
+        [buffer](const std::unique_ptr<PooledBuffer>& pooled) {
+          return pooled->pixels.data() == buffer->allocation;
+        });
+    if (pooled != buffer_pool_.end() &&
+        std::find(free_buffers_.begin(), free_buffers_.end(),
+                  pooled->get()) == free_buffers_.end()) {
+      buffer_present_count_++;
+    }
+  }
+  // The buffer returns to the pool after this call, so the scene is a copy.
+  SkPixmap pixmap(SkImageInfo::MakeN32Premul(
+                      buffer->row_bytes / sizeof(uint32_t), buffer->height),
+                  buffer->allocation, buffer->row_bytes);
+  FireRootSurfacePresentCallbackIfPresent(
+      [pixmap] { return SkImages::RasterFromPixmapCopy(pixmap); });
+  return true;
+}
+
 }  // namespace flutter::testing
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_TEST_CONTEXT_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_TEST_CONTEXT_SOFTWARE_H_
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "flutter/shell/platform/embedder/tests/embedder_test_context.h"
 
 #include "third_party/skia/include/core/SkSurface.h"
@@ -26,7 +30,36 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
 
   bool Present(const sk_sp<SkImage>& image);
 
+  // Makes the engine render into buffers from a pool of this context instead
+  // of into buffers of the engine. Buffers return to the pool when the engine
+  // is done with them.
+  void SetupBufferPool();
+
+  // The number of buffers that were allocated for the pool.
+  size_t GetBufferPoolSize() const;
+
+  // The number of times that the engine acquired a buffer of the pool,
+  // presented one, and returned one to the pool.
+  size_t GetBufferAcquireCount() const;
+  size_t GetBufferPresentCount() const;
+  size_t GetBufferDestructionCount() const;
+
+  // The number of frames that the engine rendered into its own buffer and
+  // presented as a copy, instead of rendering into a buffer of the pool.
+  size_t GetCopiedFrameCount() const;
+
  private:
+  struct PooledBuffer {
+    EmbedderTestContextSoftware* context;
+    DlISize size;
+    std::vector<uint32_t> pixels;
+  };
+
+  bool AcquireBuffer(const FlutterFrameInfo* frame_info,
+                     FlutterSoftwareBackingStore* buffer_out);
+
+  bool PresentBuffer(const FlutterSoftwareBackingStore* buffer);
+
   // |EmbedderTestContext|
   void SetSurface(DlISize surface_size) override;
 
@@ -36,6 +69,13 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
   sk_sp<SkSurface> surface_;
   DlISize surface_size_;
   size_t software_surface_present_count_ = 0;
+  size_t copied_frame_count_ = 0;
+  mutable std::mutex buffer_pool_mutex_;
+  std::vector<std::unique_ptr<PooledBuffer>> buffer_pool_;
+  std::vector<PooledBuffer*> free_buffers_;
+  size_t buffer_acquire_count_ = 0;
+  size_t buffer_present_count_ = 0;
+  size_t buffer_destruction_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderTestContextSoftware);
 };
@@ -4,6 +4,7 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -3920,6 +3921,208 @@ TEST_F(EmbedderTest, CanScheduleFrame) {
   check_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanRenderIntoEmbedderBuffersWithoutVsync) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  context.SetupBufferPool();
+  context.SetVsyncCallback([](intptr_t baton) {
+    ADD_FAILURE() << "Frames should not wait for vsync.";
+  });
+
+  constexpr uint64_t kFrameCount = 3;
+  std::atomic<uint64_t> frame_count = 0;
+  fml::AutoResetWaitableEvent frames_latch;
+  context.SetFrameCompleteCallback([&](const FlutterFrameTimings* timings) {
+    EXPECT_LE(timings->vsync_start_nanos, timings->build_start_nanos);
+    EXPECT_LE(timings->build_start_nanos, timings->build_finish_nanos);
+    EXPECT_LE(timings->build_finish_nanos, timings->raster_start_nanos);
+    EXPECT_LE(timings->raster_start_nanos, timings->raster_finish_nanos);
+    if (++frame_count == kFrameCount) {
+      frames_latch.Signal();
+    }
+  });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("render_gradient_three_times");
+  builder.SetSurface(DlISize(800, 600));
+  builder.SetupVsyncCallback();
+  builder.SetupFrameCompleteCallback();
+  builder.GetProjectArgs().frame_pacing = kFlutterFramePacingThroughput;
+
+  auto rendered_scene = context.GetNextSceneImage();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  ASSERT_TRUE(ImageMatchesFixture(
+      FixtureNameForBackend(EmbedderTestContextType::kSoftwareContext,
+                            "gradient.png"),
+      rendered_scene));
+
+  frames_latch.Wait();
+  // Shutting down the engine releases the buffers of frames that are still
+  // in flight.
+  engine.reset();
+
+  EXPECT_EQ(frame_count.load(), kFrameCount);
+  // Every frame was rendered into a buffer of the pool and presented from
+  // it, and none was rendered by the engine and copied.
+  EXPECT_EQ(context.GetBufferAcquireCount(), kFrameCount);
+  EXPECT_EQ(context.GetBufferPresentCount(), kFrameCount);
+  EXPECT_EQ(context.GetBufferDestructionCount(), kFrameCount);
+  EXPECT_EQ(context.GetCopiedFrameCount(), 0u);
+  // The engine returns every buffer before it acquires the next one.
+  EXPECT_EQ(context.GetBufferPoolSize(), 1u);
+}
+
+TEST_F(EmbedderTest, RejectsEmbedderBuffersWithShortRows) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  static fml::AutoResetWaitableEvent destruction_latch;
+  // The rows of the buffer are 100 pixels long, which is too short for the
+  // 800 pixels wide frame.
+  context.GetRendererConfig().software.acquire_buffer_callback =
+      [](void* context, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBackingStore* buffer_out) {
+        static std::vector<uint32_t> pixels;
+        pixels.resize(100 * frame_info->size.height);
+        buffer_out->allocation = pixels.data();
+        buffer_out->row_bytes = 100 * sizeof(uint32_t);
+        buffer_out->height = frame_info->size.height;
+        buffer_out->user_data = nullptr;
+        buffer_out->destruction_callback = [](void* user_data) {
+          destruction_latch.Signal();
+        };
+        return true;
+      };
+  context.GetRendererConfig().software.present_buffer_callback =
+      [](void* context, const FlutterSoftwareBackingStore* buffer) {
+        ADD_FAILURE() << "A buffer with short rows should not be presented.";
+        return false;
+      };
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("render_gradient");
+  builder.SetSurface(DlISize(800, 600));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  // The engine returns the buffer right away instead of rendering into it.
+  destruction_latch.Wait();
+}
+
+TEST_F(EmbedderTest, CanRenderGradientInParallelTiles) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("render_gradient");
+  builder.SetSurface(DlISize(800, 600));
+  builder.AddCommandLineArgument("--software-raster-threads=4");
+
+  auto rendered_scene = context.GetNextSceneImage();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  ASSERT_TRUE(ImageMatchesFixture(
+      FixtureNameForBackend(EmbedderTestContextType::kSoftwareContext,
+                            "gradient.png"),
+      rendered_scene));
+}
+
+TEST_F(EmbedderTest, CompositorReusesUnchangedBackingStores) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(300, 200));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("reuses_unchanged_backing_stores");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  struct PresentedBackingStore {
+    void* user_data;
+    bool did_update;
+  };
+  std::vector<std::vector<PresentedBackingStore>> frames;
+  fml::CountDownLatch latch(3);
+  context.GetCompositor().SetPresentCallback(
+      [&](FlutterViewId view_id, const FlutterLayer** layers,
+          size_t layers_count) {
+        ASSERT_EQ(layers_count, 3u);
+        std::vector<PresentedBackingStore> backing_stores;
+        for (size_t i = 0; i < layers_count; ++i) {
+          if (layers[i]->type == kFlutterLayerContentTypeBackingStore) {
+            backing_stores.push_back({layers[i]->backing_store->user_data,
+                                      layers[i]->backing_store->did_update});
+          }
+        }
+        frames.push_back(std::move(backing_stores));
+        latch.CountDown();
+      },
+      /*one_shot=*/false);
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  ASSERT_EQ(frames.size(), 3u);
+  for (const auto& frame : frames) {
+    ASSERT_EQ(frame.size(), 2u);
+  }
+
+  // The first frame renders both backing stores.
+  EXPECT_TRUE(frames[0][0].did_update);
+  EXPECT_TRUE(frames[0][1].did_update);
+
+  // The second frame is unchanged and presents them again as they are.
+  EXPECT_EQ(frames[1][0].user_data, frames[0][0].user_data);
+  EXPECT_EQ(frames[1][1].user_data, frames[0][1].user_data);
+  EXPECT_FALSE(frames[1][0].did_update);
+  EXPECT_FALSE(frames[1][1].did_update);
+
+  // The third frame only changes the contents above the platform view.
+  EXPECT_EQ(frames[2][0].user_data, frames[0][0].user_data);
+  EXPECT_FALSE(frames[2][0].did_update);
+  EXPECT_TRUE(frames[2][1].did_update);
+
+  EXPECT_EQ(context.GetCompositor().GetBackingStoresCreatedCount(), 2u);
+}
+
 TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
   EmbedderConfigBuilder builder(context);
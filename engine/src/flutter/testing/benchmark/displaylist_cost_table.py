@@ -0,0 +1,433 @@
+#!/usr/bin/env python3
+#
+# Copyright 2013 The Flutter Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Fits DisplayList complexity costs to display_list_benchmarks results.
+
+The script reads the JSON output of the display_list_benchmarks suite, or
+runs the suite itself, and fits the linear cost models described in
+flutter/display_list/benchmarking/dl_complexity_cost_table.h to the
+measurements of one backend. It then writes a C++ source file defining a
+DlComplexityCostTable for the DisplayListTableComplexityCalculator.
+
+Costs that could not be fitted because the results contain no matching
+benchmarks keep the seed values below, which were carried over from the
+OpenGL calculator, and are marked as such in the generated file.
+
+Example:
+
+    $ out/host_profile/display_list_benchmarks \\
+        --benchmark_filter=/Software/ --benchmark_format=json > sw.json
+    $ ./displaylist_cost_table.py --input sw.json --backend Software \\
+        --name "Skia Software" --symbol kDlSkiaSoftwareCostTable \\
+        --output ../../display_list/benchmarking/dl_complexity_table_skia_software.cc
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+
+# A score of 100 is roughly equivalent to 0.0005ms.
+SCORE_PER_MS = 200000.0
+
+# Milliseconds per unit of the `time_unit` reported by Google Benchmark.
+TIME_UNITS = {'ns': 1e-6, 'us': 1e-3, 'ms': 1.0, 's': 1e3}
+
+# The number of segments of each polygon drawn by BM_DrawPath and
+# BM_DrawShadow. Each polygon also has a move and a close verb, which are
+# included in the VerbCount counter but are not costed by the calculator.
+PATH_POLYGON_SIDES = 20
+SHADOW_POLYGON_SIDES = 10
+
+STYLES = ['fill', 'fill_aa', 'stroke', 'stroke_aa', 'hairline', 'hairline_aa']
+STYLED_ENTRIES = ['line', 'rect', 'oval', 'circle', 'round_rect', 'diff_round_rect', 'arc']
+PATH_ENTRIES = ['path', 'path_aa', 'shadow', 'shadow_transparent']
+IMAGE_ENTRIES = ['image', 'image_rect', 'image_nine']
+VERBS = {'Lines': 'line_verb', 'Quads': 'quad_verb', 'Conics': 'conic_verb', 'Cubics': 'cubic_verb'}
+POINT_MODES = {'Points': 0, 'Lines': 1, 'Polygon': 2}
+
+
+def cost(fixed=0.0, per_unit=0.0, per_area=0.0):
+  return {'fixed': fixed, 'per_unit': per_unit, 'per_area': per_area}
+
+
+def styled(fill, fill_aa, stroke, stroke_aa, hairline, hairline_aa):
+  return dict(zip(STYLES, [fill, fill_aa, stroke, stroke_aa, hairline, hairline_aa]))
+
+
+def path_costs(fixed, line, quad, conic, cubic):
+  return {
+      'fixed': fixed, 'line_verb': line, 'quad_verb': quad, 'conic_verb': conic,
+      'cubic_verb': cubic
+  }
+
+
+def seed_table():
+  """Returns costs equivalent to the DisplayListGLComplexityCalculator."""
+  rect_stroke = cost(per_unit=2.0)
+  rect_stroke_aa = cost(per_unit=4.0 / 3.0)
+  oval_stroke = cost(per_unit=8.0 / 3.0)
+  oval_stroke_aa = cost(per_area=0.05)
+  rrect_stroke = cost(30.0, 0.8)
+  rrect_stroke_aa = cost(40.0, 1.6)
+  drrect_stroke = cost(50.0, 100.0 / 27.0)
+  drrect_stroke_aa = cost(100.0, 20.0 / 3.0)
+  return {
+      'cache_threshold': 200000,
+      'draw_color': cost(50.0),
+      'save_layer': cost(2000000.0, 40000.0),
+      'draw_text': cost(50000.0, 2500.0 / 3.0),
+      'line': styled(
+          cost(299.0, 0.575), cost(520.0, 1.0), cost(299.0, 0.575), cost(520.0, 1.0),
+          cost(260.0, 0.5), cost(520.0, 1.0)
+      ),
+      'rect': styled(
+          cost(per_area=2.0 / 175.0), cost(per_area=2.0 / 175.0), rect_stroke, rect_stroke_aa,
+          rect_stroke, rect_stroke_aa
+      ),
+      'oval': styled(
+          cost(per_area=1.0 / 30.0), cost(per_area=1.0 / 30.0), oval_stroke, oval_stroke_aa,
+          oval_stroke, oval_stroke_aa
+      ),
+      # The area of the bounds of a circle is 4 times its radius squared, and
+      # the average of their width and height is twice the radius.
+      'circle': styled(
+          cost(2160.0, per_area=0.0206), cost(2000.0, per_area=0.019), cost(800.0, 2.0),
+          cost(400.0, 20.0 / 3.0), cost(800.0, 2.0), cost(400.0, 20.0 / 3.0)
+      ),
+      'round_rect': styled(
+          cost(20.0, per_area=0.0125), cost(20.0, per_area=0.0125), rrect_stroke, rrect_stroke_aa,
+          rrect_stroke, rrect_stroke_aa
+      ),
+      'diff_round_rect': styled(
+          cost(200.0, per_area=0.0625), cost(200.0, per_area=0.0625), drrect_stroke,
+          drrect_stroke_aa, drrect_stroke, drrect_stroke_aa
+      ),
+      'arc': styled(
+          cost(178.0, per_area=2.0 / 585.0), cost(222.0, per_area=1.0 / 45.0), cost(100.0, 0.5),
+          cost(267.0, per_area=1.0 / 171.0), cost(100.0, 0.5), cost(267.0, per_area=1.0 / 171.0)
+      ),
+      'path': path_costs(50000.0, 135.0, 150.0, 200.0, 235.0),
+      'path_aa': path_costs(200000.0, 235.0, 365.0, 365.0, 725.0),
+      'points': [
+          styled(
+              cost(50000.0, 100.0 / 9.0), cost(per_unit=400.0 / 9.0), cost(50000.0, 100.0 / 9.0),
+              cost(per_unit=400.0), cost(50000.0, 100.0 / 9.0), cost(per_unit=400.0 / 9.0)
+          ),
+          styled(
+              cost(50000.0, 200.0 / 9.0), cost(per_unit=800.0 / 3.0), cost(50000.0, 200.0 / 9.0),
+              cost(per_unit=400.0), cost(50000.0, 400.0 / 17.0), cost(per_unit=800.0 / 3.0)
+          ),
+          styled(
+              cost(50000.0, 80.0 / 3.0), cost(per_unit=4000.0 / 7.0), cost(50000.0, 80.0 / 3.0),
+              cost(per_unit=800.0), cost(50000.0, 80.0 / 3.0), cost(per_unit=4000.0 / 7.0)
+          ),
+      ],
+      'vertices': cost(200000.0, 125.0),
+      'image': {'texture': cost(per_unit=400.0 / 13.0), 'upload': cost(4000.0, per_area=0.13)},
+      'image_rect': {'texture': cost(per_unit=200.0 / 11.0), 'upload': cost(2000.0, per_area=0.1)},
+      'image_nine': {
+          'texture': cost(1200.0, per_area=1.0 / 9.0), 'upload': cost(1680.0, per_area=0.156)
+      },
+      'shadow': path_costs(0.0, 17000.0, 20000.0, 20000.0, 120000.0),
+      'shadow_transparent': path_costs(0.0, 20400.0, 24000.0, 24000.0, 144000.0),
+  }
+
+
+def solve(matrix, vector):
+  """Solves a small linear system with Gaussian elimination."""
+  size = len(vector)
+  rows = [list(matrix[i]) + [vector[i]] for i in range(size)]
+  for col in range(size):
+    pivot = max(range(col, size), key=lambda r: abs(rows[r][col]))
+    if abs(rows[pivot][col]) < 1e-12:
+      return None
+    rows[col], rows[pivot] = rows[pivot], rows[col]
+    for row in range(size):
+      if row != col:
+        factor = rows[row][col] / rows[col][col]
+        for k in range(col, size + 1):
+          rows[row][k] -= factor * rows[col][k]
+  return [rows[i][size] / rows[i][i] for i in range(size)]
+
+
+def fit(samples, columns):
+  """Fits y = sum(c * x[column]) by least squares with non-negative c.
+
+  Each sample is a dict with an entry for each column and for 'y'. Columns
+  whose coefficient would be negative are removed and the fit is repeated,
+  as a negative cost would make the calculator underestimate large ops.
+  """
+  columns = list(columns)
+  while columns:
+    matrix = [[sum(s[a] * s[b] for s in samples) for b in columns] for a in columns]
+    vector = [sum(s[a] * s['y'] for s in samples) for a in columns]
+    coefficients = solve(matrix, vector)
+    if coefficients is None:
+      columns.pop()
+      continue
+    worst = min(range(len(columns)), key=lambda i: coefficients[i])
+    if coefficients[worst] >= 0.0:
+      return dict(zip(columns, coefficients))
+    columns.pop(worst)
+  return {}
+
+
+def fit_cost(samples):
+  columns = ['fixed']
+  if len({s['per_unit'] for s in samples}) > 1:
+    columns.append('per_unit')
+  if len({s['per_area'] for s in samples}) > 1:
+    columns.append('per_area')
+  fitted = fit(samples, columns)
+  return cost(*[fitted.get(c, 0.0) for c in ['fixed', 'per_unit', 'per_area']])
+
+
+def style_key(result, always_stroked):
+  aa = result.get('AntiAliasing', 0) != 0
+  if not always_stroked and result.get('StrokedStyle', 0) == 0:
+    key = 'fill'
+  elif result.get('HairlineStroke', 0) != 0:
+    key = 'hairline'
+  else:
+    key = 'stroke'
+  return key + '_aa' if aa else key
+
+
+def sample(units, area, score):
+  return {'fixed': 1.0, 'per_unit': float(units), 'per_area': float(area), 'y': score}
+
+
+def classify(result, backend):
+  """Returns the cost table key and sample for one benchmark result."""
+  parts = [p for p in result['name'].split('/') if p != 'real_time']
+  if len(parts) < 3 or parts[-2] != backend:
+    return None
+  function, variant, seed = parts[0], parts[1:-2], float(parts[-1])
+  total = result['real_time'] * TIME_UNITS[result['time_unit']] * SCORE_PER_MS
+  calls = result.get('DrawCallCount', 1.0) or 1.0
+  score = total / calls
+
+  shapes = {
+      # Lines run between opposite edges of an n by n square, so their
+      # horizontal distance averages n / 2 and their vertical distance is n.
+      'BM_DrawLine': ('line', 1.5 * seed, 0.0),
+      'BM_DrawRect': ('rect', seed, seed * seed),
+      'BM_DrawOval': ('oval', 1.25 * seed, 1.5 * seed * seed),
+      'BM_DrawCircle': ('circle', seed, seed * seed),
+      'BM_DrawArc': ('arc', seed, seed * seed),
+      'BM_DrawRRect': ('round_rect', seed, seed * seed),
+      'BM_DrawDRRect': ('diff_round_rect', seed, seed * seed),
+  }
+  if function in shapes:
+    entry, units, area = shapes[function]
+    key = style_key(result, function == 'BM_DrawLine')
+    return (entry, key), sample(units, area, score)
+
+  images = {
+      'BM_DrawImage': 'image', 'BM_DrawImageRect': 'image_rect', 'BM_DrawImageNine': 'image_nine'
+  }
+  if function in images:
+    kind = 'upload' if variant and variant[0] == 'Upload' else 'texture'
+    return (images[function], kind), sample(seed, seed * seed, score)
+
+  if function == 'BM_DrawPath' and variant and variant[0] in VERBS:
+    entry = 'path_aa' if result.get('AntiAliasing', 0) != 0 else 'path'
+    verbs = result['VerbCount'] * PATH_POLYGON_SIDES / (PATH_POLYGON_SIDES + 2)
+    return (entry, variant[0]), sample(verbs, 0.0, total)
+
+  if function == 'BM_DrawShadow' and len(variant) > 1 and variant[0] in VERBS:
+    entry = 'shadow_transparent' if variant[1] == 'Transparent' else 'shadow'
+    return (entry, variant[0]), sample(SHADOW_POLYGON_SIDES, 0.0, total)
+
+  if function == 'BM_DrawPoints' and variant and variant[0] in POINT_MODES:
+    key = style_key(result, True)
+    return ('points', POINT_MODES[variant[0]], key), sample(result['PointCount'], 0.0, total)
+
+  if function == 'BM_DrawVertices':
+    return ('vertices',), sample(result['VertexCount'] / calls, 0.0, score)
+
+  batched = {'BM_DrawTextBlob': 'draw_text', 'BM_SaveLayer': 'save_layer'}
+  if function in batched:
+    return (batched[function],), sample(result['DrawCallCount_Varies'], 0.0, total)
+
+  return None
+
+
+def fit_table(results, backend):
+  """Returns the seed table with every cost that has samples refitted."""
+  groups = {}
+  for result in results:
+    if 'aggregate_name' in result or result.get('run_type') == 'aggregate':
+      continue
+    classified = classify(result, backend)
+    if classified is not None:
+      key, point = classified
+      groups.setdefault(key, []).append(point)
+
+  table = seed_table()
+  fitted = set()
+  for key, samples in groups.items():
+    if key[0] in PATH_ENTRIES:
+      continue
+    target = table
+    for part in key[:-1]:
+      target = target[part]
+    target[key[-1]] = fit_cost(samples)
+    fitted.add(key)
+
+  # The fixed cost of a path op is shared by all verb types, so it is
+  # averaged over the fits for each verb type. Shadows have no measurable
+  # fixed cost, so their whole cost is spread over the verbs.
+  for entry in PATH_ENTRIES:
+    fixed = []
+    for verb, field in VERBS.items():
+      samples = groups.get((entry, verb))
+      if not samples:
+        continue
+      if entry.startswith('shadow'):
+        mean = sum(s['y'] for s in samples) / len(samples)
+        table[entry][field] = mean / SHADOW_POLYGON_SIDES
+      else:
+        verb_cost = fit_cost(samples)
+        table[entry][field] = verb_cost['per_unit']
+        fixed.append(verb_cost['fixed'])
+      fitted.add((entry, verb))
+    if fixed:
+      table[entry]['fixed'] = sum(fixed) / len(fixed)
+  return table, fitted
+
+
+def format_float(value):
+  text = '%.6g' % value
+  if '.' not in text and 'e' not in text:
+    text += '.0'
+  return text + 'f'
+
+
+def format_cost(value):
+  fields = ['.%s = %s' % (k, format_float(value[k])) for k in ['fixed', 'per_unit', 'per_area']]
+  return '{' + ', '.join(fields) + '}'
+
+
+def format_path(value):
+  fields = ['fixed', 'line_verb', 'quad_verb', 'conic_verb', 'cubic_verb']
+  return '{' + ', '.join('.%s = %s' % (k, format_float(value[k])) for k in fields) + '}'
+
+
+def is_fitted(fitted, *key):
+  return any(k[:len(key)] == key for k in fitted)
+
+
+def emit_styled(lines, indent, value, fitted, *key):
+  for style in STYLES:
+    note = '' if is_fitted(fitted, *key, style) else '  // seed'
+    lines.append('%s.%s = %s,%s' % (indent, style, format_cost(value[style]), note))
+
+
+def emit_table(table, fitted, name, symbol, source):
+  lines = [
+      '// Copyright 2013 The Flutter Authors. All rights reserved.',
+      '// Use of this source code is governed by a BSD-style license that can be',
+      '// found in the LICENSE file.',
+      '',
+      '// Generated by testing/benchmark/displaylist_cost_table.py from',
+      '// %s.' % source,
+      '// Do not edit by hand. Costs marked as seed were not measured.',
+      '',
+      '#include "flutter/display_list/benchmarking/dl_complexity_cost_table.h"',
+      '',
+      'namespace flutter {',
+      '',
+      '// clang-format off',
+      'const DlComplexityCostTable %s = {' % symbol,
+      '    .name = "%s",' % name,
+      '    .cache_threshold = %du,' % table['cache_threshold'],
+  ]
+
+  def note(*key):
+    return '' if is_fitted(fitted, *key) else '  // seed'
+
+  for entry in ['draw_color', 'save_layer', 'draw_text']:
+    lines.append('    .%s = %s,%s' % (entry, format_cost(table[entry]), note(entry)))
+  for entry in STYLED_ENTRIES:
+    lines.append('    .%s = {' % entry)
+    emit_styled(lines, '        ', table[entry], fitted, entry)
+    lines.append('    },')
+  for entry in ['path', 'path_aa']:
+    lines.append('    .%s = %s,%s' % (entry, format_path(table[entry]), note(entry)))
+  lines.append('    .points = {')
+  for mode in range(3):
+    lines.append('        {')
+    emit_styled(lines, '            ', table['points'][mode], fitted, 'points', mode)
+    lines.append('        },')
+  lines.append('    },')
+  lines.append('    .vertices = %s,%s' % (format_cost(table['vertices']), note('vertices')))
+  for entry in IMAGE_ENTRIES:
+    lines.append('    .%s = {' % entry)
+    for kind in ['texture', 'upload']:
+      lines.append(
+          '        .%s = %s,%s' % (kind, format_cost(table[entry][kind]), note(entry, kind))
+      )
+    lines.append('    },')
+  for entry in ['shadow', 'shadow_transparent']:
+    lines.append('    .%s = %s,%s' % (entry, format_path(table[entry]), note(entry)))
+  lines += ['};', '// clang-format on', '', '}  // namespace flutter', '']
+  return '\n'.join(lines)
+
+
+def load_results(args):
+  if args.benchmarks:
+    command = [
+        args.benchmarks, '--benchmark_format=json',
+        '--benchmark_filter=/%s/' % args.backend
+    ]
+    output = subprocess.check_output(command)
+    return json.loads(output)['benchmarks'], 'display_list_benchmarks results'
+  with open(args.input, 'r') as json_file:
+    return json.load(json_file)['benchmarks'], 'display_list_benchmarks results'
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  source = parser.add_mutually_exclusive_group(required=True)
+  source.add_argument('--input', help='JSON output of display_list_benchmarks.')
+  source.add_argument('--benchmarks', help='Path to a display_list_benchmarks binary to run.')
+  parser.add_argument(
+      '--backend',
+      default='Software',
+      help='Backend name used in the benchmark names, e.g. Software.'
+  )
+  parser.add_argument('--name', required=True, help='Name of the table.')
+  parser.add_argument('--symbol', required=True, help='C++ symbol of the table.')
+  parser.add_argument(
+      '--threshold',
+      type=int,
+      default=None,
+      help='Cache threshold in complexity units (defaults to 1ms).'
+  )
+  parser.add_argument('--output', help='Output file, defaults to stdout.')
+  args = parser.parse_args()
+
+  results, source_description = load_results(args)
+  table, fitted = fit_table(results, args.backend)
+  if not fitted:
+    print('No results for backend %s.' % args.backend, file=sys.stderr)
+    return 1
+  if args.threshold is not None:
+    table['cache_threshold'] = args.threshold
+  source_description = '%s for the %s backend' % (source_description, args.backend)
+
+  output = emit_table(table, fitted, args.name, args.symbol, source_description)
+  if args.output:
+    with open(args.output, 'w') as output_file:
+      output_file.write(output)
+  else:
+    sys.stdout.write(output)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -44,7 +44,9 @@ void main() {
       'layerCacheBytes: 0, '
       'pictureCacheCount: 0, '
       'pictureCacheBytes: 0, '
-      'frameNumber: 23)',
+      'frameNumber: 23, '
+      'queuedFramesAtBuildFinish: 0, '
+      'queuedFramesAtRasterStart: 0)',
     );
   });
 
@@ -61,6 +63,8 @@ void main() {
       pictureCacheCount: 3,
       pictureCacheBytes: 300000,
       frameNumber: 29,
+      queuedFramesAtBuildFinish: 1,
+      queuedFramesAtRasterStart: 2,
     );
     expect(
       timing.toString(),
@@ -72,7 +76,9 @@ void main() {
       'layerCacheBytes: 200000, '
       'pictureCacheCount: 3, '
       'pictureCacheBytes: 300000, '
-      'frameNumber: 29)',
+      'frameNumber: 29, '
+      'queuedFramesAtBuildFinish: 1, '
+      'queuedFramesAtRasterStart: 2)',
     );
   });
 